@@ -21,6 +21,8 @@ To compile TestMothur you need to uncomment
  
  //ReferenceDB* ReferenceDB::myInstance; in referencedb.cpp
  
+ //PerformanceTrace* PerformanceTrace::_uniqueInstance; in performancetrace.cpp
+ 
  */
 //***********************************************************//
 //***********************************************************//
@@ -45,6 +45,18 @@ TEST_CASE("Testing Sequence Class") {
         CHECK(seq.getUnaligned() == "atgcatgc");
     }
     
+    SECTION("test getAligned / getUnaligned return references") {
+        INFO("Using ..atgc--atgc..") // Only appears on a FAIL
+        seq.setAligned("..atgc--atgc..");
+        const string& aligned = seq.getAligned();
+        const string& unaligned = seq.getUnaligned();
+        CAPTURE(aligned); // Displays this variable on a FAIL
+        
+        CHECK(&aligned == &seq.getAligned());
+        CHECK(&unaligned == &seq.getUnaligned());
+        CHECK(unaligned == "atgcatgc");
+    }
+    
     SECTION("test initialize") {
         INFO("No data") // Only appears on a FAIL
         seq2.initialize();
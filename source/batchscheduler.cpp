@@ -0,0 +1,469 @@
+/*
+ *  batchscheduler.cpp
+ *  Mothur
+ *
+ *  Copyright 2016 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "batchscheduler.h"
+
+/***********************************************************************/
+BatchScheduler::BatchScheduler(int p) : processors(p) {
+	try {
+		m = MothurOut::getInstance();
+		cFactory = CommandFactory::getInstance();
+		if (processors < 1) { processors = 1; }
+		used = 0; numAnalyzed = 0; numApplied = 0; numFailed = 0;
+		parentPID = m->mothurGetpid(0);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "BatchScheduler");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void BatchScheduler::addCommand(string input) {
+	try {
+		BatchJob job;
+		job.input = input;
+
+		//allow user to omit the () on the quit command
+		if (input == "quit") { job.input = "quit()"; }
+
+		CommandOptionParser parser(job.input);
+		job.commandName = parser.getCommandString();
+		job.options = parser.getOptionString();
+
+		//commands that change mothur's settings run by themselves, so the commands after them see the change
+		//rename.file moves its inputs and make.file names its output after a directory, so they run by themselves too
+		map<string, string> commands = cFactory->getListCommands();
+		if ((commands.find(job.commandName) == commands.end()) || (job.commandName.substr(0, 4) == "set.") || (job.commandName == "get.current") || (job.commandName == "system") || (job.commandName == "quit") || (job.commandName == "help") || (job.commandName == "rename.file") || (job.commandName == "make.file")) {
+			job.alone = true;
+		}
+
+		jobs.push_back(job);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "addCommand");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int BatchScheduler::run() {
+	try {
+		int quitCommandCalled = 0;
+
+		while (numApplied < jobs.size()) {
+			if (m->control_pressed) { break; }
+
+			//jobs are analyzed in order, a job after set.dir or a command using current files has to wait for them
+			while ((numFailed == 0) && (numAnalyzed < jobs.size()) && analyze(numAnalyzed)) { numAnalyzed++; }
+
+			//after a crash the running commands are finished, but no more are started
+			bool started = false;
+			for (int i = numApplied; (numFailed == 0) && (i < numAnalyzed); i++) {
+				if (!canStart(i)) { continue; }
+
+				started = true;
+				if (jobs[i].alone) {
+					m->mothurOut("\nmothur > " + jobs[i].input + "\n");
+					quitCommandCalled = executeCommand(jobs[i]);
+					jobs[i].state = 2;
+					applyCurrentFiles();
+					break; //the jobs after this one have not been analyzed yet
+				}else { startJob(i); }
+			}
+
+			if (quitCommandCalled == 1) { break; }
+
+			if (used == 0) {
+				if (numFailed != 0) { break; }
+				if (!started) { m->mothurOut("[ERROR]: unable to schedule the remaining commands.\n"); break; }
+				continue;
+			}
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+			//wait for a command to finish
+			int status = 0;
+			int pid = wait(&status);
+			if (pid == -1) { m->mothurOut("[ERROR]: lost track of the running commands.\n"); break; }
+
+			for (int i = numApplied; i < numAnalyzed; i++) {
+				if ((jobs[i].state == 1) && (jobs[i].pid == pid)) {
+					jobs[i].state = 2;
+					used -= jobs[i].processors;
+
+					if (WIFSIGNALED(status)) { jobs[i].failure = "it was stopped by signal " + toString(WTERMSIG(status)); numFailed++; }
+					else if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) { jobs[i].failure = "it exited with status " + toString(WEXITSTATUS(status)); numFailed++; }
+					break;
+				}
+			}
+
+			applyCurrentFiles();
+#endif
+		}
+
+		//output of commands that finished after a command before them was left waiting
+		for (int i = numApplied; i < jobs.size(); i++) {
+			if (jobs[i].state == 2) { appendOutput(i); m->mothurRemove(getCurrentFileName(i)); }
+		}
+
+		if (numFailed != 0) {
+			m->mothurOut("[ERROR]: " + toString(numFailed) + " of the scheduled commands did not finish, the commands waiting for them were not run.\n");
+			return 2;
+		}
+
+		return quitCommandCalled;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "run");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool BatchScheduler::analyze(int index) {
+	try {
+		BatchJob& job = jobs[index];
+
+		//nothing is analyzed past a command that changes mothur's settings until it runs
+		for (int j = 0; j < index; j++) {
+			if (jobs[j].alone && (jobs[j].state != 2)) { return false; }
+		}
+
+		if (!job.alone) {
+			findFiles(job);
+
+			//the current files are not known until the commands before it are done
+			if (job.usesCurrent && (numApplied < index)) { return false; }
+
+			//we don't know what a command without input files writes
+			if (job.inputFiles.size() == 0) { job.alone = true; }
+		}
+
+		job.dependsOn.clear();
+		for (int j = 0; j < index; j++) {
+			if (jobs[j].state == 2) { continue; }
+			if (job.alone || conflicts(job, jobs[j])) { job.dependsOn.push_back(j); }
+		}
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "analyze");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void BatchScheduler::findFiles(BatchJob& job) {
+	try {
+		job.inputFiles.clear(); job.outputRoots.clear(); job.usesCurrent = false;
+
+		map<string, string> parameters;
+		OptionParser parser(job.options, parameters);
+		map<string, string> currentFiles = m->getCurrentFiles();
+
+		string inputDir = cFactory->getInputDir();
+		if (parameters.count("inputdir") != 0) { inputDir = parameters["inputdir"]; }
+		string outputDir = cFactory->getOutputDir();
+		if (parameters.count("outputdir") != 0) { outputDir = parameters["outputdir"]; }
+		if (outputDir != "") {
+			outputDir = m->getFullPathName(outputDir);
+			char lastChar = outputDir[outputDir.length()-1];
+			if ((lastChar != '/') && (lastChar != '\\')) { outputDir += "/"; }
+		}
+
+		Command* shellCommand = cFactory->getCommand(job.commandName);
+		vector<CommandParameter> commandParameters = shellCommand->getParameters();
+
+		//a file group without a file given can be filled in with current files
+		set<string> groupsGiven;
+		for (int i = 0; i < commandParameters.size(); i++) {
+			if ((commandParameters[i].type == "InputTypes") && (parameters.count(commandParameters[i].name) != 0)) { groupsGiven.insert(commandParameters[i].chooseAtLeastOneGroup); }
+		}
+
+		vector<string> files;
+		for (int i = 0; i < commandParameters.size(); i++) {
+			//an output named by the user isn't named after the inputs, so we can't tell who reads it
+			if ((commandParameters[i].type == "String") && ((commandParameters[i].name == "output") || (commandParameters[i].name == "prefix")) && (parameters.count(commandParameters[i].name) != 0)) { job.alone = true; }
+			if (commandParameters[i].type != "InputTypes") { continue; }
+
+			string name = commandParameters[i].name;
+			map<string, string>::iterator it = parameters.find(name);
+
+			string value = "";
+			if (it != parameters.end()) {
+				value = it->second;
+				if (value == "current") { job.usesCurrent = true; value = currentFiles[name]; }
+			}else {
+				string group = commandParameters[i].chooseAtLeastOneGroup;
+				bool missing = commandParameters[i].required || ((group != "none") && (group != "") && (groupsGiven.count(group) == 0));
+				if (missing && (currentFiles.count(name) != 0)) { job.usesCurrent = true; value = currentFiles[name]; }
+			}
+			if (value == "") { continue; }
+
+			//parameters can hold several files separated by dashes
+			files.push_back(value);
+			vector<string> pieces;
+			m->splitAtDash(value, pieces);
+			if (pieces.size() > 1) { for (int j = 0; j < pieces.size(); j++) { files.push_back(pieces[j]); } }
+		}
+
+		for (int i = 0; i < files.size(); i++) {
+			string filename = files[i];
+			if ((inputDir != "") && (m->hasPath(filename) == "")) { filename = inputDir + filename; }
+			filename = m->getFullPathName(filename);
+			job.inputFiles.insert(filename);
+
+			//outputs are named after the inputs, x.fasta -> x.*
+			string path = m->hasPath(filename);
+			if (outputDir != "") { path = outputDir; }
+			job.outputRoots.insert(path + m->getRootName(m->getSimpleName(filename)));
+		}
+
+		//processors the command will use
+		job.processors = 1;
+		string temp = m->getProcessors();
+		if (parameters.count("processors") != 0) { temp = parameters["processors"]; }
+		if (m->isInteger(temp)) { m->mothurConvert(temp, job.processors); }
+		if (job.processors < 1) { job.processors = 1; }
+		if (job.processors > processors) { job.processors = processors; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "findFiles");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//does a read a file b may write
+bool BatchScheduler::readsOutputOf(BatchJob& a, BatchJob& b) {
+	try {
+		for (set<string>::iterator it = a.inputFiles.begin(); it != a.inputFiles.end(); it++) {
+			//b reads it too, so b does not make it
+			if (b.inputFiles.count(*it) != 0) { continue; }
+
+			for (set<string>::iterator itRoot = b.outputRoots.begin(); itRoot != b.outputRoots.end(); itRoot++) {
+				if ((*it).compare(0, (*itRoot).length(), *itRoot) == 0) { return true; }
+			}
+		}
+		return false;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "readsOutputOf");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool BatchScheduler::conflicts(BatchJob& a, BatchJob& b) {
+	try {
+		if (a.alone || b.alone) { return true; }
+		if (readsOutputOf(a, b) || readsOutputOf(b, a)) { return true; }
+
+		//the same command on the same file writes the same output files
+		if (a.commandName == b.commandName) {
+			for (set<string>::iterator it = a.inputFiles.begin(); it != a.inputFiles.end(); it++) {
+				if (b.inputFiles.count(*it) != 0) { return true; }
+			}
+		}
+		return false;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "conflicts");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool BatchScheduler::canStart(int index) {
+	try {
+		BatchJob& job = jobs[index];
+		if (job.state != 0) { return false; }
+
+		for (int j = 0; j < job.dependsOn.size(); j++) {
+			if (jobs[job.dependsOn[j]].state != 2) { return false; }
+		}
+
+		if (job.alone) { return (used == 0); }
+
+		//a command asking for more than is free waits, unless nothing is running
+		return ((used == 0) || ((used + job.processors) <= processors));
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "canStart");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int BatchScheduler::startJob(int index) {
+	try {
+		BatchJob& job = jobs[index];
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		m->flushLog();
+
+		int pid = fork();
+
+		if (pid > 0) {
+			job.pid = pid;
+			job.state = 1;
+			used += job.processors;
+			return 0;
+		}else if (pid == 0){
+			//the output is added to the logfile in batch order when the command is done, so commands running at the same time don't mix their output
+			m->redirectOutput(getLogFileName(m->mothurGetpid(0)));
+			m->mothurOut("\nmothur > " + job.input + "\n");
+
+			map<string, string> before = m->getCurrentFiles();
+			executeCommand(job);
+			map<string, string> after = m->getCurrentFiles();
+
+			//send the current files this command set back to mothur
+			ofstream out;
+			m->openOutputFile(getCurrentFileName(index), out);
+			for (map<string, string>::iterator it = after.begin(); it != after.end(); it++) {
+				map<string, string>::iterator itBefore = before.find(it->first);
+				if ((itBefore == before.end()) || (itBefore->second != it->second)) { out << it->first << '=' << it->second << endl; }
+			}
+			out.close();
+
+			m->redirectOutput("");
+			exit(0);
+		}else {
+			m->mothurOut("[WARNING]: unable to start a new process for " + job.commandName + ", running it in mothur.\n");
+		}
+#endif
+		m->mothurOut("\nmothur > " + job.input + "\n");
+		executeCommand(job);
+		job.state = 2;
+		applyCurrentFiles();
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "startJob");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int BatchScheduler::executeCommand(BatchJob& job) {
+	try {
+		int quitCommandCalled = 0;
+
+		if (job.commandName != "") {
+			m->executing = true;
+
+			//executes valid command
+			m->changedSeqNames = false;
+			m->runParse = true;
+			m->clearGroups();
+			m->clearAllGroups();
+			m->Treenames.clear();
+			m->saveNextLabel = "";
+			m->commandInputsConvertError = false;
+			m->printedSharedHeaders = false;
+			m->currentSharedBinLabels.clear();
+			m->sharedBinLabelsInFile.clear();
+			m->printedListHeaders = false;
+			m->listBinLabelsInFile.clear();
+
+			PerformanceTrace::getInstance()->startCommand(job.commandName);
+			Command* command = cFactory->getCommand(job.commandName, job.options);
+			if (m->commandInputsConvertError) { quitCommandCalled = 2; }
+			else { quitCommandCalled = command->execute(); }
+			PerformanceTrace::getInstance()->endCommand(quitCommandCalled, command->getOutputFiles());
+
+			//if we aborted command
+			if (quitCommandCalled == 2) {  m->mothurOut("[ERROR]: did not complete " + job.commandName + ".\n");  }
+
+			m->control_pressed = 0;
+			m->executing = false;
+		}else {
+			m->mothurOut("Invalid.\n");
+		}
+
+		return quitCommandCalled;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "executeCommand");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//applies the current files set by finished commands in batch order, so the last command to set a file wins like it would running one at a time
+int BatchScheduler::applyCurrentFiles() {
+	try {
+		while ((numApplied < jobs.size()) && (jobs[numApplied].state == 2)) {
+			appendOutput(numApplied);
+
+			string filename = getCurrentFileName(numApplied);
+
+			ifstream in;
+			if (!jobs[numApplied].alone && (m->openInputFile(filename, in, "no error") == 0)) {
+				while (!in.eof()) {
+					string line = m->getline(in); m->gobble(in);
+
+					int pos = line.find_first_of('=');
+					if (pos != string::npos) { m->setCurrentFile(line.substr(0, pos), line.substr(pos+1)); }
+				}
+				in.close();
+				m->mothurRemove(filename);
+			}
+
+			numApplied++;
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "applyCurrentFiles");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//adds the output of a command that ran in its own process to the logfile and the screen
+int BatchScheduler::appendOutput(int index) {
+	try {
+		BatchJob& job = jobs[index];
+		if (job.pid == 0) { return 0; } //ran in mothur
+
+		string filename = getLogFileName(toString(job.pid));
+
+		//read as written, blank lines included
+		ifstream in(filename.c_str());
+		if (in) {
+			string line;
+			while (std::getline(in, line)) { m->mothurOut(line + "\n"); }
+			in.close();
+			m->mothurRemove(filename);
+		}
+
+		if (job.failure != "") { m->mothurOut("[ERROR]: " + job.commandName + " did not finish, " + job.failure + ".\n"); }
+		m->flushLog();
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "appendOutput");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string BatchScheduler::getLogFileName(string pid) {
+	try {
+		return (cFactory->getOutputDir() + pid + ".batch.log.temp");
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "getLogFileName");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string BatchScheduler::getCurrentFileName(int index) {
+	try {
+		return (cFactory->getOutputDir() + parentPID + ".batch." + toString(index) + ".current.temp");
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BatchScheduler", "getCurrentFileName");
+		exit(1);
+	}
+}
+/***********************************************************************/
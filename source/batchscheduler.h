@@ -0,0 +1,79 @@
+#ifndef BATCHSCHEDULER_H
+#define BATCHSCHEDULER_H
+
+/*
+ *  batchscheduler.h
+ *  Mothur
+ *
+ *  Copyright 2016 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "command.hpp"
+#include "commandfactory.hpp"
+#include "commandoptionparser.hpp"
+#include "performancetrace.h"
+
+/* Runs the commands of a batch file at the same time when they don't depend on each other.
+ A command depends on an earlier command if one of them reads a file the other may write. mothur names its outputs
+ after its inputs, so a command running on x.fasta writes files starting with x., and a later command reading
+ x.good.fasta has to wait for it. Commands that use current files wait for every command before them, and set.dir,
+ set.current and the other commands that change mothur's settings run by themselves, as do commands whose outputs are
+ named by the user, like merge.files, and rename.file and make.file.
+ Each command runs in its own process and sends the current files it set and its output back to mothur, which applies the
+ files and adds the output to the logfile in batch order. If a process crashes no more commands are started.
+ The processors budget is shared by the running commands, each using its processors parameter or the current processors. */
+
+/***********************************************************************/
+
+struct BatchJob {
+	string input, commandName, options;
+	set<string> inputFiles;         //files named in the options, with the current files the command will use
+	set<string> outputRoots;        //the files the command writes start with one of these
+	bool alone;                     //runs in mothur once every command before it is done
+	bool usesCurrent;               //reads current files so it waits for every command before it
+	int processors;
+	vector<int> dependsOn;
+	int state;                      //0 waiting, 1 running, 2 done
+	int pid;
+	string failure;                 //why the process running the command did not finish, "" if it did
+
+	BatchJob() : alone(false), usesCurrent(false), processors(1), state(0), pid(0), failure("") {}
+};
+
+/***********************************************************************/
+
+class BatchScheduler {
+
+public:
+	BatchScheduler(int);            //processors budget
+	~BatchScheduler() {}
+
+	void addCommand(string);        //a line of the batch file
+	int run();                      //returns 1 if a command asked mothur to quit, 2 if a command's process did not finish
+
+private:
+	MothurOut* m;
+	CommandFactory* cFactory;
+	vector<BatchJob> jobs;
+	int processors, used, numAnalyzed, numApplied, numFailed;
+	string parentPID;
+
+	bool analyze(int);              //false if the job can't be analyzed until the jobs before it are done
+	void findFiles(BatchJob&);
+	bool conflicts(BatchJob&, BatchJob&);
+	bool readsOutputOf(BatchJob&, BatchJob&);
+	bool canStart(int);
+	int startJob(int);
+	int executeCommand(BatchJob&);
+	int applyCurrentFiles();
+	int appendOutput(int);
+	string getCurrentFileName(int);
+	string getLogFileName(string);  //pid of the process running the command
+};
+
+/***********************************************************************/
+
+#endif
@@ -15,6 +15,7 @@ EstOutput getValues(SharedRAbundVector* shared1, SharedRAbundVector* shared2), w
 
 
 typedef vector<double> EstOutput;
+struct SharedPairStats;
 
 /***********************************************************************/
 
@@ -35,6 +36,9 @@ public:
 	virtual int getCols()		{	return cols;	}
 	virtual bool getMultiple()  {   return multiple;   }
 	virtual bool getNeedsAll()  {   return needsAll;   }
+    //calculators that only need the merged sums of a pair can skip the loop over every otu, see sharedpairstats.h
+    virtual bool hasPairStats()  {   return false;   }
+    virtual EstOutput getPairValues(SharedPairStats&) { data.clear(); return data; }
 	virtual string getCitation() = 0;
 	void citation() { m->mothurOut(getCitation()); m->mothurOutEndLine(); }
 protected:
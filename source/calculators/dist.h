@@ -20,7 +20,7 @@ public:
 	Dist(){ dist = 0; m = MothurOut::getInstance(); }
 	Dist(const Dist& d) : dist(d.dist) { m = MothurOut::getInstance(); }
 	virtual ~Dist() {}
-	virtual void calcDist(Sequence, Sequence) = 0;
+	virtual void calcDist(const Sequence&, const Sequence&) = 0;
 	double getDist()	{	return dist;	}
 
 protected:
@@ -18,13 +18,13 @@
 class eachGapDistIgnoreNs : public Dist {
 	
 public:
-	void calcDist(Sequence A, Sequence B){		
+	void calcDist(const Sequence& A, const Sequence& B){		
 		int diff = 0;
 		int length = 0;
 		int start = 0;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
+		const string& seqA = A.getAligned();
+		const string& seqB = B.getAligned();
 		
 		int alignLength = seqA.length();
 		
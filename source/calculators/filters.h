@@ -63,9 +63,9 @@ public:
 	
 	}
 	
-	void doTrump(Sequence seq) {
+	void doTrump(const Sequence& seq) {
 	
-		string curAligned = seq.getAligned();
+		const string& curAligned = seq.getAligned();
 
 		for(int j = 0; j < alignmentLength; j++) {
 			if(curAligned[j] == trump){
@@ -86,9 +86,9 @@ public:
         if (filter.length() != alignmentLength) {  m->mothurOut("[ERROR]: Sequences are not all the same length as the filter, please correct.\n");  m->control_pressed = true; }
 	}
 
-	void getFreqs(Sequence seq) {
+	void getFreqs(const Sequence& seq) {
 	
-		string curAligned = seq.getAligned();
+		const string& curAligned = seq.getAligned();
 	
 		for(int j=0;j<alignmentLength;j++){
 			if(toupper(curAligned[j]) == 'A')										{	a[j]++;		}
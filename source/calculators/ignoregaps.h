@@ -22,14 +22,14 @@ public:
 	
 	ignoreGaps() {}
 	
-	void calcDist(Sequence A, Sequence B){		
+	void calcDist(const Sequence& A, const Sequence& B){		
 		int diff = 0;
 		int length = 0;
 		int start = 0;
 		bool overlap = false;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
+		const string& seqA = A.getAligned();
+		const string& seqB = B.getAligned();
 		int alignLength = seqA.length();
 		
 		for(int i=0;i<alignLength;i++){
@@ -36,3 +36,20 @@ EstOutput Manhattan::getValues(vector<SharedRAbundVector*> shared) {
 	}
 }
 /***********************************************************************/
+/***********************************************************************/
+EstOutput Manhattan::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		data[0] = stats.sumAbsDiff;
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Manhattan", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
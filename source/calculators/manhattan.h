@@ -12,6 +12,7 @@
 
 
 #include "calculator.h"
+#include "sharedpairstats.h"
 
 /***********************************************************************/
 
@@ -21,6 +22,8 @@ public:
 	Manhattan() :  Calculator("manhattan", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	bool hasPairStats() { return true; }
+	EstOutput getPairValues(SharedPairStats&);
 	string getCitation() { return "http://www.mothur.org/wiki/Manhattan"; }
 private:
 	
@@ -20,7 +20,7 @@ public:
 	
 	oneGapDist() {}
 	
-	void calcDist(Sequence A, Sequence B){
+	void calcDist(const Sequence& A, const Sequence& B){
 		
 		int difference = 0;
 		int minLength = 0;
@@ -28,8 +28,8 @@ public:
 		int openGapB = 0;
 		int start = 0;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
+		const string& seqA = A.getAligned();
+		const string& seqB = B.getAligned();
 		int alignLength = seqA.length();
 		
 		for(int i=0;i<alignLength;i++){
@@ -20,7 +20,7 @@ public:
 	
 	oneGapIgnoreTermGapDist() {}
 	
-	void calcDist(Sequence A, Sequence B){
+	void calcDist(const Sequence& A, const Sequence& B){
 		
 		int difference = 0;
 		int openGapA = 0;
@@ -30,8 +30,8 @@ public:
 		int end = 0;
 		bool overlap = false;
 		
-		string seqA = A.getAligned();
-		string seqB = B.getAligned();
+		const string& seqA = A.getAligned();
+		const string& seqB = B.getAligned();
 		int alignLength = seqA.length();
 
 		// this assumes that sequences start and end with '.'s instead of'-'s.
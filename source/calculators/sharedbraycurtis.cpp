@@ -50,3 +50,20 @@ EstOutput BrayCurtis::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput BrayCurtis::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		data[0] = 1.0 - (2 * stats.sumMin) / (float)( stats.Atotal + stats.Btotal);
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BrayCurtis", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
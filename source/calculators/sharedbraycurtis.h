@@ -9,6 +9,7 @@
  *
  */
 #include "calculator.h"
+#include "sharedpairstats.h"
 
 /***********************************************************************/
 
@@ -18,6 +19,8 @@ public:
 	BrayCurtis() :  Calculator("braycurtis", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	bool hasPairStats() { return true; }
+	EstOutput getPairValues(SharedPairStats&);
 	string getCitation() { return "http://www.mothur.org/wiki/Braycurtis"; }
 private:
 	
@@ -47,3 +47,20 @@ EstOutput Jclass::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput Jclass::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		data[0] = 1.0 - stats.S12 / (float)(stats.S1 + stats.S2 - stats.S12);
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Jclass", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
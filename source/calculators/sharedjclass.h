@@ -13,6 +13,7 @@
 It is a child of the calculator class. */
 
 #include "calculator.h"
+#include "sharedpairstats.h"
 
 /***********************************************************************/
 
@@ -22,6 +23,8 @@ public:
 	Jclass() :  Calculator("jclass", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	bool hasPairStats() { return true; }
+	EstOutput getPairValues(SharedPairStats&);
 	string getCitation() { return "http://www.mothur.org/wiki/Jclass"; }
 private:
 	
@@ -54,3 +54,22 @@ EstOutput MorHorn::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput MorHorn::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		double morhorn = 1- (2 * stats.dFloat) / (stats.aFloat + stats.bFloat);
+		
+		if (isnan(morhorn) || isinf(morhorn)) { morhorn = 1; }
+		
+		data[0] = morhorn;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MorHorn", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -11,6 +11,7 @@
 
 
 #include "calculator.h"
+#include "sharedpairstats.h"
 
 /***********************************************************************/
 
@@ -20,6 +21,8 @@ public:
 	MorHorn() :  Calculator("morisitahorn", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	bool hasPairStats() { return true; }
+	EstOutput getPairValues(SharedPairStats&);
 	string getCitation() { return "http://www.mothur.org/wiki/Morisitahorn"; }
 private:
 	
@@ -0,0 +1,73 @@
+//
+//  sharedpairstats.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "sharedpairstats.h"
+
+/***********************************************************************/
+void SharedPairStats::clear() {
+	Atotal = 0; Btotal = 0;
+	S1 = 0; S2 = 0; S12 = 0;
+	sumMin = 0; sumAbsDiff = 0;
+	a = 0; b = 0; d = 0; sumPcubed = 0; sumQcubed = 0; sumPQsq = 0; sumPsqQ = 0;
+	aFloat = 0; bFloat = 0; dFloat = 0;
+	sharedRelA = 0; sharedRelB = 0;
+}
+/***********************************************************************/
+void SharedPairStats::fill(SharedOTUTable& table, int groupA, int groupB) {
+	clear();
+
+	Atotal = table.getNumSeqs(groupA);
+	Btotal = table.getNumSeqs(groupB);
+
+	unsigned long long i = table.getRowStart(groupA); unsigned long long endA = table.getRowEnd(groupA);
+	unsigned long long j = table.getRowStart(groupB); unsigned long long endB = table.getRowEnd(groupB);
+
+	while ((i < endA) || (j < endB)) {
+		double tempA = 0; double tempB = 0;
+
+		//take the next otu present in either group
+		int otuA = (i < endA) ? table.getOTU(i) : -1;
+		int otuB = (j < endB) ? table.getOTU(j) : -1;
+		if ((otuB == -1) || ((otuA != -1) && (otuA < otuB)))       {   tempA = table.getCellAbundance(i); i++;    }
+		else if ((otuA == -1) || (otuB < otuA))                     {   tempB = table.getCellAbundance(j); j++;    }
+		else                                                        {   tempA = table.getCellAbundance(i); i++; tempB = table.getCellAbundance(j); j++;    }
+
+		if (tempA != 0) { S1++; }
+		if (tempB != 0) { S2++; }
+
+		if (tempA < tempB) { sumMin += tempA; }
+		else { sumMin += tempB; }
+		sumAbsDiff += abs((int)(tempA - tempB));
+
+		double pi = tempA / Atotal;
+		double qi = tempB / Btotal;
+		if (tempA == 0) { pi = 0; }
+		if (tempB == 0) { qi = 0; }
+
+		a += pi * pi;
+		b += qi * qi;
+		d += pi * qi;
+		sumPcubed += pi * pi * pi;
+		sumQcubed += qi * qi * qi;
+		sumPQsq += pi * qi * qi;
+		sumPsqQ += pi * pi * qi;
+
+		float relA = pi;
+		float relB = qi;
+		aFloat += relA * relA;
+		bFloat += relB * relB;
+		dFloat += relA * relB;
+
+		//they are shared
+		if ((tempA != 0) && (tempB != 0)) {
+			S12++;
+			sharedRelA += (tempA / (float)Atotal);
+			sharedRelB += (tempB / (float)Btotal);
+		}
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,36 @@
+#ifndef Mothur_sharedpairstats_h
+#define Mothur_sharedpairstats_h
+
+//
+//  sharedpairstats.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "sharedotutable.h"
+
+/* The sums the two group calculators need, taken once per pair from a SharedOTUTable.
+ The non zero cells of the two groups are merged in otu order, so a pair costs the number of otus present
+ in either group instead of the number of otus in the table. The sums are added in the same order the
+ calculators add them over the dense vectors, so calculators using them give the same values. */
+
+/***********************************************************************/
+
+struct SharedPairStats {
+	double Atotal, Btotal;
+	double S1, S2, S12;                 //otus in A, in B and in both
+	double sumMin, sumAbsDiff;
+	double a, b, d, sumPcubed, sumQcubed, sumPQsq, sumPsqQ;    //relative abundance sums, thetayc
+	double aFloat, bFloat, dFloat;      //same sums from float relative abundances, morisitahorn
+	double sharedRelA, sharedRelB;      //relative abundance of the shared otus, thetan
+
+	SharedPairStats() { clear(); }
+	void clear();
+	void fill(SharedOTUTable&, int, int);   //table, group A, group B
+};
+
+/***********************************************************************/
+
+#endif
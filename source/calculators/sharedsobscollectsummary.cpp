@@ -70,3 +70,18 @@ EstOutput SharedSobsCS::getValues(vector<SharedRAbundVector*> shared, vector<str
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput SharedSobsCS::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		data[0] = stats.S12;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedSobsCS", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -13,6 +13,7 @@
 /* This calculator returns the number of shared species between 2 groups. */
 
 #include "calculator.h"
+#include "sharedpairstats.h"
 
 /***********************************************************************/
 class SharedSobsCS : public Calculator {
@@ -21,6 +22,8 @@ public:
 	SharedSobsCS() : Calculator("sharedsobs", 1, true) {};
 	EstOutput getValues(SAbundVector* rank){ return data; };
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	bool hasPairStats() { return true; }
+	EstOutput getPairValues(SharedPairStats&);
     EstOutput getValues(vector<SharedRAbundVector*>, vector<string>&);
 	string getCitation() { return "http://www.mothur.org/wiki/Sharedsobs"; }
 };
@@ -47,3 +47,20 @@ EstOutput SorClass::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput SorClass::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		data[0] = 1.0-(2 * stats.S12) / (float)(stats.S1 + stats.S2);
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SorClass", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -14,6 +14,7 @@ It is a child of the calculator class. */
 
 
 #include "calculator.h"
+#include "sharedpairstats.h"
 
 /***********************************************************************/
 
@@ -23,6 +24,8 @@ public:
 	SorClass() :  Calculator("sorclass", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	bool hasPairStats() { return true; }
+	EstOutput getPairValues(SharedPairStats&);
 	string getCitation() { return "http://www.mothur.org/wiki/Sorclass"; }
 private:
 	
@@ -57,3 +57,24 @@ EstOutput ThetaN::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput ThetaN::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		double a = stats.sharedRelA;
+		double b = stats.sharedRelB;
+		double thetaN = (a * b) / (a + b - (a * b));
+		
+		if (isnan(thetaN) || isinf(thetaN)) { thetaN = 0; }
+		
+		data[0] = 1.0 - thetaN;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThetaN", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -88,3 +88,50 @@ EstOutput ThetaYC::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+/***********************************************************************/
+EstOutput ThetaYC::getPairValues(SharedPairStats& stats) {
+	try {
+		data.resize(3,0.0000);
+		
+		double Atotal = stats.Atotal;
+		double Btotal = stats.Btotal;
+		double a = stats.a;
+		double b = stats.b;
+		double d = stats.d;
+		
+		double thetaYC = d / (a + b - d);
+		
+		if (isnan(thetaYC) || isinf(thetaYC)) { thetaYC = 0; }
+		
+		double varA = 4 / Atotal * (stats.sumPcubed - a * a);
+		double varB = 4 / Btotal * (stats.sumQcubed - b * b);
+		double varD = stats.sumPQsq / Atotal + stats.sumPsqQ / Btotal - d * d * (1/Atotal + 1/Btotal);
+		double covAD = 2 / Atotal * (stats.sumPsqQ - a * d);
+		double covBD = 2 / Btotal * (stats.sumPQsq - b* d);
+		
+		double varT = d * d * (varA + varB) / pow(a + b - d, (double)4.0) + pow(a+b, (double)2.0) * varD / pow(a+b-d, (double)4.0)
+						- 2.0 * (a + b) * d / pow(a + b - d, (double)4.0) * (covAD + covBD);
+		
+		double ci = 1.95 * sqrt(varT);
+		
+		data[0] = thetaYC;
+		data[1] = thetaYC - ci;
+		data[2] = thetaYC + ci;
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		if (isnan(data[1]) || isinf(data[1])) { data[1] = 0; }
+		if (isnan(data[2]) || isinf(data[2])) { data[2] = 0; }
+		
+		data[0] = 1.0 - data[0];
+        double hold = data[1];
+        data[1] = 1.0 - data[2];
+        data[2] = 1.0 - hold;
+        
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThetaYC", "getPairValues");
+		exit(1);
+	}
+}
+/***********************************************************************/
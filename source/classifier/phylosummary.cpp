@@ -21,6 +21,7 @@ PhyloSummary::PhyloSummary(string refTfile, CountTable* c, bool r, int p){
 		
 		ct = c;
         groupmap = NULL;
+        setGroups();
         
 		//check for necessary files
 		string taxFileNameTest = m->getFullPathName((refTfile.substr(0,refTfile.find_last_of(".")+1) + "tree.sum"));
@@ -55,9 +56,11 @@ PhyloSummary::PhyloSummary(CountTable* c, bool r, int p){
 		
 		ct = c;
         groupmap = NULL;
+        setGroups();
 		
 		tree.push_back(rawTaxNode("Root"));
 		tree[0].rank = "0";
+		groupCounts.push_back(vector<int>(groups.size(), 0));
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloSummary", "PhyloSummary");
@@ -76,6 +79,7 @@ PhyloSummary::PhyloSummary(string refTfile, GroupMap* g, bool r, int p){
 		
 		groupmap = g;
         ct = NULL;
+        setGroups();
 				
 		//check for necessary files
 		string taxFileNameTest = m->getFullPathName((refTfile.substr(0,refTfile.find_last_of(".")+1) + "tree.sum"));
@@ -110,9 +114,11 @@ PhyloSummary::PhyloSummary(GroupMap* g, bool r, int p){
 		
 		groupmap = g;
         ct = NULL;
+        setGroups();
 		
 		tree.push_back(rawTaxNode("Root"));
 		tree[0].rank = "0";
+		groupCounts.push_back(vector<int>(groups.size(), 0));
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloSummary", "PhyloSummary");
@@ -141,161 +147,145 @@ int PhyloSummary::summarize(string userTfile){
 
 /**************************************************************************************************/
 
-string PhyloSummary::getNextTaxon(string& heirarchy){
+void PhyloSummary::setGroups(){
 	try {
-		string currentLevel = "";
-		if(heirarchy != ""){
-			int pos = heirarchy.find_first_of(';');
-			currentLevel=heirarchy.substr(0,pos);
-			if (pos != (heirarchy.length()-1)) {  heirarchy=heirarchy.substr(pos+1);  }
-			else { heirarchy = ""; }
-		}
-		return currentLevel;
+		groups.clear(); groupIndex.clear();
+		
+		if (groupmap != NULL) { groups = groupmap->getNamesOfGroups(); }
+		else if (ct != NULL) { if (ct->hasGroupInfo()) { groups = ct->getNamesOfGroups(); } }
+		
+		for (int i = 0; i < groups.size(); i++) { groupIndex[groups[i]] = i; }
 	}
 	catch(exception& e) {
-		m->errorOut(e, "PhyloSummary", "getNextTaxon");
+		m->errorOut(e, "PhyloSummary", "setGroups");
 		exit(1);
 	}
 }
-
 /**************************************************************************************************/
-
-int PhyloSummary::addSeqToTree(string seqName, string seqTaxonomy){
+//returns the index of the child, adding it if we are building the tree, -1 if it is not in the reference tree
+int PhyloSummary::findChild(int currentNode, string taxon){
 	try {
-				
-		numSeqs++;
+		map<string, int>::iterator childPointer = tree[currentNode].children.find(taxon);
 		
-		map<string, int>::iterator childPointer;
+		if (childPointer != tree[currentNode].children.end()) { return childPointer->second; }
 		
-		int currentNode = 0;
-		string taxon;
+		if (!ignore) { return -1; }
 		
-		int level = 0;
+		tree.push_back(rawTaxNode(taxon));
+		int index = tree.size() - 1;
 		
-		//are there confidence scores, if so remove them
-		if (seqTaxonomy.find_first_of('(') != -1) {  m->removeConfidences(seqTaxonomy);	}
+		tree[index].parent = currentNode;
+		tree[index].level = tree[currentNode].level+1;
+		tree[currentNode].children[taxon] = index;
+		groupCounts.push_back(vector<int>(groups.size(), 0));
+		
+		return index;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "findChild");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//nodes a taxonomy adds to, with unclassified nodes added until maxLevel. If a taxon is not in the reference tree,
+//missing is set to it and the nodes before it are returned.
+vector<int>& PhyloSummary::findNodes(int taxonomy, string& missing){
+	try {
+		missing = "";
 		
-		while (seqTaxonomy != "") {
+		map<int, vector<int> >::iterator it = taxonomyNodes.find(taxonomy);
+		
+		if (it == taxonomyNodes.end()) {
+			const vector<int>& taxons = taxIndex.getTaxons(taxonomy);
 			
-			if (m->control_pressed) { return 0; }
+			vector<int> nodes;
+			int currentNode = 0;
+			for (int i = 0; i < taxons.size(); i++) {
+				currentNode = findChild(currentNode, taxIndex.getTaxonName(taxons[i]));
+				
+				if (currentNode == -1) {
+					missing = taxIndex.getTaxonName(taxons[i]);
+					if (nodes.size() > maxLevel) { maxLevel = nodes.size(); }
+					failedNodes = nodes;
+					return failedNodes;
+				}
+				nodes.push_back(currentNode);
+			}
 			
-			//somehow the parent is getting one too many accnos
-			//use print to reassign the taxa id
-			taxon = getNextTaxon(seqTaxonomy);
+			it = taxonomyNodes.insert(make_pair(taxonomy, nodes)).first;
+		}
+		
+		vector<int>& nodes = it->second;
+		
+		if (nodes.size() > maxLevel) { maxLevel = nodes.size(); }
+		
+		//if you think you are done and you are not.
+		while ((nodes.size() != 0) && (nodes.size() < maxLevel)) {
+			int child = findChild(nodes[nodes.size()-1], "unclassified");
 			
-			childPointer = tree[currentNode].children.find(taxon);
+			if (child == -1) { missing = "unclassified"; failedNodes = nodes; return failedNodes; }
 			
-			if(childPointer != tree[currentNode].children.end()){	//if the node already exists, update count and move on
-				int thisCount = 1;
-                
-                if (groupmap != NULL) {
-					//find out the sequences group
-					string group = groupmap->getGroup(seqName);
-					
-					if (group == "not found") {  m->mothurOut("[WARNING]: " + seqName + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
-					
-					//do you have a count for this group?
-					map<string, int>::iterator itGroup = tree[childPointer->second].groupCount.find(group);
-					
-					//if yes, increment it - there should not be a case where we can't find it since we load group in read
-					if (itGroup != tree[childPointer->second].groupCount.end()) {
-						tree[childPointer->second].groupCount[group]++;
-					}
-				}else if (ct != NULL) {
-                    if (ct->hasGroupInfo()) {
-                        vector<int> groupCounts = ct->getGroupCounts(seqName);
-                        vector<string> groups = ct->getNamesOfGroups();
-                        for (int i = 0; i < groups.size(); i++) {
-                            
-                            if (groupCounts[i] != 0) {
-                                //do you have a count for this group?
-                                map<string, int>::iterator itGroup = tree[childPointer->second].groupCount.find(groups[i]);
-                                
-                                //if yes, increment it - there should not be a case where we can't find it since we load group in read
-                                if (itGroup != tree[childPointer->second].groupCount.end()) {
-                                    tree[childPointer->second].groupCount[groups[i]] += groupCounts[i];
-                                }
-                            }
-                        }
-                    }
-                    thisCount = ct->getNumSeqs(seqName);
-                }
-				
-				tree[childPointer->second].total += thisCount;
+			nodes.push_back(child);
+		}
+		
+		return nodes;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "findNodes");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 
-				currentNode = childPointer->second;
-			}else{	
-				if (ignore) {
-						
-					tree.push_back(rawTaxNode(taxon));
-					int index = tree.size() - 1;
+int PhyloSummary::addSeqToTree(string seqName, string seqTaxonomy){
+	try {
 				
-					tree[index].parent = currentNode;
-					tree[index].level = (level+1);
-					tree[currentNode].children[taxon] = index;
-                    int thisCount = 1;
-					
-					//initialize groupcounts
-					if (groupmap != NULL) {
-						vector<string> mGroups = groupmap->getNamesOfGroups();
-						for (int j = 0; j < mGroups.size(); j++) {
-							tree[index].groupCount[mGroups[j]] = 0;
-						}
-						
-						//find out the sequences group
-						string group = groupmap->getGroup(seqName);
-						
-						if (group == "not found") {  m->mothurOut("[WARNING]: " + seqName + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
-						
-						//do you have a count for this group?
-						map<string, int>::iterator itGroup = tree[index].groupCount.find(group);
-						
-						//if yes, increment it - there should not be a case where we can't find it since we load group in read
-						if (itGroup != tree[index].groupCount.end()) {
-							tree[index].groupCount[group]++;
-						}
-					}else if (ct != NULL) {
-                        if (ct->hasGroupInfo()) {
-                            vector<string> mGroups = ct->getNamesOfGroups();
-                            for (int j = 0; j < mGroups.size(); j++) {
-                                tree[index].groupCount[mGroups[j]] = 0;
-                            }
-                            vector<int> groupCounts = ct->getGroupCounts(seqName);
-                            vector<string> groups = ct->getNamesOfGroups();
-                        
-                            for (int i = 0; i < groups.size(); i++) {
-                                if (groupCounts[i] != 0) {
-                                   
-                                    //do you have a count for this group?
-                                    map<string, int>::iterator itGroup = tree[index].groupCount.find(groups[i]);
-                                     
-                                    //if yes, increment it - there should not be a case where we can't find it since we load group in read
-                                    if (itGroup != tree[index].groupCount.end()) {
-                                        tree[index].groupCount[groups[i]]+=groupCounts[i];
-                                    }
-                                }
-                            }
-                        }
-                        thisCount = ct->getNumSeqs(seqName);
-                    }
-					
-                    tree[index].total = thisCount;
-					currentNode = index;
-					
-				}else{ //otherwise, error
-					m->mothurOut("Warning: cannot find taxon " + taxon + " in reference taxonomy tree at level " + toString(tree[currentNode].level) + " for " + seqName + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
-					break;
+		numSeqs++;
+		
+		//find the sequences groups once, instead of at every level
+		int thisCount = 1;
+		bool inGroupFile = true;
+		vector<int> seqGroups, seqCounts;
+		
+		if (groupmap != NULL) {
+			string group = groupmap->getGroup(seqName);
+			
+			if (group == "not found") { inGroupFile = false; }
+			else {
+				map<string, int>::iterator itGroup = groupIndex.find(group);
+				if (itGroup != groupIndex.end()) { seqGroups.push_back(itGroup->second); seqCounts.push_back(1); }
+			}
+		}else if (ct != NULL) {
+			if (ct->hasGroupInfo()) {
+				vector<int> counts = ct->getGroupCounts(seqName);
+				for (int i = 0; i < counts.size(); i++) {
+					if ((counts[i] != 0) && (i < groups.size())) { seqGroups.push_back(i); seqCounts.push_back(counts[i]); }
 				}
 			}
+			thisCount = ct->getNumSeqs(seqName);
+		}
+		
+		string missing;
+		vector<int>& nodes = findNodes(taxIndex.getTaxonomy(seqTaxonomy), missing);
+		
+		for (int i = 0; i < nodes.size(); i++) {
 			
-			level++;
-            
-            if (level > maxLevel) { maxLevel = level; }
+			if (m->control_pressed) { return 0; }
 			
-			if ((seqTaxonomy == "") && (level < maxLevel)) {  //if you think you are done and you are not.
-				for (int k = level; k < maxLevel; k++) {  seqTaxonomy += "unclassified;";   }
-			}
+			if (!inGroupFile) {  m->mothurOut("[WARNING]: " + seqName + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
+			
+			tree[nodes[i]].total += thisCount;
+			
+			vector<int>& counts = groupCounts[nodes[i]];
+			for (int j = 0; j < seqGroups.size(); j++) { counts[seqGroups[j]] += seqCounts[j]; }
+		}
+		
+		if (missing != "") {
+			int currentNode = 0;
+			if (nodes.size() != 0) { currentNode = nodes[nodes.size()-1]; }
+			m->mothurOut("Warning: cannot find taxon " + missing + " in reference taxonomy tree at level " + toString(tree[currentNode].level) + " for " + seqName + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
 		}
+		
 		return 0;
 	}
 	catch(exception& e) {
@@ -309,69 +299,34 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 	try {
 		numSeqs++;
 		
-		map<string, int>::iterator childPointer;
-		
-		int currentNode = 0;
-		string taxon;
-		
-		int level = 0;
+		//groups we don't print are not counted
+		vector<int> seqGroups;
+		for (map<string, bool>::iterator itGroup = containsGroup.begin(); itGroup != containsGroup.end(); itGroup++) {
+			if (itGroup->second == true) {
+				map<string, int>::iterator itIndex = groupIndex.find(itGroup->first);
+				if (itIndex != groupIndex.end()) { seqGroups.push_back(itIndex->second); }
+			}
+		}
 		
-		//are there confidence scores, if so remove them
-		if (seqTaxonomy.find_first_of('(') != -1) {  m->removeConfidences(seqTaxonomy);	}
+		string missing;
+		vector<int>& nodes = findNodes(taxIndex.getTaxonomy(seqTaxonomy), missing);
 		
-		while (seqTaxonomy != "") {
+		for (int i = 0; i < nodes.size(); i++) {
 			
 			if (m->control_pressed) { return 0; }
 			
-			//somehow the parent is getting one too many accnos
-			//use print to reassign the taxa id
-			taxon = getNextTaxon(seqTaxonomy);
+			tree[nodes[i]].total++;
 			
-			childPointer = tree[currentNode].children.find(taxon);
-			
-			if(childPointer != tree[currentNode].children.end()){	//if the node already exists, update count and move on
-                for (map<string, bool>::iterator itGroup = containsGroup.begin(); itGroup != containsGroup.end(); itGroup++) {
-                    if (itGroup->second == true) {
-                        tree[childPointer->second].groupCount[itGroup->first]++;
-                    }
-                }
-					
-				tree[childPointer->second].total++;
-				
-				currentNode = childPointer->second;
-			}else{	
-				if (ignore) {
-					
-					tree.push_back(rawTaxNode(taxon));
-					int index = tree.size() - 1;
-					
-					tree[index].parent = currentNode;
-					tree[index].level = (level+1);
-					tree[index].total = 1;
-					tree[currentNode].children[taxon] = index;
-						
-                    for (map<string, bool>::iterator itGroup = containsGroup.begin(); itGroup != containsGroup.end(); itGroup++) {
-                        if (itGroup->second == true) {
-                            tree[index].groupCount[itGroup->first]++;
-                        }
-                    }
-					
-					currentNode = index;
-					
-				}else{ //otherwise, error
-					m->mothurOut("Warning: cannot find taxon " + taxon + " in reference taxonomy tree at level " + toString(tree[currentNode].level) + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
-					break;
-				}
-			}
-			
-			level++;
-            
-            if (level > maxLevel) { maxLevel = level; }
-			
-			if ((seqTaxonomy == "") && (level < maxLevel)) {  //if you think you are done and you are not.
-				for (int k = level; k < maxLevel; k++) {  seqTaxonomy += "unclassified;";   }
-			}
+			vector<int>& counts = groupCounts[nodes[i]];
+			for (int j = 0; j < seqGroups.size(); j++) { counts[seqGroups[j]]++; }
+		}
+		
+		if (missing != "") {
+			int currentNode = 0;
+			if (nodes.size() != 0) { currentNode = nodes[nodes.size()-1]; }
+			m->mothurOut("Warning: cannot find taxon " + missing + " in reference taxonomy tree at level " + toString(tree[currentNode].level) + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
 		}
+		
 		return 0;
 	}
 	catch(exception& e) {
@@ -379,7 +334,6 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 		exit(1);
 	}
 }
-
 /**************************************************************************************************/
 
 void PhyloSummary::assignRank(int index){
@@ -447,7 +401,6 @@ void PhyloSummary::print(ofstream& out, string output){
 	try {
 		
 		if (ignore)     {  assignRank(0); }
-        vector<string> mGroups;
         
         //print labels
         if (output == "detail") {   out << "taxlevel\trankID\ttaxon\tdaughterlevels\ttotal";  }
@@ -456,41 +409,27 @@ void PhyloSummary::print(ofstream& out, string output){
         if (printlevel == -1) { printlevel = maxLevel; }
         else if (printlevel > maxLevel) { m->mothurOut("[WARNING]: Your printlevel is greater than your maxlevel, adjusting your printlevel to " + toString(maxLevel) + "\n"); printlevel = maxLevel; }
         
-		if (groupmap != NULL) {
-			//so the labels match the counts below, since the map sorts them automatically...
-			//sort(groupmap->namesOfGroups.begin(), groupmap->namesOfGroups.end());
-            mGroups = groupmap->getNamesOfGroups();
-			for (int i = 0; i < mGroups.size(); i++) {
-				out << '\t' << mGroups[i];
-			}
-		}else if (ct != NULL) {
-            if (ct->hasGroupInfo()) {
-                mGroups = ct->getNamesOfGroups();
-                for (int i = 0; i < mGroups.size(); i++) {
-                    out << '\t' << mGroups[i];
-                }
-            }
-        }
+		for (int i = 0; i < groups.size(); i++) { out << '\t' << groups[i]; }
 		out << endl;
 		
+		//number of sequences in each group, for the relative abundances
+		groupTotals.assign(groups.size(), 0);
+		for (int i = 0; i < groups.size(); i++) {
+			if (groupmap != NULL)   { groupTotals[i] = groupmap->getNumSeqs(groups[i]);  }
+			else                    { groupTotals[i] = ct->getGroupCount(groups[i]);     }
+		}
+		
 		int totalChildrenInTree = 0;
-		map<string, int>::iterator itGroup;
 		map<string,int>::iterator it;
 		for(it=tree[0].children.begin();it!=tree[0].children.end();it++){   
 			if (tree[it->second].total != 0)  {   
 				totalChildrenInTree++; 
 				tree[0].total += tree[it->second].total;
 				
-				if (groupmap != NULL) {
-					for (int i = 0; i < mGroups.size(); i++) { tree[0].groupCount[mGroups[i]] += tree[it->second].groupCount[mGroups[i]]; } 
-				}else if ( ct != NULL) {
-                    if (ct->hasGroupInfo()) { for (int i = 0; i < mGroups.size(); i++) { tree[0].groupCount[mGroups[i]] += tree[it->second].groupCount[mGroups[i]]; } }
-                }
+				for (int i = 0; i < groups.size(); i++) { groupCounts[0][i] += groupCounts[it->second][i]; }
 			}
 		}
 		
-        
-        
             //print root
             if (relabund) {
                 out.setf(ios::fixed, ios::floatfield); out.setf(ios::showpoint);
@@ -501,24 +440,12 @@ void PhyloSummary::print(ofstream& out, string output){
                     out << tree[0].name << "\t" << (tree[0].total/(double) tree[0].total);
                 }
                 
-                
-                if (groupmap != NULL) {
-                    for (int i = 0; i < mGroups.size(); i++) {
-                        double thisNum = tree[0].groupCount[mGroups[i]];
-                        thisNum /= (double) groupmap->getNumSeqs(mGroups[i]);
-                        out  << '\t' << thisNum;
-                    }
-                }else if ( ct != NULL) {
-                    if (ct->hasGroupInfo()) {
-                        for (int i = 0; i < mGroups.size(); i++) {
-                            double thisNum = tree[0].groupCount[mGroups[i]];
-                            thisNum /= (double) ct->getGroupCount(mGroups[i]);
-                            out  << '\t' << thisNum;
-                        }
-                    }
+                for (int i = 0; i < groups.size(); i++) {
+                    double thisNum = groupCounts[0][i];
+                    thisNum /= groupTotals[i];
+                    out  << '\t' << thisNum;
                 }
                 out << endl;
-               
                 
             }else {
                 if (output == "detail") {
@@ -527,16 +454,10 @@ void PhyloSummary::print(ofstream& out, string output){
                     out << tree[0].name << '\t' << tree[0].total;
                 }
                 
-                if (groupmap != NULL) {
-                    for (int i = 0; i < mGroups.size(); i++) {  out  << '\t'<< tree[0].groupCount[mGroups[i]]; }
-                }else if ( ct != NULL) {
-                    if (ct->hasGroupInfo()) { for (int i = 0; i < mGroups.size(); i++) {  out  << '\t' << tree[0].groupCount[mGroups[i]]; } }
-                }
+                for (int i = 0; i < groups.size(); i++) {  out  << '\t'<< groupCounts[0][i]; }
                 out << endl;
-                
             }
         
-        
 		//print rest
 		print(0, out, output);
 		
@@ -554,7 +475,6 @@ void PhyloSummary::print(ofstream& out, bool relabund){
 		if (ignore) { assignRank(0); }
 	
 		int totalChildrenInTree = 0;
-		map<string, int>::iterator itGroup;
 		
 		map<string,int>::iterator it;
 		for(it=tree[0].children.begin();it!=tree[0].children.end();it++){
@@ -562,31 +482,17 @@ void PhyloSummary::print(ofstream& out, bool relabund){
 				totalChildrenInTree++;
 				tree[0].total += tree[it->second].total;
 				
-				if (groupmap != NULL) {
-                    vector<string> mGroups = groupmap->getNamesOfGroups();
-					for (int i = 0; i < mGroups.size(); i++) { tree[0].groupCount[mGroups[i]] += tree[it->second].groupCount[mGroups[i]]; }
-				}else if ( ct != NULL) {
-                    vector<string> mGroups = ct->getNamesOfGroups();
-                    if (ct->hasGroupInfo()) { for (int i = 0; i < mGroups.size(); i++) { tree[0].groupCount[mGroups[i]] += tree[it->second].groupCount[mGroups[i]]; } }
-                }
+				for (int i = 0; i < groups.size(); i++) { groupCounts[0][i] += groupCounts[it->second][i]; }
 			}
 		}
         
         //print root
         out << tree[0].name << "\t" << "1.0000"; //root relative abundance is 1, everyone classifies to root
         
-        if (groupmap != NULL) {
-            vector<string> mGroups = groupmap->getNamesOfGroups();
-            for (int i = 0; i < mGroups.size(); i++) {  out  << '\t' << "1.0000"; }
-        }else if ( ct != NULL) {
-            vector<string> mGroups = ct->getNamesOfGroups();
-            if (ct->hasGroupInfo()) { for (int i = 0; i < mGroups.size(); i++) {  out  << '\t' << "1.0000"; } }
-        }
+        for (int i = 0; i < groups.size(); i++) {  out  << '\t' << "1.0000"; }
         
         out << endl;
         
-       
-        
 		//print rest
 		print(0, out, relabund);
 		
@@ -612,6 +518,8 @@ void PhyloSummary::print(int i, ofstream& out, string output){
 					if (tree[it2->second].total != 0)  {   totalChildrenInTree++; }
 				}
                 
+                bool printNode = (((output == "detail") && (printlevel >= tree[it->second].level)) || (printlevel == tree[it->second].level));
+                
                 if ((output == "detail") && (printlevel >= tree[it->second].level)) {
                     if (relabund) {
                         out << tree[it->second].level << "\t" << tree[it->second].rank << "\t" << tree[it->second].name << "\t" << totalChildrenInTree << "\t" << (tree[it->second].total/(double) tree[0].total);
@@ -628,47 +536,15 @@ void PhyloSummary::print(int i, ofstream& out, string output){
                     }
                 }
                 
-                if (relabund) {
-                    map<string, int>::iterator itGroup;
-                    if (groupmap != NULL) {
-                        vector<string> mGroups = groupmap->getNamesOfGroups();
-                        for (int i = 0; i < mGroups.size(); i++) {
-                            if (((output == "detail") && (printlevel >= tree[it->second].level)) || (printlevel == tree[it->second].level)) {
-                                out  << '\t' << (tree[it->second].groupCount[mGroups[i]]/(double)groupmap->getNumSeqs(mGroups[i]));
-                            }
-                        }
-                    }else if (ct != NULL) {
-                        if (ct->hasGroupInfo()) {
-                            vector<string> mGroups = ct->getNamesOfGroups();
-                            for (int i = 0; i < mGroups.size(); i++) {
-                                if (((output == "detail") && (printlevel >= tree[it->second].level)) || (printlevel == tree[it->second].level)) {
-                                    out  << '\t' << (tree[it->second].groupCount[mGroups[i]]/(double)ct->getGroupCount(mGroups[i]));
-                                }
-                            }
-                        }
-                    }
-                }else {
-                    map<string, int>::iterator itGroup;
-                    if (groupmap != NULL) {
-                        vector<string> mGroups = groupmap->getNamesOfGroups();
-                        for (int i = 0; i < mGroups.size(); i++) {
-                            if (((output == "detail") && (printlevel >= tree[it->second].level)) || (printlevel == tree[it->second].level)) {
-                                out  << '\t' << tree[it->second].groupCount[mGroups[i]];
-                            }
-                        }
-                    }else if (ct != NULL) {
-                        if (ct->hasGroupInfo()) {
-                            vector<string> mGroups = ct->getNamesOfGroups();
-                            for (int i = 0; i < mGroups.size(); i++) {
-                                if (((output == "detail") && (printlevel >= tree[it->second].level)) || (printlevel == tree[it->second].level)) {
-                                    out  << '\t' << tree[it->second].groupCount[mGroups[i]];
-                                }
-                            }
-                        }
+                if (printNode) {
+                    vector<int>& counts = groupCounts[it->second];
+                    if (relabund) {
+                        for (int j = 0; j < groups.size(); j++) { out  << '\t' << (counts[j]/groupTotals[j]); }
+                    }else {
+                        for (int j = 0; j < groups.size(); j++) { out  << '\t' << counts[j]; }
                     }
-                    
+                    out << endl;
                 }
-                if (((output == "detail") && (printlevel >= tree[it->second].level)) || (printlevel == tree[it->second].level)) { out << endl; }
 			}
 			
 			print(it->second, out, output);
@@ -707,24 +583,13 @@ void PhyloSummary::print(int i, ofstream& out, bool relabund){
                 
 				out << nodeName << "\t" << (tree[it->second].total / (float)tree[i].total);
 				
-				map<string, int>::iterator itGroup;
-				if (groupmap != NULL) {
-					vector<string> mGroups = groupmap->getNamesOfGroups();
-					for (int j = 0; j < mGroups.size(); j++) {
-                        if (tree[i].groupCount[mGroups[j]] == 0) {
-                            out  << '\t' << 0;
-                        }else { out  << '\t' << (tree[it->second].groupCount[mGroups[j]] / (float)tree[i].groupCount[mGroups[j]]); }
-                    }
-				}else if (ct != NULL) {
-                    if (ct->hasGroupInfo()) {
-                        vector<string> mGroups = ct->getNamesOfGroups();
-                        for (int j = 0; j < mGroups.size(); j++) {
-                            if (tree[i].groupCount[mGroups[j]] == 0) {
-                                out  << '\t' << 0 ;
-                            }else { out  << '\t' << (tree[it->second].groupCount[mGroups[j]] / (float)tree[i].groupCount[mGroups[j]]); }
-                        }
-                    }
-                }
+				vector<int>& counts = groupCounts[it->second];
+				vector<int>& parentCounts = groupCounts[i];
+				for (int j = 0; j < groups.size(); j++) {
+					if (parentCounts[j] == 0) {
+						out  << '\t' << 0;
+					}else { out  << '\t' << (counts[j] / (float)parentCounts[j]); }
+				}
 				out << endl;
 				
 			}
@@ -749,6 +614,7 @@ void PhyloSummary::readTreeStruct(ifstream& in){
 		in >> num; m->gobble(in);
 		
 		tree.resize(num);
+		groupCounts.assign(num, vector<int>(groups.size(), 0));
 		
 		in >> maxLevel; m->gobble(in);
 	
@@ -765,19 +631,6 @@ void PhyloSummary::readTreeStruct(ifstream& in){
 				tree[i].children[childName] = childIndex;
 			}
 			
-			//initialize groupcounts
-			if (groupmap != NULL) {
-				for (int j = 0; j < (groupmap->getNamesOfGroups()).size(); j++) {
-					tree[i].groupCount[(groupmap->getNamesOfGroups())[j]] = 0;
-				}
-			}else if (ct != NULL) {
-                if (ct->hasGroupInfo()) {
-                    for (int j = 0; j < (ct->getNamesOfGroups()).size(); j++) {
-                        tree[i].groupCount[(ct->getNamesOfGroups())[j]] = 0;
-                    }
-                }
-            }
-			
 			tree[i].total = 0;
 			
 			m->gobble(in);
@@ -792,6 +645,3 @@ void PhyloSummary::readTreeStruct(ifstream& in){
 	}
 }
 /**************************************************************************************************/
-
-
-	
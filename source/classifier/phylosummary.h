@@ -14,6 +14,7 @@
 #include "mothurout.h"
 #include "groupmap.h"
 #include "counttable.h"
+#include "taxonomyindex.h"
 
 /**************************************************************************************************/
 
@@ -29,6 +30,8 @@ struct rawTaxNode {
 };
 
 /**************************************************************************************************/
+//the group counts of a node are kept in groupCounts, indexed the same as groups, instead of the node's groupCount map.
+//each taxonomy is walked once, the nodes it reaches are saved by its id in the TaxonomyIndex.
 class PhyloSummary {
 
 public:
@@ -46,7 +49,6 @@ public:
 	int getMaxLevel() { return maxLevel; }
 	
 private:
-	string getNextTaxon(string&);
 	vector<rawTaxNode> tree;
 	void print(int, ofstream&, string);
     void print(int, ofstream&, bool);
@@ -54,10 +56,21 @@ private:
     string getTaxons(vector<int> indexes, int index, int i, string&);
 	void readTreeStruct(ifstream&);
     string findTaxon(string);
+    void setGroups();
+    int findChild(int, string);
+    vector<int>& findNodes(int, string&);
 	GroupMap* groupmap;
     CountTable* ct;
 	bool ignore, relabund;
 	
+	TaxonomyIndex taxIndex;
+	map<int, vector<int> > taxonomyNodes;   //taxonomy id -> nodes from the top level down, with the unclassified nodes
+	vector<int> failedNodes;
+	vector<string> groups;
+	map<string, int> groupIndex;
+	vector< vector<int> > groupCounts;      //node -> count of each group
+	vector<double> groupTotals;             //sequences in each group, for the relative abundances
+	
 	int numNodes, printlevel;
 	int numSeqs;
 	int maxLevel;
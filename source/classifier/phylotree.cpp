@@ -183,36 +183,55 @@ int PhyloTree::addSeqToTree(string seqName, string seqTaxonomy){
 	try {
 		numSeqs++;
 		
-		map<string, int>::iterator childPointer;
+		tree[0].accessions.push_back(seqName);
 		
-		int currentNode = 0;
-		int level = 0;
+		if (m->control_pressed) { return 0; }
 		
-		tree[0].accessions.push_back(seqName);
-		m->removeConfidences(seqTaxonomy);
+		int taxonomy = taxIndex.getTaxonomy(seqTaxonomy);
+		vector<int>& nodes = findNodes(taxonomy);
 		
-		string taxon;// = getNextTaxon(seqTaxonomy);
-	
-		while(seqTaxonomy != ""){
-			
+		for (int i = 0; i < nodes.size(); i++) {
+            if (m->debug) { m->mothurOut(seqName +'\t' + tree[nodes[i]].name +'\n'); }
+			tree[nodes[i]].accessions.push_back(seqName);
+		}
+		
+		int level = nodes.size();
+		if (level != 0) { name2Taxonomy[seqName] = nodes[level-1];  uniqueTaxonomies.insert(nodes[level-1]); }
+		
+		if (level < taxIndex.getTaxons(taxonomy).size()) {
 			level++;
+			m->mothurOut(seqName + " has an error in the taxonomy.  This may be due to a ;;"); m->mothurOutEndLine();
+		}
+        
+        //save maxLevel for binning the unclassified seqs
+        if (level > maxLevel) { maxLevel = level; }
+        
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloTree", "addSeqToTree");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//nodes of a taxonomy from the top level down, stopping at an empty taxon. Missing nodes are added.
+vector<int>& PhyloTree::findNodes(int taxonomy){
+	try {
+		map<int, vector<int> >::iterator it = taxonomyNodes.find(taxonomy);
+		if (it != taxonomyNodes.end()) { return it->second; }
 		
-			if (m->control_pressed) { return 0; }
-			
-			//somehow the parent is getting one too many accnos
-			//use print to reassign the taxa id
-			taxon = getNextTaxon(seqTaxonomy, seqName);
-            
-            if (m->debug) { m->mothurOut(seqName +'\t' + taxon +'\n'); }
+		const vector<int>& taxons = taxIndex.getTaxons(taxonomy);
+		int numValid = taxIndex.getNumValidTaxons(taxonomy);
+		
+		vector<int> nodes;
+		int currentNode = 0;
+		for (int i = 0; i < numValid; i++) {
+			string taxon = taxIndex.getTaxonName(taxons[i]);
 			
-			if (taxon == "") {  m->mothurOut(seqName + " has an error in the taxonomy.  This may be due to a ;;"); m->mothurOutEndLine(); if (currentNode != 0) {  uniqueTaxonomies.insert(currentNode); } break;  }
-			
-			childPointer = tree[currentNode].children.find(taxon);
+			map<string, int>::iterator childPointer = tree[currentNode].children.find(taxon);
 			
 			if(childPointer != tree[currentNode].children.end()){	//if the node already exists, move on
 				currentNode = childPointer->second;
-				tree[currentNode].accessions.push_back(seqName);
-				name2Taxonomy[seqName] = currentNode;
 			}
 			else{											//otherwise, create it
 				tree.push_back(TaxNode(taxon));
@@ -220,22 +239,17 @@ int PhyloTree::addSeqToTree(string seqName, string seqTaxonomy){
 				tree[currentNode].children[taxon] = numNodes-1;
 				tree[numNodes-1].parent = currentNode;
 				
-				currentNode = tree[currentNode].children[taxon];
-				tree[currentNode].accessions.push_back(seqName);
-				name2Taxonomy[seqName] = currentNode;
+				currentNode = numNodes-1;
 			}
-	
-			if (seqTaxonomy == "") {   uniqueTaxonomies.insert(currentNode);	}
-
+			nodes.push_back(currentNode);
 		}
-        
-        //save maxLevel for binning the unclassified seqs
-        if (level > maxLevel) { maxLevel = level; }
-        
-		return 0;
+		
+		it = taxonomyNodes.insert(make_pair(taxonomy, nodes)).first;
+		
+		return it->second;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "PhyloTree", "addSeqToTree");
+		m->errorOut(e, "PhyloTree", "findNodes");
 		exit(1);
 	}
 }
@@ -503,7 +517,7 @@ void PhyloTree::printTreeNodes(string treefilename) {
 	}
 }
 /**************************************************************************************************/
-TaxNode PhyloTree::get(int i ){
+const TaxNode& PhyloTree::get(int i ){
 	try {
 		if (i < tree.size()) {  return tree[i];	 }
 		else {  cout << i << '\t' << tree.size() << endl ; m->mothurOut("Mismatch with taxonomy and template files. Cannot continue."); m->mothurOutEndLine(); exit(1); }
@@ -514,7 +528,7 @@ TaxNode PhyloTree::get(int i ){
 	}
 }
 /**************************************************************************************************/
-TaxNode PhyloTree::get(string seqName){
+const TaxNode& PhyloTree::get(string seqName){
 	try {
 		map<string, int>::iterator itFind = name2Taxonomy.find(seqName);
 	
@@ -12,6 +12,7 @@
 
 #include "mothur.h"
 #include "mothurout.h"
+#include "taxonomyindex.h"
 
 /**************************************************************************************************/
 
@@ -41,8 +42,8 @@ public:
 	vector<int> getGenusTotals();	
 	void setUp(string);  //used to create file needed for summary file if you use () constructor and add seqs manually instead of passing taxonomyfile
 		
-	TaxNode get(int i);				
-	TaxNode get(string seqName);
+	const TaxNode& get(int i);
+	const TaxNode& get(string seqName);
 	string getName(int i);			
 	int getGenusIndex(string seqName);	
 	string getFullTaxonomy(string);	 //pass a sequence name return taxonomy
@@ -59,6 +60,7 @@ private:
 	void print(ofstream&, vector<TaxNode>&); //used to create static reference taxonomy file
 	void fillOutTree(int, vector<TaxNode>&); //used to create static reference taxonomy file
 	void binUnclassified(string);
+	vector<int>& findNodes(int);
 	
 	vector<TaxNode> tree;
 	vector<int> genusIndex; //holds the indexes in tree where the genus level taxonomies are stored
@@ -67,6 +69,8 @@ private:
     map<string, int> name2GenusNodeIndex;
 	set<int> uniqueTaxonomies;  //map of unique taxonomies
 	map<int, int> leafNodes; //used to create static reference taxonomy file
+	TaxonomyIndex taxIndex;
+	map<int, vector<int> > taxonomyNodes;  //taxonomy id -> its nodes, so sequences with the same taxonomy only walk the tree once
 	//void print(int, ofstream&);
 	int numNodes;
 	int numSeqs;
@@ -0,0 +1,66 @@
+//
+//  taxonomyindex.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "taxonomyindex.h"
+
+/***********************************************************************/
+int TaxonomyIndex::getTaxonomy(string tax) {
+	try {
+		map<string, int>::iterator it = taxonomyIds.find(tax);
+		if (it != taxonomyIds.end()) { return it->second; }
+
+		//removeConfidences also drops a last taxon missing its ;
+		string clean = tax;
+		if ((clean.find_first_of('(') != string::npos) || ((clean != "") && (clean[clean.length()-1] != ';'))) { m->removeConfidences(clean); }
+
+		//taxonomies with confidence scores are rarely repeated, so only the taxonomy without them is saved
+		it = taxonomyIds.find(clean);
+		if (it != taxonomyIds.end()) { return it->second; }
+
+		vector<int> taxons;
+		int numValid = -1;
+		int start = 0;
+		for (int i = 0; i < clean.length(); i++) {
+			if (clean[i] == ';') {
+				string taxon = clean.substr(start, i-start);
+				if ((taxon == "") && (numValid == -1)) { numValid = taxons.size(); }
+				taxons.push_back(getTaxonId(taxon));
+				start = i+1;
+			}
+		}
+		if (numValid == -1) { numValid = taxons.size(); }
+
+		int id = taxonomies.size();
+		taxonomies.push_back(taxons);
+		validTaxons.push_back(numValid);
+		taxonomyIds[clean] = id;
+
+		return id;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "TaxonomyIndex", "getTaxonomy");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int TaxonomyIndex::getTaxonId(string taxon) {
+	try {
+		map<string, int>::iterator it = taxonIds.find(taxon);
+		if (it != taxonIds.end()) { return it->second; }
+
+		int id = taxonNames.size();
+		taxonNames.push_back(taxon);
+		taxonIds[taxon] = id;
+
+		return id;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "TaxonomyIndex", "getTaxonId");
+		exit(1);
+	}
+}
+/***********************************************************************/
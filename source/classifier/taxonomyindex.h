@@ -0,0 +1,47 @@
+#ifndef Mothur_taxonomyindex_h
+#define Mothur_taxonomyindex_h
+
+//
+//  taxonomyindex.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/* Gives each taxon name and each taxonomy string an integer id, so the trees built from a taxonomy file parse a
+ taxonomy once no matter how many sequences share it. A taxonomy is stored as the ids of its taxa from the top level
+ down. Confidence scores are removed the same way removeConfidences does before the taxonomy is split, and an empty
+ taxon from a ;; is kept as the taxon "" so each tree can handle it the way it did before. */
+
+/***********************************************************************/
+
+class TaxonomyIndex {
+
+public:
+	TaxonomyIndex() { m = MothurOut::getInstance(); }
+	~TaxonomyIndex() {}
+
+	int getTaxonomy(string);                                        //returns the id of a taxonomy, adding it if it's new
+	const vector<int>& getTaxons(int i)     { return taxonomies[i];         }   //taxon ids of a taxonomy from the top level down
+	int getNumValidTaxons(int i)            { return validTaxons[i];        }   //taxa before the first empty one
+	int getNumTaxonomies()                  { return taxonomies.size();     }
+
+	int getTaxonId(string);                                         //returns the id of a taxon name, adding it if it's new
+	string getTaxonName(int i)              { return taxonNames[i];         }
+	int getNumTaxons()                      { return taxonNames.size();     }
+
+private:
+	MothurOut* m;
+	map<string, int> taxonomyIds;       //taxonomy without confidences -> id
+	map<string, int> taxonIds;
+	vector<string> taxonNames;
+	vector< vector<int> > taxonomies;
+	vector<int> validTaxons;
+};
+
+/***********************************************************************/
+
+#endif
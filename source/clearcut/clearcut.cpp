@@ -1069,6 +1069,152 @@ NJ_collapse(DMAT *dmat,
 
 
 
+/*
+ * NJ_row_min() - Find the smallest distance along the horizontal of a row
+ *
+ *
+ * INPUTS:
+ * -------
+ *   dmat -- A pointer to the distance matrix
+ *      a -- The index of the row
+ *
+ * RETURNS:
+ * --------
+ *   <float> -- The smallest distance, or HUGE_VAL for the last row
+ *
+ */
+static inline
+float
+NJ_row_min(DMAT *dmat,
+	   long int a) {
+
+  long int i, size;
+  float min;
+  float *ptr;
+
+  size = dmat->size;
+  min  = (float)HUGE_VAL;
+
+  ptr = &(dmat->val[NJ_MAP(a, a+1, size)]);
+  for(i=a+1;i<size;i++) {
+    if(*ptr < min) {
+      min = *ptr;
+    }
+    ptr++;
+  }
+
+  return(min);
+}
+
+
+
+
+
+
+
+/*
+ * NJ_init_rowmin() - Find the smallest distance along every row 
+ *
+ *
+ * INPUTS:
+ * -------
+ *   dmat   -- A pointer to the distance matrix
+ *   rowmin -- The vector to fill, one entry per row
+ *
+ * RETURNS:
+ * --------
+ *   NONE
+ *
+ */
+static inline
+void
+NJ_init_rowmin(DMAT *dmat,
+	       float *rowmin) {
+
+  long int i;
+
+  for(i=0;i<dmat->size;i++) {
+    rowmin[i] = NJ_row_min(dmat, i);
+  }
+
+  return;
+}
+
+
+
+
+
+
+
+/*
+ * NJ_update_rowmin() - Keep the row minima in step with NJ_collapse()
+ *
+ *
+ * INPUTS:
+ * -------
+ *   dmat   -- A pointer to the collapsed distance matrix
+ *   rowmin -- The row minima, already shifted by one row like r and r2
+ *      a -- The index of the row a before the collapse
+ *      b -- The index of the row b before the collapse
+ *
+ * RETURNS:
+ * --------
+ *   NONE
+ *
+ * DESCRIPTION:
+ * ------------
+ *
+ * After the collapse, the new node is in row a-1 (or in row b-1 when 
+ * a was row 0) and what was row 0 is in row b-1.  Those two rows are
+ * searched again and their columns can only lower the minima of the rows 
+ * above them.  Every other row only lost entries, so its stored minimum 
+ * may be smaller than the real one, which is all NJ_min_transform() needs.
+ *
+ */
+static inline
+void
+NJ_update_rowmin(DMAT *dmat,
+		 float *rowmin,
+		 long int a,
+		 long int b) {
+
+  long int i, size;
+  long int rows[2];
+  int k, nrows;
+  float *ptr;
+
+  size  = dmat->size;
+  nrows = 0;
+
+  if(a) {
+    rows[nrows++] = a-1;
+  }
+  rows[nrows++] = b-1;
+
+  for(k=0;k<nrows;k++) {
+
+    rowmin[rows[k]] = NJ_row_min(dmat, rows[k]);
+
+    /* walk down the column, lowering the minima of the rows above */
+    ptr = dmat->val + rows[k];
+    for(i=0;i<rows[k];i++) {
+      if(*ptr < rowmin[i]) {
+	rowmin[i] = *ptr;
+      }
+      ptr += size-i-1;
+    }
+  }
+
+  return;
+}
+
+
+
+
+
+
+
+
 /*
  * NJ_neighbor_joining() - Perform a traditional Neighbor-Joining
  *
@@ -1103,6 +1249,8 @@ NJ_neighbor_joining(NJ_ARGS *nj_args,
 
   long int a, b;
   float min;
+  float *rowmin, *rowminhandle;  /* smallest distance along each row */
+  float *bound;                  /* lower bound of each row's trans. dists */
     
 
   /* initialize the r and r2 vectors */
@@ -1114,6 +1262,16 @@ NJ_neighbor_joining(NJ_ARGS *nj_args,
     fprintf(stderr, "Clearcut:  Could not initialize vertex in NJ_neighbor_joining()\n");
     return(NULL);
   }
+
+  /* allocate the row minima and bounds used to prune the global search */
+  rowminhandle = (float *)calloc(dmat->size, sizeof(float));
+  bound        = (float *)calloc(dmat->size, sizeof(float));
+  if(!rowminhandle || !bound) {
+    fprintf(stderr, "Clearcut:  Memory allocation error in NJ_neighbor_joining()\n");
+    return(NULL);
+  }
+  rowmin = rowminhandle;
+  NJ_init_rowmin(dmat, rowmin);
   
   /* we iterate until the working distance matrix has only 2 entries */
   while(vertex->nactive > 2) {
@@ -1121,7 +1279,7 @@ NJ_neighbor_joining(NJ_ARGS *nj_args,
     /* 
      * Find the global minimum transformed distance from the distance matrix
      */
-    min = NJ_min_transform(dmat, &a, &b);
+    min = NJ_min_transform(dmat, rowmin, bound, &a, &b);
 
     /* 
      * Build the tree by removing nodes a and b from the vertex array
@@ -1136,11 +1294,18 @@ NJ_neighbor_joining(NJ_ARGS *nj_args,
 
     /* compact the distance matrix and the r and r2 vectors */
     NJ_collapse(dmat, vertex, a, b);
+
+    /* compact the row minima the same way */
+    rowmin++;
+    NJ_update_rowmin(dmat, rowmin, a, b);
   }
   
   /* Properly join the last two nodes on the vertex list */
   tree = NJ_decompose(dmat, vertex, 0, 1, NJ_LAST);
 
+  free(rowminhandle);
+  free(bound);
+
   /* return the computed tree to the calling function */
   return(tree);
 }
@@ -2088,7 +2253,9 @@ NJ_free_vertex(NJ_VERTEX *vertex) {
  *
  * INPUTS:
  * -------
- *  dmat  -- The distance matrix
+ *  dmat   -- The distance matrix
+ *  rowmin -- The smallest distance along each row (see NJ_update_rowmin())
+ *  bound  -- Scratch space for the lower bound of each row
  *
  * RETURNS:
  * --------
@@ -2105,9 +2272,17 @@ NJ_free_vertex(NJ_VERTEX *vertex) {
  * This requires traversing the entire diagonal matrix, which is itself a 
  * O(N^2) operation.
  *
+ * To cut that down, no transformed distance along a row can be smaller 
+ * than the row's smallest distance minus its r2 and the largest r2 to 
+ * its right.  Rows whose bound is above the smallest value found so far 
+ * are skipped.  Float rounding keeps this order, so the result is the 
+ * same as searching every row.
+ *
  */
 float
 NJ_min_transform(DMAT *dmat,
+		 float *rowmin,
+		 float *bound,
 		 long int *ret_i,
 		 long int *ret_j) {
 
@@ -2116,30 +2291,71 @@ NJ_min_transform(DMAT *dmat,
   long int tmp_j = 0;/* to limit pointer dereferencing  */
   float smallest;  /* track the smallest trans. dist  */
   float curval;    /* the current trans. dist in loop */
+  float r2max;     /* largest r2 to the right of a row */
+
+  long int n;      /* position in the search order    */
+  long int first;  /* the row with the lowest bound   */
 
   float *ptr;      /* pointer into distance matrix    */
+  float *val;      /* pointer to the distances        */
   float *r2;       /* pointer to r2 matrix for computing transformed dists */
   
   smallest = (float)HUGE_VAL;
 
   /* track these here to limit pointer dereferencing in inner loop */
-  ptr = dmat->val;
+  val = dmat->val;
   r2  = dmat->r2;
 
-  /* for every row */
-  for(i=0;i<dmat->size;i++) {
-    ptr++;  /* skip diagonal */
+  /* 
+   * bound the transformed distances of each row from below, working 
+   * up from the last row so we know the largest r2 to the right
+   */
+  r2max = -(float)HUGE_VAL;
+  first = dmat->size-1;
+  for(i=dmat->size-1;i>=0;i--) {
+    bound[i] = rowmin[i] - (r2[i] + r2max);
+    if(r2[i] > r2max) {
+      r2max = r2[i];
+    }
+    if(bound[i] <= bound[first]) {
+      first = i;
+    }
+  }
+
+  /* 
+   * Search the row with the lowest bound first, so the smallest value 
+   * found is small early and most rows can be skipped.  Equal values
+   * are kept for the earliest row so we pick the same join as a search
+   * of the rows in order.
+   */
+  for(n=-1;n<dmat->size;n++) {
+
+    if(n<0) {
+      i = first;
+    } else if(n == first) {
+      continue;
+    } else {
+      i = n;
+    }
+
+    /* nothing in this row can beat the smallest so far, skip it */
+    if(bound[i] > smallest) {
+      continue;
+    }
+
+    ptr = &(val[NJ_MAP(i, i+1, dmat->size)]);
     for(j=i+1;j<dmat->size;j++) {   /* for every column */
 
       /* find transformed distance in matrix at i, j */
       curval = *(ptr++) - (r2[i] + r2[j]);
 
       /* if the transformed distanance is less than the known minimum */
-      if(curval < smallest) {
-
-	smallest = curval;
-	tmp_i = i;
-	tmp_j = j;
+      if(curval <= smallest) {
+	if(curval < smallest || i < tmp_i) {
+	  smallest = curval;
+	  tmp_i = i;
+	  tmp_j = j;
+	}
       }
     }
   }
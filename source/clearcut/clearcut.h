@@ -270,6 +270,8 @@ NJ_free_vertex(NJ_VERTEX *vertex);
 /* for computing the global minimum transformed distance in traditional NJ */
 float
 NJ_min_transform(DMAT *dmat,
+		 float *rowmin,
+		 float *bound,
 		 long int *ret_i,
 		 long int *ret_j);
 
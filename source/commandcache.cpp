@@ -0,0 +1,462 @@
+/*
+ *  commandcache.cpp
+ *  Mothur
+ *
+ *  Copyright 2016 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "commandcache.h"
+
+/***********************************************************************/
+CommandCache::CommandCache(string d, unsigned long long s) {
+	try {
+		m = MothurOut::getInstance();
+		directory = d;
+		maxSize = s;
+		indexFile = directory + "mothur.cache.index";
+		numHits = 0; numMisses = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "CommandCache");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string CommandCache::hashString(string s) {
+	try {
+		unsigned long long hash = NameHash::hash(s);
+
+		char buffer[17];
+		sprintf(buffer, "%016llx", hash);
+		return string(buffer);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "hashString");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string CommandCache::hashFile(string filename) {
+	try {
+		//files that haven't changed since they were hashed are not read again
+		string stamp = getFileStamp(filename);
+		map<string, pair<string, string> >::iterator it = fileHashes.find(filename);
+		if ((it != fileHashes.end()) && (it->second.first == stamp)) { return it->second.second; }
+
+		ifstream in;
+		m->openInputFileBinary(filename, in);
+
+		unsigned long long hash = NameHash::hash("");
+		char buffer[65536];
+		while (in) {
+			if (m->control_pressed) { break; }
+			in.read(buffer, 65536);
+			int numRead = in.gcount();
+			hash = NameHash::hash(hash, buffer, numRead);
+		}
+		in.close();
+
+		char hex[17];
+		sprintf(hex, "%016llx", hash);
+		fileHashes[filename] = make_pair(stamp, string(hex));
+
+		return string(hex);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "hashFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string CommandCache::getFileStamp(string filename) {
+	try {
+		return toString(getFileSize(filename)) + "_" + toString(m->getTimeStamp(filename));
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "getFileStamp");
+		exit(1);
+	}
+}
+/***********************************************************************/
+unsigned long long CommandCache::getFileSize(string filename) {
+	try {
+		ifstream in(filename.c_str(), ios::binary);
+		if (!in) { return 0; }
+		in.seekg(0, ios::end);
+		unsigned long long size = in.tellg();
+		in.close();
+		return size;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "getFileSize");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int CommandCache::copyFile(string from, string to) {
+	try {
+		ifstream in(from.c_str(), ios::binary);
+		if (!in) { return 1; }
+		ofstream out(to.c_str(), ios::binary | ios::trunc);
+		if (!out) { in.close(); return 1; }
+
+		out << in.rdbuf();
+
+		in.close();
+		out.close();
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "copyFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the key describes everything that changes the output of the command
+string CommandCache::getKey(string commandName, string options, Command* command) {
+	try {
+		//these commands change mothur's settings or don't make files from their inputs
+		if ((commandName.substr(0, 4) == "set.") || (commandName == "get.current") || (commandName == "system") || (commandName == "quit") ||
+			(commandName == "help") || (commandName == "get.commandinfo") || (commandName == "make.file") || (commandName == "rename.file") ||
+			(commandName == "pipeline.pds")) { return ""; }
+
+		map<string, string> parameters;
+		OptionParser parser(options, parameters);
+		map<string, string> currentFiles = m->getCurrentFiles();
+
+		string inputDir = "";
+		if (parameters.count("inputdir") != 0) { inputDir = parameters["inputdir"]; }
+		parameters.erase("inputdir");
+		parameters.erase("processors");     //the same results with any number of processors
+
+		vector<CommandParameter> commandParameters = command->getParameters();
+
+		//a file group without a file given is filled in with current files
+		set<string> groupsGiven;
+		for (int i = 0; i < commandParameters.size(); i++) {
+			if ((commandParameters[i].type == "InputTypes") && (parameters.count(commandParameters[i].name) != 0)) { groupsGiven.insert(commandParameters[i].chooseAtLeastOneGroup); }
+		}
+
+		string files = "";
+		int numFiles = 0;
+		for (int i = 0; i < commandParameters.size(); i++) {
+			if (commandParameters[i].type != "InputTypes") { continue; }
+
+			string name = commandParameters[i].name;
+			string value = "";
+			map<string, string>::iterator it = parameters.find(name);
+			if (it != parameters.end()) {
+				value = it->second;
+				if (value == "current") { value = currentFiles[name]; }
+			}else {
+				string group = commandParameters[i].chooseAtLeastOneGroup;
+				bool missing = commandParameters[i].required || ((group != "none") && (group != "") && (groupsGiven.count(group) == 0));
+				if (missing && (currentFiles.count(name) != 0)) { value = currentFiles[name]; }
+			}
+			if ((value == "") || (value == "none")) { continue; }
+
+			//parameters can hold several files separated by dashes
+			vector<string> pieces;
+			m->splitAtDash(value, pieces);
+			if (pieces.size() < 2) { pieces.clear(); pieces.push_back(value); }
+
+			string resolved = "";
+			for (int j = 0; j < pieces.size(); j++) {
+				string filename = pieces[j];
+				if ((inputDir != "") && (m->hasPath(filename) == "")) { filename = inputDir + filename; }
+				filename = m->getFullPathName(filename);
+
+				ifstream in(filename.c_str());
+				if (!in) {
+					//commands look in the default path for reference files
+					filename = m->getFullPathName(m->getDefaultPath() + m->getSimpleName(pieces[j]));
+					ifstream inDefault(filename.c_str());
+					if (!inDefault) { return ""; }      //the command will complain
+					inDefault.close();
+				}else { in.close(); }
+
+				files += name + "\t" + filename + "\t" + hashFile(filename) + "\n";
+				resolved += filename + "-";
+				numFiles++;
+			}
+			parameters[name] = resolved.substr(0, resolved.length()-1);
+		}
+
+		if (numFiles == 0) { return ""; }
+
+		//commands using random numbers give other results with another seed
+		string description = "mothur " + m->getVersion() + "\n" + commandName + "\nseed=" + toString(m->getRandomSeed()) + "\n";
+		for (map<string, string>::iterator it = parameters.begin(); it != parameters.end(); it++) { description += it->first + "=" + it->second + "\n"; }
+		description += files;
+
+		return hashString(description);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "getKey");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//key size lastUsed
+map<string, CacheEntry> CommandCache::readIndex() {
+	try {
+		map<string, CacheEntry> entries;
+
+		ifstream in(indexFile.c_str());
+		if (!in) { return entries; }
+
+		string key; unsigned long long size, lastUsed;
+		while (in >> key >> size >> lastUsed) { entries[key] = CacheEntry(size, lastUsed); }
+		in.close();
+
+		return entries;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "readIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int CommandCache::writeIndex(map<string, CacheEntry>& entries) {
+	try {
+		//written to a temp file and renamed so a reader never sees half an index
+		string tempFile = indexFile + "." + m->mothurGetpid(0) + ".temp";
+		ofstream out;
+		m->openOutputFile(tempFile, out);
+		for (map<string, CacheEntry>::iterator it = entries.begin(); it != entries.end(); it++) {
+			out << it->first << '\t' << it->second.size << '\t' << it->second.lastUsed << endl;
+		}
+		out.close();
+
+		m->mothurRemove(indexFile);
+		rename(tempFile.c_str(), indexFile.c_str());
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "writeIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int CommandCache::removeEntry(string key) {
+	try {
+		string manifest = directory + key + ".manifest";
+
+		ifstream in(manifest.c_str());
+		if (in) {
+			string line;
+			while (getline(in, line)) {
+				vector<string> pieces;
+				m->splitAtChar(line, pieces, '\t');
+				if ((pieces.size() == 4) && (pieces[0] == "output")) { m->mothurRemove(directory + pieces[3]); }
+			}
+			in.close();
+		}
+		m->mothurRemove(manifest);
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "removeEntry");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//removes the results used longest ago until the cache fits
+int CommandCache::trim(map<string, CacheEntry>& entries) {
+	try {
+		unsigned long long total = 0;
+		vector< pair<unsigned long long, string> > byAge;
+		for (map<string, CacheEntry>::iterator it = entries.begin(); it != entries.end(); it++) {
+			total += it->second.size;
+			byAge.push_back(make_pair(it->second.lastUsed, it->first));
+		}
+		sort(byAge.begin(), byAge.end());
+
+		for (int i = 0; i < byAge.size(); i++) {
+			if (total <= maxSize) { break; }
+			m->mothurOutJustToLog("[CACHE]: removing " + byAge[i].second + " to keep the cache under " + toString(maxSize / 1000000.0) + " MB.\n");
+			total -= entries[byAge[i].second].size;
+			removeEntry(byAge[i].second);
+			entries.erase(byAge[i].second);
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "trim");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool CommandCache::restore(string key, string commandName, map<string, vector<string> >& outputTypes) {
+	try {
+		outputTypes.clear();
+
+		map<string, CacheEntry> entries = readIndex();
+		string manifest = directory + key + ".manifest";
+		ifstream in(manifest.c_str());
+
+		if ((entries.count(key) == 0) || !in) {
+			numMisses++;
+			m->mothurOutJustToLog("[CACHE]: miss for " + commandName + " (" + key + "), " + toString(numHits) + " hits and " + toString(numMisses) + " misses so far.\n");
+			return false;
+		}
+
+		vector< pair<string, string> > files;      //stored, original
+		map<string, string> currentFiles;
+		string line;
+		while (getline(in, line)) {
+			vector<string> pieces;
+			m->splitAtChar(line, pieces, '\t');
+			if ((pieces.size() == 4) && (pieces[0] == "output")) {
+				outputTypes[pieces[1]].push_back(pieces[2]);
+				files.push_back(make_pair(directory + pieces[3], pieces[2]));
+			}else if ((pieces.size() == 3) && (pieces[0] == "current")) { currentFiles[pieces[1]] = pieces[2]; }
+		}
+		in.close();
+
+		for (int i = 0; i < files.size(); i++) {
+			if (copyFile(files[i].first, files[i].second) != 0) {
+				m->mothurOut("[WARNING]: could not restore " + files[i].second + " from the cache, running " + commandName + ".\n");
+				removeEntry(key);
+				entries.erase(key);
+				writeIndex(entries);
+				outputTypes.clear();
+				numMisses++;
+				return false;
+			}
+		}
+
+		for (map<string, string>::iterator it = currentFiles.begin(); it != currentFiles.end(); it++) { m->setCurrentFile(it->first, it->second); }
+
+		entries[key].lastUsed = time(NULL);
+		writeIndex(entries);
+
+		numHits++;
+		m->mothurOut("Restored the output of " + commandName + " from the cache.\n");
+		m->mothurOutJustToLog("[CACHE]: hit for " + commandName + " (" + key + "), " + toString(numHits) + " hits and " + toString(numMisses) + " misses so far.\n");
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "restore");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int CommandCache::save(string key, string commandName, map<string, vector<string> > outputTypes, map<string, string> currentFiles) {
+	try {
+		//outputs are named output, type, original file name, stored file name
+		string manifest = directory + key + ".manifest";
+		string tempManifest = manifest + "." + m->mothurGetpid(0) + ".temp";
+		ofstream out;
+		m->openOutputFile(tempManifest, out);
+
+		unsigned long long size = 0;
+		int count = 0;
+		set<string> saved;
+		for (map<string, vector<string> >::iterator it = outputTypes.begin(); it != outputTypes.end(); it++) {
+			for (int i = 0; i < it->second.size(); i++) {
+				string filename = it->second[i];
+				if (saved.count(filename) != 0) { continue; }
+
+				string stored = key + "." + toString(count) + ".output";
+				if (copyFile(filename, directory + stored) != 0) {
+					//don't save part of the results
+					out.close();
+					for (int j = 0; j < count; j++) { m->mothurRemove(directory + key + "." + toString(j) + ".output"); }
+					m->mothurRemove(tempManifest);
+					return 0;
+				}
+				out << "output\t" << it->first << '\t' << filename << '\t' << stored << endl;
+				size += getFileSize(filename);
+				saved.insert(filename); count++;
+			}
+		}
+		for (map<string, string>::iterator it = currentFiles.begin(); it != currentFiles.end(); it++) { out << "current\t" << it->first << '\t' << it->second << endl; }
+		out.close();
+
+		if (count == 0) { m->mothurRemove(tempManifest); return 0; }
+
+		if (size > maxSize) {
+			for (int j = 0; j < count; j++) { m->mothurRemove(directory + key + "." + toString(j) + ".output"); }
+			m->mothurRemove(tempManifest);
+			m->mothurOutJustToLog("[CACHE]: the output of " + commandName + " is bigger than the cache, not saving it.\n");
+			return 0;
+		}
+
+		m->mothurRemove(manifest);
+		rename(tempManifest.c_str(), manifest.c_str());
+
+		map<string, CacheEntry> entries = readIndex();
+		entries[key] = CacheEntry(size, time(NULL));
+		trim(entries);
+		writeIndex(entries);
+
+		m->mothurOutJustToLog("[CACHE]: saved " + toString(count) + " files from " + commandName + " (" + key + ").\n");
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandCache", "save");
+		exit(1);
+	}
+}
+/***********************************************************************/
+CachedCommand::CachedCommand(Command* c, string name, string o, CommandCache* cc) : Command() {
+	command = c;
+	commandName = name;
+	options = o;
+	cache = cc;
+	restored = false;
+}
+/***********************************************************************/
+map<string, vector<string> > CachedCommand::getOutputFiles() {
+	if (restored) { return outputTypes; }
+	return command->getOutputFiles();
+}
+/***********************************************************************/
+int CachedCommand::execute() {
+	try {
+		string key = cache->getKey(commandName, options, command);
+		if (key == "") { return command->execute(); }
+
+		if (cache->restore(key, commandName, outputTypes)) {
+			restored = true;
+
+			m->mothurOutEndLine();
+			m->mothurOut("Output File Names: "); m->mothurOutEndLine();
+			for (map<string, vector<string> >::iterator it = outputTypes.begin(); it != outputTypes.end(); it++) {
+				for (int i = 0; i < it->second.size(); i++) { m->mothurOut(it->second[i]); m->mothurOutEndLine(); }
+			}
+			m->mothurOutEndLine();
+
+			return 0;
+		}
+
+		map<string, string> currentBefore = m->getCurrentFiles();
+
+		int result = command->execute();
+		if ((result != 0) || m->control_pressed || m->commandInputsConvertError) { return result; }
+
+		//current files the command set are restored with its outputs
+		map<string, string> currentAfter = m->getCurrentFiles();
+		map<string, string> currentSet;
+		for (map<string, string>::iterator it = currentAfter.begin(); it != currentAfter.end(); it++) {
+			map<string, string>::iterator itBefore = currentBefore.find(it->first);
+			if ((itBefore == currentBefore.end()) || (itBefore->second != it->second)) { currentSet[it->first] = it->second; }
+		}
+
+		cache->save(key, commandName, command->getOutputFiles(), currentSet);
+
+		return result;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CachedCommand", "execute");
+		exit(1);
+	}
+}
+/***********************************************************************/
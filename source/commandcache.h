@@ -0,0 +1,98 @@
+#ifndef COMMANDCACHE_H
+#define COMMANDCACHE_H
+
+/*
+ *  commandcache.h
+ *  Mothur
+ *
+ *  Copyright 2016 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "command.hpp"
+#include "namehash.h"
+
+/* Saves the output files of commands so running the same command again restores them instead of recomputing.
+ Turned on with set.dir(cache=yourCacheDirectory). A command is looked up by its name, its parameters, the mothur version,
+ the random seed and the contents of its input files, so changing a parameter or an input file reruns the command.
+ mothur seeds random with its start time, so results are reused by a later session only when the seed is set.
+ The output files and the current files the command set are copied into the cache directory. When the cache is bigger
+ than cachesize the results used longest ago are removed. Hits and misses are reported in the logfile. */
+
+/***********************************************************************/
+
+struct CacheEntry {
+	unsigned long long size;
+	unsigned long long lastUsed;
+
+	CacheEntry() : size(0), lastUsed(0) {}
+	CacheEntry(unsigned long long s, unsigned long long l) : size(s), lastUsed(l) {}
+};
+
+/***********************************************************************/
+
+class CommandCache {
+
+public:
+	CommandCache(string, unsigned long long);       //cache directory, max size in bytes
+	~CommandCache() {}
+
+	string getDirectory()           { return directory; }
+	unsigned long long getMaxSize() { return maxSize;   }
+
+	string getKey(string, string, Command*);        //command name, options, command. returns "" if the command can't be cached
+	bool restore(string, string, map<string, vector<string> >&);   //key, command name, fills output types. false if not in the cache
+	int save(string, string, map<string, vector<string> >, map<string, string>);  //key, command name, output types, current files set
+
+private:
+	MothurOut* m;
+	string directory, indexFile;
+	unsigned long long maxSize;
+	int numHits, numMisses;
+	map<string, pair<string, string> > fileHashes;  //filename -> (size and modification time, hash)
+
+	string hashString(string);
+	string hashFile(string);
+	string getFileStamp(string);
+	unsigned long long getFileSize(string);
+	int copyFile(string, string);
+	map<string, CacheEntry> readIndex();
+	int writeIndex(map<string, CacheEntry>&);
+	int removeEntry(string);
+	int trim(map<string, CacheEntry>&);
+};
+
+/***********************************************************************/
+//created by the CommandFactory around the command it makes while the cache is on
+
+class CachedCommand : public Command {
+
+public:
+	CachedCommand(Command*, string, string, CommandCache*);     //command, command name, options, cache
+	~CachedCommand() { delete command; }
+
+	vector<string> setParameters()              { return command->setParameters();          }
+	vector<CommandParameter> getParameters()    { return command->getParameters();          }
+	string getCommandName()                     { return command->getCommandName();         }
+	string getCommandCategory()                 { return command->getCommandCategory();     }
+	string getOutputPattern(string type)        { return command->getOutputPattern(type);   }
+	string getHelpString()                      { return command->getHelpString();          }
+	string getCitation()                        { return command->getCitation();            }
+	string getDescription()                     { return command->getDescription();         }
+	map<string, vector<string> > getOutputFiles();
+
+	int execute();
+	void help() { command->help(); }
+
+private:
+	Command* command;
+	CommandCache* cache;
+	string commandName, options;
+	bool restored;
+};
+
+/***********************************************************************/
+
+#endif
@@ -153,6 +153,7 @@
 #include "renamefilecommand.h"
 #include "chimeravsearchcommand.h"
 #include "mergecountcommand.hpp"
+#include "makeotuindexcommand.h"
 
 //needed for testing project
 //CommandFactory* CommandFactory::_uniqueInstance;
@@ -179,6 +180,7 @@ CommandFactory::CommandFactory(){
 
 	outputDir = ""; inputDir = "";
 	logFileName = "";
+	cache = NULL;
 	append = false;
 
 	//initialize list of valid commands
@@ -329,6 +331,7 @@ CommandFactory::CommandFactory(){
     commands["set.seed"]            = "set.seed";
     commands["rename.file"]         = "rename.file";
     commands["merge.count"]         = "merge.count";
+    commands["make.otuindex"]       = "make.otuindex";
 
 
 }
@@ -339,9 +342,21 @@ CommandFactory::~CommandFactory(){
 	delete command;
 	delete shellcommand;
 	delete pipecommand;
+	if (cache != NULL) { delete cache; }
 }
 /***********************************************************/
 
+/***********************************************************/
+void CommandFactory::setCache(string directory, unsigned long long size) {
+	try {
+		if (cache != NULL) { delete cache; cache = NULL; }
+		if (directory != "") { cache = new CommandCache(directory, size); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CommandFactory", "setCache");
+		exit(1);
+	}
+}
 /***********************************************************/
 int CommandFactory::checkForRedirects(string optionString) {
     try {
@@ -398,7 +413,7 @@ int CommandFactory::checkForRedirects(string optionString) {
             }
 
             if (seed)  {
-                srand(random);
+                m->setRandomSeed(random);
                 m->mothurOut("Setting random seed to " + toString(random) + ".\n\n");
             }
         }
@@ -529,6 +544,7 @@ Command* CommandFactory::getCommand(string commandName, string optionString){
 		else if(commandName == "remove.rare")			{	command = new RemoveRareCommand(optionString);				}
 		else if(commandName == "merge.groups")			{	command = new MergeGroupsCommand(optionString);				}
         else if(commandName == "merge.count")			{	command = new MergeCountCommand(optionString);				}
+        else if(commandName == "make.otuindex")			{	command = new MakeOTUIndexCommand(optionString);				}
 		else if(commandName == "amova")					{	command = new AmovaCommand(optionString);					}
 		else if(commandName == "homova")				{	command = new HomovaCommand(optionString);					}
 		else if(commandName == "mantel")				{	command = new MantelCommand(optionString);					}
@@ -579,6 +595,9 @@ Command* CommandFactory::getCommand(string commandName, string optionString){
         else if(commandName == "rename.file")           {	command = new RenameFileCommand(optionString);              }
 		else											{	command = new NoCommand(optionString);						}
 
+		//restore the outputs of this command from the cache if it has already been run
+		if (cache != NULL) { command = new CachedCommand(command, commandName, optionString, cache); }
+
 		return command;
 	}
 	catch(exception& e) {
@@ -703,6 +722,7 @@ Command* CommandFactory::getCommand(string commandName, string optionString, str
 		else if(commandName == "remove.rare")			{	pipecommand = new RemoveRareCommand(optionString);				}
 		else if(commandName == "merge.groups")			{	pipecommand = new MergeGroupsCommand(optionString);				}
         else if(commandName == "merge.count")			{	pipecommand = new MergeCountCommand(optionString);				}
+        else if(commandName == "make.otuindex")			{	pipecommand = new MakeOTUIndexCommand(optionString);				}
 		else if(commandName == "amova")					{	pipecommand = new AmovaCommand(optionString);					}
 		else if(commandName == "homova")				{	pipecommand = new HomovaCommand(optionString);					}
 		else if(commandName == "mantel")				{	pipecommand = new MantelCommand(optionString);					}
@@ -863,6 +883,7 @@ Command* CommandFactory::getCommand(string commandName){
 		else if(commandName == "remove.rare")			{	shellcommand = new RemoveRareCommand();				}
 		else if(commandName == "merge.groups")			{	shellcommand = new MergeGroupsCommand();			}
         else if(commandName == "merge.count")			{	shellcommand = new MergeCountCommand();				}
+        else if(commandName == "make.otuindex")			{	shellcommand = new MakeOTUIndexCommand();				}
 		else if(commandName == "amova")					{	shellcommand = new AmovaCommand();					}
 		else if(commandName == "homova")				{	shellcommand = new HomovaCommand();					}
 		else if(commandName == "mantel")				{	shellcommand = new MantelCommand();					}
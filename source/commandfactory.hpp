@@ -13,6 +13,7 @@
 #include "mothur.h"
 #include "mothurout.h"
 #include "currentfile.h"
+#include "commandcache.h"
 
 class Command;
 
@@ -35,6 +36,8 @@ public:
 	string getOutputDir()					{	return outputDir;		}
     string getInputDir()					{	return inputDir;		}
 	map<string, string> getListCommands()	{	return commands;		}
+	void setCache(string, unsigned long long);	//cache directory, max size in bytes. "" turns the cache off
+	CommandCache* getCache()				{	return cache;			}
 	
 private:
 	Command* command;
@@ -43,6 +46,7 @@ private:
 	
 	MothurOut* m;
 	CurrentFile* currentFile;
+	CommandCache* cache;
 	
 	map<string, string> commands;
 	map<string, string>::iterator it;
@@ -31,6 +31,7 @@ vector<string> AlignCommand::setParameters(){
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pflip("flip", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pflip);
 		CommandParameter pthreshold("threshold", "Number", "", "0.50", "", "", "","",false,false); parameters.push_back(pthreshold);
+		CommandParameter pmaxcache("maxcache", "Number", "", "10000", "", "", "","",false,false); parameters.push_back(pmaxcache);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -49,7 +50,7 @@ string AlignCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The align.seqs command reads a file containing sequences and creates an alignment file and a report file.";
-		helpString += "The align.seqs command parameters are reference, fasta, search, ksize, align, match, mismatch, gapopen, gapextend and processors.";
+		helpString += "The align.seqs command parameters are reference, fasta, search, ksize, align, match, mismatch, gapopen, gapextend, maxcache and processors.";
 		helpString += "The reference and fasta parameters are required. You may leave fasta blank if you have a valid fasta file. You may enter multiple fasta files by separating their names with dashes. ie. fasta=abrecovery.fasta-amzon.fasta.";
 		helpString += "The search parameter allows you to specify the method to find most similar template.  Your options are: suffix, kmer and blast. The default is kmer.";
 		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, blast and noalign. The default is needleman.";
@@ -62,6 +63,7 @@ string AlignCommand::getHelpString(){
 		helpString += "The threshold is used to specify a cutoff at which an alignment is deemed 'bad' and the reverse complement may be tried. The default threshold is 0.50, meaning 50% of the bases are removed in the alignment.";
 		helpString += "If the flip parameter is set to true the reverse complement of the sequence is aligned and the better alignment is reported.";
 		helpString += "The default for the threshold parameter is 0.50, meaning at least 50% of the bases must remain or the sequence is reported as potentially reversed.";
+		helpString += "The maxcache parameter allows you to specify how many unique sequences each processor remembers the alignments of. Sequences that repeat one of them reuse its alignment. The default is 10000, 0 turns it off.";
 		helpString += "The align.seqs command should be in the following format:";
 		helpString += "align.seqs(reference=yourTemplateFile, fasta=yourCandidateFile, align=yourAlignmentMethod, search=yourSearchmethod, ksize=yourKmerSize, match=yourMatchBonus, mismatch=yourMismatchpenalty, gapopen=yourGapopenPenalty, gapextend=yourGapExtendPenalty)";
 		helpString += "Example align.seqs(candidate=candidate.fasta, template=core.filtered, align=kmer, search=gotoh, ksize=8, match=2.0, mismatch=3.0, gapopen=-2.0, gapextend=-1.0)";
@@ -267,6 +269,9 @@ AlignCommand::AlignCommand(string option)  {
 			temp = validParameter.validFile(parameters, "threshold", false);	if (temp == "not found"){	temp = "0.50";			}
 			m->mothurConvert(temp, threshold); 
 			
+			temp = validParameter.validFile(parameters, "maxcache", false);	if (temp == "not found"){	temp = "10000";			}
+			m->mothurConvert(temp, maxCache); 
+			
 			search = validParameter.validFile(parameters, "search", false);		if (search == "not found"){	search = "kmer";		}
 			if ((search != "suffix") && (search != "kmer") && (search != "blast")) { m->mothurOut("invalid search option: choices are kmer, suffix or blast."); m->mothurOutEndLine(); abort=true; }
 			
@@ -295,7 +300,9 @@ int AlignCommand::execute(){
 	try {
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 
+		PerformanceTrace::getInstance()->startPhase("read");
 		templateDB = new AlignmentDB(templateFileName, search, kmerSize, gapOpen, gapExtend, match, misMatch, rand());
+		PerformanceTrace::getInstance()->endPhase("read");
 		
 		for (int s = 0; s < candidateFileNames.size(); s++) {
 			if (m->control_pressed) { outputTypes.clear(); return 0; }
@@ -336,11 +343,14 @@ int AlignCommand::execute(){
 			}
 		#endif
 			
+			PerformanceTrace::getInstance()->startPhase("compute");
+			numCacheHits = 0;
 			if(processors == 1){
 				numFastaSeqs = driver(lines[0], alignFileName, reportFileName, accnosFileName, candidateFileNames[s]);
 			}else{
 				numFastaSeqs = createProcesses(alignFileName, reportFileName, accnosFileName, candidateFileNames[s]); 
 			}
+			PerformanceTrace::getInstance()->endPhase("compute");
 				
 			if (m->control_pressed) { m->mothurRemove(accnosFileName); m->mothurRemove(alignFileName); m->mothurRemove(reportFileName); outputTypes.clear();  return 0; }
 			
@@ -360,6 +370,7 @@ int AlignCommand::execute(){
 
 			m->mothurOut("It took " + toString(time(NULL) - start) + " secs to align " + toString(numFastaSeqs) + " sequences.");
 			m->mothurOutEndLine();
+			if (numCacheHits != 0) { m->mothurOut(toString(numCacheHits) + " of them repeated a sequence already aligned and reused its alignment.\n"); }
 			m->mothurOutEndLine();
 		}
 		
@@ -401,6 +412,7 @@ int AlignCommand::driver(linePair* filePos, string alignFName, string reportFNam
 
 		bool done = false;
 		int count = 0;
+		AlignmentCache cache(maxCache);
 		
 		//moved this into driver to avoid deep copies in windows paralellized version
 		Alignment* alignment;
@@ -427,7 +439,15 @@ int AlignCommand::driver(linePair* filePos, string alignFName, string reportFNam
 			string originalUnaligned = candidateSeq->getUnaligned();
 			int numBasesNeeded = origNumBases * threshold;
 	
-			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
+			alignResult cached;
+			if (candidateSeq->getName() == "") {} //incase there is a commented sequence at the end of a file
+			else if (cache.get(originalUnaligned, cached)) { //same sequence as one already aligned
+				alignmentFile << '>' << candidateSeq->getName() << '\n' << cached.aligned.getSequence().getAligned() << endl;
+				report.print(candidateSeq->getName(), cached.report);
+				if (cached.inAccnos) { accnosFile << candidateSeq->getName() << cached.accnos << endl; }
+				
+				count++;
+			}else {
 				if (candidateSeq->getUnaligned().length()+1 > alignment->getnRows()) {
                     if (m->debug) { m->mothurOut("[DEBUG]: " + candidateSeq->getName() + " " + toString(candidateSeq->getUnaligned().length()) + " " + toString(alignment->getnRows()) + " \n"); }
 					alignment->resize(candidateSeq->getUnaligned().length()+2);
@@ -448,9 +468,10 @@ int AlignCommand::driver(linePair* filePos, string alignFName, string reportFNam
 												//so this bool tells you if you need to delete it
 												
 				//if there is a possibility that this sequence should be reversed
+				string wasBetter =  "";
+				bool inAccnos = false;
 				if (candidateSeq->getNumBases() < numBasesNeeded) {
 					
-					string wasBetter =  "";
 					//if the user wants you to try the reverse
 					if (flip) {
 				
@@ -492,6 +513,7 @@ int AlignCommand::driver(linePair* filePos, string alignFName, string reportFNam
 					
 					//create accnos file with names
 					accnosFile << candidateSeq->getName() << wasBetter << endl;
+					inAccnos = true;
 				}
 				
 				report.setTemplate(templateSeq);
@@ -502,6 +524,8 @@ int AlignCommand::driver(linePair* filePos, string alignFName, string reportFNam
 				alignmentFile << '>' << candidateSeq->getName() << '\n' << candidateSeq->getAligned() << endl;
 				
 				report.print();
+				cache.add(originalUnaligned, alignResult(PackedSequence(*candidateSeq), report.getResults(), wasBetter, inAccnos));
+				
 				delete nast;
                 delete templateSeq;
 				if (needToDeleteCopy) {   delete copy;   }
@@ -529,6 +553,8 @@ int AlignCommand::driver(linePair* filePos, string alignFName, string reportFNam
 		inFASTA.close();
 		accnosFile.close();
 		
+		numCacheHits += cache.getHits();
+		
 		return count;
 	}
 	catch(exception& e) {
@@ -561,7 +587,7 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
 				ofstream out;
 				string tempFile = alignFileName + toString(m->mothurGetpid(process)) + ".num.temp";
 				m->openOutputFile(tempFile, out);
-				out << num << endl;
+				out << num << '\t' << numCacheHits << endl;
 				out.close();
 				
 				exit(0);
@@ -604,7 +630,7 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
                     ofstream out;
                     string tempFile = alignFileName + toString(m->mothurGetpid(process)) + ".num.temp";
                     m->openOutputFile(tempFile, out);
-                    out << num << endl;
+                    out << num << '\t' << numCacheHits << endl;
                     out.close();
                     
                     exit(0);
@@ -633,7 +659,7 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
 			ifstream in;
 			string tempFile =  alignFileName + toString(processIDS[i]) + ".num.temp";
 			m->openInputFile(tempFile, in);
-			if (!in.eof()) { int tempNum = 0; in >> tempNum; num += tempNum; }
+			if (!in.eof()) { int tempNum = 0; int tempHits = 0; in >> tempNum >> tempHits; num += tempNum; numCacheHits += tempHits; }
 			in.close(); m->mothurRemove(tempFile);
 			
 			m->appendFiles((alignFileName + toString(processIDS[i]) + ".temp"), alignFileName);
@@ -22,6 +22,7 @@
 
 #include "nast.hpp"
 #include "nastreport.hpp"
+#include "alignmentcache.h"
 
 //test
 class AlignCommand : public Command {
@@ -55,7 +56,7 @@ private:
 		
 	string candidateFileName, templateFileName, distanceFileName, search, align, outputDir;
 	float match, misMatch, gapOpen, gapExtend, threshold;
-	int processors, kmerSize;
+	int processors, kmerSize, maxCache, numCacheHits;
 	vector<string> candidateFileNames;
 	vector<string> outputNames;
 	
@@ -253,6 +253,7 @@ int BinSeqCommand::execute(){
         if (countfile != "") {  ct.readTable(countfile, true, false);  }
 		
 		input = new InputData(listfile, "list");
+		input->setLabels(labels);
 		list = input->getListVector();
 		string lastLabel = list->getLabel();
 		
@@ -555,6 +555,10 @@ ChimeraUchimeCommand::ChimeraUchimeCommand(string option)  {
             if (hasCount && (templatefile != "self")) { m->mothurOut("You have provided a countfile and the reference parameter is not set to self. I am not sure what reference you are trying to use, aborting."); m->mothurOutEndLine(); abort=true; }
 			if (hasGroup && (templatefile != "self")) { m->mothurOut("You have provided a group file and the reference parameter is not set to self. I am not sure what reference you are trying to use, aborting."); m->mothurOutEndLine(); abort=true; }
 			
+#ifdef UCHIME_LIBRARY
+            //uchime is built into mothur, no need to look for the executable
+            uchimeLocation = "uchime";
+#else
 			//look for uchime exe
 			path = m->argv;
 			string tempPath = path;
@@ -601,6 +605,7 @@ ChimeraUchimeCommand::ChimeraUchimeCommand(string option)  {
             }else {  uchimeLocation = uchimeCommand; }
             
             uchimeLocation = m->getFullPathName(uchimeLocation);
+#endif
         }
 	}
 	catch(exception& e) {
@@ -616,6 +621,14 @@ int ChimeraUchimeCommand::execute(){
         if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 		
 		m->mothurOut("\nuchime by Robert C. Edgar\nhttp://drive5.com/uchime\nThis code is donated to the public domain.\n\n");
+        
+#ifdef UCHIME_LIBRARY
+        //read the reference once, before any processes are created, so every file and child process searches the same copy
+        if (templatefile != "self") {
+            string uchimeError = "";
+            if (uchime_preloaddb(templatefile, uchimeError) != 0) { m->mothurOut("[ERROR]: uchime could not read " + templatefile + ": " + uchimeError + "\n"); return 0; }
+        }
+#endif
 		
 		for (int s = 0; s < fastaFileNames.size(); s++) {
 			
@@ -1489,16 +1502,33 @@ int ChimeraUchimeCommand::driver(string outputFName, string filename, string acc
 		uchimeParameters = new char*[cPara.size()];
 		string commandString = "";
 		for (int i = 0; i < cPara.size(); i++) {  uchimeParameters[i] = cPara[i];  commandString += toString(cPara[i]) + " "; } 
-		//int numArgs = cPara.size();
 		
-		//uchime_main(numArgs, uchimeParameters); 
+#ifdef UCHIME_LIBRARY
+        if (m->debug) { m->mothurOut("[DEBUG]: uchime parameters = " + commandString + ".\n"); }
+        
+        //no shell is involved, so remove the quotes we added for paths with spaces
+		for (int i = 0; i < cPara.size(); i++) {
+            string param = toString(cPara[i]);
+            while ((param.length() > 0) && (param[param.length()-1] == ' ')) { param = param.substr(0, param.length()-1); }
+            if ((param.length() > 1) && (param[0] == '"') && (param[param.length()-1] == '"')) { param = param.substr(1, param.length()-2); }
+            
+            delete cPara[i];
+            cPara[i] = new char[param.length()+1];
+            *cPara[i] = '\0'; strncat(cPara[i], param.c_str(), param.length());
+            uchimeParameters[i] = cPara[i];
+        }
+		int numArgs = cPara.size();
 		
+		string uchimeError = "";
+		if (uchime_main(numArgs, uchimeParameters, uchimeError) != 0) { m->mothurOut("[ERROR]: uchime failed: " + uchimeError + "\n"); m->control_pressed = true; }
+#else
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #else
 		commandString = "\"" + commandString + "\"";
 #endif
         if (m->debug) { m->mothurOut("[DEBUG]: uchime command = " + commandString + ".\n"); }
 		system(commandString.c_str());
+#endif
 		
 		//free memory
 		for(int i = 0; i < cPara.size(); i++)  {  delete cPara[i];  }
@@ -1611,6 +1641,7 @@ int ChimeraUchimeCommand::createProcesses(string outputFileName, string filename
 				process++;
 			}else if (pid == 0){
 				num = driver(outputFileName + toString(m->mothurGetpid(process)) + ".temp", files[process], accnos + toString(m->mothurGetpid(process)) + ".temp", alns + toString(m->mothurGetpid(process)) + ".temp", numChimeras);
+				if (m->control_pressed) { num = -1; } //tell the parent uchime failed
 				
 				//pass numSeqs to parent
 				ofstream out;
@@ -1644,7 +1675,8 @@ int ChimeraUchimeCommand::createProcesses(string outputFileName, string filename
 			if (!in.eof()) { 
 				int tempNum = 0; 
 				in >> tempNum; m->gobble(in);
-				num += tempNum; 
+				if (tempNum < 0) { m->control_pressed = true; }
+				else { num += tempNum; }
 				in >> tempNum;
 				numChimeras += tempNum;
 			}
@@ -1785,6 +1817,7 @@ int ChimeraUchimeCommand::createProcessesGroups(string outputFName, string filen
 				process++;
 			}else if (pid == 0){
 				num = driverGroups(outputFName + toString(m->mothurGetpid(process)) + ".temp", filename + toString(m->mothurGetpid(process)) + ".temp", accnos + toString(m->mothurGetpid(process)) + ".temp", alns + toString(m->mothurGetpid(process)) + ".temp", accnos + ".byCount." + toString(m->mothurGetpid(process)) + ".temp", lines[process].start, lines[process].end, groups);
+				if (m->control_pressed) { num = -1; } //tell the parent uchime failed
 				
 				//pass numSeqs to parent
 				ofstream out;
@@ -1816,7 +1849,7 @@ int ChimeraUchimeCommand::createProcessesGroups(string outputFName, string filen
 			ifstream in;
 			string tempFile =  outputFName + toString(processIDS[i]) + ".num.temp";
 			m->openInputFile(tempFile, in);
-			if (!in.eof()) { int tempNum = 0; in >> tempNum; num += tempNum; }
+			if (!in.eof()) { int tempNum = 0; in >> tempNum; if (tempNum < 0) { m->control_pressed = true; } else { num += tempNum; } }
 			in.close(); m->mothurRemove(tempFile);
         }
         
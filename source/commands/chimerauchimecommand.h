@@ -16,6 +16,13 @@
 #include "counttable.h"
 #include "sequencecountparser.h"
 
+#ifdef UCHIME_LIBRARY
+//defined in uchime_src/uchime_main.cpp
+//both return 1 and set the message if uchime hits a fatal error
+int uchime_main(int, char**, string&);
+int uchime_preloaddb(const string&, string&);
+#endif
+
 /***********************************************************/
 
 class ChimeraUchimeCommand : public Command {
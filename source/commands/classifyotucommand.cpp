@@ -8,8 +8,6 @@
  */
 
 #include "classifyotucommand.h"
-#include "phylotree.h"
-#include "phylosummary.h"
 #include "sharedutilities.h"
 
 //**********************************************************************************************************************
@@ -29,6 +27,7 @@ vector<string> ClassifyOtuCommand::setParameters(){
 		CommandParameter pcutoff("cutoff", "Number", "", "51", "", "", "","",false,true); parameters.push_back(pcutoff);
         CommandParameter pthreshold("threshold", "Number", "", "0", "", "", "","",false,true); parameters.push_back(pthreshold);
 		CommandParameter pprobs("probs", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pprobs);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -46,7 +45,7 @@ vector<string> ClassifyOtuCommand::setParameters(){
 string ClassifyOtuCommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The classify.otu command parameters are list, taxonomy, name, group, count, persample, cutoff, label, basis, relabund and probs.  The taxonomy and list parameters are required unless you have a valid current file.\n";
+		helpString += "The classify.otu command parameters are list, taxonomy, name, group, count, persample, cutoff, label, basis, relabund, processors and probs.  The taxonomy and list parameters are required unless you have a valid current file.\n";
 		helpString += "The name parameter allows you add a names file with your taxonomy file.\n";
 		helpString += "The group parameter allows you provide a group file to use in creating the summary file breakdown.\n";
 		helpString += "The count parameter allows you add a count file associated with your list file. When using the count parameter mothur assumes your list file contains only uniques.\n";
@@ -64,6 +63,7 @@ string ClassifyOtuCommand::getHelpString(){
 		helpString += "The cutoff parameter allows you to specify a consensus confidence threshold for your otu taxonomy output.  The default is 51, meaning 51%. Cutoff cannot be below 51.\n";
 		helpString += "The probs parameter shuts off the outputting of the consensus confidence results. The default is true, meaning you want the confidence to be shown.\n";
         helpString += "The threshold parameter allows you to specify a cutoff for the taxonomy file that is being inputted. Once the classification falls below the threshold the mothur will refer to it as unclassified when calculating the concensus.  This feature is similar to adjusting the cutoff in classify.seqs. Default=0.\n";
+        helpString += "The processors parameter allows you to specify the number of processors to use. The OTUs are divided between the processors. The default is 1.\n";
         helpString += "The classify.otu command should be in the following format: classify.otu(taxonomy=yourTaxonomyFile, list=yourListFile, name=yourNamesFile, label=yourLabels).\n";
 		helpString += "Example classify.otu(taxonomy=abrecovery.silva.full.taxonomy, list=abrecovery.fn.list, label=0.10).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. list), '=' and parameters (i.e.yourListFile).\n";
@@ -261,6 +261,10 @@ ClassifyOtuCommand::ClassifyOtuCommand(string option)  {
             temp = validParameter.validFile(parameters, "printlevel", false);		if (temp == "not found"){	temp = "-1";		}
             m->mothurConvert(temp, printlevel);
             
+            temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+            m->setProcessors(temp);
+            m->mothurConvert(temp, processors);
+            
             output = validParameter.validFile(parameters, "output", false);		if(output == "not found"){	output = "detail"; }
             if ((output != "simple") && (output != "detail")) { m->mothurOut(output + " is not a valid output form. Options are simple and detail. I will use detail."); m->mothurOutEndLine(); output = "detail"; }
 			
@@ -309,10 +313,18 @@ int ClassifyOtuCommand::execute(){
 		m->readTax(taxfile, taxMap, removeConfidences);
         
         if (threshold != 0) {  processTaxMap();  }
+        
+        //each taxonomy is split once, the consensus of a bin works with the ids
+        for (map<string, string>::iterator it = taxMap.begin(); it != taxMap.end();) {
+            taxIds[it->first] = taxIndex.getTaxonomy(it->second);
+            taxMap.erase(it++);
+        }
+        unknownTaxonomy = taxIndex.getTaxonomy("unknown;");
 		
 		if (m->control_pressed) { return 0; }
 		
 		input = new InputData(listfile, "list");
+		input->setLabels(labels);
 		list = input->getListVector();
 		string lastLabel = list->getLabel();
 
@@ -401,33 +413,58 @@ int ClassifyOtuCommand::execute(){
 	}
 }
 //**********************************************************************************************************************
+//adds a sequence to the taxonomies of a bin, the way PhyloTree's addSeqToTree counted it
+int ClassifyOtuCommand::addTaxonomy(string name, int taxonomy, int numSeqs, map<int, int>& taxonomies, int& maxLevel) {
+	try{
+		if (numSeqs < 1) { return 0; }
+		
+		taxonomies[taxonomy] += numSeqs;
+		
+		int level = taxIndex.getNumValidTaxons(taxonomy);
+		if (level < taxIndex.getTaxons(taxonomy).size()) {
+			level++;
+			for (int i = 0; i < numSeqs; i++) { m->mothurOut(name + " has an error in the taxonomy.  This may be due to a ;;"); m->mothurOutEndLine(); }
+		}
+		
+		if (level > maxLevel) { maxLevel = level; }
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "addTaxonomy");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
 vector<string> ClassifyOtuCommand::findConsensusTaxonomy(vector<string> names, int& size, string& conTax, string group) {
 	try{
 		conTax = "";
 		vector<string> allNames;
-		map<string, string>::iterator it;
+		map<string, int>::iterator it;
 		map<string, string>::iterator it2;
 
-		//create a tree containing sequences from this bin
-		PhyloTree* phylo = new PhyloTree();
+		//taxonomy id -> number of sequences in this bin. PhyloTree started every bin with an unknown sequence.
+		map<int, int> taxonomies;
+		int maxLevel = 0;
+		addTaxonomy("unknown", unknownTaxonomy, 1, taxonomies, maxLevel);
 		
 		size = 0;
 		for (int i = 0; i < names.size(); i++) {
             
             if (group != "") { //no need to check for name file, names already added in previous step
                 //is this sequence in the taxonomy file - look for repSeqName since we are assuming the taxonomy file is unique
-                it = taxMap.find(names[i]);
+                it = taxIds.find(names[i]);
                 
-                if (it == taxMap.end()) { //this name is not in taxonomy file, skip it
+                if (it == taxIds.end()) { //this name is not in taxonomy file, skip it
                     m->mothurOut("[WARNING]: " + names[i] + " is not in your taxonomy file.  I will not include it in the consensus."); m->mothurOutEndLine();
                 }else{
                     if (countfile != "") {
                         int numDups = ct->getGroupCount(names[i], group);
-                        for (int j = 0; j < numDups; j++) {  phylo->addSeqToTree(names[i], it->second);  }
+                        addTaxonomy(names[i], it->second, numDups, taxonomies, maxLevel);
                         size += numDups;
                     }else{
                         //add seq to tree
-                        phylo->addSeqToTree(names[i], it->second);
+                        addTaxonomy(names[i], it->second, 1, taxonomies, maxLevel);
                         size++;
                     }
                     allNames.push_back(names[i]);
@@ -445,16 +482,16 @@ vector<string> ClassifyOtuCommand::findConsensusTaxonomy(vector<string> names, i
                     }else{
                         
                         //is this sequence in the taxonomy file - look for repSeqName since we are assuming the taxonomy file is unique
-                        it = taxMap.find(it2->second);
+                        it = taxIds.find(it2->second);
                         
-                        if (it == taxMap.end()) { //this name is not in taxonomy file, skip it
+                        if (it == taxIds.end()) { //this name is not in taxonomy file, skip it
                             
                             if (names[i] != it2->second) { m->mothurOut(names[i] + " is represented by " +  it2->second + " and is not in your taxonomy file.  I will not include it in the consensus."); m->mothurOutEndLine(); }
                             else {  m->mothurOut(names[i] + " is not in your taxonomy file.  I will not include it in the consensus."); m->mothurOutEndLine(); }
                         }else{
                             
                             //add seq to tree
-                            phylo->addSeqToTree(names[i], it->second);
+                            addTaxonomy(names[i], it->second, 1, taxonomies, maxLevel);
                             size++;
                             allNames.push_back(names[i]);
                         }
@@ -462,18 +499,18 @@ vector<string> ClassifyOtuCommand::findConsensusTaxonomy(vector<string> names, i
                     
                 }else{
                     //is this sequence in the taxonomy file - look for repSeqName since we are assuming the taxonomy file is unique
-                    it = taxMap.find(names[i]);
+                    it = taxIds.find(names[i]);
                     
-                    if (it == taxMap.end()) { //this name is not in taxonomy file, skip it
+                    if (it == taxIds.end()) { //this name is not in taxonomy file, skip it
                         m->mothurOut("[WARNING]: " + names[i] + " is not in your taxonomy file.  I will not include it in the consensus."); m->mothurOutEndLine();
                     }else{
                         if (countfile != "") {
                             int numDups = ct->getNumSeqs(names[i]); 
-                            for (int j = 0; j < numDups; j++) {  phylo->addSeqToTree(names[i], it->second);  }
+                            addTaxonomy(names[i], it->second, numDups, taxonomies, maxLevel);
                             size += numDups;
                         }else{
                             //add seq to tree
-                            phylo->addSeqToTree(names[i], it->second);
+                            addTaxonomy(names[i], it->second, 1, taxonomies, maxLevel);
                             size++;  
                         }
                         allNames.push_back(names[i]);
@@ -481,45 +518,46 @@ vector<string> ClassifyOtuCommand::findConsensusTaxonomy(vector<string> names, i
                 }
             }
 			
-			if (m->control_pressed) { delete phylo; return allNames; }
+			if (m->control_pressed) { return allNames; }
 			
 		}
 		
-		//build tree
-		phylo->assignHeirarchyIDs(0);
+		//taxonomies under the current taxon
+		vector<int> current, currentSizes;
+		for (map<int, int>::iterator itTax = taxonomies.begin(); itTax != taxonomies.end(); itTax++) { current.push_back(itTax->first); currentSizes.push_back(itTax->second); }
 		
-		TaxNode currentNode = phylo->get(0);
 		int myLevel = 0; 	
 		//at each level
-		while (currentNode.children.size() != 0) { //you still have more to explore
-		
-			TaxNode bestChild;
-			int bestChildSize = 0;
+		for (int level = 0; current.size() != 0; level++) {
 			
-			//go through children
-			for (map<string, int>::iterator itChild = currentNode.children.begin(); itChild != currentNode.children.end(); itChild++) {
-				
-				TaxNode temp = phylo->get(itChild->second);
-				
-				//select child with largest accesions - most seqs assigned to it
-				if (temp.accessions.size() > bestChildSize) {
-					bestChild = phylo->get(itChild->second);
-					bestChildSize = temp.accessions.size();
-				}
-				
+			//number of seqs assigned to each child
+			map<int, int> children;
+			for (int i = 0; i < current.size(); i++) {
+				if (taxIndex.getNumValidTaxons(current[i]) > level) { children[taxIndex.getTaxons(current[i])[level]] += currentSizes[i]; }
 			}
+			
+			if (children.size() == 0) { break; } //nothing more to explore
+			
+			//select child with largest accesions - most seqs assigned to it, ties go to the first name as they did in the tree
+			int bestChild = -1;
+			int bestChildSize = 0;
+			for (map<int, int>::iterator itChild = children.begin(); itChild != children.end(); itChild++) {
+				if (itChild->second > bestChildSize) { bestChild = itChild->first; bestChildSize = itChild->second; }
+				else if ((itChild->second == bestChildSize) && (taxIndex.getTaxonName(itChild->first) < taxIndex.getTaxonName(bestChild))) { bestChild = itChild->first; }
+			}
+			string bestName = taxIndex.getTaxonName(bestChild);
             
             //phylotree adds an extra unknown so we want to remove that
-            if (bestChild.name == "unknown") { bestChildSize--; }
+            if (bestName == "unknown") { bestChildSize--; }
 				
 			//is this taxonomy above cutoff
 			int consensusConfidence = ceil((bestChildSize / (float) size) * 100);
             
 			if (consensusConfidence >= cutoff) { //if yes, add it
 				if (probs) {
-					conTax += bestChild.name + "(" + toString(consensusConfidence) + ");";
+					conTax += bestName + "(" + toString(consensusConfidence) + ");";
 				}else{
-					conTax += bestChild.name + ";";
+					conTax += bestName + ";";
 				}
 				myLevel++;
 			}else{ //if no, quit
@@ -527,14 +565,16 @@ vector<string> ClassifyOtuCommand::findConsensusTaxonomy(vector<string> names, i
 			}
 			
 			//move down a level
-			currentNode = bestChild;
+			vector<int> next, nextSizes;
+			for (int i = 0; i < current.size(); i++) {
+				if ((taxIndex.getNumValidTaxons(current[i]) > level) && (taxIndex.getTaxons(current[i])[level] == bestChild)) { next.push_back(current[i]); nextSizes.push_back(currentSizes[i]); }
+			}
+			current.swap(next); currentSizes.swap(nextSizes);
 		}
         
         if (conTax == "") {  conTax = "unknown;";  }
         
-		if (myLevel != phylo->getMaxLevel()) {  conTax = m->addUnclassifieds(conTax, phylo->getMaxLevel(), probs);  }
-		
-		delete phylo;	
+		if (myLevel != maxLevel) {  conTax = m->addUnclassifieds(conTax, maxLevel, probs);  }
 		
 		return allNames;
 	}
@@ -546,9 +586,6 @@ vector<string> ClassifyOtuCommand::findConsensusTaxonomy(vector<string> names, i
 //**********************************************************************************************************************
 int ClassifyOtuCommand::process(ListVector* processList) {
 	try{
-		string conTax;
-		int size;
-		
 		//create output file
 		if (outputDir == "") { outputDir += m->hasPath(listfile); }
 				
@@ -567,22 +604,19 @@ int ClassifyOtuCommand::process(ListVector* processList) {
 		
 		out << "OTU\tSize\tTaxonomy" << endl;
 		
-		PhyloSummary* taxaSum;
         if (countfile != "") { taxaSum = new PhyloSummary(ct,relabund, printlevel); }
         else { taxaSum = new PhyloSummary(groupMap,relabund, printlevel); }
         
-        vector<string> outs;
-        vector<PhyloSummary*> taxaSums;
-        map<string, int> groupIndex;
+        taxaSums.clear(); groupOuts.clear(); groupIndex.clear();
         if (persample) {
             for (int i = 0; i < groups.size(); i++) {
                 groupIndex[groups[i]] = i;
                 variables["[distance]"] = processList->getLabel() + "." + groups[i];
                 string outputFile = getOutputFileName("constaxonomy", variables);
-                ofstream temp;
-                m->openOutputFile(outputFile, temp);
-                outs.push_back(outputFile);
-                temp << "OTU\tSize\tTaxonomy" << endl;
+                ofstream* temp = new ofstream();
+                m->openOutputFile(outputFile, *temp);
+                groupOuts.push_back(temp);
+                *temp << "OTU\tSize\tTaxonomy" << endl;
                 outputNames.push_back(outputFile); outputTypes["constaxonomy"].push_back(outputFile);
                 
                 PhyloSummary* taxaSumt;
@@ -593,120 +627,13 @@ int ClassifyOtuCommand::process(ListVector* processList) {
         }
         
 		//for each bin in the list vector
-        string snumBins = toString(processList->getNumBins());
-        vector<string> binLabels = processList->getLabels();
-		for (int i = 0; i < processList->getNumBins(); i++) {
-			
-			if (m->control_pressed) { break; }
-			
-			vector<string> names;
-            string binnames = processList->get(i);
-            vector<string> thisNames;
-            m->splitAtComma(binnames, thisNames);
-            
-			names = findConsensusTaxonomy(thisNames, size, conTax, "");
-		
-			if (m->control_pressed) { break; }
-
-			out << binLabels[i] << '\t' << size << '\t' << conTax << endl;
-			
-			string noConfidenceConTax = conTax;
-			m->removeConfidences(noConfidenceConTax);
-			
-			//add this bins taxonomy to summary
-			if (basis == "sequence") {
-				for(int j = 0; j < names.size(); j++) {  
-                    //int numReps = 1;
-                    //if (countfile != "") {  numReps = ct->getNumSeqs(names[j]); }
-                    //for(int k = 0; k < numReps; k++) {  taxaSum->addSeqToTree(names[j], noConfidenceConTax);  }
-                    taxaSum->addSeqToTree(names[j], noConfidenceConTax);
-                }
-			}else { //otu
-                map<string, bool> containsGroup; 
-                if (countfile != "") {
-                    if (ct->hasGroupInfo()) {
-                        vector<string> mGroups = ct->getNamesOfGroups();
-                        for (int k = 0; k < names.size(); k++) {
-                            vector<int> counts = ct->getGroupCounts(names[k]);
-                            for (int h = 0; h < counts.size(); h++) {  
-                                if (counts[h] != 0) {  containsGroup[mGroups[h]] = true; }
-                            }
-                        }
-                    }
-                }else {
-                    if (groupfile != "") {
-                        vector<string> mGroups = groupMap->getNamesOfGroups();
-                        for (int j = 0; j < mGroups.size(); j++) { containsGroup[mGroups[j]] = false; }
-                        
-                        for (int k = 0; k < names.size(); k++) {
-                            //find out the sequences group
-                            string group = groupMap->getGroup(names[k]);
-                            
-                            if (group == "not found") {  m->mothurOut("[WARNING]: " + names[k] + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
-                            else {
-                                containsGroup[group] = true;
-                            }
-                        }
-                    }
-                }
-				taxaSum->addSeqToTree(noConfidenceConTax, containsGroup);
-			}
-            
-            
-            if (persample) {
-                //divide names by group
-                map<string, vector<string> > parsedNames;
-                map<string, vector<string> >::iterator itParsed;
-                
-                //parse names by group
-                for (int j = 0; j < names.size(); j++) {
-                    if (groupfile != "") { 
-                        string group = groupMap->getGroup(names[j]); 
-                        itParsed = parsedNames.find(group);
-                        
-                        if (itParsed != parsedNames.end()) { itParsed->second.push_back(names[j]); }
-                        else { vector<string> tempNames; tempNames.push_back(names[j]); parsedNames[group] = tempNames; }
-                    }else { //count file was used
-                        vector<string> thisSeqsGroups = ct->getGroups(names[j]);
-                        for (int k = 0; k < thisSeqsGroups.size(); k++) {
-                            string group = thisSeqsGroups[k]; 
-                            itParsed = parsedNames.find(group);
-                            
-                            if (itParsed != parsedNames.end()) { itParsed->second.push_back(names[j]); }
-                            else { vector<string> tempNames; tempNames.push_back(names[j]); parsedNames[group] = tempNames; }
-                        }
-                    }
-                }
-                
-                for (itParsed = parsedNames.begin(); itParsed != parsedNames.end(); itParsed++) {
-                    vector<string> theseNames = findConsensusTaxonomy(itParsed->second, size, conTax, itParsed->first);
-                    
-                    if (m->control_pressed) { break; }
-                    
-                    ofstream out; m->openOutputFileAppend(outs[groupIndex[itParsed->first]], out);
-                    out << binLabels[i] << '\t' << size << '\t' << conTax << endl;
-                    out.close();
-                    
-                    string noConfidenceConTax = conTax;
-                    m->removeConfidences(noConfidenceConTax);
-                    
-                    //add this bins taxonomy to summary
-                    if (basis == "sequence") {
-                        for(int j = 0; j < theseNames.size(); j++) {  
-                            int numReps = 1;
-                            if (countfile != "") {  numReps = ct->getGroupCount(theseNames[j], itParsed->first); } //get num seqs for this seq from this group
-                            for(int k = 0; k < numReps; k++) {  (taxaSums[groupIndex[itParsed->first]])->addSeqToTree(theseNames[j], noConfidenceConTax);  }
-                        }
-                    }else { //otu
-                        map<string, bool> containsGroup; 
-                        containsGroup[itParsed->first] = true;
-                        (taxaSums[groupIndex[itParsed->first]])->addSeqToTree(noConfidenceConTax, containsGroup);
-                    }
-                }
-            }
-		}
+        binLabels = processList->getLabels();
+        if (processors == 1) { driver(processList, 0, processList->getNumBins(), out); }
+        else { createProcesses(processList, out); }
 
 		out.close();
+        for (int i = 0; i < groupOuts.size(); i++) { groupOuts[i]->close(); delete groupOuts[i]; }
+        groupOuts.clear();
 		
 		//print summary file
 		taxaSum->print(outSum, output);
@@ -724,6 +651,7 @@ int ClassifyOtuCommand::process(ListVector* processList) {
                 delete taxaSums[i];
             }
         }
+        taxaSums.clear();
 		
 		delete taxaSum;
 		
@@ -735,6 +663,311 @@ int ClassifyOtuCommand::process(ListVector* processList) {
 		exit(1);
 	}
 }
+//**********************************************************************************************************************
+int ClassifyOtuCommand::driver(ListVector* processList, int start, int end, ofstream& out) {
+	try{
+		for (int i = start; i < end; i++) {
+			
+			if (m->control_pressed) { break; }
+			
+			otuConsensus result;
+			findConsensus(processList, i, result);
+			
+			if (m->control_pressed) { break; }
+			
+			addConsensus(i, result, out);
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "driver");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int ClassifyOtuCommand::createProcesses(ListVector* processList, ofstream& out) {
+	try{
+		int numBins = processList->getNumBins();
+		
+		int numProcessors = processors;
+		if (numProcessors > numBins) { numProcessors = numBins; }
+		if (numProcessors < 1) { numProcessors = 1; }
+		
+		//divide the otus between the processors by the number of sequences in them
+		vector<double> binSizes(numBins, 0);
+		double totalWork = 0;
+		for (int i = 0; i < numBins; i++) {
+			string bin = processList->get(i);
+			binSizes[i] = count(bin.begin(), bin.end(), ',') + 1;
+			totalWork += binSizes[i];
+		}
+		
+		vector<int> starts(numProcessors+1, numBins); starts[0] = 0;
+		int process = 1;
+		double work = 0;
+		for (int i = 0; i < numBins; i++) {
+			while ((process < numProcessors) && (work >= (totalWork * process / (double) numProcessors))) { starts[process] = i; process++; }
+			work += binSizes[i];
+		}
+		
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		process = 1;
+		vector<int> processIDS;
+		
+		//loop through and create all the processes you want
+		while (process != numProcessors) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);
+				process++;
+			}else if (pid == 0){
+				//pass the consensus of each otu to the parent, who writes them in order
+				ofstream outTemp;
+				string tempFile = outputDir + m->mothurGetpid(process) + ".classifyotu.temp";
+				m->openOutputFile(tempFile, outTemp);
+				
+				for (int i = starts[process]; i < starts[process+1]; i++) {
+					if (m->control_pressed) { break; }
+					
+					otuConsensus result;
+					findConsensus(processList, i, result);
+					writeConsensus(outTemp, result);
+				}
+				outTemp.close();
+				
+				exit(0);
+			}else {
+				m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+				for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+				exit(0);
+			}
+		}
+		
+		//do my part
+		driver(processList, starts[0], starts[1], out);
+		
+		//force parent to wait until all the processes are done
+		for (int i=0;i<processIDS.size();i++) {
+			int temp = processIDS[i];
+			wait(&temp);
+		}
+		
+		for (int i = 0; i < processIDS.size(); i++) {
+			ifstream in;
+			string tempFile = outputDir + toString(processIDS[i]) + ".classifyotu.temp";
+			m->openInputFile(tempFile, in);
+			
+			for (int j = starts[i+1]; j < starts[i+2]; j++) {
+				if (m->control_pressed) { break; }
+				
+				otuConsensus result;
+				if (!readConsensus(in, result)) { m->mothurOut("[ERROR]: missing the consensus of " + binLabels[j] + ", quitting.\n"); m->control_pressed = true; break; }
+				addConsensus(j, result, out);
+			}
+			
+			in.close(); m->mothurRemove(tempFile);
+		}
+#else
+		driver(processList, 0, numBins, out);
+#endif
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "createProcesses");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int ClassifyOtuCommand::findConsensus(ListVector* processList, int bin, otuConsensus& result) {
+	try{
+		string binnames = processList->get(bin);
+		vector<string> thisNames;
+		m->splitAtComma(binnames, thisNames);
+		
+		result.names = findConsensusTaxonomy(thisNames, result.size, result.conTax, "");
+		
+		if (m->control_pressed) { return 0; }
+		
+		if (persample) {
+			//divide names by group
+			map<string, vector<string> > parsedNames;
+			map<string, vector<string> >::iterator itParsed;
+			
+			//parse names by group
+			for (int j = 0; j < result.names.size(); j++) {
+				if (groupfile != "") { 
+					string group = groupMap->getGroup(result.names[j]); 
+					parsedNames[group].push_back(result.names[j]);
+				}else { //count file was used
+					vector<string> thisSeqsGroups = ct->getGroups(result.names[j]);
+					for (int k = 0; k < thisSeqsGroups.size(); k++) { parsedNames[thisSeqsGroups[k]].push_back(result.names[j]); }
+				}
+			}
+			
+			for (itParsed = parsedNames.begin(); itParsed != parsedNames.end(); itParsed++) {
+				int size;
+				string conTax;
+				vector<string> theseNames = findConsensusTaxonomy(itParsed->second, size, conTax, itParsed->first);
+				
+				if (m->control_pressed) { break; }
+				
+				result.groups.push_back(itParsed->first);
+				result.groupSizes.push_back(size);
+				result.groupConTaxes.push_back(conTax);
+				result.groupNames.push_back(theseNames);
+			}
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "findConsensus");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//writes the consensus of an otu and adds it to the summaries
+int ClassifyOtuCommand::addConsensus(int bin, otuConsensus& result, ofstream& out) {
+	try{
+		vector<string>& names = result.names;
+		
+		out << binLabels[bin] << '\t' << result.size << '\t' << result.conTax << endl;
+		
+		string noConfidenceConTax = result.conTax;
+		m->removeConfidences(noConfidenceConTax);
+		
+		//add this bins taxonomy to summary
+		if (basis == "sequence") {
+			for(int j = 0; j < names.size(); j++) {  
+				//int numReps = 1;
+				//if (countfile != "") {  numReps = ct->getNumSeqs(names[j]); }
+				//for(int k = 0; k < numReps; k++) {  taxaSum->addSeqToTree(names[j], noConfidenceConTax);  }
+				taxaSum->addSeqToTree(names[j], noConfidenceConTax);
+			}
+		}else { //otu
+			map<string, bool> containsGroup; 
+			if (countfile != "") {
+				if (ct->hasGroupInfo()) {
+					vector<string> mGroups = ct->getNamesOfGroups();
+					for (int k = 0; k < names.size(); k++) {
+						vector<int> counts = ct->getGroupCounts(names[k]);
+						for (int h = 0; h < counts.size(); h++) {  
+							if (counts[h] != 0) {  containsGroup[mGroups[h]] = true; }
+						}
+					}
+				}
+			}else {
+				if (groupfile != "") {
+					vector<string> mGroups = groupMap->getNamesOfGroups();
+					for (int j = 0; j < mGroups.size(); j++) { containsGroup[mGroups[j]] = false; }
+					
+					for (int k = 0; k < names.size(); k++) {
+						//find out the sequences group
+						string group = groupMap->getGroup(names[k]);
+						
+						if (group == "not found") {  m->mothurOut("[WARNING]: " + names[k] + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
+						else {
+							containsGroup[group] = true;
+						}
+					}
+				}
+			}
+			taxaSum->addSeqToTree(noConfidenceConTax, containsGroup);
+		}
+		
+		for (int i = 0; i < result.groups.size(); i++) {
+			string group = result.groups[i];
+			int index = groupIndex[group];
+			vector<string>& theseNames = result.groupNames[i];
+			
+			*(groupOuts[index]) << binLabels[bin] << '\t' << result.groupSizes[i] << '\t' << result.groupConTaxes[i] << endl;
+			
+			string noConfidenceConTax = result.groupConTaxes[i];
+			m->removeConfidences(noConfidenceConTax);
+			
+			//add this bins taxonomy to summary
+			if (basis == "sequence") {
+				for(int j = 0; j < theseNames.size(); j++) {  
+					int numReps = 1;
+					if (countfile != "") {  numReps = ct->getGroupCount(theseNames[j], group); } //get num seqs for this seq from this group
+					for(int k = 0; k < numReps; k++) {  taxaSums[index]->addSeqToTree(theseNames[j], noConfidenceConTax);  }
+				}
+			}else { //otu
+				map<string, bool> containsGroup; 
+				containsGroup[group] = true;
+				taxaSums[index]->addSeqToTree(noConfidenceConTax, containsGroup);
+			}
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "addConsensus");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int ClassifyOtuCommand::writeConsensus(ofstream& out, otuConsensus& result) {
+	try{
+		out << result.size << '\t' << result.conTax << endl;
+		out << result.names.size();
+		for (int i = 0; i < result.names.size(); i++) { out << '\t' << result.names[i]; }
+		out << endl;
+		
+		out << result.groups.size() << endl;
+		for (int i = 0; i < result.groups.size(); i++) {
+			out << result.groups[i] << '\t' << result.groupSizes[i] << '\t' << result.groupConTaxes[i] << endl;
+			out << result.groupNames[i].size();
+			for (int j = 0; j < result.groupNames[i].size(); j++) { out << '\t' << result.groupNames[i][j]; }
+			out << endl;
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "writeConsensus");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+bool ClassifyOtuCommand::readConsensus(ifstream& in, otuConsensus& result) {
+	try{
+		int num = 0;
+		
+		in >> result.size; in.get();
+		result.conTax = m->getline(in); m->gobble(in);
+		
+		in >> num;
+		result.names.resize(num);
+		for (int i = 0; i < num; i++) { in >> result.names[i]; }
+		
+		int numGroups = 0;
+		in >> numGroups;
+		if (in.fail()) { return false; }
+		
+		result.groups.resize(numGroups); result.groupSizes.resize(numGroups); result.groupConTaxes.resize(numGroups); result.groupNames.resize(numGroups);
+		for (int i = 0; i < numGroups; i++) {
+			in >> result.groups[i] >> result.groupSizes[i]; in.get();
+			result.groupConTaxes[i] = m->getline(in); m->gobble(in);
+			
+			in >> num;
+			result.groupNames[i].resize(num);
+			for (int j = 0; j < num; j++) { in >> result.groupNames[i][j]; }
+		}
+		
+		bool good = !in.fail();
+		m->gobble(in);
+		
+		return good;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ClassifyOtuCommand", "readConsensus");
+		exit(1);
+	}
+}
 /**************************************************************************************************/
 int ClassifyOtuCommand::processTaxMap() {
     try{
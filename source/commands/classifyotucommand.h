@@ -14,7 +14,23 @@
 #include "listvector.hpp"
 #include "inputdata.h"
 #include "counttable.h"
+#include "taxonomyindex.h"
+#include "phylosummary.h"
 
+/**************************************************************************************************/
+//consensus of an otu, and of the sequences from each group when persample=t
+struct otuConsensus {
+	int size;
+	string conTax;
+	vector<string> names;               //sequences used to find the consensus
+	vector<string> groups;
+	vector<int> groupSizes;
+	vector<string> groupConTaxes;
+	vector< vector<string> > groupNames;
+	
+	otuConsensus() : size(0), conTax("") {}
+};
+/**************************************************************************************************/
 
 class ClassifyOtuCommand : public Command {
 
@@ -42,15 +58,32 @@ private:
 	InputData* input;
 	string listfile, namefile, taxfile, label, outputDir, groupfile, basis, countfile, output;
 	bool abort, allLines, probs, persample, relabund;
-	int cutoff, threshold, printlevel;
+	int cutoff, threshold, printlevel, processors;
 	set<string> labels; //holds labels to be used
 	vector<string> outputNames, groups;
 	map<string, string> nameMap;
 	map<string, string> taxMap;
+	TaxonomyIndex taxIndex;
+	map<string, int> taxIds;    //sequence name -> taxonomy id
+	int unknownTaxonomy;
 
 	int process(ListVector*);
     int processTaxMap();
 	vector<string> findConsensusTaxonomy(vector<string>, int&, string&, string); 	// returns the name of the "representative" taxonomy of given bin
+	int addTaxonomy(string, int, int, map<int, int>&, int&);
+	int findConsensus(ListVector*, int, otuConsensus&);
+	int addConsensus(int, otuConsensus&, ofstream&);
+	int driver(ListVector*, int, int, ofstream&);
+	int createProcesses(ListVector*, ofstream&);
+	int writeConsensus(ofstream&, otuConsensus&);
+	bool readConsensus(ifstream&, otuConsensus&);
+	
+	//outputs of the label being processed
+	vector<string> binLabels;
+	PhyloSummary* taxaSum;
+	vector<PhyloSummary*> taxaSums;
+	vector<ofstream*> groupOuts;
+	map<string, int> groupIndex;
 	
 												
 };
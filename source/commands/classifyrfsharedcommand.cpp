@@ -15,7 +15,7 @@
 //**********************************************************************************************************************
 vector<string> ClassifyRFSharedCommand::setParameters(){	
 	try {
-		//CommandParameter pprocessors("processors", "Number", "", "1", "", "", "",false,false); parameters.push_back(pprocessors);        
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);        
         CommandParameter pshared("shared", "InputTypes", "", "", "none", "none", "none","summary",false,true,true); parameters.push_back(pshared);		
         CommandParameter pdesign("design", "InputTypes", "", "", "none", "none", "none","",false,true,true); parameters.push_back(pdesign);	
         CommandParameter potupersplit("otupersplit", "Multiple", "log2-squareroot", "log2", "", "", "","",false,false); parameters.push_back(potupersplit);
@@ -50,10 +50,11 @@ string ClassifyRFSharedCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The classify.rf command allows you to ....\n";
-		helpString += "The classify.rf command parameters are: shared, design, label, groups, otupersplit.\n";
+		helpString += "The classify.rf command parameters are: shared, design, label, groups, otupersplit, processors.\n";
         helpString += "The label parameter is used to analyze specific labels in your input.\n";
         //helpString += "The sets parameter allows you to specify which of the sets in your designfile you would like to analyze. The set names are separated by dashes. THe default is all sets in the designfile.\n";
 		helpString += "The groups parameter allows you to specify which of the groups in your designfile you would like analyzed.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use building the trees. The default is 1.\n";
 		helpString += "The classify.rf should be in the following format: \n";
 		helpString += "classify.rf(shared=yourSharedFile, design=yourDesignFile)\n";
 		return helpString;
@@ -210,6 +211,10 @@ ClassifyRFSharedCommand::ClassifyRFSharedCommand(string option) {
         temp = validParameter.validFile(parameters, "stdthreshold", false);
         if (temp == "not found") { temp = "0.0"; }
         m->mothurConvert(temp, featureStandardDeviationThreshold);
+        
+        temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+        m->setProcessors(temp);
+        m->mothurConvert(temp, processors);
                         
             // end of pruning params
         
@@ -269,6 +274,7 @@ int ClassifyRFSharedCommand::execute() {
       }*/
       
       InputData input(sharedfile, "sharedfile");
+      input.setLabels(labels);
       vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
       
       
@@ -404,7 +410,7 @@ void ClassifyRFSharedCommand::processSharedAndDesignData(vector<SharedRAbundVect
             dataSet[i][j] = treatmentToIntMap[treatmentName];
         }
         
-        RandomForest randomForest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold);
+        RandomForest randomForest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold, processors);
         
         randomForest.populateDecisionTrees();
         
@@ -462,6 +462,7 @@ int ClassifySvmSharedCommand::execute() {
     if (abort == true) { if (calledHelp) { return 0; }  return 2;   }
 
     InputData input(sharedfile, "sharedfile");
+    input.setLabels(labels);
     vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
 
     //read design file
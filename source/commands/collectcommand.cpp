@@ -460,6 +460,7 @@ int CollectCommand::execute(){
 			if (cDisplays.size() == 0) { return 0; }
 			
 			input = new InputData(inputFileNames[p], format);
+			input->setLabels(labels);
 			order = input->getOrderVector();
 			string lastLabel = order->getLabel();
 			
@@ -503,6 +503,7 @@ int CollectSharedCommand::execute(){
 		for(int i=0;i<cDisplays.size();i++){	cDisplays[i]->setAll(all);	}	
 	
 		input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		order = input->getSharedOrderVector();
 		string lastLabel = order->getLabel();
 		
@@ -17,6 +17,7 @@
 #include "optionparser.h"
 #include "validparameter.h"
 #include "mothurout.h"
+#include "performancetrace.h"
 #include "commandparameter.h"
 
 
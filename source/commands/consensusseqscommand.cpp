@@ -315,6 +315,7 @@ int ConsensusSeqsCommand::execute(){
 			
             
 			InputData* input = new InputData(listfile, "list");
+			input->setLabels(labels);
 			ListVector* list = input->getListVector();
 			
 			string lastLabel = list->getLabel();
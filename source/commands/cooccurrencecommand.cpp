@@ -16,6 +16,7 @@ vector<string> CooccurrenceCommand::setParameters() {
 		CommandParameter pmetric("metric", "Multiple", "cscore-checker-combo-vratio", "cscore", "", "", "","",false,false); parameters.push_back(pmetric);
 		CommandParameter pmatrix("matrixmodel", "Multiple", "sim1-sim2-sim3-sim4-sim5-sim6-sim7-sim8-sim9", "sim2", "", "", "","",false,false); parameters.push_back(pmatrix);
         CommandParameter pruns("iters", "Number", "", "1000", "", "", "","",false,false); parameters.push_back(pruns);
+        CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -35,9 +36,10 @@ vector<string> CooccurrenceCommand::setParameters() {
 string CooccurrenceCommand::getHelpString(){	
 	try {
 		string helpString = "The cooccurrence command calculates four metrics and tests their significance to assess whether presence-absence patterns are different than what one would expect by chance.";
-        helpString += "The cooccurrence command parameters are shared, metric, matrixmodel, iters, label and groups.";
+        helpString += "The cooccurrence command parameters are shared, metric, matrixmodel, iters, processors, label and groups.";
         helpString += "The matrixmodel parameter options are sim1, sim2, sim3, sim4, sim5, sim6, sim7, sim8 and sim9. Default=sim2";
         helpString += "The metric parameter options are cscore, checker, combo and vratio. Default=cscore";
+        helpString += "The processors parameter allows you to specify the number of processors to use. The iters are divided between the processors, with sim9 each processor runs its own swap chain. Default=1.\n";
         helpString += "The label parameter is used to analyze specific labels in your input.\n";
 		helpString += "The groups parameter allows you to specify which of the groups you would like analyzed.\n";
         helpString += "The cooccurrence command should be in the following format: \n";
@@ -167,6 +169,10 @@ CooccurrenceCommand::CooccurrenceCommand(string option) {
             
             string temp = validParameter.validFile(parameters, "iters", false);			if (temp == "not found") { temp = "1000"; }
 			m->mothurConvert(temp, runs); 
+            
+            temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
 
 		}
 
@@ -184,6 +190,7 @@ int CooccurrenceCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 		
 		InputData* input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		vector<SharedRAbundVector*> lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
@@ -322,7 +329,6 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
        
         vector<double> stats;
         vector<double> probabilityMatrix; probabilityMatrix.resize(ncols * nrows, 0);
-        vector<vector<int> > nullmatrix(nrows, vector<int>(ncols, 0));
        
         TrialSwap2 trial;
         
@@ -425,19 +431,149 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
         
         m->mothurOut("Initial c score: " + toString(initscore)); m->mothurOutEndLine();
         
+        createProcesses(co_matrix, rowtotal, columntotal, probabilityMatrix, stats);
+        if (m->control_pressed) { return 0; }
+        
+        double total = 0.0;
+        for (int i=0; i<stats.size();i++) { total+=stats[i]; }
+        
+        double nullMean = double (total/(double)stats.size());
+        
+        m->mothurOutEndLine(); m->mothurOut("average metric score: " + toString(nullMean)); m->mothurOutEndLine();
+        
+        //calc_p_value is not a statistical p-value, it's just the average that are either > or < the initscore.
+        //All it does is show what is expected in a competitively structured community
+        //zscore is output so p-value can be looked up in a ztable
+        double pvalue = 0.0;
+        if (metric == "cscore" || metric == "checker") { pvalue = trial.calc_pvalue_greaterthan (stats, initscore); }
+        else{ pvalue = trial.calc_pvalue_lessthan (stats, initscore); }
+
+        double sd = trial.getSD((int)stats.size(), stats, nullMean);
+
+        double zscore = trial.get_zscore(sd, nullMean, initscore);
+        
+        m->mothurOut("zscore: " + toString(zscore)); m->mothurOutEndLine();
+        m->mothurOut("standard deviation: " + toString(sd)); m->mothurOutEndLine();
+        m->mothurOut("non-parametric p-value: " + toString(pvalue)); m->mothurOutEndLine();
+        out << metric << '\t' << thisLookUp[0]->getLabel() << '\t' << nullMean << '\t' << zscore << '\t' << sd << '\t' << pvalue << endl;
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CooccurrenceCommand", "Cooccurrence");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//**********************************************************************************************************************
+int CooccurrenceCommand::createProcesses(vector<vector<int> >& co_matrix, vector<int>& rowtotal, vector<int>& columntotal, vector<double>& probabilityMatrix, vector<double>& stats){
+    try {
+        int numProcessors = processors;
+        if (numProcessors > runs) { numProcessors = runs; }
+        if (numProcessors < 1) { numProcessors = 1; }
+        
+        //divide the runs between the processors
+        vector<int> numRuns(numProcessors, runs / numProcessors);
+        for (int i = 0; i < (runs % numProcessors); i++) { numRuns[i]++; }
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        //each process gets its own seed so the chains are independent
+        vector<unsigned int> seeds;
+        if (numProcessors > 1) { for (int i = 0; i < numProcessors; i++) { seeds.push_back(rand()); } }
+        
+        int process = 1;
+        vector<int> processIDS;
+        
+        //loop through and create all the processes you want
+        while (process != numProcessors) {
+            pid_t pid = fork();
+            
+            if (pid > 0) {
+                processIDS.push_back(pid);
+                process++;
+            }else if (pid == 0){
+                srand(seeds[process]);
+                vector<double> processStats;
+                driver(co_matrix, rowtotal, columntotal, probabilityMatrix, numRuns[process], processStats);
+                
+                //pass stats to parent
+                ofstream out;
+                string tempFile = outputDir + m->mothurGetpid(process) + ".cooccurrence.temp";
+                m->openOutputFile(tempFile, out);
+                out << setprecision(20) << processStats.size() << endl;
+                for (int i = 0; i < processStats.size(); i++) { out << processStats[i] << endl; }
+                out.close();
+                
+                exit(0);
+            }else {
+                m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+                exit(0);
+            }
+        }
+        
+        //do my part
+        if (numProcessors > 1) { srand(seeds[0]); }
+        driver(co_matrix, rowtotal, columntotal, probabilityMatrix, numRuns[0], stats);
+        
+        //force parent to wait until all the processes are done
+        for (int i=0;i<processIDS.size();i++) {
+            int temp = processIDS[i];
+            wait(&temp);
+        }
+        
+        //pool the stats in process order
+        for (int i = 0; i < processIDS.size(); i++) {
+            ifstream in;
+            string tempFile = outputDir + toString(processIDS[i]) + ".cooccurrence.temp";
+            m->openInputFile(tempFile, in);
+            
+            int num = 0;
+            in >> num; m->gobble(in);
+            for (int j = 0; j < num; j++) {
+                double score; in >> score; m->gobble(in);
+                stats.push_back(score);
+            }
+            in.close(); m->mothurRemove(tempFile);
+        }
+#else
+        driver(co_matrix, rowtotal, columntotal, probabilityMatrix, runs, stats);
+#endif
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CooccurrenceCommand", "createProcesses");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//builds numRuns null matrices and scores them. co_matrix is a copy so sim2 and sim9 can shuffle and swap it
+int CooccurrenceCommand::driver(vector<vector<int> > co_matrix, vector<int>& rowtotal, vector<int>& columntotal, vector<double>& probabilityMatrix, int numRuns, vector<double>& stats){
+    try {
+        int nrows = rowtotal.size();
+        int ncols = columntotal.size();
+        int n = accumulate( columntotal.begin(), columntotal.end(), 0 );
+        vector<vector<int> > nullmatrix(nrows, vector<int>(ncols, 0));
+        
+        TrialSwap2 trial;
+        
         double previous;
         double current;
         double randnum;
         int count;
 
-        //burn-in for sim9    
+        //burn-in for sim9, each process runs its own chain
+        SwapChain chain;
         if(matrix == "sim9") {
-            for(int i=0;i<10000;i++) trial.swap_checkerboards (co_matrix, ncols, nrows);
+            trial.start_chain(chain, co_matrix, rowtotal, ncols, nrows);
+            for(int i=0;i<10000;i++) { trial.swap_checkerboards(chain); if (m->control_pressed) { return 0; } }
+            trial.track_pairs(chain);
         }
 
         //populate null matrix from probability matrix, do this a lot.
-        for(int k=0;k<runs;k++){
-            nullmatrix.clear();
+        for(int k=0;k<numRuns;k++){
+            if (m->control_pressed) { return 0; }
             //zero-fill the null matrix
             nullmatrix.assign(nrows, vector<int>(ncols, 0));
             
@@ -515,10 +651,12 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
                 }
             }
             
-            //swap_checkerboards takes the original matrix and swaps checkerboards
+            //swap_checkerboards takes the original matrix and swaps checkerboards, the chain keeps its scores up to date
             else if(matrix == "sim9") {
-                trial.swap_checkerboards (co_matrix, ncols, nrows);
-                nullmatrix = co_matrix;
+                trial.swap_checkerboards(chain);
+                if (metric == "cscore") { stats.push_back(trial.calc_c_score(chain)); continue; }
+                else if (metric == "checker") { stats.push_back(trial.calc_checker(chain)); continue; }
+                for(int i=0;i<nrows;i++) { for(int j=0;j<ncols;j++) { nullmatrix[i][j] = chain.matrix.get(i, j); } }
             }
             else {
                 m->mothurOut("[ERROR]: No null model selected!\n\n"); m->control_pressed = true;
@@ -545,38 +683,11 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
             
         }
         
-        
-        
-        double total = 0.0;
-        for (int i=0; i<stats.size();i++) { total+=stats[i]; }
-        
-        double nullMean = double (total/(double)stats.size());
-        
-        m->mothurOutEndLine(); m->mothurOut("average metric score: " + toString(nullMean)); m->mothurOutEndLine();
-        
-        //calc_p_value is not a statistical p-value, it's just the average that are either > or < the initscore.
-        //All it does is show what is expected in a competitively structured community
-        //zscore is output so p-value can be looked up in a ztable
-        double pvalue = 0.0;
-        if (metric == "cscore" || metric == "checker") { pvalue = trial.calc_pvalue_greaterthan (stats, initscore); }
-        else{ pvalue = trial.calc_pvalue_lessthan (stats, initscore); }
-
-        double sd = trial.getSD(runs, stats, nullMean);
-
-        double zscore = trial.get_zscore(sd, nullMean, initscore);
-        
-        m->mothurOut("zscore: " + toString(zscore)); m->mothurOutEndLine();
-        m->mothurOut("standard deviation: " + toString(sd)); m->mothurOutEndLine();
-        m->mothurOut("non-parametric p-value: " + toString(pvalue)); m->mothurOutEndLine();
-        out << metric << '\t' << thisLookUp[0]->getLabel() << '\t' << nullMean << '\t' << zscore << '\t' << sd << '\t' << pvalue << endl;
-        
         return 0;
     }
     catch(exception& e) {
-        m->errorOut(e, "CooccurrenceCommand", "Cooccurrence");
+        m->errorOut(e, "CooccurrenceCommand", "driver");
         exit(1);
     }
 }
 //**********************************************************************************************************************
-
-
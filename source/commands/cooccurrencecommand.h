@@ -44,9 +44,11 @@ private:
     bool abort, allLines;
     set<string> labels;
     vector<string> outputNames, Groups;
-    int runs;
+    int runs, processors;
     
     int getCooccurrence(vector<SharedRAbundVector*>&, ofstream&);
+    int createProcesses(vector<vector<int> >&, vector<int>&, vector<int>&, vector<double>&, vector<double>&);
+    int driver(vector<vector<int> >, vector<int>&, vector<int>&, vector<double>&, int, vector<double>&); //matrix, rowtotal, columntotal, probabilityMatrix, runs, stats
 	
 };
 
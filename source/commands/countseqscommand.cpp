@@ -221,6 +221,7 @@ int CountSeqsCommand::execute(){
             variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(sharedfile));
             
             InputData input(sharedfile, "sharedfile");
+            input.setLabels(labels);
             vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
             string lastLabel = lookup[0]->getLabel();
             
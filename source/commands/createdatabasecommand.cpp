@@ -613,6 +613,7 @@ ListVector* CreateDatabaseCommand::getList(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input->setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((list != NULL) && (userLabels.size() != 0)) {
@@ -690,6 +691,7 @@ vector<SharedRAbundVector*> CreateDatabaseCommand::getShared(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input.setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((lookup[0] != NULL) && (userLabels.size() != 0)) {
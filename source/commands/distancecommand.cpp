@@ -272,6 +272,7 @@ int DistanceCommand::execute(){
 			outputTypes["phylip"].push_back(outputFile);
 		}
 
+		PerformanceTrace::getInstance()->startPhase("compute");
 		//if you don't need to fork anything
 		if(processors == 1){
 			if (output != "square") {  driver(0, numSeqs, outputFile, cutoff); }
@@ -279,6 +280,7 @@ int DistanceCommand::execute(){
 		}else{ //you have multiple processors
 			createProcesses(outputFile, numSeqs);
 		}
+		PerformanceTrace::getInstance()->endPhase("compute");
 
 		if (m->control_pressed) { outputTypes.clear();  m->mothurRemove(outputFile); return 0; }
 		
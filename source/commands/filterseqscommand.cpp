@@ -282,7 +282,7 @@ int FilterSeqsCommand::execute() {
 		
 		m->mothurOutEndLine();  m->mothurOutEndLine();
 		
-		if (m->control_pressed) { outputTypes.clear(); return 0; }
+		if (m->control_pressed) { outputTypes.clear(); removeFlatFiles(); return 0; }
 		
 		ofstream outFilter;
 		
@@ -302,6 +302,7 @@ int FilterSeqsCommand::execute() {
 		m->mothurOut("Running Filter... "); m->mothurOutEndLine();
 		
 		filterSequences();
+		removeFlatFiles();
 		
 		m->mothurOutEndLine();	m->mothurOutEndLine();
 					
@@ -353,6 +354,20 @@ int FilterSeqsCommand::filterSequences() {
                 variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(fastafileNames[s]));
 				string filteredFasta = getOutputFileName("fasta", variables);
             
+		#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+            //createFilter already parsed this file, so filter the records it flattened instead of re-reading the fasta
+            map<int, vector<string> >::iterator itFlat = flatFiles.find(s);
+            if (itFlat != flatFiles.end()) {
+                if ((itFlat->second).size() == 1)   {   numSeqs += driverRunFlatFilter(filteredFasta, (itFlat->second)[0]);          }
+                else                                {   numSeqs += createProcessesRunFlatFilter(itFlat->second, filteredFasta);    }
+                
+                if (m->control_pressed) {  return 1; }
+                
+                outputNames.push_back(filteredFasta); outputTypes["fasta"].push_back(filteredFasta);
+                continue;
+            }
+		#endif
+            
             vector<unsigned long long> positions;
             if (savedPositions.size() != 0) { positions = savedPositions[s]; }
             else {
@@ -439,8 +454,8 @@ int FilterSeqsCommand::driverRunFilter(string F, string outputFilename, string i
 				
 				Sequence seq(in); m->gobble(in);
 				if (seq.getName() != "") {
-					string align = seq.getAligned();
-					string filterSeq = "";
+					const string& align = seq.getAligned();
+					string filterSeq = ""; filterSeq.reserve(align.length());
 					
 					for(int j=0;j<alignmentLength;j++){
 						if(filter[j] == '1'){
@@ -673,16 +688,19 @@ string FilterSeqsCommand::createFilter() {
 				}	
 				
 				if(processors == 1){
-					int numFastaSeqs = driverCreateFilter(F, fastafileNames[s], lines[0]);
+					int numFastaSeqs = driverCreateFilter(F, fastafileNames[s], lines[0], getFlatFileName(fastafileNames[s], 0));
 					numSeqs += numFastaSeqs;
 				}else{
 					int numFastaSeqs = createProcessesCreateFilter(F, fastafileNames[s]); 
 					numSeqs += numFastaSeqs;
 				}
+                
+                //one flattened file per chunk, lines may have been redivided if we could not spawn all the processes
+                for (int i = 0; i < lines.size(); i++) { flatFiles[s].push_back(getFlatFileName(fastafileNames[s], i)); }
 		#else
                 if(processors == 1){
                     lines.push_back(new linePair(0, 1000));
-                    int numFastaSeqs = driverCreateFilter(F, fastafileNames[s], lines[0]);
+                    int numFastaSeqs = driverCreateFilter(F, fastafileNames[s], lines[0], "");
                     numSeqs += numFastaSeqs;
 				}else {
                     int numFastaSeqs = 0;
@@ -722,11 +740,15 @@ string FilterSeqsCommand::createFilter() {
 	}
 }
 /**************************************************************************************/
-int FilterSeqsCommand::driverCreateFilter(Filters& F, string filename, linePair* filePos) {	
+int FilterSeqsCommand::driverCreateFilter(Filters& F, string filename, linePair* filePos, string flatFile) {	
 	try {
 		
 		ifstream in;
 		m->openInputFile(filename, in);
+        
+        //save each parsed record as name and packed alignment lines so the run filter pass does not need to parse the fasta again
+        ofstream outFlat;
+        if (flatFile != "") { m->openOutputFile(flatFile, outFlat); }
 				
 		in.seekg(filePos->start);
         
@@ -739,7 +761,7 @@ int FilterSeqsCommand::driverCreateFilter(Filters& F, string filename, linePair*
         
 		while (!done) {
 				
-			if (m->control_pressed) { in.close(); return 1; }
+			if (m->control_pressed) { in.close(); if (flatFile != "") { outFlat.close(); } return 1; }
 					
 			Sequence seq(in); m->gobble(in);
 			if (seq.getName() != "") {
@@ -748,6 +770,7 @@ int FilterSeqsCommand::driverCreateFilter(Filters& F, string filename, linePair*
 					
 					if(trump != '*')			{	F.doTrump(seq);		}
 					if(m->isTrue(vertical) || soft != 0)	{	F.getFreqs(seq);	}
+                    if (flatFile != "")         {   outFlat << seq.getName() << '\n' << packGaps(seq.getAligned()) << '\n'; }
 					cout.flush();
 					count++;
 			}
@@ -765,6 +788,7 @@ int FilterSeqsCommand::driverCreateFilter(Filters& F, string filename, linePair*
 		//report progress
 		if((count) % 100 != 0){	m->mothurOutJustToScreen(toString(count)+"\n"); 	}
 		in.close();
+        if (flatFile != "") { outFlat.close(); }
 		
         if (error) { m->control_pressed = true; }
         
@@ -801,7 +825,7 @@ int FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string filename)
 				F.c.clear(); F.c.resize(alignmentLength, 0);
 				F.gap.clear(); F.gap.resize(alignmentLength, 0);
 				
-				num = driverCreateFilter(F, filename, lines[process]);
+				num = driverCreateFilter(F, filename, lines[process], getFlatFileName(filename, process));
 				
 				//write out filter counts to file
 				filename += m->mothurGetpid(process) + "filterValues.temp";
@@ -831,6 +855,7 @@ int FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string filename)
                 m->control_pressed = false;
                 for (int i=0;i<processIDS.size();i++) {
                     m->mothurRemove(filename + (toString(processIDS[i]) + "filterValues.temp"));
+                    m->mothurRemove(getFlatFileName(filename, i+1));
                 }
                 recalc = true;
                 break;
@@ -867,7 +892,7 @@ int FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string filename)
                     F.c.clear(); F.c.resize(alignmentLength, 0);
                     F.gap.clear(); F.gap.resize(alignmentLength, 0);
                     
-                    num = driverCreateFilter(F, filename, lines[process]);
+                    num = driverCreateFilter(F, filename, lines[process], getFlatFileName(filename, process));
                     
                     //write out filter counts to file
                     filename += m->mothurGetpid(process) + "filterValues.temp";
@@ -896,7 +921,7 @@ int FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string filename)
 
         
 		//parent do your part
-		num = driverCreateFilter(F, filename, lines[0]);
+		num = driverCreateFilter(F, filename, lines[0], getFlatFileName(filename, 0));
 		
 		//force parent to wait until all the processes are done
 		for (int i=0;i<(processors-1);i++) { 
@@ -982,3 +1007,170 @@ int FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string filename)
 	}
 }
 /**************************************************************************************/
+int FilterSeqsCommand::driverRunFlatFilter(string outputFilename, string flatFile) {
+	try {
+		ofstream out;
+		m->openOutputFile(outputFilename, out);
+		
+		ifstream in;
+		m->openInputFile(flatFile, in, "noerror");
+		
+		int count = 0;
+		string name, align;
+		
+		while (getline(in, name) && getline(in, align)) {
+			
+			if (m->control_pressed) { in.close(); out.close(); return 0; }
+			
+			//unpack the runs of gaps as we go, a run is the gap followed by its length
+			string filterSeq = "";
+			int column = 0;
+			for (int j = 0; (j < align.length()) && (column < alignmentLength); j++) {
+				char base = align[j];
+				int runLength = 1;
+				if (((align[j] == '-') || (align[j] == '.')) && ((j+1) < align.length()) && isdigit(align[j+1])) {
+					runLength = 0;
+					while (((j+1) < align.length()) && isdigit(align[j+1])) { runLength = (runLength * 10) + (align[j+1] - '0'); j++; }
+				}
+				
+				for (int k = 0; (k < runLength) && (column < alignmentLength); k++) {
+					if (filter[column] == '1') { filterSeq += base; }
+					column++;
+				}
+			}
+			
+			out << '>' << name << endl << filterSeq << endl;
+			count++;
+			
+			//report progress
+			if((count) % 100 == 0){	m->mothurOutJustToScreen(toString(count)+"\n"); 	}
+		}
+		//report progress
+		if((count) % 100 != 0){	m->mothurOutJustToScreen(toString(count)+"\n"); 		}
+		
+		out.close();
+		in.close();
+		
+		return count;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FilterSeqsCommand", "driverRunFlatFilter");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//most columns of an alignment are gaps, so runs of 3 or more are written as the gap and the length of the run
+string FilterSeqsCommand::packGaps(string aligned) {
+	try {
+		string packed = ""; packed.reserve(aligned.length());
+		
+		int i = 0;
+		while (i < aligned.length()) {
+			int end = i + 1;
+			if ((aligned[i] == '-') || (aligned[i] == '.')) { while ((end < aligned.length()) && (aligned[end] == aligned[i])) { end++; } }
+			
+			if ((end - i) < 3) { packed += aligned.substr(i, end - i); }
+			else { packed += aligned[i]; packed += toString(end - i); }
+			i = end;
+		}
+		
+		return packed;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FilterSeqsCommand", "packGaps");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//each chunk was flattened by the process that built its part of the filter, so the chunks are already divided
+int FilterSeqsCommand::createProcessesRunFlatFilter(vector<string>& flatChunks, string filteredFastaName) {
+	try {
+		int num = 0;
+		
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		int process = 1;
+		processIDS.clear();
+		
+		//loop through and create all the processes you want
+		while (process < flatChunks.size()) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);
+				process++;
+			}else if (pid == 0){
+				num = driverRunFlatFilter(flatChunks[process] + ".filtered.temp", flatChunks[process]);
+				
+				//pass numSeqs to parent
+				ofstream out;
+				string tempFile = flatChunks[process] + ".num.temp";
+				m->openOutputFile(tempFile, out);
+				out << num << endl;
+				out.close();
+				
+				exit(0);
+			}else { 
+				m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, the parent will filter the remaining chunks.\n");
+				break;
+			}
+		}
+		
+		num = driverRunFlatFilter(filteredFastaName, flatChunks[0]);
+		
+		//parent does any chunks we could not spawn a process for
+		for (int i = process; i < flatChunks.size(); i++) {
+			num += driverRunFlatFilter(flatChunks[i] + ".filtered.temp", flatChunks[i]);
+		}
+		
+		//force parent to wait until all the processes are done
+		for (int i=0;i<processIDS.size();i++) { 
+			int temp = processIDS[i];
+			wait(&temp);
+		}
+		
+		for (int i = 1; i < process; i++) {
+			ifstream in;
+			string tempFile = flatChunks[i] + ".num.temp";
+			m->openInputFile(tempFile, in);
+			if (!in.eof()) { int tempNum = 0; in >> tempNum; num += tempNum; }
+			in.close(); m->mothurRemove(tempFile);
+		}
+		
+		//append in chunk order so the output matches the input order
+		for (int i = 1; i < flatChunks.size(); i++) {
+			m->appendFiles((flatChunks[i] + ".filtered.temp"), filteredFastaName);
+			m->mothurRemove((flatChunks[i] + ".filtered.temp"));
+		}
+#endif
+		
+		return num;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FilterSeqsCommand", "createProcessesRunFlatFilter");
+		exit(1);
+	}
+}
+/**************************************************************************************/
+string FilterSeqsCommand::getFlatFileName(string filename, int chunk) {
+	try {
+		return (filename + "." + toString(chunk) + ".flat.temp");
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FilterSeqsCommand", "getFlatFileName");
+		exit(1);
+	}
+}
+/**************************************************************************************/
+void FilterSeqsCommand::removeFlatFiles() {
+	try {
+		for (map<int, vector<string> >::iterator it = flatFiles.begin(); it != flatFiles.end(); it++) {
+			for (int i = 0; i < (it->second).size(); i++) { m->mothurRemove((it->second)[i]); }
+		}
+		flatFiles.clear();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FilterSeqsCommand", "removeFlatFiles");
+		exit(1);
+	}
+}
+/**************************************************************************************/
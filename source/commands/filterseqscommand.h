@@ -38,6 +38,7 @@ private:
 	vector<linePair*> lines;
 	vector<int> processIDS;
     map<int, vector<unsigned long long> > savedPositions;
+    map<int, vector<string> > flatFiles; //per fasta file, the flattened records written while creating the filter, with runs of gaps packed
 
 	string vertical, filter, fasta, hard, outputDir, filterFileName;
 	vector<string> fastafileNames;	
@@ -55,7 +56,12 @@ private:
 	int createProcessesCreateFilter(Filters&, string);
 	int createProcessesRunFilter(string, string, string);
 	int driverRunFilter(string, string, string, linePair*);
-	int driverCreateFilter(Filters& F, string filename, linePair* line);
+	int driverCreateFilter(Filters& F, string filename, linePair* line, string flatFile);
+	int createProcessesRunFlatFilter(vector<string>&, string);
+	int driverRunFlatFilter(string, string);
+	string getFlatFileName(string, int);
+	string packGaps(string);
+	void removeFlatFiles();
 	
 };
 
@@ -207,8 +213,8 @@ static DWORD WINAPI MyRunFilterThreadFunction(LPVOID lpParam){
 			
 			Sequence seq(in); pDataArray->m->gobble(in);
             if (seq.getName() != "") {
-                string align = seq.getAligned();
-                string filterSeq = "";
+                const string& align = seq.getAligned();
+                string filterSeq = ""; filterSeq.reserve(align.length());
                 
                 for(int j=0;j<pDataArray->alignmentLength;j++){
                     if(pDataArray->filter[j] == '1'){
@@ -227,6 +227,7 @@ int FilterSharedCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 		
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
 		vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
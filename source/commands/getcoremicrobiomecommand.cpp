@@ -220,6 +220,7 @@ int GetCoreMicroBiomeCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
         
         InputData input(inputFileName, format);
+        input.setLabels(labels);
         vector<SharedRAbundFloatVector*> lookup = input.getSharedRAbundFloatVectors();
         string lastLabel = lookup[0]->getLabel();
         
@@ -695,6 +695,7 @@ int GetLineageCommand::getListVector(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input.setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((list != NULL) && (userLabels.size() != 0)) {
@@ -842,6 +843,7 @@ int GetLineageCommand::getShared(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input.setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((lookup[0] != NULL) && (userLabels.size() != 0)) {
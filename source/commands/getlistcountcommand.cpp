@@ -158,6 +158,7 @@ int GetListCountCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 		
 		input = new InputData(listfile, "list");
+		input->setLabels(labels);
 		list = input->getListVector();
 		string lastLabel = list->getLabel();
 
@@ -53,7 +53,7 @@ string GetMetaCommunityCommand::getHelpString(){
 		helpString += "The minpartitions parameter is used to .... Default=5.\n";
         helpString += "The maxpartitions parameter is used to .... Default=10.\n";
         helpString += "The optimizegap parameter is used to .... Default=3.\n";
-        helpString += "The processors parameter allows you to specify number of processors to use.  The default is 1.\n";
+        helpString += "The processors parameter allows you to specify number of processors to use. The partitions are divided between the processors and the results don't depend on the number of processors. The default is 1.\n";
 		helpString += "The get.communitytype command should be in the following format: get.communitytype(shared=yourSharedFile).\n";
 		return helpString;
 	}
@@ -169,10 +169,7 @@ GetMetaCommunityCommand::GetMetaCommunityCommand(string option)  {
 			m->mothurConvert(temp, optimizegap);
             
             temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
-			//set processors to 1 until we figure out whats going on with this command.
-            temp = "1";
-            //m->setProcessors(temp);
-            m->mothurOut("Using 1 processor\n");
+			m->setProcessors(temp);
 			m->mothurConvert(temp, processors);
             
             string groups = validParameter.validFile(parameters, "groups", false);
@@ -233,6 +230,7 @@ int GetMetaCommunityCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
         
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
         vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
         string lastLabel = lookup[0]->getLabel();
         
@@ -354,11 +352,10 @@ int GetMetaCommunityCommand::execute(){
 int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislookup){
 	try {
         
-        //#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-       // #else
-        //until bug is resolved
-        processors=1; //qFinderDMM not thread safe
-        //#endif
+        #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        #else
+        processors=1;
+        #endif
         
         vector<int> processIDS;
 		int process = 1;
@@ -368,6 +365,10 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 		//sanity check
 		if (maxpartitions < processors) { processors = maxpartitions; }
         
+        //each partition gets its own seed, so its fit is the same whichever process runs it
+        partitionSeeds.assign(maxpartitions+1, 0);
+        for (int i=1; i<=maxpartitions; i++) { partitionSeeds[i] = rand(); }
+        
         map<string, string> variables;
         variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(sharedfile));
         variables["[distance]"] = thislookup[0]->getLabel();
@@ -378,7 +379,7 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 		//divide the partitions between the processors
 		vector< vector<int> > dividedPartitions;
         vector< vector<string> > rels, matrix;
-        vector<string> doneFlags;
+        vector<string> doneFlags, relNames, matrixNames;
         dividedPartitions.resize(processors);
         rels.resize(processors);
         matrix.resize(processors);
@@ -398,6 +399,7 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             string mName = getOutputFileName("matrix", variables);
             rels[(processToAssign-1)].push_back(relName);
             matrix[(processToAssign-1)].push_back(mName);
+            relNames.push_back(relName); matrixNames.push_back(mName);
         }
         
         for (int i = 0; i < processors; i++) { //read from everyone elses, just write to yours
@@ -476,22 +478,33 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             m->mothurRemove(outputFileName + toString(processIDS[i]));
         }
         
-        if (processors > 1) { 
+        if (processors > 1) {
+            //find where running the partitions in order would have stopped, some processes may have gone past it
+            map<int, double> scores;
+            readScores(doneFlags, scores);
+            int stopPartition = findStopPartition(scores, minPartition);
+            if (stopPartition == 0) { stopPartition = maxpartitions; }
+            
+            set<string> removeNames;
+            for (int i = stopPartition; i < maxpartitions; i++) { removeNames.insert(relNames[i]); removeNames.insert(matrixNames[i]); }
+            
             outputNames.clear();
-            for (int i = 0; i < tempOutputNames.size(); i++) { //remove files if needed
-                string name = tempOutputNames[i];
-                vector<string> parts;
-                m->splitAtChar(name, parts, '.');
-                bool keep = true;
-                if (((parts[parts.size()-1] == "relabund") || (parts[parts.size()-1] == "posterior")) && (parts[parts.size()-2] == "mix")) {
-                    string tempNum = parts[parts.size()-3];
-                    int num;  m->mothurConvert(tempNum, num);
-                    //if (num > minPartition) {
-                     //   m->mothurRemove(tempOutputNames[i]);
-                    //    keep = false; if (m->debug) { m->mothurOut("[DEBUG]: removing " + tempOutputNames[i] + ".\n"); }
-                    //}
-                }
-                if (keep) { outputNames.push_back(tempOutputNames[i]); }
+            set<string> written;
+            for (int i = 0; i < tempOutputNames.size(); i++) {
+                if (removeNames.count(tempOutputNames[i]) != 0) { m->mothurRemove(tempOutputNames[i]); }
+                else { outputNames.push_back(tempOutputNames[i]); written.insert(tempOutputNames[i]); }
+            }
+            
+            //the other processes' files are not in outputTypes
+            set<string> partitionNames(relNames.begin(), relNames.end());
+            partitionNames.insert(matrixNames.begin(), matrixNames.end());
+            vector<string> keepRels, keepMatrix;
+            for (int i = 0; i < outputTypes["relabund"].size(); i++) { if (partitionNames.count(outputTypes["relabund"][i]) == 0) { keepRels.push_back(outputTypes["relabund"][i]); } }
+            for (int i = 0; i < outputTypes["matrix"].size(); i++) { if (partitionNames.count(outputTypes["matrix"][i]) == 0) { keepMatrix.push_back(outputTypes["matrix"][i]); } }
+            outputTypes["relabund"] = keepRels; outputTypes["matrix"] = keepMatrix;
+            for (int i = 0; i < stopPartition; i++) {
+                if (written.count(matrixNames[i]) != 0) { outputTypes["matrix"].push_back(matrixNames[i]); }
+                if (written.count(relNames[i]) != 0) { outputTypes["relabund"].push_back(relNames[i]); }
             }
             
             //reorder fit file
@@ -512,8 +525,9 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             m->openOutputFile(outputFileName, out);
             out << headers << endl;
             for (map<int, string>::iterator it = file.begin(); it != file.end(); it++) {
-                out << it->first << '\t' << it->second << endl;
-                if (m->debug) { m->mothurOut("[DEBUG]: printing: " + toString(it->first) + '\t' + it->second + ".\n"); }
+                if (it->first > stopPartition) { break; }
+                out << it->first << it->second << endl;
+                m->mothurOut(toString(it->first) + it->second + "\n");
             }
             out.close();
         }
@@ -570,6 +584,8 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
         
         cout.setf(ios::fixed, ios::floatfield);
         cout.setf(ios::showpoint);
+        
+        map<int, double> scores, myScores; //laplace or ch index of each partition
 
         vector< vector<int> > sharedMatrix;
         vector<string> thisGroups;
@@ -596,18 +612,16 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
             
             if (m->control_pressed) { break; }
             
-            //check to see if anyone else is done
-            for (int j = 0; j < doneFlags.size(); j++) {
-                if (!m->isBlank(doneFlags[j])) { //another process has finished
-                    //are they done at a lower partition?
-                    ifstream in;
-                    m->openInputFile(doneFlags[j], in);
-                    int tempNum;
-                    in >> tempNum; in.close();
-                    if (tempNum < numPartitions) { break; } //quit, because someone else has finished
-                }
+            //check to see if the partitions the other processes finished already stop the search below this one
+            if (processors > 1) {
+                readScores(doneFlags, scores);
+                int bestPartition;
+                int stopPartition = findStopPartition(scores, bestPartition);
+                if ((stopPartition != 0) && (stopPartition < numPartitions)) { break; }
             }
             
+            srand(partitionSeeds[numPartitions]);
+            
             CommunityTypeFinder* finder = NULL;
             if (method == "dmm")            {   finder = new qFinderDMM(sharedMatrix, numPartitions);   }
             else if (method == "kmeans")    {   finder = new KMeans(sharedMatrix, numPartitions);       }
@@ -630,6 +644,7 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
                     minPartition = numPartitions;
                     minLaplace = laplace;
                 }
+                myScores[numPartitions] = laplace;
             }else {
                 chi = finder->calcCHIndex(dists);
                 silhouettes = finder->calcSilhouettes(dists);
@@ -638,15 +653,18 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
                     minLaplace = chi;
                     minSilhouettes = silhouettes;
                 }
+                myScores[numPartitions] = chi;
             }
+            writeScores(doneFlags[processID], myScores);
             
+            //with several processes the parent prints the fit data in order once they are done
             if (method == "dmm") {
-                finder->printFitData(cout, minLaplace);
+                if (processors == 1) { finder->printFitData(cout, minLaplace); }
                 finder->printFitData(fitData);
                 finder->printRelAbund(relabund, m->currentSharedBinLabels);
                 outputNames.push_back(relabund); outputTypes["relabund"].push_back(relabund);
             }else if ((method == "pam") || (method == "kmeans")) { //print silouettes and ch values
-                finder->printSilData(cout, chi, silhouettes);
+                if (processors == 1) { finder->printSilData(cout, chi, silhouettes); }
                 finder->printSilData(silData, chi, silhouettes);
                 if (method == "kmeans") {
                     finder->printRelAbund(relabund, m->currentSharedBinLabels);
@@ -655,12 +673,7 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
             }
             delete finder;
             
-            if(optimizegap != -1 && (numPartitions - minPartition) >= optimizegap && numPartitions >= minpartitions){
-                string tempDoneFile = m->getRootName(m->getSimpleName(sharedfile)) + toString(processID) + ".done.temp";
-                ofstream outDone;
-                m->openOutputFile(tempDoneFile, outDone);
-                outDone << minPartition << endl;
-                outDone.close();
+            if((processors == 1) && optimizegap != -1 && (numPartitions - minPartition) >= optimizegap && numPartitions >= minpartitions){
                 break;
             }
         }
@@ -676,6 +689,87 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
 	}
 }
 /**************************************************************************************************/
+//returns the partition running the partitions in order stops at and the best partition up to it, or 0 if it
+//doesn't stop at any of the partitions scored so far. partitions after a gap in the scores are not looked at
+
+int GetMetaCommunityCommand::findStopPartition(map<int, double>& scores, int& minPartition){
+	try {
+        double minLaplace = 1e10;
+        if ((method == "pam") || (method == "kmeans")) { minLaplace = 0; }
+        minPartition = 1;
+        
+        for (int numPartitions = 1; scores.count(numPartitions) != 0; numPartitions++) {
+            double score = scores[numPartitions];
+            if (method == "dmm") {
+                if (score < minLaplace) { minPartition = numPartitions; minLaplace = score; }
+            }else {
+                if (score > minLaplace) { minPartition = numPartitions; minLaplace = score; }
+            }
+            
+            if(optimizegap != -1 && (numPartitions - minPartition) >= optimizegap && numPartitions >= minpartitions){
+                return numPartitions;
+            }
+        }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetMetaCommunityCommand", "findStopPartition");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+int GetMetaCommunityCommand::readScores(vector<string>& doneFlags, map<int, double>& scores){
+	try {
+        for (int i = 0; i < doneFlags.size(); i++) {
+            if (m->isBlank(doneFlags[i])) { continue; }
+            
+            ifstream in;
+            m->openInputFile(doneFlags[i], in);
+            while (!in.eof()) {
+                if (m->control_pressed) { break; }
+                
+                int numPartitions; string score;
+                in >> numPartitions >> score;
+                if (in.fail()) { break; }
+                scores[numPartitions] = strtod(score.c_str(), NULL); //nan and inf too
+                m->gobble(in);
+            }
+            in.close();
+        }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetMetaCommunityCommand", "readScores");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//written to a temp file and renamed so the other processes never read part of it
+
+int GetMetaCommunityCommand::writeScores(string doneFlag, map<int, double>& scores){
+	try {
+        string tempFile = doneFlag + ".temp";
+        ofstream out;
+        m->openOutputFile(tempFile, out);
+        out << setprecision(17);
+        for (map<int, double>::iterator it = scores.begin(); it != scores.end(); it++) {
+            out << it->first << '\t' << it->second << endl;
+        }
+        out.close();
+        
+        rename(tempFile.c_str(), doneFlag.c_str());
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetMetaCommunityCommand", "writeScores");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 
 vector<double> GetMetaCommunityCommand::generateDesignFile(int numPartitions, map<string,string> variables){
     try {
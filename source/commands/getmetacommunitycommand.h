@@ -86,11 +86,15 @@ private:
     int minpartitions, maxpartitions, optimizegap, processors, iters, subsampleSize;
     vector<string> Groups, Estimators;
     set<string> labels;
+    vector<int> partitionSeeds;     //[numPartitions] so a partition's fit doesn't depend on which process runs it
     
     vector<vector<double> > generateDistanceMatrix(vector<SharedRAbundVector*>& lookup);
     int driver(vector<SharedRAbundVector*> thisLookup, vector< vector<seqDist> >& calcDists, Calculator*);
     int processDriver(vector<SharedRAbundVector*>&, vector<int>&, string, vector<string>, vector<string>, vector<string>, int);
     int createProcesses(vector<SharedRAbundVector*>&);
+    int findStopPartition(map<int, double>&, int&);
+    int readScores(vector<string>&, map<int, double>&);
+    int writeScores(string, map<int, double>&);
     vector<double> generateDesignFile(int, map<string,string>);
     int generateSummaryFile(int, map<string,string>, vector<double>);
 
@@ -574,6 +574,7 @@ int GetOtuLabelsCommand::readList(){
 int GetOtuLabelsCommand::getListVector(){
 	try {
 		InputData input(listfile, "list");
+		input.setLabels(labels);
 		list = input.getListVector();
 		string lastLabel = list->getLabel();
 		
@@ -649,6 +650,7 @@ int GetOtuLabelsCommand::getListVector(){
 int GetOtuLabelsCommand::getShared(){
 	try {
 		InputData input(sharedfile, "sharedfile");
+		input.setLabels(labels);
 		lookup = input.getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
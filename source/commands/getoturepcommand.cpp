@@ -54,6 +54,7 @@ vector<string> GetOTURepCommand::setParameters(){
 		CommandParameter psorted("sorted", "Multiple", "none-name-bin-size-group", "none", "", "", "","",false,false); parameters.push_back(psorted);
         CommandParameter pmethod("method", "Multiple", "distance-abundance", "distance", "", "", "","",false,false); parameters.push_back(pmethod);
 		CommandParameter plarge("large", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(plarge);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -71,7 +72,7 @@ vector<string> GetOTURepCommand::setParameters(){
 string GetOTURepCommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The get.oturep command parameters are phylip, column, list, fasta, name, group, count, large, weighted, cutoff, precision, groups, sorted, method and label.  The list parameter is required, as well as phylip or column and name if you are using method=distance. If method=abundance a name or count file is required.\n";
+		helpString += "The get.oturep command parameters are phylip, column, list, fasta, name, group, count, large, weighted, cutoff, precision, groups, sorted, method, processors and label.  The list parameter is required, as well as phylip or column and name if you are using method=distance. If method=abundance a name or count file is required.\n";
 		helpString += "The label parameter allows you to select what distance levels you would like a output files created for, and is separated by dashes.\n";
 		helpString += "The phylip or column parameter is required for method=distance, but only one may be used.  If you use a column file the name or count filename is required. \n";
         helpString += "The method parameter allows you to select the method of selecting the representative sequence. Choices are distance and abundance.  The distance method finds the sequence with the smallest maximum distance to the other sequences. If tie occurs the sequence with smallest average distance is selected.  The abundance method chooses the most abundant sequence in the OTU as the representative.\n";
@@ -80,6 +81,7 @@ string GetOTURepCommand::getHelpString(){
 		helpString += "Example get.oturep(phylip=amazon.dist, fasta=amazon.fasta, list=amazon.fn.list, group=amazon.groups).\n";
 		helpString += "The default value for label is all labels in your inputfile.\n";
 		helpString += "The sorted parameter allows you to indicate you want the output sorted. You can sort by sequence name, bin number, bin size or group. The default is no sorting, but your options are name, number, size, or group.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use when method=distance. The OTUs are divided between the processors. The default is 1.\n";
 		helpString += "The large parameter allows you to indicate that your distance matrix is too large to fit in RAM.  The default value is false.\n";
 		helpString += "The weighted parameter allows you to indicate that want to find the weighted representative. You must provide a namesfile to set weighted to true.  The default value is false.\n";
 		helpString += "The representative is found by selecting the sequence that has the smallest total distance to all other sequences in the OTU. If a tie occurs the smallest average distance is used.\n";
@@ -383,6 +385,10 @@ GetOTURepCommand::GetOTURepCommand(string option)  {
 			temp = validParameter.validFile(parameters, "cutoff", false);			if (temp == "not found") { temp = "10.0"; }
 			m->mothurConvert(temp, cutoff); 
 			cutoff += (5 / (precision * 10.0));
+			
+			temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
 		}
 	}
 	catch(exception& e) {
@@ -434,6 +440,7 @@ int GetOTURepCommand::execute(){
         if (list != NULL) { delete list; }
         
         InputData input(listfile, "list");
+        input.setLabels(labels);
         list = input.getListVector();
         string lastLabel = list->getLabel();
         
@@ -609,15 +616,13 @@ int GetOTURepCommand::readDist() {
 			// via the index of a sequence in the distance matrix
 			seqVec = vector<SeqMap>(list->size()); 
             for (int i = 0; i < matrix->seqVec.size(); i++) {
+                if (m->control_pressed) { delete readMatrix; return 0; }
                 for (int j = 0; j < matrix->seqVec[i].size(); j++) {
-                    if (m->control_pressed) { delete readMatrix; return 0; }
                     //already added everyone else in row
-                    if (i < matrix->seqVec[i][j].index) {  seqVec[i][matrix->seqVec[i][j].index] = matrix->seqVec[i][j].dist;  }
+                    if (i < matrix->seqVec[i][j].index) {  seqVec[i].push_back(matrix->seqVec[i][j]);  }
                 }
 			}
-			//add dummy map for unweighted calc
-			SeqMap dummy;
-			seqVec.push_back(dummy);
+			rowEntry.assign(seqVec.size(), -1);
 			
 			delete matrix;
 			delete readMatrix;
@@ -651,7 +656,7 @@ int GetOTURepCommand::readDist() {
 			//positions in file where the distances for each sequence begin
 			//rowPositions[1] = position in file where distance related to sequence 1 start.
 			rowPositions = formatMatrix->getRowPositions();
-			rowPositions.push_back(-1); //dummy row for unweighted calc
+			rowEntry.assign(rowPositions.size(), -1);
 			
 			delete formatMatrix;
 			delete nameMap;
@@ -815,118 +820,272 @@ string GetOTURepCommand::findRepAbund(vector<string> names, string group) {
 	}
 }
 //**********************************************************************************************************************
-string GetOTURepCommand::findRep(vector<string> names, string group) {
+//finds the representative of each otu, or of each group in an otu for groups
+int GetOTURepCommand::findReps(vector< vector<string> >& names, vector<string>& groups, vector<string>& reps) {
+	try {
+		reps.clear();
+		
+		//if using abundance 
+		if (method == "abundance") {
+			for (int i = 0; i < names.size(); i++) {
+				if (m->control_pressed) { return 0; }
+				reps.push_back(findRepAbund(names[i], groups[i]));
+			}
+			return 0;
+		}
+		
+		//look up the rows of the sequences once, so the processes only compare distances
+		vector<repJob> jobs(names.size());
+		for (int i = 0; i < names.size(); i++) {
+			if (m->control_pressed) { return 0; }
+			
+			// if only 1 sequence in bin or processing the "unique" label, then
+			// the first sequence of the OTU is the representative one
+			if (names[i].size() > 1) { getRepJob(names[i], groups[i], jobs[i]); }
+		}
+		
+		if (m->control_pressed) { return 0; }
+		
+		vector<int> repIndexes;
+		createProcesses(jobs, repIndexes);
+		
+		if (m->control_pressed) { return 0; }
+		
+		for (int i = 0; i < names.size(); i++) { reps.push_back(names[i][repIndexes[i]]); }
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "findReps");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//sequences using the same row in the distance matrix have the same distances, so they are stored once and weighted
+bool GetOTURepCommand::getRepJob(vector<string>& names, string group, repJob& job) {
 	try{
-        //if using abundance 
-        if (method == "abundance") { return (findRepAbund(names, group)); }
-        else { //find rep based on distance
-            
-            // if only 1 sequence in bin or processing the "unique" label, then
-            // the first sequence of the OTU is the representative one
-            if ((names.size() == 1)) {
-                return names[0];
-            }else{
-                vector<int> seqIndex; //(names.size());
-                map<string, string>::iterator itNameFile;
-                map<string, int>::iterator itNameIndex;
-                
-                //fill seqIndex and initialize sums
-                for (size_t i = 0; i < names.size(); i++) {
-                    if (weighted) {
-                        seqIndex.push_back(nameToIndex[names[i]]);
-                        if (countfile != "") {  //if countfile is not blank then we can assume the list file contains only uniques, otherwise we assume list file contains everyone.
-                            int numRep = 0;
-                            if (group != "") {  numRep = ct.getGroupCount(names[i], group);  }
-                            else { numRep = ct.getNumSeqs(names[i]);  }
-                            for (int j = 1; j < numRep; j++) { //don't add yourself again
-                                seqIndex.push_back(nameToIndex[names[i]]);
-                            }
-                        }
-                    }else {
-                        if (namefile == "") {
-                            itNameIndex = nameToIndex.find(names[i]);
-                            
-                            if (itNameIndex == nameToIndex.end()) { // you are not in the distance file and no namesfile, then assume you are not unique
-                                if (large) {  seqIndex.push_back((rowPositions.size()-1)); }
-                                else {  seqIndex.push_back((seqVec.size()-1)); }
-                            }else {
-                                seqIndex.push_back(itNameIndex->second);
-                            }
-                            
-                        }else {
-                            itNameFile = nameFileMap.find(names[i]);
-                            
-                            if (itNameFile == nameFileMap.end()) {
-                                m->mothurOut("[ERROR]: " + names[i] + " is not in your namefile, please correct."); m->mothurOutEndLine(); m->control_pressed = true;
-                            }else{
-                                string name1 = itNameFile->first;
-                                string name2 = itNameFile->second;
-                                
-                                if (name1 == name2) { //then you are unique so add your real dists
-                                    seqIndex.push_back(nameToIndex[names[i]]);
-                                }else { //add dummy
-                                    if (large) {  seqIndex.push_back((rowPositions.size()-1)); }
-                                    else {  seqIndex.push_back((seqVec.size()-1)); }
-                                }
-                            }
-                        }
-                    }
-                }
-                
-                vector<float> max_dist(seqIndex.size(), 0.0);
-                vector<float> total_dist(seqIndex.size(), 0.0);
-                
-                // loop through all entries in seqIndex
-                SeqMap::iterator it;
-                SeqMap currMap;
-                for (size_t i=0; i < seqIndex.size(); i++) {
-                    if (m->control_pressed) {  return  "control"; }
-                    
-                    if (!large) {	currMap = seqVec[seqIndex[i]];  }
-                    else		{	currMap = getMap(seqIndex[i]);	}
-                    
-                    for (size_t j=0; j < seqIndex.size(); j++) {
-                        it = currMap.find(seqIndex[j]);
-                        if (it != currMap.end()) {
-                            max_dist[i] = max(max_dist[i], it->second);
-                            max_dist[j] = max(max_dist[j], it->second);
-                            total_dist[i] += it->second;
-                            total_dist[j] += it->second;
-                        }else{ //if you can't find the distance make it the cutoff
-                            max_dist[i] = max(max_dist[i], cutoff);
-                            max_dist[j] = max(max_dist[j], cutoff);
-                            total_dist[i] += cutoff;
-                            total_dist[j] += cutoff;
-                        }
-                    }
-                }
-                
-                // sequence with the smallest maximum distance is the representative
-                //if tie occurs pick sequence with smallest average distance
-                float min = 10000;
-                int minIndex;
-                for (size_t i=0; i < max_dist.size(); i++) {
-                    if (m->control_pressed) {  return  "control"; }
-                    if (max_dist[i] < min) {
-                        min = max_dist[i];
-                        minIndex = i;
-                    }else if (max_dist[i] == min) {
-                        float currentAverage = total_dist[minIndex] / (float) total_dist.size();
-                        float newAverage = total_dist[i] / (float) total_dist.size();
-                        
-                        if (newAverage < currentAverage) {
-                            min = max_dist[i];
-                            minIndex = i;
-                        }
-                    }
-                }
-                
-                return(names[minIndex]);
-            }
-        }
+		job.rows.clear(); job.weights.clear(); job.firsts.clear();
+		
+		int dummyEntry = -1;
+		bool good = true;
+		map<string, string>::iterator itNameFile;
+		map<string, int>::iterator itNameIndex;
+		
+		for (int i = 0; i < names.size(); i++) {
+			int row = -1; int weight = 1;
+			itNameIndex = nameToIndex.find(names[i]);
+			
+			if (weighted) {
+				if (itNameIndex != nameToIndex.end()) { row = itNameIndex->second; }
+				if (countfile != "") {  //if countfile is not blank then we can assume the list file contains only uniques, otherwise we assume list file contains everyone.
+					if (group != "") {  weight = ct.getGroupCount(names[i], group);  }
+					else { weight = ct.getNumSeqs(names[i]);  }
+					if (weight < 1) { weight = 1; }
+				}
+			}else if (namefile == "") {
+				// you are not in the distance file and no namesfile, then assume you are not unique
+				if (itNameIndex != nameToIndex.end()) { row = itNameIndex->second; }
+			}else {
+				itNameFile = nameFileMap.find(names[i]);
+				
+				if (itNameFile == nameFileMap.end()) {
+					m->mothurOut("[ERROR]: " + names[i] + " is not in your namefile, please correct."); m->mothurOutEndLine(); m->control_pressed = true; good = false;
+					continue;
+				}else if (itNameFile->first == itNameFile->second) { //then you are unique so add your real dists
+					if (itNameIndex != nameToIndex.end()) { row = itNameIndex->second; }
+				}
+			}
+			
+			int entry = dummyEntry;
+			if (row != -1) { entry = rowEntry[row]; }
+			
+			if (entry == -1) { //first sequence using this row
+				entry = job.rows.size();
+				job.rows.push_back(row); job.weights.push_back(0); job.firsts.push_back(i);
+				if (row != -1) { rowEntry[row] = entry; }
+				else { dummyEntry = entry; }
+			}
+			job.weights[entry] += weight;
+		}
+		
+		for (int i = 0; i < job.rows.size(); i++) { if (job.rows[i] != -1) { rowEntry[job.rows[i]] = -1; } }
+		
+		return good;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "getRepJob");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//returns the index in the otu's names of the "representative" sequence
+int GetOTURepCommand::findRepIndex(repJob& job) {
+	try{
+		int numEntries = job.rows.size();
+		if (numEntries < 2) { return 0; }
+		
+		for (int i = 0; i < numEntries; i++) { if (job.rows[i] != -1) { rowEntry[job.rows[i]] = i; } }
+		
+		int totalWeight = 0;
+		for (int i = 0; i < numEntries; i++) { totalWeight += job.weights[i]; }
+		
+		vector<float> max_dist(numEntries, 0.0);
+		vector<float> total_dist(numEntries, 0.0);
+		vector<float> dists(numEntries, cutoff); //if you can't find the distance make it the cutoff
+		
+		// loop through all entries
+		SeqMap emptyRow, fileRow;
+		for (int i = 0; i < numEntries; i++) {
+			if (m->control_pressed) { break; }
+			
+			SeqMap* currRow = &emptyRow;
+			if (job.rows[i] != -1) {
+				if (!large) {	currRow = &seqVec[job.rows[i]];  }
+				else		{	fileRow = getMap(job.rows[i]); currRow = &fileRow;	}
+			}
+			
+			//distances from this row to the otu's entries
+			for (int k = 0; k < currRow->size(); k++) {
+				ull index = (*currRow)[k].index;
+				if (index < rowEntry.size()) { if (rowEntry[index] != -1) { dists[rowEntry[index]] = (*currRow)[k].dist; } }
+			}
+			
+			for (int j = 0; j < numEntries; j++) {
+				max_dist[i] = max(max_dist[i], dists[j]);
+				max_dist[j] = max(max_dist[j], dists[j]);
+				total_dist[i] += job.weights[j] * dists[j];
+				total_dist[j] += job.weights[i] * dists[j];
+			}
+			
+			for (int k = 0; k < currRow->size(); k++) {
+				ull index = (*currRow)[k].index;
+				if (index < rowEntry.size()) { if (rowEntry[index] != -1) { dists[rowEntry[index]] = cutoff; } }
+			}
+		}
+		
+		for (int i = 0; i < numEntries; i++) { if (job.rows[i] != -1) { rowEntry[job.rows[i]] = -1; } }
+		
+		if (m->control_pressed) { return 0; }
+		
+		// sequence with the smallest maximum distance is the representative
+		//if tie occurs pick sequence with smallest average distance
+		float min = 10000;
+		int minIndex = 0;
+		for (int i = 0; i < numEntries; i++) {
+			if (max_dist[i] < min) {
+				min = max_dist[i];
+				minIndex = i;
+			}else if (max_dist[i] == min) {
+				float currentAverage = total_dist[minIndex] / (float) totalWeight;
+				float newAverage = total_dist[i] / (float) totalWeight;
+				
+				if (newAverage < currentAverage) {
+					min = max_dist[i];
+					minIndex = i;
+				}
+			}
+		}
+		
+		return job.firsts[minIndex];
 	}
 	catch(exception& e) {
-		m->errorOut(e, "GetOTURepCommand", "FindRep");
+		m->errorOut(e, "GetOTURepCommand", "findRepIndex");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int GetOTURepCommand::createProcesses(vector<repJob>& jobs, vector<int>& repIndexes) {
+	try {
+		repIndexes.assign(jobs.size(), 0);
+		
+		int numProcessors = processors;
+		if (numProcessors > jobs.size()) { numProcessors = jobs.size(); }
+		if (numProcessors < 1) { numProcessors = 1; }
+		
+		//divide the otus between the processors, an otu with n rows compares n*n distances
+		double totalWork = 0;
+		for (int i = 0; i < jobs.size(); i++) { totalWork += (double) jobs[i].rows.size() * jobs[i].rows.size(); }
+		
+		vector<int> starts(numProcessors+1, jobs.size()); starts[0] = 0;
+		int process = 1;
+		double work = 0;
+		for (int i = 0; i < jobs.size(); i++) {
+			while ((process < numProcessors) && (work >= (totalWork * process / (double) numProcessors))) { starts[process] = i; process++; }
+			work += (double) jobs[i].rows.size() * jobs[i].rows.size();
+		}
+		
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		process = 1;
+		vector<int> processIDS;
+		
+		//loop through and create all the processes you want
+		while (process != numProcessors) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);
+				process++;
+			}else if (pid == 0){
+				//the formatted matrix is read by seeking, so each process needs its own file position
+				if (large) { inRow.close(); m->openInputFile(distFile, inRow); }
+				
+				driver(jobs, starts[process], starts[process+1], repIndexes);
+				
+				//pass reps to parent
+				ofstream out;
+				string tempFile = outputDir + m->mothurGetpid(process) + ".oturep.temp";
+				m->openOutputFile(tempFile, out);
+				for (int i = starts[process]; i < starts[process+1]; i++) { out << repIndexes[i] << endl; }
+				out.close();
+				
+				exit(0);
+			}else {
+				m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+				for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+				exit(0);
+			}
+		}
+		
+		//do my part
+		driver(jobs, starts[0], starts[1], repIndexes);
+		
+		//force parent to wait until all the processes are done
+		for (int i=0;i<processIDS.size();i++) {
+			int temp = processIDS[i];
+			wait(&temp);
+		}
+		
+		for (int i = 0; i < processIDS.size(); i++) {
+			ifstream in;
+			string tempFile = outputDir + toString(processIDS[i]) + ".oturep.temp";
+			m->openInputFile(tempFile, in);
+			
+			for (int j = starts[i+1]; j < starts[i+2]; j++) { in >> repIndexes[j]; }
+			
+			in.close(); m->mothurRemove(tempFile);
+		}
+#else
+		driver(jobs, 0, jobs.size(), repIndexes);
+#endif
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "createProcesses");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int GetOTURepCommand::driver(vector<repJob>& jobs, int start, int end, vector<int>& repIndexes) {
+	try {
+		for (int i = start; i < end; i++) {
+			if (m->control_pressed) { break; }
+			repIndexes[i] = findRepIndex(jobs[i]);
+		}
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "driver");
 		exit(1);
 	}
 }
@@ -942,7 +1101,7 @@ int GetOTURepCommand::process(ListVector* processList) {
 				
 		ofstream newNamesOutput;
 		string outputNamesFile;
-		map<string, string> files; //group -> filenameAW
+		map<string, ofstream*> files; //group -> file
 		
         map<string, string> variables; 
         variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(listfile));
@@ -963,7 +1122,6 @@ int GetOTURepCommand::process(ListVector* processList) {
 			for (int i=0; i<Groups.size(); i++) {
                 variables["[tag]"] = processList->getLabel();
                 variables["[group]"] = Groups[i];
-				outputNamesFile = outputDir + m->getRootName(m->getSimpleName(listfile)) + processList->getLabel() + "." + Groups[i] + ".";
                 if (countfile == "") { 
                     outputNamesFile = getOutputFileName("name", variables);
                     outputNames.push_back(outputNamesFile); outputTypes["name"].push_back(outputNamesFile); 
@@ -971,41 +1129,29 @@ int GetOTURepCommand::process(ListVector* processList) {
                     outputNamesFile = getOutputFileName("count", variables);
                     outputNames.push_back(outputNamesFile); outputTypes["count"].push_back(outputNamesFile); 
                 }
-				files[Groups[i]] = outputNamesFile;
-                ofstream temp;
-				m->openOutputFile(outputNamesFile, temp);
-                temp << Groups[i] << endl; temp.close();
+                ofstream* temp = new ofstream();
+				m->openOutputFile(outputNamesFile, *temp);
+                *temp << Groups[i] << endl;
+				files[Groups[i]] = temp;
 				outputNameFiles[outputNamesFile] = processList->getLabel() + "." + Groups[i];
 			}
 		}
 		
-		//for each bin in the list vector
+		//find the sequences of each bin, or of each group in each bin
         vector<string> binLabels = processList->getLabels();
+        vector< vector<string> > repNames;
+        vector<string> repGroups;
+        vector<int> repBins;
 		for (int i = 0; i < processList->size(); i++) {
         
-			if (m->control_pressed) { out.close(); if (Groups.size() == 0) { newNamesOutput.close(); } return 0; }
+			if (m->control_pressed) { break; }
 			
 			string temp = processList->get(i);
 			vector<string> namesInBin;
 			m->splitAtComma(temp, namesInBin);
 			
 			if (Groups.size() == 0) {
-				nameRep = findRep(namesInBin, "");
-				newNamesOutput << binLabels[i] << '\t' << nameRep << '\t';
-                
-                //put rep at first position in names line
-                string outputString = nameRep + ",";
-                for (int k=0; k<namesInBin.size()-1; k++) {//output list of names in this otu
-                    if (namesInBin[k] != nameRep) { outputString += namesInBin[k] + ","; }
-                }
-                
-                //output last name
-                if (namesInBin[namesInBin.size()-1] != nameRep) { outputString += namesInBin[namesInBin.size()-1]; }
-                
-                if (outputString[outputString.length()-1] == ',') { //rip off comma
-                    outputString = outputString.substr(0, outputString.length()-1);
-                }
-                newNamesOutput << outputString << endl;
+				repNames.push_back(namesInBin); repGroups.push_back(""); repBins.push_back(i);
 			}else{
 				map<string, vector<string> > NamesInGroup;
 				for (int j=0; j<Groups.size(); j++) { //initialize groups
@@ -1030,34 +1176,46 @@ int GetOTURepCommand::process(ListVector* processList) {
 				//get rep for each group in otu
 				for (int j=0; j<Groups.size(); j++) {
 					if (NamesInGroup[Groups[j]].size() != 0) { //are there members from this group in this otu?
-						//get rep for each group
-						nameRep = findRep(NamesInGroup[Groups[j]], Groups[j]);
-						
-						//output group rep and other members of this group
-                        ofstream outGroup;
-                        m->openOutputFileAppend(files[Groups[j]], outGroup);
-						outGroup << binLabels[i] << '\t' << nameRep << '\t';
-						
-                        //put rep at first position in names line
-                        string outputString = nameRep + ",";
-                        for (int k=0; k<NamesInGroup[Groups[j]].size()-1; k++) {//output list of names in this otu from this group
-                            if (NamesInGroup[Groups[j]][k] != nameRep) { outputString +=  NamesInGroup[Groups[j]][k] + ","; }
-                        }
-                        
-                        //output last name
-                        if (NamesInGroup[Groups[j]][NamesInGroup[Groups[j]].size()-1] != nameRep) { outputString += NamesInGroup[Groups[j]][NamesInGroup[Groups[j]].size()-1]; }
-                        
-                        if (outputString[outputString.length()-1] == ',') { //rip off comma
-                            outputString = outputString.substr(0, outputString.length()-1);
-                        }
-                        outGroup << outputString << endl; outGroup.close();
+						repNames.push_back(NamesInGroup[Groups[j]]); repGroups.push_back(Groups[j]); repBins.push_back(i);
 					}
 				}
 			}
 		}
 		
+		vector<string> reps;
+		if (!m->control_pressed) { findReps(repNames, repGroups, reps); }
+		
+		for (int i = 0; i < reps.size(); i++) {
+			if (m->control_pressed) { break; }
+			
+			nameRep = reps[i];
+			vector<string>& namesInRep = repNames[i];
+			
+			//output group rep and other members of this group
+			ofstream* outRep = &newNamesOutput;
+			if (Groups.size() != 0) { outRep = files[repGroups[i]]; }
+			*outRep << binLabels[repBins[i]] << '\t' << nameRep << '\t';
+			
+			//put rep at first position in names line
+			string outputString = nameRep + ",";
+			for (int k=0; k<namesInRep.size()-1; k++) {//output list of names in this otu
+				if (namesInRep[k] != nameRep) { outputString += namesInRep[k] + ","; }
+			}
+			
+			//output last name
+			if (namesInRep[namesInRep.size()-1] != nameRep) { outputString += namesInRep[namesInRep.size()-1]; }
+			
+			if (outputString[outputString.length()-1] == ',') { //rip off comma
+				outputString = outputString.substr(0, outputString.length()-1);
+			}
+			*outRep << outputString << endl;
+		}
+		
         //you don't want to use groups
 		if (Groups.size() == 0) { newNamesOutput.close(); }
+		else {
+			for (map<string, ofstream*>::iterator it = files.begin(); it != files.end(); it++) { (it->second)->close(); delete it->second; }
+		}
 		
 		return 0;
 
@@ -1298,8 +1456,7 @@ SeqMap GetOTURepCommand::getMap(int row) {
 			
 			for(int i = 0; i < numDists; i++) {
 				inRow >> colNum >> dist;
-				rowMap[colNum] = dist;
-				
+				rowMap.push_back(PDistCell(colNum, dist));
 			}
 		}
 		
@@ -20,7 +20,8 @@
 #include "formatmatrix.h"
 #include "counttable.h"
 
-typedef map<int, float> SeqMap;
+//distances of a sequence, index is the row of the other sequence in the distance matrix
+typedef vector<PDistCell> SeqMap;
 
 struct repStruct {
 		string name;
@@ -34,6 +35,13 @@ struct repStruct {
 		~repStruct() {}
 };
 
+//the sequences of an otu or of a group in an otu, sequences sharing a row in the distance matrix are stored once
+struct repJob {
+        vector<int> rows;       //row in the distance matrix, -1 if the sequence has no distances
+        vector<int> weights;    //number of sequences using the row
+        vector<int> firsts;     //index of the first sequence using the row in the otu's names
+};
+
 class GetOTURepCommand : public Command {
 
 public:
@@ -72,17 +80,22 @@ private:
 	vector<string> outputNames, Groups;
 	map<string, string> outputNameFiles;
 	float cutoff;
-	int precision;
+	int precision, processors;
 	vector<SeqMap> seqVec;			// contains maps with sequence index and distance
 									// for all distances related to a certain sequence
 	vector<int> rowPositions;
+	vector<int> rowEntry;           //entry in the current repJob using each row, -1 if none
 
 	void readNamesFile(FastaMap*&);
 	void readNamesFile(bool);
 	int process(ListVector*);
 	SeqMap getMap(int);
-	string findRep(vector<string>, string); 	// returns the name of the "representative" sequence of given bin or subset of a bin, for groups
     string findRepAbund(vector<string>, string);
+    int findReps(vector< vector<string> >&, vector<string>&, vector<string>&);
+    bool getRepJob(vector<string>&, string, repJob&);
+    int findRepIndex(repJob&);
+    int createProcesses(vector<repJob>&, vector<int>&);
+    int driver(vector<repJob>&, int, int, vector<int>&);
 	int processNames(string, string);
 	int processFastaNames(string, string, FastaMap*&);
     int readDist();
@@ -277,6 +277,7 @@ int GetOtusCommand::readListGroup(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input->setLabels(labels);
 		
 		bool wroteSomething = false;
 
@@ -214,6 +214,7 @@ int GetRAbundCommand::execute(){
             processList(out);
         }else {
             InputData input(inputfile, format);
+            input.setLabels(labels);
             RAbundVector* rabund = input.getRAbundVector();
             string lastLabel = rabund->getLabel();
             
@@ -323,6 +324,7 @@ int GetRAbundCommand::processList(ofstream& out){
         ct.readTable(countfile, false, false);
         
         InputData input(inputfile, format);
+        input.setLabels(labels);
         ListVector* list = input.getListVector();
         string lastLabel = list->getLabel();
         
@@ -178,6 +178,7 @@ int GetRelAbundCommand::execute(){
 		out.setf(ios::fixed, ios::floatfield); out.setf(ios::showpoint);
 		
 		input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
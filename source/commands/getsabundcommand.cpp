@@ -205,6 +205,7 @@ int GetSAbundCommand::execute(){
             processList(out);
         }else {
             InputData input(inputfile, format);
+            input.setLabels(labels);
             SAbundVector* sabund = input.getSAbundVector();
             string lastLabel = sabund->getLabel();
             
@@ -311,6 +312,7 @@ int GetSAbundCommand::processList(ofstream& out){
         ct.readTable(countfile, false, false);
         
         InputData input(inputfile, format);
+        input.setLabels(labels);
         ListVector* list = input.getListVector();
         string lastLabel = list->getLabel();
         
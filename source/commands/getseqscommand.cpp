@@ -12,6 +12,7 @@
 #include "listvector.hpp"
 #include "counttable.h"
 #include "fastqread.h"
+#include "sequenceindex.h"
 
 //**********************************************************************************************************************
 vector<string> GetSeqsCommand::setParameters(){	
@@ -27,6 +28,7 @@ vector<string> GetSeqsCommand::setParameters(){
 		CommandParameter pqfile("qfile", "InputTypes", "", "", "none", "FNGLT", "none","qfile",false,false); parameters.push_back(pqfile);
 		CommandParameter paccnos("accnos", "InputTypes", "", "", "none", "none", "none","",false,true,true); parameters.push_back(paccnos);
 		CommandParameter pdups("dups", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pdups);
+		CommandParameter pindex("index", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pindex);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
         CommandParameter pformat("format", "Multiple", "sanger-illumina-solexa-illumina1.8+", "illumina1.8+", "", "", "","",false,false,true); parameters.push_back(pformat);
@@ -48,8 +50,9 @@ string GetSeqsCommand::getHelpString(){
 		string helpString = "";
 		helpString += "The get.seqs command reads an .accnos file and any of the following file types: fasta, name, group, count, list, taxonomy, quality, fastq or alignreport file.\n";
 		helpString += "It outputs a file containing only the sequences in the .accnos file.\n";
-		helpString += "The get.seqs command parameters are accnos, fasta, name, group, list, taxonomy, qfile, alignreport, fastq and dups.  You must provide accnos unless you have a valid current accnos file, and at least one of the other parameters.\n";
+		helpString += "The get.seqs command parameters are accnos, fasta, name, group, list, taxonomy, qfile, alignreport, fastq, dups and index.  You must provide accnos unless you have a valid current accnos file, and at least one of the other parameters.\n";
 		helpString += "The dups parameter allows you to add the entire line from a name file if you add any name from the line. default=true. \n";
+		helpString += "The index parameter allows you to save an index of your fasta, qfile or fastq file next to it, so later commands only read the sequences they select. default=false. \n";
         helpString += "The format parameter is used to indicate whether your sequences are sanger, solexa, illumina1.8+ or illumina, default=illumina1.8+.\n";
 		helpString += "The get.seqs command should be in the following format: get.seqs(accnos=yourAccnos, fasta=yourFasta).\n";
 		helpString += "Example get.seqs(accnos=amazon.accnos, fasta=amazon.fasta).\n";
@@ -316,6 +319,9 @@ GetSeqsCommand::GetSeqsCommand(string option)  {
 			string temp = validParameter.validFile(parameters, "dups", false);	if (temp == "not found") { temp = "true"; usedDups = ""; }
 			dups = m->isTrue(temp);
             
+            temp = validParameter.validFile(parameters, "index", false);	if (temp == "not found") { temp = "false"; }
+            saveIndex = m->isTrue(temp);
+            
             format = validParameter.validFile(parameters, "format", false);		if (format == "not found"){	format = "illumina1.8+";	}
             
             if ((format != "sanger") && (format != "illumina") && (format != "illumina1.8+") && (format != "solexa"))  {
@@ -432,9 +438,6 @@ int GetSeqsCommand::readFastq(){
 		bool wroteSomething = false;
 		int selectedCount = 0;
         
-		ifstream in;
-		m->openInputFile(fastqfile, in);
-		
 		string thisOutputDir = outputDir;
 		if (outputDir == "") {  thisOutputDir += m->hasPath(fastqfile);  }
 		map<string, string> variables;
@@ -445,32 +448,7 @@ int GetSeqsCommand::readFastq(){
 		m->openOutputFile(outputFileName, out);
 
         set<string> uniqueNames;
-		while(!in.eof()){
-			
-			if (m->control_pressed) { in.close(); out.close(); m->mothurRemove(outputFileName); return 0; }
-			
-			//read sequence name
-            bool ignore;
-            FastqRead fread(in, ignore, format); m->gobble(in);
-            
-			if (!ignore) {
-                string name = fread.getName();
-                
-                if (names.count(name) != 0) {
-                    if (uniqueNames.count(name) == 0) { //this name hasn't been seen yet
-                        wroteSomething = true;
-                        selectedCount++;
-                        fread.printFastq(out);
-                        uniqueNames.insert(name);
-                    }else {
-                        m->mothurOut("[WARNING]: " + name + " is in your fastq file more than once.  Mothur requires sequence names to be unique. I will only add it once.\n");
-                    }
-                }
-            }
-            
-			m->gobble(in);
-		}
-		in.close();
+        selectedCount = selectIndexed(fastqfile, "fastq", out, uniqueNames, wroteSomething);
 		out.close();
         
 		if (wroteSomething == false) { m->mothurOut("Your file does not contain any sequence from the .accnos file."); m->mothurOutEndLine();  }
@@ -487,6 +465,41 @@ int GetSeqsCommand::readFastq(){
 	}
 }
 
+//**********************************************************************************************************************
+//writes the records of the file that are in names, with a saved index only those records are read
+int GetSeqsCommand::selectIndexed(string filename, string type, ofstream& out, set<string>& uniqueNames, bool& wroteSomething){
+	try {
+		int selectedCount = 0;
+		string fileWord = type + " file"; if (type == "qfile") { fileWord = "qfile"; }
+		
+		SequenceIndex index(filename, type, format, saveIndex);
+		string name;
+		while (index.getNext(name)) {
+			
+			if (m->control_pressed) { break; }
+			
+			if (names.count(name) != 0) {
+				if (uniqueNames.count(name) == 0) { //this name hasn't been seen yet
+					wroteSomething = true;
+					
+					index.print(out);
+					selectedCount++;
+					uniqueNames.insert(name);
+					
+					if (m->debug) { if (type == "fasta") { sanity["fasta"].insert(name); } else if (type == "qfile") { sanity["qual"].insert(name); } }
+				}else {
+					m->mothurOut("[WARNING]: " + name + " is in your " + fileWord + " more than once.  Mothur requires sequence names to be unique. I will only add it once.\n");
+				}
+			}
+		}
+		
+		return selectedCount;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GetSeqsCommand", "selectIndexed");
+		exit(1);
+	}
+}
 //**********************************************************************************************************************
 int GetSeqsCommand::readFasta(){
 	try {
@@ -509,7 +522,9 @@ int GetSeqsCommand::readFasta(){
         if (m->debug) { set<string> temp; sanity["fasta"] = temp; }
 		
         set<string> uniqueNames;
-		while(!in.eof()){
+        bool useIndex = (dups || (uniqueMap.size() == 0)); //names are not changed, so only the selected sequences need to be read
+        if (useIndex) { selectedCount = selectIndexed(fastafile, "fasta", out, uniqueNames, wroteSomething); }
+		while(!in.eof() && !useIndex){
 		
 			if (m->control_pressed) { in.close(); out.close(); m->mothurRemove(outputFileName);  return 0; }
 			
@@ -581,7 +596,9 @@ int GetSeqsCommand::readQual(){
         if (m->debug) { set<string> temp; sanity["qual"] = temp; }
 		
         set<string> uniqueNames;
-		while(!in.eof()){	
+        bool useIndex = (dups || (uniqueMap.size() == 0)); //names are not changed, so only the selected sequences need to be read
+        if (useIndex) { selectedCount = selectIndexed(qualfile, "qfile", out, uniqueNames, wroteSomething); }
+		while(!in.eof() && !useIndex){	
 			string saveName = "";
 			string name = "";
 			string scores = "";
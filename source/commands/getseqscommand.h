@@ -37,7 +37,7 @@ class GetSeqsCommand : public Command {
 		set<string> names;
 		vector<string> outputNames;
 		string accnosfile, accnosfile2, fastafile, fastqfile, namefile, countfile, groupfile, alignfile, listfile, taxfile, qualfile, outputDir, format;
-		bool abort, dups;
+		bool abort, dups, saveIndex;
         map<string, string> uniqueMap;
         //for debug
         map<string, set<string> > sanity; //maps file type to names chosen for file. something like "fasta" -> vector<string>. If running in debug mode this is filled and we check to make sure all the files have the same names. If they don't we output the differences for the user.
@@ -51,6 +51,7 @@ class GetSeqsCommand : public Command {
 		int readList();
 		int readTax();
 		int readQual();
+		int selectIndexed(string, string, ofstream&, set<string>&, bool&);
 		int compareAccnos();
         int runSanityCheck();
         int createMisMatchFile(ofstream&, string, string, set<string>, set<string>);
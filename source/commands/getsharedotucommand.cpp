@@ -613,6 +613,7 @@ int GetSharedOTUCommand::process(ListVector* shared) {
 int GetSharedOTUCommand::runShared() {
 	try {
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
 		vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
         
@@ -277,6 +277,7 @@ int HeatMapCommand::execute(){
 
 		string lastLabel;
 		input = new InputData(inputfile, format);
+		input->setLabels(labels);
 		
 		if (format == "sharedfile") {
 			//you have groups
@@ -356,6 +356,7 @@ int HeatMapSimCommand::runCommandShared() {
 		if (heatCalculators.size() == 0) { m->mothurOut("No valid calculators."); m->mothurOutEndLine(); return 0; }
 		
 		input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 			
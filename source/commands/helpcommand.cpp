@@ -154,6 +154,7 @@
 #include "renamefilecommand.h"
 #include "chimeravsearchcommand.h"
 #include "mergecountcommand.hpp"
+#include "makeotuindexcommand.h"
 
 
 //**********************************************************************************************************************
@@ -273,6 +274,7 @@ int HelpCommand::execute(){
                 else if(commandName == "remove.rare")			{	command = new RemoveRareCommand(optionString);				}
                 else if(commandName == "merge.groups")			{	command = new MergeGroupsCommand(optionString);				}
                 else if(commandName == "merge.count")			{	command = new MergeCountCommand(optionString);				}
+                else if(commandName == "make.otuindex")			{	command = new MakeOTUIndexCommand(optionString);				}
                 else if(commandName == "amova")					{	command = new AmovaCommand(optionString);					}
                 else if(commandName == "homova")				{	command = new HomovaCommand(optionString);					}
                 else if(commandName == "mantel")				{	command = new MantelCommand(optionString);					}
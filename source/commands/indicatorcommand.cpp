@@ -1000,6 +1000,7 @@ int IndicatorCommand::getShared(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input->setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((lookup[0] != NULL) && (userLabels.size() != 0)) {
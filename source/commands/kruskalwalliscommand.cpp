@@ -179,6 +179,7 @@ int KruskalWallisCommand::execute(){
         if (mclass == "") {  mclass = designMap.getDefaultClass(); m->mothurOut("\nYou did not provide a class, using " + mclass +".\n\n"); }
         
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
         vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
         string lastLabel = lookup[0]->getLabel();
         
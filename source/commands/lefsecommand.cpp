@@ -296,6 +296,7 @@ int LefseCommand::execute(){
         }
         
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
         vector<SharedRAbundFloatVector*> lookup = input.getSharedRAbundFloatVectors();
         string lastLabel = lookup[0]->getLabel();
         
@@ -205,6 +205,7 @@ int ListOtuLabelsCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
         
         InputData input(inputFileName, format);
+        input.setLabels(labels);
         
         if (format == "relabund") {
             vector<SharedRAbundFloatVector*> lookup = input.getSharedRAbundFloatVectors();
@@ -344,15 +344,16 @@ int MakeBiomCommand::execute(){
         
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
         
-        vector<SharedRAbundVector*> lookup;
+        SharedOTUTable* table = NULL;
         vector<SharedRAbundFloatVector*> lookupRel;
         string lastLabel;
         
 		InputData input(inputFileName, fileFormat);
+		input.setLabels(labels);
         if (fileFormat == "sharedfile") {
-            lookup = input.getSharedRAbundVectors();
-            lastLabel = lookup[0]->getLabel();
-            getSampleMetaData(lookup);
+            table = input.getSharedOTUTable();
+            lastLabel = table->getLabel();
+            getSampleMetaData(table->getGroups());
         }else                        {
             lookupRel = input.getSharedRAbundFloatVectors();
             lastLabel = lookupRel[0]->getLabel();
@@ -372,40 +373,40 @@ int MakeBiomCommand::execute(){
         if (fileFormat == "sharedfile") {
             
             //as long as you are not at the end of the file or done wih the lines you want
-            while((lookup[0] != NULL) && ((allLines == 1) || (userLabels.size() != 0))) {
+            while((table != NULL) && ((allLines == 1) || (userLabels.size() != 0))) {
                 
-                if (m->control_pressed) { for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }  return 0; }
+                if (m->control_pressed) { for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } delete table;  return 0; }
                 
-                if(allLines == 1 || labels.count(lookup[0]->getLabel()) == 1){
+                if(allLines == 1 || labels.count(table->getLabel()) == 1){
                     
-                    m->mothurOut(lookup[0]->getLabel()); m->mothurOutEndLine();
-                    getBiom(lookup);
+                    m->mothurOut(table->getLabel()); m->mothurOutEndLine();
+                    getBiom(table);
                     
-                    processedLabels.insert(lookup[0]->getLabel());
-                    userLabels.erase(lookup[0]->getLabel());
+                    processedLabels.insert(table->getLabel());
+                    userLabels.erase(table->getLabel());
                 }
                 
-                if ((m->anyLabelsToProcess(lookup[0]->getLabel(), userLabels, "") == true) && (processedLabels.count(lastLabel) != 1)) {
-                    string saveLabel = lookup[0]->getLabel();
+                if ((m->anyLabelsToProcess(table->getLabel(), userLabels, "") == true) && (processedLabels.count(lastLabel) != 1)) {
+                    string saveLabel = table->getLabel();
                     
-                    for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
-                    lookup = input.getSharedRAbundVectors(lastLabel);
-                    m->mothurOut(lookup[0]->getLabel()); m->mothurOutEndLine();
+                    delete table;
+                    table = input.getSharedOTUTable(lastLabel);
+                    m->mothurOut(table->getLabel()); m->mothurOutEndLine();
                     
-                    getBiom(lookup);
+                    getBiom(table);
                     
-                    processedLabels.insert(lookup[0]->getLabel());
-                    userLabels.erase(lookup[0]->getLabel());
+                    processedLabels.insert(table->getLabel());
+                    userLabels.erase(table->getLabel());
                     
                     //restore real lastlabel to save below
-                    lookup[0]->setLabel(saveLabel);
+                    table->setLabel(saveLabel);
                 }
                 
-                lastLabel = lookup[0]->getLabel();
+                lastLabel = table->getLabel();
                 
                 //prevent memory leak and get next set
-                for (int i = 0; i < lookup.size(); i++) {  delete lookup[i]; lookup[i] = NULL; }
-                lookup = input.getSharedRAbundVectors();				
+                delete table;
+                table = input.getSharedOTUTable();
             }
         }else {
             
@@ -449,6 +450,8 @@ int MakeBiomCommand::execute(){
         
         if (m->control_pressed) { for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); }  return 0; }     
         
+        if (table != NULL) { delete table; table = NULL; }
+        
 		//output error messages about any remaining user labels
 		set<string>::iterator it;
 		bool needToRun = false;
@@ -465,13 +468,13 @@ int MakeBiomCommand::execute(){
 		//run last label if you need to
 		if (needToRun == true)  {
             if (fileFormat == "sharedfile") {
-                for (int i = 0; i < lookup.size(); i++) { if (lookup[i] != NULL) { delete lookup[i]; } }
-                lookup = input.getSharedRAbundVectors(lastLabel);
+                if (table != NULL) { delete table; }
+                table = input.getSharedOTUTable(lastLabel);
                 
-                m->mothurOut(lookup[0]->getLabel()); m->mothurOutEndLine();
-                getBiom(lookup);
+                m->mothurOut(table->getLabel()); m->mothurOutEndLine();
+                getBiom(table);
                 
-                for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
+                delete table; table = NULL;
             }else {
                 for (int i = 0; i < lookupRel.size(); i++) { if (lookupRel[i] != NULL) { delete lookupRel[i]; } }
                 lookupRel = input.getSharedRAbundFloatVectors(lastLabel);
@@ -506,74 +509,105 @@ int MakeBiomCommand::execute(){
 	}
 }
 //**********************************************************************************************************************
-int MakeBiomCommand::getBiom(vector<SharedRAbundVector*>& lookup){
+int MakeBiomCommand::getBiom(SharedOTUTable* table){
 	try {
+        //picrust merges otus by greengenes id, which is done on the dense vectors
+        if (picrust) {
+            vector<SharedRAbundVector*> lookup = table->getSharedRAbundVectors();
+            getBiom(lookup);
+            for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
+            return 0;
+        }
+        
         map<string, string> variables; 
         variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(sharedfile));
-        variables["[distance]"] = lookup[0]->getLabel();
+        variables["[distance]"] = table->getLabel();
         string outputFileName = getOutputFileName("biom",variables);
 		ofstream out;
 		m->openOutputFile(outputFileName, out);
 		outputNames.push_back(outputFileName); outputTypes["biom"].push_back(outputFileName);
-
-        string mothurString = "mothur" + toString(m->getVersion());
-        time_t rawtime;
-        struct tm * timeinfo;
-        time ( &rawtime );
-        timeinfo = localtime ( &rawtime );
-        string dateString = asctime (timeinfo);
-        int pos = dateString.find('\n');
-        if (pos != string::npos) { dateString = dateString.substr(0, pos);}
+        
+        vector<SharedRAbundVector*> noLookup; //only used by picrust
+        vector<string> metadata = getMetaData(noLookup);
+        int numBins = table->getNumBins();
+        int numGroups = table->getNumGroups();
+        
+        if (m->control_pressed) {  out.close(); return 0; }
+        
+        vector<string> groupNames = table->getGroups();
+        if (printBiomHeader(out, m->getSimpleName(sharedfile) + "-" + table->getLabel(), metadata, groupNames, numBins, "int")) { out.close(); return 0; }
+        
         string spaces = "      ";
         
-        //standard 
-        out << "{\n" + spaces + "\"id\":\"" + m->getSimpleName(sharedfile) + "-" + lookup[0]->getLabel() + "\",\n" + spaces + "\"format\": \"Biological Observation Matrix 0.9.1\",\n" + spaces + "\"format_url\": \"http://biom-format.org\",\n";
-        out << spaces + "\"type\": \"OTU table\",\n" + spaces + "\"generated_by\": \"" << mothurString << "\",\n" + spaces + "\"date\": \"" << dateString << "\",\n";
+        //the biom rows are otus, so walk the table by otu
+        vector<unsigned long long> otuStart;
+        vector<int> cellGroups, cellAbunds;
+        table->getOTUMajor(otuStart, cellGroups, cellAbunds);
+        
+        string separator = ",\n" + spaces + spaces;
+        bool first = true;
+        if (format == "sparse") {
+            //only the non zero cells are in the table
+            for (int i = 0; i < numBins; i++) {
+                
+                if (m->control_pressed) { out.close(); return 0; }
+                
+                for (unsigned long long j = otuStart[i]; j < otuStart[i+1]; j++) {
+                    if (!first) { out << separator; }
+                    out << "[" << i << "," << cellGroups[j] << "," << cellAbunds[j] << "]";
+                    first = false;
+                }
+            }
+        }else {
+            vector<int> abunds(numGroups, 0);
+            for (int i = 0; i < numBins; i++) {
+                
+                if (m->control_pressed) { out.close(); return 0; }
+                
+                for (unsigned long long j = otuStart[i]; j < otuStart[i+1]; j++) { abunds[cellGroups[j]] = cellAbunds[j]; }
+                
+                if (!first) { out << separator; }
+                out << "[";
+                for (int j = 0; j < numGroups-1; j++) { out << abunds[j] << ","; }
+                out << abunds[numGroups-1] << "]";
+                first = false;
+                
+                for (unsigned long long j = otuStart[i]; j < otuStart[i+1]; j++) { abunds[cellGroups[j]] = 0; }
+            }
+        }
+        out << "]\n";
         
+        out << "}\n";
+        out.close();
         
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "MakeBiomCommand", "getBiom");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int MakeBiomCommand::getBiom(vector<SharedRAbundVector*>& lookup){
+	try {
+        map<string, string> variables; 
+        variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(sharedfile));
+        variables["[distance]"] = lookup[0]->getLabel();
+        string outputFileName = getOutputFileName("biom",variables);
+		ofstream out;
+		m->openOutputFile(outputFileName, out);
+		outputNames.push_back(outputFileName); outputTypes["biom"].push_back(outputFileName);
+
         vector<string> metadata = getMetaData(lookup);
         int numBins = lookup[0]->getNumBins();
         
         if (m->control_pressed) {  out.close(); return 0; }
         
-        //get row info
-        /*"rows":[
-                {"id":"GG_OTU_1", "metadata":null},
-                {"id":"GG_OTU_2", "metadata":null},
-                {"id":"GG_OTU_3", "metadata":null},
-                {"id":"GG_OTU_4", "metadata":null},
-                {"id":"GG_OTU_5", "metadata":null}
-                ],*/
-        out << spaces + "\"rows\":[\n";
-        string rowFront = spaces + spaces + "{\"id\":\"";
-        string rowBack = "\", \"metadata\":";
-        for (int i = 0; i < numBins-1; i++) {
-            if (m->control_pressed) {  out.close(); return 0; }
-            out << rowFront << m->currentSharedBinLabels[i] << rowBack << metadata[i] << "},\n"; 
-        }
-        out << rowFront << m->currentSharedBinLabels[(numBins-1)] << rowBack << metadata[(numBins-1)] << "}\n" + spaces + "],\n"; 
-       
-        //get column info
-        /*"columns": [
-                    {"id":"Sample1", "metadata":null},
-                    {"id":"Sample2", "metadata":null},
-                    {"id":"Sample3", "metadata":null},
-                    {"id":"Sample4", "metadata":null},
-                    {"id":"Sample5", "metadata":null},
-                    {"id":"Sample6", "metadata":null}
-                    ],*/
-        
-        string colBack = "\", \"metadata\":";
-        out << spaces + "\"columns\":[\n";
-        for (int i = 0; i < lookup.size()-1; i++) {
-            if (m->control_pressed) {  out.close(); return 0; }
-            out << rowFront << lookup[i]->getGroup() << colBack << sampleMetadata[i] << "},\n";
-        }
-        out << rowFront << lookup[(lookup.size()-1)]->getGroup() << colBack << sampleMetadata[lookup.size()-1] << "}\n" + spaces + "],\n";
+        vector<string> groupNames;
+        for (int i = 0; i < lookup.size(); i++) { groupNames.push_back(lookup[i]->getGroup()); }
+        if (printBiomHeader(out, m->getSimpleName(sharedfile) + "-" + lookup[0]->getLabel(), metadata, groupNames, numBins, "int")) { out.close(); return 0; }
         
-        out << spaces + "\"matrix_type\": \"" << format << "\",\n" + spaces + "\"matrix_element_type\": \"int\",\n";
-        out <<  spaces + "\"shape\": [" << numBins << "," << lookup.size() << "],\n";
-        out << spaces + "\"data\":  [";
+        string spaces = "      ";
         
         vector<string> dataRows;
         if (format == "sparse") {
@@ -654,64 +688,16 @@ int MakeBiomCommand::getBiom(vector<SharedRAbundFloatVector*>& lookup){
         m->openOutputFile(outputFileName, out);
         outputNames.push_back(outputFileName); outputTypes["biom"].push_back(outputFileName);
         
-        string mothurString = "mothur" + toString(m->getVersion());
-        time_t rawtime;
-        struct tm * timeinfo;
-        time ( &rawtime );
-        timeinfo = localtime ( &rawtime );
-        string dateString = asctime (timeinfo);
-        int pos = dateString.find('\n');
-        if (pos != string::npos) { dateString = dateString.substr(0, pos);}
-        string spaces = "      ";
-        
-        //standard
-        out << "{\n" + spaces + "\"id\":\"" + sharedfile + "-" + lookup[0]->getLabel() + "\",\n" + spaces + "\"format\": \"Biological Observation Matrix 0.9.1\",\n" + spaces + "\"format_url\": \"http://biom-format.org\",\n";
-        out << spaces + "\"type\": \"OTU table\",\n" + spaces + "\"generated_by\": \"" << mothurString << "\",\n" + spaces + "\"date\": \"" << dateString << "\",\n";
-        
-        
         vector<string> metadata = getMetaData(lookup);
         int numBins = lookup[0]->getNumBins();
         
         if (m->control_pressed) {  out.close(); return 0; }
         
-        //get row info
-        /*"rows":[
-         {"id":"GG_OTU_1", "metadata":null},
-         {"id":"GG_OTU_2", "metadata":null},
-         {"id":"GG_OTU_3", "metadata":null},
-         {"id":"GG_OTU_4", "metadata":null},
-         {"id":"GG_OTU_5", "metadata":null}
-         ],*/
-        out << spaces + "\"rows\":[\n";
-        string rowFront = spaces + spaces + "{\"id\":\"";
-        string rowBack = "\", \"metadata\":";
-        for (int i = 0; i < numBins-1; i++) {
-            if (m->control_pressed) {  out.close(); return 0; }
-            out << rowFront << m->currentSharedBinLabels[i] << rowBack << metadata[i] << "},\n";
-        }
-        out << rowFront << m->currentSharedBinLabels[(numBins-1)] << rowBack << metadata[(numBins-1)] << "}\n" + spaces + "],\n";
-        
-        //get column info
-        /*"columns": [
-         {"id":"Sample1", "metadata":null},
-         {"id":"Sample2", "metadata":null},
-         {"id":"Sample3", "metadata":null},
-         {"id":"Sample4", "metadata":null},
-         {"id":"Sample5", "metadata":null},
-         {"id":"Sample6", "metadata":null}
-         ],*/
-        
-        string colBack = "\", \"metadata\":";
-        out << spaces + "\"columns\":[\n";
-        for (int i = 0; i < lookup.size()-1; i++) {
-            if (m->control_pressed) {  out.close(); return 0; }
-            out << rowFront << lookup[i]->getGroup() << colBack << sampleMetadata[i] << "},\n";
-        }
-        out << rowFront << lookup[(lookup.size()-1)]->getGroup() << colBack << sampleMetadata[lookup.size()-1] << "}\n" + spaces + "],\n";
+        vector<string> groupNames;
+        for (int i = 0; i < lookup.size(); i++) { groupNames.push_back(lookup[i]->getGroup()); }
+        if (printBiomHeader(out, sharedfile + "-" + lookup[0]->getLabel(), metadata, groupNames, numBins, "float")) { out.close(); return 0; }
         
-        out << spaces + "\"matrix_type\": \"" << format << "\",\n" + spaces + "\"matrix_element_type\": \"float\",\n";
-        out <<  spaces + "\"shape\": [" << numBins << "," << lookup.size() << "],\n";
-        out << spaces + "\"data\":  [";
+        string spaces = "      ";
         
         vector<string> dataRows;
         if (format == "sparse") {
@@ -782,11 +768,77 @@ int MakeBiomCommand::getBiom(vector<SharedRAbundFloatVector*>& lookup){
     }
 }
 //**********************************************************************************************************************
+//writes everything before the data: the id, the rows with their metadata, the columns and the shape. returns 1 if the user quit
+int MakeBiomCommand::printBiomHeader(ofstream& out, string id, vector<string>& metadata, vector<string>& groupNames, int numBins, string elementType){
+	try {
+        string mothurString = "mothur" + toString(m->getVersion());
+        time_t rawtime;
+        struct tm * timeinfo;
+        time ( &rawtime );
+        timeinfo = localtime ( &rawtime );
+        string dateString = asctime (timeinfo);
+        int pos = dateString.find('\n');
+        if (pos != string::npos) { dateString = dateString.substr(0, pos);}
+        string spaces = "      ";
+        
+        //standard 
+        out << "{\n" + spaces + "\"id\":\"" + id + "\",\n" + spaces + "\"format\": \"Biological Observation Matrix 0.9.1\",\n" + spaces + "\"format_url\": \"http://biom-format.org\",\n";
+        out << spaces + "\"type\": \"OTU table\",\n" + spaces + "\"generated_by\": \"" << mothurString << "\",\n" + spaces + "\"date\": \"" << dateString << "\",\n";
+        
+        //get row info
+        /*"rows":[
+                {"id":"GG_OTU_1", "metadata":null},
+                {"id":"GG_OTU_2", "metadata":null},
+                {"id":"GG_OTU_3", "metadata":null},
+                {"id":"GG_OTU_4", "metadata":null},
+                {"id":"GG_OTU_5", "metadata":null}
+                ],*/
+        out << spaces + "\"rows\":[\n";
+        string rowFront = spaces + spaces + "{\"id\":\"";
+        string rowBack = "\", \"metadata\":";
+        for (int i = 0; i < numBins-1; i++) {
+            if (m->control_pressed) {  return 1; }
+            out << rowFront << m->currentSharedBinLabels[i] << rowBack << metadata[i] << "},\n"; 
+        }
+        out << rowFront << m->currentSharedBinLabels[(numBins-1)] << rowBack << metadata[(numBins-1)] << "}\n" + spaces + "],\n"; 
+       
+        //get column info
+        /*"columns": [
+                    {"id":"Sample1", "metadata":null},
+                    {"id":"Sample2", "metadata":null},
+                    {"id":"Sample3", "metadata":null},
+                    {"id":"Sample4", "metadata":null},
+                    {"id":"Sample5", "metadata":null},
+                    {"id":"Sample6", "metadata":null}
+                    ],*/
+        
+        int numGroups = groupNames.size();
+        string colBack = "\", \"metadata\":";
+        out << spaces + "\"columns\":[\n";
+        for (int i = 0; i < numGroups-1; i++) {
+            if (m->control_pressed) {  return 1; }
+            out << rowFront << groupNames[i] << colBack << sampleMetadata[i] << "},\n";
+        }
+        out << rowFront << groupNames[numGroups-1] << colBack << sampleMetadata[numGroups-1] << "}\n" + spaces + "],\n";
+        
+        out << spaces + "\"matrix_type\": \"" << format << "\",\n" + spaces + "\"matrix_element_type\": \"" + elementType + "\",\n";
+        out <<  spaces + "\"shape\": [" << numBins << "," << numGroups << "],\n";
+        out << spaces + "\"data\":  [";
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "MakeBiomCommand", "printBiomHeader");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//lookup is only used when picrust merges otus, the bins are the current shared bin labels
 vector<string> MakeBiomCommand::getMetaData(vector<SharedRAbundVector*>& lookup){
 	try {
         vector<string> metadata;
         
-        if (contaxonomyfile == "") { for (int i = 0; i < lookup[0]->getNumBins(); i++) {  metadata.push_back("null");  } }
+        if (contaxonomyfile == "") { for (int i = 0; i < m->currentSharedBinLabels.size(); i++) {  metadata.push_back("null");  } }
         else {
             
             //read constaxonomy file storing in a map, otulabel -> taxonomy
@@ -855,7 +907,7 @@ vector<string> MakeBiomCommand::getMetaData(vector<SharedRAbundVector*>& lookup)
             //traverse the binLabels forming the metadata strings and saving them
             //make sure to sanity check
             map<string, string>::iterator it;
-            for (int i = 0; i < lookup[0]->getNumBins(); i++) {
+            for (int i = 0; i < m->currentSharedBinLabels.size(); i++) {
                 
                 if (m->control_pressed) { return metadata; }
                 
@@ -1384,10 +1436,10 @@ map<string, string> MakeBiomCommand::readGGOtuMap(){
     
 }
 //**********************************************************************************************************************
-int MakeBiomCommand::getSampleMetaData(vector<SharedRAbundVector*>& lookup){
+int MakeBiomCommand::getSampleMetaData(vector<string> sampleGroups){
 	try {
         sampleMetadata.clear();
-        if (metadatafile == "") {  for (int i = 0; i < lookup.size(); i++) {  sampleMetadata.push_back("null");  } }
+        if (metadatafile == "") {  for (int i = 0; i < sampleGroups.size(); i++) {  sampleMetadata.push_back("null");  } }
         else {
             ifstream in;
             m->openInputFile(metadatafile, in);
@@ -1428,13 +1480,13 @@ int MakeBiomCommand::getSampleMetaData(vector<SharedRAbundVector*>& lookup){
             in.close();
             
             map<string, vector<string> >::iterator it;
-            for (int i = 0; i < lookup.size(); i++) {
+            for (int i = 0; i < sampleGroups.size(); i++) {
                 
                 if (m->control_pressed) { return 0; }
                 
-                it = lines.find(lookup[i]->getGroup());
+                it = lines.find(sampleGroups[i]);
                 
-                if (it == lines.end()) { m->mothurOut("[ERROR]: can't find metadata information for " + lookup[i]->getGroup() + ", quitting.\n"); m->control_pressed = true; }
+                if (it == lines.end()) { m->mothurOut("[ERROR]: can't find metadata information for " + sampleGroups[i] + ", quitting.\n"); m->control_pressed = true; }
                 else {
                     vector<string> values = it->second;
                     
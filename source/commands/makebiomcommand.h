@@ -42,12 +42,14 @@ private:
     
 	bool abort, allLines, picrust;
     
+    int getBiom(SharedOTUTable*);
     int getBiom(vector<SharedRAbundVector*>&);
     int getBiom(vector<SharedRAbundFloatVector*>& lookup);
+    int printBiomHeader(ofstream&, string, vector<string>&, vector<string>&, int, string);    //id, metadata, group names, number of bins, matrix element type
     vector<string> getMetaData(vector<SharedRAbundVector*>&);
     vector<string> getMetaData(vector<SharedRAbundFloatVector*>&);
     vector<string> parseTax(string tax, vector<string>& scores);
-    int getSampleMetaData(vector<SharedRAbundVector*>&);
+    int getSampleMetaData(vector<string>);
     int getSampleMetaData(vector<SharedRAbundFloatVector*>&);
     //for picrust
     int getGreenGenesOTUIDs(vector<SharedRAbundVector*>&, map<string, string>&);
@@ -342,6 +342,7 @@ vector<SharedRAbundFloatVector*> MakeLefseCommand::getSharedRelabund(){
             set<string> labels; labels.insert(label);
             set<string> processedLabels;
             set<string> userLabels = labels;
+            input.setLabels(labels);
             
             //as long as you are not at the end of the file or done wih the lines you want
             while((templookup[0] != NULL) && (userLabels.size() != 0)) {
@@ -0,0 +1,191 @@
+//
+//  makeotuindexcommand.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "makeotuindexcommand.h"
+
+//**********************************************************************************************************************
+vector<string> MakeOTUIndexCommand::setParameters(){	
+	try {
+		CommandParameter plist("list", "InputTypes", "", "", "LRSS", "LRSS", "none","otuindex",false,false, true); parameters.push_back(plist);
+		CommandParameter pshared("shared", "InputTypes", "", "", "LRSS", "LRSS", "none","otuindex",false,false, true); parameters.push_back(pshared);
+		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
+		CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
+		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
+		
+		vector<string> myArray;
+		for (int i = 0; i < parameters.size(); i++) {	myArray.push_back(parameters[i].name);		}
+		return myArray;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MakeOTUIndexCommand", "setParameters");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+string MakeOTUIndexCommand::getHelpString(){	
+	try {
+		string helpString = "";
+		helpString += "The make.otuindex command creates a binary index of a list or shared file.\n";
+		helpString += "The index stores each sequence name or group once and has a directory of the labels in the file, so commands asking for a label can read it without parsing the labels before it.\n";
+		helpString += "The make.otuindex command parameters are list and shared. list or shared is required, unless you have a valid current file.\n";
+		helpString += "The index is written as yourFile.otuindex. Commands using your list or shared file will use it when it is in the same directory as the file. If the file changes, the index is ignored until you run make.otuindex again.\n";
+		helpString += "The make.otuindex command should be in the following format: make.otuindex(list=yourListFile).\n";
+		helpString += "Example make.otuindex(list=final.an.list).\n";
+		helpString += "Note: No spaces between parameter labels (i.e. list), '=' and parameters (i.e.yourListFile).\n";
+		return helpString;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MakeOTUIndexCommand", "getHelpString");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+string MakeOTUIndexCommand::getOutputPattern(string type) {
+	try {
+		string pattern = "";
+		
+		if (type == "otuindex")      {   pattern = "[filename],otuindex";    }
+		else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->control_pressed = true;  }
+		
+		return pattern;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MakeOTUIndexCommand", "getOutputPattern");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+MakeOTUIndexCommand::MakeOTUIndexCommand(){	
+	try {
+		abort = true; calledHelp = true; 
+		setParameters();
+		vector<string> tempOutNames;
+		outputTypes["otuindex"] = tempOutNames;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MakeOTUIndexCommand", "MakeOTUIndexCommand");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+MakeOTUIndexCommand::MakeOTUIndexCommand(string option)  {
+	try {
+		abort = false; calledHelp = false;   
+		
+		//allow user to run help
+		if(option == "help") { help(); abort = true; calledHelp = true; }
+		else if(option == "citation") { citation(); abort = true; calledHelp = true;}
+		
+		else {
+			vector<string> myArray = setParameters();
+			
+			OptionParser parser(option);
+			map<string,string> parameters = parser.getParameters();
+			map<string,string>::iterator it;
+			
+			ValidParameters validParameter;
+			
+			//check to make sure all parameters are valid for command
+			for (it = parameters.begin(); it != parameters.end(); it++) { 
+				if (validParameter.isValidParameter(it->first, myArray, it->second) != true) {  abort = true;  }
+			}
+			
+			//initialize outputTypes
+			vector<string> tempOutNames;
+			outputTypes["otuindex"] = tempOutNames;
+			
+			//if the user changes the input directory command factory will send this info to us in the output parameter 
+			string inputDir = validParameter.validFile(parameters, "inputdir", false);		
+			if (inputDir == "not found"){	inputDir = "";		}
+			else {
+				string path;
+				it = parameters.find("list");
+				//user has given a template file
+				if(it != parameters.end()){ 
+					path = m->hasPath(it->second);
+					//if the user has not given a path then, add inputdir. else leave path alone.
+					if (path == "") {	parameters["list"] = inputDir + it->second;		}
+				}
+				
+				it = parameters.find("shared");
+				//user has given a template file
+				if(it != parameters.end()){ 
+					path = m->hasPath(it->second);
+					//if the user has not given a path then, add inputdir. else leave path alone.
+					if (path == "") {	parameters["shared"] = inputDir + it->second;		}
+				}
+			}
+			
+			//check for required parameters
+			listfile = validParameter.validFile(parameters, "list", true);
+			if (listfile == "not open") { listfile = ""; abort = true; }
+			else if (listfile == "not found") { listfile = ""; }
+			else {  format = "list"; inputfile = listfile; m->setListFile(listfile); }
+			
+			sharedfile = validParameter.validFile(parameters, "shared", true);
+			if (sharedfile == "not open") { sharedfile = ""; abort = true; }	
+			else if (sharedfile == "not found") { sharedfile = ""; }
+			else {  format = "sharedfile"; inputfile = sharedfile; m->setSharedFile(sharedfile); }
+			
+			if ((listfile != "") && (sharedfile != "")) { m->mothurOut("[ERROR]: You may only use one of the list or shared parameters, aborting.\n"); abort = true; }
+			
+			if ((listfile == "") && (sharedfile == "")) { 
+				//is there are current file available for any of these?
+				//give priority to list, then shared
+				listfile = m->getListFile(); 
+				if (listfile != "") { inputfile = listfile; format = "list"; m->mothurOut("Using " + listfile + " as input file for the list parameter."); m->mothurOutEndLine(); }
+				else { 
+					sharedfile = m->getSharedFile(); 
+					if (sharedfile != "") { inputfile = sharedfile; format = "sharedfile"; m->mothurOut("Using " + sharedfile + " as input file for the shared parameter."); m->mothurOutEndLine(); }
+					else { 
+						m->mothurOut("No valid current files. You must provide a list or shared file."); m->mothurOutEndLine(); 
+						abort = true;
+					}
+				}
+			}
+			
+			//if the user changes the output directory command factory will send this info to us in the output parameter 
+			outputDir = validParameter.validFile(parameters, "outputdir", false);		if (outputDir == "not found"){	outputDir = m->hasPath(inputfile); 	}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MakeOTUIndexCommand", "MakeOTUIndexCommand");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int MakeOTUIndexCommand::execute(){
+	try {
+		
+		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
+		
+		map<string, string> variables; 
+		variables["[filename]"] = outputDir + m->getSimpleName(inputfile) + ".";
+		string indexFile = getOutputFileName("otuindex", variables);
+		
+		if (outputDir != m->hasPath(inputfile)) { m->mothurOut("[WARNING]: the index is only found when it is in the same directory as " + inputfile + ".\n"); }
+		
+		OTUIndex index;
+		index.createIndex(inputfile, format, indexFile);
+		
+		if (m->control_pressed) { m->mothurRemove(indexFile); return 0; }
+		
+		outputNames.push_back(indexFile); outputTypes["otuindex"].push_back(indexFile);
+		
+		m->mothurOutEndLine();
+		m->mothurOut("Output File Names: "); m->mothurOutEndLine();
+		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i]); m->mothurOutEndLine();	}
+		m->mothurOutEndLine();
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MakeOTUIndexCommand", "execute");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
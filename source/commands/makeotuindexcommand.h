@@ -0,0 +1,41 @@
+#ifndef Mothur_makeotuindexcommand_h
+#define Mothur_makeotuindexcommand_h
+
+//
+//  makeotuindexcommand.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "command.hpp"
+#include "otuindex.h"
+
+/**************************************************************************************************/
+
+class MakeOTUIndexCommand : public Command {
+public:
+	MakeOTUIndexCommand(string);
+	MakeOTUIndexCommand();
+	~MakeOTUIndexCommand(){}
+	
+	vector<string> setParameters();
+	string getCommandName()			{ return "make.otuindex";			}
+	string getCommandCategory()		{ return "OTU-Based Approaches";	}
+	string getHelpString();	
+	string getOutputPattern(string);
+	string getCitation() { return "http://www.mothur.org/wiki/Make.otuindex"; }
+	string getDescription()		{ return "creates a binary index of a list or shared file so labels can be read without parsing the whole file"; }
+	
+	int execute(); 
+	void help() { m->mothurOut(getHelpString()); }	
+	
+private:
+	string inputfile, listfile, sharedfile, format, outputDir;
+	bool abort;
+	vector<string> outputNames;
+};
+
+/**************************************************************************************************/
+
+#endif
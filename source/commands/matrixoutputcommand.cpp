@@ -315,6 +315,7 @@ int MatrixOutputCommand::execute(){
 		if (matrixCalculators.size() == 0) { m->mothurOut("No valid calculators."); m->mothurOutEndLine();  return 0; }
 			
 		input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
@@ -836,6 +837,14 @@ int MatrixOutputCommand::driver(vector<SharedRAbundVector*> thisLookup, int star
 	try {
 		vector<SharedRAbundVector*> subset;
         
+        //calculators with pair stats work from the sparse table instead of the dense vectors
+        bool usePairStats = false;
+        for(int i=0;i<matrixCalculators.size();i++) { if (matrixCalculators[i]->hasPairStats()) { usePairStats = true; } }
+        
+        SharedOTUTable* table = NULL;
+        if (usePairStats) { table = new SharedOTUTable(thisLookup); }
+        SharedPairStats stats;
+        
 		for (int k = start; k < end; k++) { // pass cdd each set of groups to compare
 			
 			for (int l = 0; l < k; l++) {
@@ -845,6 +854,8 @@ int MatrixOutputCommand::driver(vector<SharedRAbundVector*> thisLookup, int star
 					//add new pair of sharedrabunds
 					subset.push_back(thisLookup[k]); subset.push_back(thisLookup[l]); 
 					
+                    if (usePairStats) { stats.fill(*table, k, l); }
+                    
 					for(int i=0;i<matrixCalculators.size();i++) {
 						
 						//if this calc needs all groups to calculate the pair load all groups
@@ -855,9 +866,11 @@ int MatrixOutputCommand::driver(vector<SharedRAbundVector*> thisLookup, int star
 							}
 						}
 						
-						vector<double> tempdata = matrixCalculators[i]->getValues(subset); //saves the calculator outputs
+						vector<double> tempdata;
+                        if (matrixCalculators[i]->hasPairStats())   {   tempdata = matrixCalculators[i]->getPairValues(stats);  }
+                        else                                        {   tempdata = matrixCalculators[i]->getValues(subset);     } //saves the calculator outputs
 						
-						if (m->control_pressed) { return 1; }
+						if (m->control_pressed) { if (table != NULL) { delete table; } return 1; }
         
 						seqDist temp(l, k, tempdata[0]);
 						calcDists[i].push_back(temp);
@@ -865,6 +878,8 @@ int MatrixOutputCommand::driver(vector<SharedRAbundVector*> thisLookup, int star
 				}
 			}
 		}
+        
+        if (table != NULL) { delete table; }
 		
 		return 0;
 	}
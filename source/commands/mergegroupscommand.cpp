@@ -484,6 +484,7 @@ int MergeGroupsCommand::processSharedFile(DesignMap*& designMap){
 		m->openOutputFile(outputFileName, out);
 		
 		InputData input(sharedfile, "sharedfile");
+		input.setLabels(labels);
 		lookup = input.getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
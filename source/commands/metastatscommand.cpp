@@ -50,7 +50,7 @@ string MetaStatsCommand::getHelpString(){
 		helpString += "The threshold parameter allows you to set the significance level to reject null hypotheses (default 0.05).\n";
 		helpString += "The groups parameter allows you to specify which of the groups in your groupfile you would like included. The group names are separated by dashes.\n";
 		helpString += "The label parameter allows you to select what distance levels you would like, and are also separated by dashes.\n";
-		helpString += "The processors parameter allows you to specify how many processors you would like to use.  The default is 1. \n";
+		helpString += "The processors parameter allows you to specify how many processors you would like to use. The comparisons are divided between the processors, with one comparison its permutations are. The default is 1. \n";
 		helpString += "The metastats command should be in the following format: metastats(design=yourDesignFile).\n";
 		helpString += "Example metastats(design=temp.design, groups=A-B-C).\n";
 		helpString += "The default value for groups is all the groups in your groupfile, and all labels in your inputfile will be used.\n";
@@ -227,6 +227,7 @@ int MetaStatsCommand::execute(){
 		designMap = new DesignMap(designfile);
 
 		input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
@@ -252,7 +253,8 @@ int MetaStatsCommand::execute(){
 	
 		
 		//only 1 combo
-		if (numGroups == 2) { processors = 1; }
+		permutationProcessors = 1;
+		if (numGroups == 2) { permutationProcessors = processors; processors = 1; }
 		else if (numGroups < 2)	{ m->mothurOut("Not enough sets, I need at least 2 valid sets. Unable to complete command."); m->mothurOutEndLine(); m->control_pressed = true; }
 
         if(processors != 1){
@@ -572,7 +574,7 @@ int MetaStatsCommand::driver(unsigned long long start, unsigned long long num, v
                 if (convertSharedToInput) { convertToInput(subset, outputFileName);  }
 				
 				m->mothurOutEndLine();
-				MothurMetastats mothurMeta(threshold, iters);
+				MothurMetastats mothurMeta(threshold, iters, permutationProcessors);
 				mothurMeta.runMetastats(outputFileName , data2, setACount);
 				m->mothurOutEndLine();
 				m->mothurOutEndLine(); 
@@ -47,7 +47,7 @@ private:
 	string groups, label, outputDir, inputDir, designfile, sets, sharedfile;
 	vector<string> Groups, outputNames, Sets;
 	vector< vector<string> > namesOfGroupCombos;
-	int iters, processors;
+	int iters, processors, permutationProcessors; //with one comparison the processors run its permutations
 	float threshold;
 	
 	int process(vector<SharedRAbundVector*>&);
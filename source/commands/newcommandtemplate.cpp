@@ -337,6 +337,7 @@ int NewCommand::execute(){
         
         /*
          InputData input(sharedfile, "sharedfile");
+         input.setLabels(labels);
          vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
          string lastLabel = lookup[0]->getLabel();
          
@@ -212,6 +212,7 @@ int NormalizeSharedCommand::execute(){
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 		
 		input = new InputData(inputfile, format);
+		input->setLabels(labels);
 		
 		//you are reading a sharedfile and you do not want to make relabund
 		if ((format == "sharedfile") && (!makeRelabund)) {
@@ -237,6 +237,7 @@ int OTUAssociationCommand::execute(){
 int OTUAssociationCommand::processShared(){
 	try {
 		InputData* input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		vector<SharedRAbundVector*> lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
         
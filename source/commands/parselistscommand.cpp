@@ -211,6 +211,7 @@ int ParseListCommand::execute(){
 		set<string> userLabels = labels;	
 	
 		InputData input(listfile, "list");
+		input.setLabels(labels);
 		list = input.getListVector();
 		string lastLabel = list->getLabel();
 		
@@ -201,6 +201,7 @@ int PCACommand::execute(){
 		InputData* input;
 		if (mode == "sharedfile")			{  
 			input = new InputData(inputFile, "sharedfile");
+			input->setLabels(labels);
 		}else if (mode == "relabund")	{ 
 			input = new InputData(inputFile, "relabund");
 		}else {  m->mothurOut("[ERROR]: filetype not recognized."); m->mothurOutEndLine();  return 0; }
@@ -14,6 +14,11 @@
 #include "sabundvector.hpp"
 #include "counttable.h"
 
+//**********************************************************************************************************************
+//sorts highest to lowest
+inline bool comparePhylotypeBins(pair<int, int> left, pair<int, int> right){
+    return (left.second > right.second);
+}
 //**********************************************************************************************************************
 vector<string> PhylotypeCommand::setParameters(){	
 	try {
@@ -275,50 +280,88 @@ int PhylotypeCommand::execute(){
 				//output level
 				m->mothurOut(level); m->mothurOutEndLine();
 				
-				ListVector list;
-				list.setLabel(level);
-                
-				//go through nodes and build listvector 
+				//find the size of each bin, the names are written straight from the tree so the level is never held as a list
+				vector< pair<int, int> > bins; //node, number of names
 				for (itCurrent = currentNodes.begin(); itCurrent != currentNodes.end(); itCurrent++) {
 			
 					//get parents
-					TaxNode node = tree->get(itCurrent->first);
+					const TaxNode& node = tree->get(itCurrent->first);
 					parentNodes[node.parent] = node.parent;
 					
-					vector<string> names = node.accessions;
+					const vector<string>& names = node.accessions;
 					
-					//make the names compatable with listvector
-					string name = "";
+					int binSize = 0;
 					for (int i = 0; i < names.size(); i++) {  
                         
                         if (names[i] != "unknown") {
                             if (namefile != "") {	
                                 map<string, string>::iterator itNames = namemap.find(names[i]);  //make sure this name is in namefile
                                 
-                                if (itNames != namemap.end()) {  name += namemap[names[i]] + ",";   } //you found it in namefile
+                                if (itNames != namemap.end()) {  binSize += m->getNumNames(itNames->second);   } //you found it in namefile
                                 else { m->mothurOut("[ERROR]: " + names[i] + " is not in your namefile, please correct."); m->mothurOutEndLine(); m->control_pressed = true;  }
                                 
-                            }else{   name += names[i] + ",";	}
+                            }else{   binSize++;	}
                         }
 					}
                     
                     if (m->control_pressed) { break; }
                     
-					name = name.substr(0, name.length()-1);  //rip off extra ','
-					//add bin to list vector
-					if (name != "") { list.push_back(name); } //caused by unknown
+					//add bin
+					if (binSize != 0) { bins.push_back(pair<int, int>(itCurrent->first, binSize)); } //caused by unknown
 				}	
 				
 				//print listvector
-                if (!m->printedListHeaders) { list.printHeaders(outList); }
-                if (countfile == "") { list.print(outList);  }
-                else { list.print(outList, counts);  }
+                if (!m->printedListHeaders) {
+                    //the headers only depend on the number of otus
+                    ListVector headers;
+                    for (int i = 0; i < bins.size(); i++) { headers.push_back(""); }
+                    headers.printHeaders(outList);
+                }
+                
+                //sort the bins by abundance the way ListVector::print does
+                vector< pair<int, int> > sortedBins = bins;
+                if (countfile != "") {
+                    for (int i = 0; i < sortedBins.size(); i++) {
+                        const vector<string>& names = tree->get(sortedBins[i].first).accessions;
+                        int total = 0;
+                        for (int j = 0; j < names.size(); j++) {
+                            if (names[j] == "unknown") { continue; }
+                            map<string, int>::iterator itCount = counts.find(names[j]);
+                            if (itCount == counts.end()) {
+                                m->mothurOut("[ERROR]: " + names[j] + " is not in your count table. Please correct.\n"); m->control_pressed = true;
+                            }else { total += itCount->second; }
+                        }
+                        sortedBins[i].second = total;
+                    }
+                }
+                sort(sortedBins.begin(), sortedBins.end(), comparePhylotypeBins);
+                
+                outList << level << '\t' << bins.size();
+                for (int i = 0; i < sortedBins.size(); i++) {
+                    const vector<string>& names = tree->get(sortedBins[i].first).accessions;
+                    
+                    outList << '\t';
+                    bool first = true;
+                    for (int j = 0; j < names.size(); j++) {
+                        if (names[j] == "unknown") { continue; }
+                        if (!first) { outList << ','; }
+                        first = false;
+                        
+                        if (namefile != "") { outList << namemap[names[j]]; }
+                        else { outList << names[j]; }
+                    }
+                }
+                outList << endl;
                 
                 if (countfile == "") {
+                    RAbundVector rav;
+                    for (int i = 0; i < bins.size(); i++) { rav.push_back(bins[i].second); }
+                    rav.setLabel(level);
+                    
                     //print rabund
-                    list.getRAbundVector().print(outRabund);
+                    rav.print(outRabund);
                     //print sabund
-                    list.getSAbundVector().print(outSabund);
+                    rav.getSAbundVector().print(outSabund);
                 }
 				labels.erase(level);
 				
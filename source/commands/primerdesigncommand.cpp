@@ -1253,6 +1253,7 @@ int PrimerDesignCommand::getListVector(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input.setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((list != NULL) && (userLabels.size() != 0)) {
@@ -405,6 +405,7 @@ int RareFactCommand::execute(){
 			if (rDisplays.size() == 0) { for(int i=0;i<rDisplays.size();i++){	delete rDisplays[i];	}  return 0; }
 			
 			input = new InputData(inputFileNames[p], format);			
+			input->setLabels(labels);
 			order = input->getOrderVector();
 			string lastLabel = order->getLabel();
 			
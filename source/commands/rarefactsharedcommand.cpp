@@ -289,6 +289,7 @@ int RareFactSharedCommand::process(DesignMap& designMap, string thisSet){
         vector<Display*> rDisplays;
         
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
 		lookup = input.getSharedRAbundVectors();
         if (lookup.size() < 2) { 
 			m->mothurOut("I cannot run the command without at least 2 valid groups."); 
@@ -775,6 +775,7 @@ int RemoveLineageCommand::getListVector(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input.setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((list != NULL) && (userLabels.size() != 0)) {
@@ -922,6 +923,7 @@ int RemoveLineageCommand::getShared(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input.setLabels(labels);
 		
 		//as long as you are not at the end of the file or done wih the lines you want
 		while((lookup[0] != NULL) && (userLabels.size() != 0)) {
@@ -275,6 +275,7 @@ int RemoveOtusCommand::readListGroup(){
 		set<string> labels; labels.insert(label);
 		set<string> processedLabels;
 		set<string> userLabels = labels;
+		input->setLabels(labels);
 		
 		bool wroteSomething = false;
 		
@@ -743,6 +743,7 @@ int RemoveRareCommand::processShared(){
 		
 		//if the users enters label "0.06" and there is no "0.06" in their file use the next lowest label.
 		InputData input(sharedfile, "sharedfile");
+		input.setLabels(labels);
 		vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		set<string> processedLabels;
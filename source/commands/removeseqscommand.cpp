@@ -12,6 +12,7 @@
 #include "listvector.hpp"
 #include "counttable.h"
 #include "fastqread.h"
+#include "sequenceindex.h"
 
 //**********************************************************************************************************************
 vector<string> RemoveSeqsCommand::setParameters(){	
@@ -27,6 +28,7 @@ vector<string> RemoveSeqsCommand::setParameters(){
 		CommandParameter pqfile("qfile", "InputTypes", "", "", "none", "FNGLT", "none","qfile",false,false); parameters.push_back(pqfile);
 		CommandParameter paccnos("accnos", "InputTypes", "", "", "none", "none", "none","",false,true,true); parameters.push_back(paccnos);
 		CommandParameter pdups("dups", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pdups);
+		CommandParameter pindex("index", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pindex);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pformat("format", "Multiple", "sanger-illumina-solexa-illumina1.8+", "illumina1.8+", "", "", "","",false,false,true); parameters.push_back(pformat);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -47,9 +49,10 @@ string RemoveSeqsCommand::getHelpString(){
 		string helpString = "";
 		helpString += "The remove.seqs command reads an .accnos file and at least one of the following file types: fasta, name, group, count, list, taxonomy, quality, fastq or alignreport file.\n";
 		helpString += "It outputs a file containing the sequences NOT in the .accnos file.\n";
-		helpString += "The remove.seqs command parameters are accnos, fasta, name, group, count, list, taxonomy, qfile, alignreport, fastq and dups.  You must provide accnos and at least one of the file parameters.\n";
+		helpString += "The remove.seqs command parameters are accnos, fasta, name, group, count, list, taxonomy, qfile, alignreport, fastq, dups and index.  You must provide accnos and at least one of the file parameters.\n";
         helpString += "The format parameter is used to indicate whether your sequences are sanger, solexa, illumina1.8+ or illumina, default=illumina1.8+.\n";
 		helpString += "The dups parameter allows you to remove the entire line from a name file if you remove any name from the line. default=true. \n";
+		helpString += "The index parameter allows you to save an index of your fasta, qfile or fastq file next to it, so later commands can copy its sequences without parsing them. default=false. \n";
 		helpString += "The remove.seqs command should be in the following format: remove.seqs(accnos=yourAccnos, fasta=yourFasta).\n";
 		helpString += "Example remove.seqs(accnos=amazon.accnos, fasta=amazon.fasta).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. fasta), '=' and parameters (i.e.yourFasta).\n";
@@ -287,6 +290,9 @@ RemoveSeqsCommand::RemoveSeqsCommand(string option)  {
 			}
 			dups = m->isTrue(temp);
             
+            temp = validParameter.validFile(parameters, "index", false);	if (temp == "not found") { temp = "false"; }
+            saveIndex = m->isTrue(temp);
+            
             countfile = validParameter.validFile(parameters, "count", true);
             if (countfile == "not open") { countfile = ""; abort = true; }
             else if (countfile == "not found") { countfile = "";  }	
@@ -407,6 +413,38 @@ int RemoveSeqsCommand::execute(){
 	}
 }
 
+//**********************************************************************************************************************
+//writes the records of the file that are not in names, with a saved index the records are copied without parsing them when they can be
+int RemoveSeqsCommand::removeIndexed(string filename, string type, ofstream& out, set<string>& uniqueNames, bool& wroteSomething){
+	try {
+		int removedCount = 0;
+		string fileWord = type + " file"; if (type == "qfile") { fileWord = "qfile"; }
+		
+		SequenceIndex index(filename, type, format, saveIndex);
+		string name;
+		while (index.getNext(name)) {
+			
+			if (m->control_pressed) { break; }
+			
+			if (names.count(name) == 0) {
+				if (uniqueNames.count(name) == 0) { //this name hasn't been seen yet
+					uniqueNames.insert(name);
+					wroteSomething = true;
+					
+					index.print(out);
+				}else {
+					m->mothurOut("[WARNING]: " + name + " is in your " + fileWord + " more than once.  Mothur requires sequence names to be unique. I will only add it once.\n");
+				}
+			}else {  removedCount++;  }
+		}
+		
+		return removedCount;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "RemoveSeqsCommand", "removeIndexed");
+		exit(1);
+	}
+}
 //**********************************************************************************************************************
 int RemoveSeqsCommand::readFasta(){
 	try {
@@ -428,7 +466,9 @@ int RemoveSeqsCommand::readFasta(){
 		int removedCount = 0;
 		
         set<string> uniqueNames;
-		while(!in.eof()){
+        bool useIndex = (dups || (uniqueMap.size() == 0)); //names are not changed, so the removed sequences don't need to be read
+        if (useIndex) { removedCount = removeIndexed(fastafile, "fasta", out, uniqueNames, wroteSomething); }
+		while(!in.eof() && !useIndex){
 			if (m->control_pressed) { in.close();  out.close();  m->mothurRemove(outputFileName);  return 0; }
 			
 			Sequence currSeq(in);
@@ -477,9 +517,6 @@ int RemoveSeqsCommand::readFastq(){
 		bool wroteSomething = false;
 		int removedCount = 0;
         
-		ifstream in;
-		m->openInputFile(fastqfile, in);
-		
 		string thisOutputDir = outputDir;
 		if (outputDir == "") {  thisOutputDir += m->hasPath(fastqfile);  }
 		map<string, string> variables;
@@ -490,32 +527,7 @@ int RemoveSeqsCommand::readFastq(){
 		m->openOutputFile(outputFileName, out);
         
 		set<string> uniqueNames;
-		while(!in.eof()){
-			
-			if (m->control_pressed) { in.close(); out.close(); m->mothurRemove(outputFileName); return 0; }
-			
-            //read sequence name
-            bool ignore;
-            FastqRead fread(in, ignore, format); m->gobble(in);
-            
-            if (!ignore) {
-                string name = fread.getName();
-                
-                if (names.count(name) == 0) {
-                    if (uniqueNames.count(name) == 0) { //this name hasn't been seen yet
-                        wroteSomething = true;
-                        fread.printFastq(out);
-                        uniqueNames.insert(name);
-                    }else {
-                        m->mothurOut("[WARNING]: " + name + " is in your fastq file more than once.  Mothur requires sequence names to be unique. I will only add it once.\n");
-                    }
-
-                }else { removedCount++; }
-            }
-            
-			m->gobble(in);
-		}
-		in.close();
+        removedCount = removeIndexed(fastqfile, "fastq", out, uniqueNames, wroteSomething);
 		out.close();
 		
 		
@@ -554,7 +566,9 @@ int RemoveSeqsCommand::readQual(){
 		int removedCount = 0;
 		
 		set<string> uniqueNames;
-		while(!in.eof()){	
+        bool useIndex = (dups || (uniqueMap.size() == 0)); //names are not changed, so the removed sequences don't need to be read
+        if (useIndex) { removedCount = removeIndexed(qualfile, "qfile", out, uniqueNames, wroteSomething); }
+		while(!in.eof() && !useIndex){	
 			string saveName = "";
 			string name = "";
 			string scores = "";
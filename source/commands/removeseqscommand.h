@@ -36,7 +36,7 @@ class RemoveSeqsCommand : public Command {
 	private:
 		set<string> names;
 		string accnosfile, fastafile, fastqfile, namefile, groupfile, countfile, alignfile, listfile, taxfile, qualfile, outputDir, format;
-		bool abort, dups;
+		bool abort, dups, saveIndex;
 		vector<string> outputNames;
         map<string, string> uniqueMap;
 		
@@ -49,6 +49,7 @@ class RemoveSeqsCommand : public Command {
 		int readList();
 		int readTax();
 		int readQual();
+		int removeIndexed(string, string, ofstream&, set<string>&, bool&);
 		
 };
 
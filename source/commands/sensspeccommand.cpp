@@ -9,6 +9,13 @@
 
 #include "sensspeccommand.h"
 
+//**********************************************************************************************************************
+//orders distances by pair so the two distances of a pair in a square column file are next to each other
+inline bool compareSeqDistPair(const seqDist& left, const seqDist& right){
+	if (left.seq1 == right.seq1) { return (left.seq2 < right.seq2); }
+	return (left.seq1 < right.seq1);
+}
+
 //**********************************************************************************************************************
 vector<string> SensSpecCommand::setParameters(){
 	try {
@@ -297,13 +304,13 @@ int SensSpecCommand::execute(){
 }
 
 //***************************************************************************************************************
+//saves the otu of each sequence for the label, the distances are read once for all the labels by processDistances
 
-int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool& getCutoff, string& origCutoff){
+int SensSpecCommand::process(ListVector*& list, bool& getCutoff, string& origCutoff){
 
 	try {
 
 		string label = list->getLabel();
-		int numSeqs = list->getNumSeqs();
 		int numOTUs = list->getNumBins();
 
 		if(getCutoff == 1){
@@ -318,13 +325,52 @@ int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool&
 			}
 		}
 
-		truePositives = 0;
-		falsePositives = 0;
-		trueNegatives = 0;
-		falseNegatives = 0;
+		vector<int> otus(seqIndex.size(), -1);
+		long int sameOTUPairs = 0;
+
+		for(int otu=0;otu<numOTUs;otu++){
+			if (m->control_pressed) { return 0; }
+
+			string seqList = list->get(otu);
+			vector<string> otuVector;
+			m->splitAtComma(seqList, otuVector);
+
+			for(int i=0;i<otuVector.size();i++){
+				map<string, int>::iterator it = seqIndex.find(otuVector[i]);
+				if (it == seqIndex.end()) {
+					int id = seqIndex.size();
+					seqIndex[otuVector[i]] = id;
+					otus.push_back(otu);
+				}else {
+					otus[it->second] = otu;
+				}
+			}
+
+			//every pair of sequences in the otu is a positive
+			sameOTUPairs += (long int)otuVector.size() * (otuVector.size() - 1) / 2;
+		}
 
-		map<string, double> distanceMap;
+		processLabels.push_back(label);
+		processCutoffs.push_back(origCutoff);
+		labelCutoffs.push_back(cutoff);
+		seqOTUs.push_back(otus);
+		labelNumSeqs.push_back(list->getNumSeqs());
+		labelSameOTUPairs.push_back(sameOTUPairs);
 
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SensSpecCommand", "process");
+		exit(1);
+	}
+}
+
+//***************************************************************************************************************
+//the pairs of sequences closer than maxCutoff, each pair once with seq1 < seq2. sequences that are not in the list
+//file get an id too, their pairs are false negatives
+
+int SensSpecCommand::readDistances(vector<seqDist>& distances, double maxCutoff){
+	try {
 		//could segfault out if there are sequences in phylip-formatted distance
 		//matrix that aren't in the list file
 		if(format == "phylip"){
@@ -335,31 +381,26 @@ int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool&
 			phylipFile >> pNumSeqs;
 
 			double distance;
+			string seqName;
 
-			vector<string> seqNameVector(pNumSeqs);
-			m->mothurOut(label); m->mothurOutEndLine();
+			vector<int> seqIDs(pNumSeqs);
 
 			for(int i=0;i<pNumSeqs;i++){
 
 				if (m->control_pressed) { return 0; }
 
-				phylipFile >> seqNameVector[i];
+				phylipFile >> seqName;
 
-				//otuIndices[i] = seqMap[seqName];
+				map<string, int>::iterator it = seqIndex.find(seqName);
+				if (it == seqIndex.end()) { seqIDs[i] = seqIndex.size(); seqIndex[seqName] = seqIDs[i]; }
+				else { seqIDs[i] = it->second; }
 
 				for(int j=0;j<i;j++){
 					phylipFile >> distance;
 
-					if(distance <= cutoff){
-
-						string seqNamePair;
-						if(seqNameVector[i] < seqNameVector[j]){
-							seqNamePair = seqNameVector[i] + '-' + seqNameVector[j];
-						} else {
-							seqNamePair = seqNameVector[j] + '-' + seqNameVector[i];
-						}
-
-						distanceMap[seqNamePair] = distance;
+					if(distance <= maxCutoff){
+						if (seqIDs[i] < seqIDs[j]) { distances.push_back(seqDist(seqIDs[i], seqIDs[j], distance)); }
+						else { distances.push_back(seqDist(seqIDs[j], seqIDs[i], distance)); }
 					}
 				}
 
@@ -377,77 +418,98 @@ int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool&
 			float distance;
 
 			while(columnFile){
+				if (m->control_pressed) { columnFile.close(); return 0; }
+
 				columnFile >> seqNameA >> seqNameB >> distance;
 				m->gobble(columnFile);
 
-				if(distance <= cutoff){
-					string seqNamePair;
+				if(distance <= maxCutoff){
+					int seqA, seqB;
 
-					if(seqNameA < seqNameB){
-						seqNamePair = seqNameA + '-' + seqNameB;
-					} else {
-						seqNamePair = seqNameB + '-' + seqNameA;
-					}
-					distanceMap[seqNamePair] = distance;
+					map<string, int>::iterator it = seqIndex.find(seqNameA);
+					if (it == seqIndex.end()) { seqA = seqIndex.size(); seqIndex[seqNameA] = seqA; }
+					else { seqA = it->second; }
+
+					it = seqIndex.find(seqNameB);
+					if (it == seqIndex.end()) { seqB = seqIndex.size(); seqIndex[seqNameB] = seqB; }
+					else { seqB = it->second; }
+
+					if (seqA < seqB) { distances.push_back(seqDist(seqA, seqB, distance)); }
+					else { distances.push_back(seqDist(seqB, seqA, distance)); }
 				}
 			}
 			columnFile.close();
+
+			//a square column file has each pair twice, a pair counts once if either of its distances is under the cutoff
+			sort(distances.begin(), distances.end(), compareSeqDistPair);
+			int numUnique = 0;
+			for (int i = 0; i < distances.size(); i++) {
+				if ((numUnique != 0) && (distances[i].seq1 == distances[numUnique-1].seq1) && (distances[i].seq2 == distances[numUnique-1].seq2)) {
+					if (distances[i].dist < distances[numUnique-1].dist) { distances[numUnique-1].dist = distances[i].dist; }
+				}else {
+					distances[numUnique] = distances[i];
+					numUnique++;
+				}
+			}
+			distances.resize(numUnique);
 		}
 
-		for(int otu=0;otu<numOTUs;otu++){
-			if (m->control_pressed) { return 0; }
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SensSpecCommand", "readDistances");
+		exit(1);
+	}
+}
 
-			// get the sequence string from the list vector
-			string seqList = list->get(otu);
+//***************************************************************************************************************
+//reads the distance file once and scores all the labels
 
-			//count number of sequences in the bin
-			int nSeqsInOTU = 1;
-			for(int i=0;i<seqList.length();i++){
-				if(seqList[i] == ','){	nSeqsInOTU++;	}
-			}
+int SensSpecCommand::processDistances(){
+	try {
+		if (processLabels.size() == 0) { return 0; }
 
-			string seqName = "";
-			istringstream seqListStream(seqList);
+		double maxCutoff = labelCutoffs[0];
+		for (int i = 1; i < labelCutoffs.size(); i++) { if (labelCutoffs[i] > maxCutoff) { maxCutoff = labelCutoffs[i]; } }
 
-			int index = 0;
-			vector<string> otuVector(nSeqsInOTU);
-			while(getline(seqListStream, seqName, ',')) {
-				otuVector[index++] = seqName;
-			}
+		vector<seqDist> distances;
+		readDistances(distances, maxCutoff);
 
-			// indicate that a pair of sequences are in the same OTU; will
-			// assume that if they don't show up in the map that they're in
-			// different OTUs
-			for(int i=0;i<otuVector.size();i++){
-				for(int j=0;j<i;j++){
+		if (m->control_pressed) { return 0; }
 
-					string seqNamePair = "";
-					if(otuVector[i] < otuVector[j]){
-						seqNamePair = otuVector[i] + '-' + otuVector[j];
-					} else{
-						seqNamePair = otuVector[j] + '-' + otuVector[i];
-					}
+		for (int l = 0; l < processLabels.size(); l++) {
+			if (m->control_pressed) { return 0; }
 
-					map<string, double>::iterator it = distanceMap.find(seqNamePair);
+			m->mothurOut(processLabels[l]); m->mothurOutEndLine();
 
-					if(it != distanceMap.end()){
-						truePositives++;
-						distanceMap.erase(it);
-					} else {
-						falsePositives++;
-					}
+			vector<int>& otus = seqOTUs[l];
+			otus.resize(seqIndex.size(), -1); //seqs only found in the distance file
+
+			long int numPairs = 0;
+			truePositives = 0;
+
+			for (int i = 0; i < distances.size(); i++) {
+				if (distances[i].dist <= labelCutoffs[l]) {
+					numPairs++;
+
+					int otu = otus[distances[i].seq1];
+					if ((otu != -1) && (otu == otus[distances[i].seq2]) && (distances[i].seq1 != distances[i].seq2)) { truePositives++; }
 				}
 			}
-		}
-		falseNegatives = distanceMap.size();
-		trueNegatives = numSeqs * (numSeqs-1)/2 - (falsePositives + falseNegatives + truePositives);
 
-		outputStatistics(label, origCutoff);
+			falsePositives = labelSameOTUPairs[l] - truePositives;
+			falseNegatives = numPairs - truePositives;
+			trueNegatives = labelNumSeqs[l] * (labelNumSeqs[l]-1)/2 - (falsePositives + falseNegatives + truePositives);
+
+			outputStatistics(processLabels[l], processCutoffs[l]);
+
+			vector<int>().swap(otus);
+		}
 
 		return 0;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "SensSpecCommand", "process");
+		m->errorOut(e, "SensSpecCommand", "processDistances");
 		exit(1);
 	}
 }
@@ -463,9 +525,8 @@ int SensSpecCommand::processListFile(){
 		else if( !hard )	{	origCutoff = toString(cutoff);	cutoff += (0.49 / double(precision));	}
 		else 				{	origCutoff = toString(cutoff);	}
 
-		map<string, int> seqMap;
-
 		InputData input(listFile, "list");
+		input.setLabels(labels);
 		ListVector* list = input.getListVector();
 		string lastLabel = list->getLabel();
 
@@ -481,9 +542,7 @@ int SensSpecCommand::processListFile(){
 				processedLabels.insert(list->getLabel());
 				userLabels.erase(list->getLabel());
 
-				//process
-				// int numSeqs = fillSeqMap(seqMap, list);
-				process(seqMap, list, getCutoff, origCutoff);
+				process(list, getCutoff, origCutoff);
 			}
 
 			if ((m->anyLabelsToProcess(list->getLabel(), userLabels, "") == true) && (processedLabels.count(lastLabel) != 1)) {
@@ -496,9 +555,7 @@ int SensSpecCommand::processListFile(){
 				processedLabels.insert(list->getLabel());
 				userLabels.erase(list->getLabel());
 
-				//process
-				//int numSeqs = fillSeqMap(seqMap, list);
-				process(seqMap, list, getCutoff, origCutoff);
+				process(list, getCutoff, origCutoff);
 
 				//restore real lastlabel to save below
 				list->setLabel(saveLabel);
@@ -527,13 +584,13 @@ int SensSpecCommand::processListFile(){
 			if (list != NULL) {	delete list;	}
 			list = input.getListVector(lastLabel);
 
-			//process
-			//int numSeqs = fillSeqMap(seqMap, list);
-			process(seqMap, list, getCutoff, origCutoff);
+			process(list, getCutoff, origCutoff);
 
 			delete list;
 		}
 
+		processDistances();
+
 		return 0;
 	}
 	catch(exception& e) {
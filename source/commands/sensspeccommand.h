@@ -53,7 +53,16 @@ private:
 	double cutoff;
 	int precision;
 
-	int process(map<string, int>&, ListVector*&, bool&, string&);
+	//the labels to score, filled by process and scored together in one pass through the distance file
+	map<string, int> seqIndex;                  //name -> seq id
+	vector<string> processLabels, processCutoffs;
+	vector<double> labelCutoffs;
+	vector< vector<int> > seqOTUs;              //[label][seq id] -> otu, -1 if the seq is not in the list
+	vector<long int> labelNumSeqs, labelSameOTUPairs;
+
+	int process(ListVector*&, bool&, string&);
+	int readDistances(vector<seqDist>&, double);
+	int processDistances();
 };
 
 #endif
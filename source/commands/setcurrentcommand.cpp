@@ -600,58 +600,7 @@ int SetCurrentCommand::readCurrentFiles(){
             
             if (pieces.size() != 2) { m->mothurOut("[ERROR]: " + m->getStringFromVector(pieces, ",") + " line is not in the correct format.  Did you edit the file? Mothur expects tag=filename.  Example: fasta=final.fasta\n"); m->control_pressed = true;  }
             else{
-                   //look for file types
-                if (pieces[0] == "fasta") {
-                    m->setFastaFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "qfile") {
-                    m->setQualFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "phylip") {
-                    m->setPhylipFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "column") {
-                    m->setColumnFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "list") {
-                    m->setListFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "rabund") {
-                    m->setRabundFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "sabund") {
-                    m->setSabundFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "name") {
-                    m->setNameFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "group") {
-                    m->setGroupFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "order") {
-                    m->setOrderFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "ordergroup") {
-                    m->setOrderGroupFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "tree") {
-                    m->setTreeFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "shared") {
-                    m->setSharedFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "relabund") {
-                    m->setRelAbundFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "design") {
-                    m->setDesignFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "sff") {
-                    m->setSFFFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "oligos") {
-                    m->setOligosFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "accnos") {
-                    m->setAccnosFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "taxonomy") {
-                    m->setTaxonomyFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "flow") {
-                    m->setFlowFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "biom") {
-                    m->setBiomFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "count") {
-                    m->setCountTableFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "summary") {
-                    m->setSummaryFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "file") {
-                    m->setFileFile(m->getFullPathName(pieces[1]));
-                }else if (pieces[0] == "processors") {
-                    m->setProcessors(pieces[1]);
-                }else {
+                if (!m->setCurrentFile(pieces[0], pieces[1])) {
                     m->mothurOut("[ERROR]: mothur does not save a current file for " + m->getFullPathName(pieces[1])); m->mothurOutEndLine();
                 }
             }
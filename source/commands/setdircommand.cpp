@@ -16,6 +16,10 @@ vector<string> SetDirectoryCommand::setParameters(){
         CommandParameter pdebug("debug", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pdebug);
         CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pmodnames("modifynames", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pmodnames);
+        CommandParameter pcache("cache", "String", "", "", "", "", "","",false,false); parameters.push_back(pcache);
+        CommandParameter pcachesize("cachesize", "Number", "", "10000", "", "", "","",false,false); parameters.push_back(pcachesize);
+        CommandParameter pcountbinary("countbinary", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pcountbinary);
+        CommandParameter ptrace("trace", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(ptrace);
 		CommandParameter pinput("input", "String", "", "", "", "", "","",false,false,true); parameters.push_back(pinput);
 		CommandParameter poutput("output", "String", "", "", "", "", "","",false,false,true); parameters.push_back(poutput);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -40,9 +44,14 @@ string SetDirectoryCommand::getHelpString(){
         helpString += "The set.dir command can also be used to run mothur in debug mode.\n";
         helpString += "The set.dir command can also be used to seed random.\n";
         helpString += "The set.dir command can also be used to set the modifynames parameter. Default=t, meaning if your sequence names contain ':' change them to '_' to avoid issues while making trees.  modifynames=F will leave sequence names as they are.\n";
-		helpString += "The set.dir command parameters are input, output, tempdefault and debug and one is required.\n";
+		helpString += "The set.dir command parameters are input, output, tempdefault, cache, cachesize, countbinary, trace and debug and one is required.\n";
         helpString += "To run mothur in debug mode set debug=true. Default debug=false.\n";
         helpString += "To seed random set seed=yourRandomValue. By default mothur seeds random with the start time.\n";
+        helpString += "The set.dir command can also be used to cache the output of commands. When a command is run again with the same parameters and input files, mothur restores its output files from the cache instead of running it.\n";
+        helpString += "To turn on the cache set cache=yourCacheDirectory. To turn it off you may enter: cache=clear. Hits and misses are reported in the logfile.\n";
+        helpString += "The cachesize parameter sets the size of the cache in megabytes. When the cache is bigger, the output used longest ago is removed. Default cachesize=10000.\n";
+        helpString += "The set.dir command can also be used to save binary copies of large count files. With countbinary=t, reading a count file of 10MB or more saves a copy as yourFile.count_table.binary next to it, and later reads load the copy until the count file changes. Existing copies are always used. Default countbinary=f.\n";
+        helpString += "The set.dir command can also be used to trace the time, memory and bytes read and written by each command. With trace=t mothur writes a row for each command to yourLogfile.trace.csv and a line of JSON to yourLogfile.trace.json. Default trace=f.\n";
 		helpString += "To return the output to the same directory as the input files you may enter: output=clear.\n";
 		helpString += "To return the input to the current working directory you may enter: input=clear.\n";
 		helpString += "To set the output to the directory where mothur.exe is located you may enter: output=default.\n";
@@ -112,14 +121,32 @@ SetDirectoryCommand::SetDirectoryCommand(string option)  {
                 else { m->mothurOut("[ERROR]: Seed must be an integer for the set.dir command."); m->mothurOutEndLine(); abort = true; }
             }
             
+            cache = validParameter.validFile(parameters, "cache", false);
+            if (cache == "not found") {  cache = "";  }
+            
+            temp = validParameter.validFile(parameters, "cachesize", false);		if (temp == "not found"){	temp = "10000";	}
+            m->mothurConvert(temp, cacheSize);
+            if (cacheSize <= 0) { m->mothurOut("[ERROR]: cachesize must be greater than 0 for the set.dir command."); m->mothurOutEndLine(); abort = true; }
+            
+            bool nocountbinary = false;
+            temp = validParameter.validFile(parameters, "countbinary", false);
+            if (temp == "not found") {  nocountbinary = true; }
+            else {  m->saveCountBinary = m->isTrue(temp); }
+            
+            bool notrace = false;
+            temp = validParameter.validFile(parameters, "trace", false);
+            if (temp == "not found") {  trace = false;  notrace = true; }
+            else {  trace = m->isTrue(temp); }
+            traceSet = !notrace;
+            
             if (debug) { m->mothurOut("Setting [DEBUG] flag.\n"); }
             if (seed)  {
-                srand(random);
+                m->setRandomSeed(random);
                 m->mothurOut("Setting random seed to " + toString(random) + ".\n\n");
             }
             
-			if ((input == "") && (output == "") && (tempdefault == "") && nodebug && nomod && !seed) {
-				m->mothurOut("[ERROR]: You must provide either an input, output, tempdefault, debug or modifynames for the set.dir command."); m->mothurOutEndLine(); abort = true;
+			if ((input == "") && (output == "") && (tempdefault == "") && (cache == "") && nodebug && nomod && nocountbinary && notrace && !seed) {
+				m->mothurOut("[ERROR]: You must provide either an input, output, tempdefault, cache, countbinary, trace, debug or modifynames for the set.dir command."); m->mothurOutEndLine(); abort = true;
 			}else if((input == "") && (output == "") && (tempdefault == "")) { debugorSeedOnly = true; }
 		}
 	}
@@ -134,10 +161,10 @@ int SetDirectoryCommand::execute(){
 	try {
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 		
+        commandFactory = CommandFactory::getInstance();
+        
         if (debugorSeedOnly) {  }
         else {
-            commandFactory = CommandFactory::getInstance();
-            
             m->mothurOut("Mothur's directories:"); m->mothurOutEndLine();
             
             //redirect output
@@ -195,6 +222,23 @@ int SetDirectoryCommand::execute(){
                 }
             }
         }
+        
+        //trace the commands that follow
+        if (trace) {
+            PerformanceTrace::getInstance()->setTraceFile(m->getFileName());
+            m->mothurOut("Tracing commands to " + m->getFileName() + ".trace.csv and " + m->getFileName() + ".trace.json"); m->mothurOutEndLine();
+        }else if (traceSet) { PerformanceTrace::getInstance()->setTraceFile(""); }
+        
+        //cache command outputs
+        if (cache == "clear") {
+            commandFactory->setCache("", 0);
+            m->mothurOut("The command cache is off."); m->mothurOutEndLine();
+        }else if (cache != "") {
+            if (m->mkDir(cache)) {
+                m->mothurOut("cacheDir=" + cache + ", cachesize=" + toString(cacheSize) + " MB"); m->mothurOutEndLine();
+                commandFactory->setCache(cache, (unsigned long long)(cacheSize * 1000000));
+            }
+        }
 		return 0;
 	}
 	catch(exception& e) {
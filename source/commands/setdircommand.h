@@ -36,9 +36,10 @@ public:
 	
 private:
 	CommandFactory* commandFactory;
-	string output, input, tempdefault;
-	bool abort, debugorSeedOnly, modifyNames;
+	string output, input, tempdefault, cache;
+	bool abort, debugorSeedOnly, modifyNames, trace, traceSet;
     int random;
+    double cacheSize;
 	vector<string> outputNames;
 	
 		
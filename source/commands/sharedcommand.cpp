@@ -781,20 +781,17 @@ string SharedCommand::getTag(string& line) {
 //**********************************************************************************************************************
 int SharedCommand::createSharedFromListGroup() {
 	try {
-
-        GroupMap* groupMap = NULL;
-        CountTable* countTable = NULL;
+        //names are mapped to their groups once, each label of the list file is counted as it is read
+        NameGroupIndex seqGroups;
         if (groupfile != "") {
-            groupMap = new GroupMap(groupfile);
-
-            int groupError = groupMap->readMap();
-            if (groupError == 1) { delete groupMap; return 0; }
-            vector<string> allGroups = groupMap->getNamesOfGroups();
+            int groupError = seqGroups.readGroupFile(groupfile);
+            if (groupError == 1) { return 0; }
+            vector<string> allGroups = seqGroups.getNamesOfGroups();
             m->setAllGroups(allGroups);
         }else{
-            countTable = new CountTable();
-            countTable->readTable(countfile, true, false);
+            seqGroups.readCountTable(countfile);
         }
+        vector<string> allGroups = seqGroups.getNamesOfGroups();
 
         if (m->control_pressed) { return 0; }
 
@@ -802,8 +799,7 @@ int SharedCommand::createSharedFromListGroup() {
 
         //if hte user has not specified any groups then use them all
         if (Groups.size() == 0) {
-            if (groupfile != "") { Groups = groupMap->getNamesOfGroups();  }
-            else {  Groups = countTable->getNamesOfGroups();  }
+            Groups = allGroups;
             m->setGroups(Groups);
         }else { pickedGroups = true; }
 
@@ -811,7 +807,7 @@ int SharedCommand::createSharedFromListGroup() {
         ofstream out;
         string filename = "";
         if (!pickedGroups) {
-            string filename = listfile;
+            filename = listfile;
             if (outputDir == "") { outputDir += m->hasPath(filename); }
 
             map<string, string> variables;
@@ -827,38 +823,50 @@ int SharedCommand::createSharedFromListGroup() {
 		variables["[filename]"] = fileroot;
         string errorOff = "no error";
 
-        InputData input(listfile, "shared");
-        SharedListVector* SharedList = input.getSharedListVector();
-        string lastLabel = SharedList->getLabel();
-        vector<SharedRAbundVector*> lookup;
+        ifstream in;
+        m->openInputFile(listfile, in);
+
+        vector<string> binLabels = readListHeaders(in);
+        map<string, unsigned long long> labelPositions;
+        string label = "";
+        int numBins = 0;
+        if (!readListLabel(in, label, numBins, labelPositions)) {
+            in.close(); if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
+            return 0;
+        }
+        string lastLabel = label;
 
         if (m->control_pressed) {
-            delete SharedList; if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
-            out.close(); if (!pickedGroups) { m->mothurRemove(filename); }
+            in.close(); if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
             return 0;
         }
 
-        //sanity check
-        vector<string> namesSeqs;
-        int numGroupNames = 0;
-        if (m->groupMode == "group") { namesSeqs = groupMap->getNamesSeqs(); numGroupNames = groupMap->getNumSeqs(); }
-        else { namesSeqs = countTable->getNamesOfSeqs(); numGroupNames = countTable->getNumUniqueSeqs(); }
-        int error = ListGroupSameSeqs(namesSeqs, SharedList);
-
-        if ((!pickedGroups) && (SharedList->getNumSeqs() != numGroupNames)) {  //if the user has not specified any groups and their files don't match exit with error
-            m->mothurOut("Your group file contains " + toString(numGroupNames) + " sequences and list file contains " + toString(SharedList->getNumSeqs()) + " sequences. Please correct."); m->mothurOutEndLine(); m->control_pressed = true;
+        //sanity check, counting the first label marks the names found in the list file
+        vector< vector<int> > abunds;
+        vector<bool> found(seqGroups.getNumSeqs(), false);
+        int numListSeqs = 0;
+        int error = fillListAbundances(in, numBins, seqGroups, abunds, &found, numListSeqs);
+
+        vector<int> sortedSeqs = seqGroups.getSeqsSortedByName();
+        for (int i = 0; i < sortedSeqs.size(); i++) {
+            if (!found[sortedSeqs[i]]) {
+                error = 1;
+                m->mothurOut("[ERROR]: " + seqGroups.getName(sortedSeqs[i]) + " is in your groupfile and not your listfile. Please correct."); m->mothurOutEndLine();
+            }
+        }
+        found.clear();
 
-            out.close(); if (!pickedGroups) { m->mothurRemove(filename); } //remove blank shared file you made
+        if ((!pickedGroups) && (numListSeqs != seqGroups.getNumSeqs())) {  //if the user has not specified any groups and their files don't match exit with error
+            m->mothurOut("Your group file contains " + toString(seqGroups.getNumSeqs()) + " sequences and list file contains " + toString(numListSeqs) + " sequences. Please correct."); m->mothurOutEndLine(); m->control_pressed = true;
 
-            //delete memory
-            delete SharedList; if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
+            in.close(); out.close(); m->mothurRemove(filename); //remove blank shared file you made
             return 0;
         }
 
         if (error == 1) { m->control_pressed = true; }
 
         //if user has specified groups make new groupfile for them
-        if ((pickedGroups) && (m->groupMode == "group")) { //make new group file
+        if ((pickedGroups) && (groupfile != "")) { //make new group file
             string groups = "";
             if (m->getNumGroups() < 4) {
                 for (int i = 0; i < m->getNumGroups()-1; i++) {
@@ -875,128 +883,69 @@ int SharedCommand::createSharedFromListGroup() {
             ofstream outGroups;
             m->openOutputFile(newGroupFile, outGroups);
 
-            vector<string> names = groupMap->getNamesSeqs();
+            vector<string> userGroups = m->getGroups();
             string groupName;
-            for (int i = 0; i < names.size(); i++) {
-                groupName = groupMap->getGroup(names[i]);
-                if (isValidGroup(groupName, m->getGroups())) {
-                    outGroups << names[i] << '\t' << groupName << endl;
+            for (int i = 0; i < sortedSeqs.size(); i++) {
+                groupName = seqGroups.getGroup(sortedSeqs[i]);
+                if (isValidGroup(groupName, userGroups)) {
+                    outGroups << seqGroups.getName(sortedSeqs[i]) << '\t' << groupName << endl;
                 }
             }
             outGroups.close();
         }
+        sortedSeqs.clear();
 
         //if the users enters label "0.06" and there is no "0.06" in their file use the next lowest label.
         set<string> processedLabels;
         set<string> userLabels = labels;
-    
-        while((SharedList != NULL) && ((allLines == 1) || (userLabels.size() != 0))) {
+        bool haveLabel = true;
+        bool filled = true; //abunds holds the counts of the current label
+
+        while(haveLabel && ((allLines == 1) || (userLabels.size() != 0))) {
             if (m->control_pressed) {
-                delete SharedList; if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
-                if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
+                in.close(); if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
                 return 0;
             }
 
-            if(allLines == 1 || labels.count(SharedList->getLabel()) == 1){
-
-                lookup = SharedList->getSharedRAbundVector();
-
-                m->mothurOut(lookup[0]->getLabel()); m->mothurOutEndLine();
-
-                if (m->control_pressed) {
-                    delete SharedList; if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
-                    for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
-                    if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
-                    return 0;
-                }
-
-                //if picked groups must split the shared file by label
-                if (pickedGroups) {
-                    string filename = listfile;
-                    if (outputDir == "") { outputDir += m->hasPath(filename); }
-
-                    map<string, string> variables;
-                    variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(filename));
-                    variables["[distance]"] = lookup[0]->getLabel();
-                    filename = getOutputFileName("shared",variables);
-                    outputNames.push_back(filename); outputTypes["shared"].push_back(filename);
-                    ofstream out2;
-                    m->openOutputFile(filename, out2);
-
-                    vector<string> savedLabels = m->currentSharedBinLabels;
-                    eliminateZeroOTUS(lookup);
-                    lookup[0]->printHeaders(out2);
-                    printSharedData(lookup, out2);
-                    out2.close();
-                    m->currentSharedBinLabels = savedLabels; //restore old labels
-
-                }else {
-                    if (!m->printedSharedHeaders) { lookup[0]->printHeaders(out); }
-                    printSharedData(lookup, out); //prints info to the .shared file
-                }
-                for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
-
-                processedLabels.insert(SharedList->getLabel());
-                userLabels.erase(SharedList->getLabel());
-            }
-
-            if ((m->anyLabelsToProcess(SharedList->getLabel(), userLabels, errorOff) == true) && (processedLabels.count(lastLabel) != 1)) {
-                string saveLabel = SharedList->getLabel();
-
-                delete SharedList;
-                SharedList = input.getSharedListVector(lastLabel); //get new list vector to process
+            if(allLines == 1 || labels.count(label) == 1){
 
-                lookup = SharedList->getSharedRAbundVector();
-                m->mothurOut(lookup[0]->getLabel()); m->mothurOutEndLine();
+                if (!filled) { fillListAbundances(in, numBins, seqGroups, abunds, NULL, numListSeqs); }
+                printSharedLabel(label, numBins, binLabels, allGroups, abunds, out);
 
-                if (m->control_pressed) {
-                    delete SharedList; if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
-                    for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
-                    if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
-                    return 0;
-                }
+                processedLabels.insert(label);
+                userLabels.erase(label);
+            }else if (!filled) { m->getline(in); m->gobble(in); } //skip the otus of this label
 
-                //if picked groups must split the shared file by label
-                if (pickedGroups) {
-                    string filename = listfile;
-                    if (outputDir == "") { outputDir += m->hasPath(filename); }
-
-                    map<string, string> variables;
-                    variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(filename));
-                    variables["[distance]"] = lookup[0]->getLabel();
-                    filename = getOutputFileName("shared",variables);
-                    outputNames.push_back(filename); outputTypes["shared"].push_back(filename);
-                    ofstream out2;
-                    m->openOutputFile(filename, out2);
-
-                    vector<string> savedLabels = m->currentSharedBinLabels;
-                    eliminateZeroOTUS(lookup);
-                    lookup[0]->printHeaders(out2);
-                    printSharedData(lookup, out2);
-                    out2.close();
-                    m->currentSharedBinLabels = savedLabels; //restore old labels
-
-                }else {
-                    if (!m->printedSharedHeaders) { lookup[0]->printHeaders(out); }
-                    printSharedData(lookup, out); //prints info to the .shared file
-                }
+            if ((m->anyLabelsToProcess(label, userLabels, errorOff) == true) && (processedLabels.count(lastLabel) != 1)) {
+                string saveLabel = label;
+                int saveNumBins = numBins;
+                unsigned long long next = in.tellg();
 
-                for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
+                //go back to the last label
+                in.clear(); in.seekg(labelPositions[lastLabel]);
+                readListLabel(in, label, numBins, labelPositions);
+                fillListAbundances(in, numBins, seqGroups, abunds, NULL, numListSeqs);
+                printSharedLabel(label, numBins, binLabels, allGroups, abunds, out);
 
-                processedLabels.insert(SharedList->getLabel());
-                userLabels.erase(SharedList->getLabel());
+                processedLabels.insert(label);
+                userLabels.erase(label);
 
                 //restore real lastlabel to save below
-                SharedList->setLabel(saveLabel);
+                label = saveLabel; numBins = saveNumBins;
+                in.clear(); in.seekg(next);
             }
 
+            lastLabel = label;
 
-            lastLabel = SharedList->getLabel();
+            haveLabel = readListLabel(in, label, numBins, labelPositions);
+            filled = false;
+        }
 
-            delete SharedList;
-            SharedList = input.getSharedListVector(); //get new list vector to process
+        if (m->control_pressed) {
+            in.close(); if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
+            return 0;
         }
-        
+
         //output error messages about any remaining user labels
         set<string>::iterator it;
         bool needToRun = false;
@@ -1005,62 +954,257 @@ int SharedCommand::createSharedFromListGroup() {
                 needToRun = true;
             }
         }
-        
+
         //run last label if you need to
         if (needToRun == true)  {
-            if (SharedList != NULL) {	delete SharedList;	}
-            SharedList = input.getSharedListVector(lastLabel); //get new list vector to process
+            in.clear(); in.seekg(labelPositions[lastLabel]);
+            readListLabel(in, label, numBins, labelPositions);
+            fillListAbundances(in, numBins, seqGroups, abunds, NULL, numListSeqs);
+            printSharedLabel(label, numBins, binLabels, allGroups, abunds, out);
+        }
+        in.close();
 
-            lookup = SharedList->getSharedRAbundVector();
-            m->mothurOut(lookup[0]->getLabel()); m->mothurOutEndLine();
+        if (!pickedGroups) { out.close(); }
 
-            if (m->control_pressed) {
-                if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
-                if (!pickedGroups) { out.close(); m->mothurRemove(filename); }
-                return 0;
+        if (m->control_pressed) {
+            if (!pickedGroups) { m->mothurRemove(filename); }
+            return 0;
+        }
+
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SharedCommand", "createSharedFromListGroup");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//reads the header line of a list file if it has one, otherwise makes the otu labels of the first row the way SharedListVector does
+vector<string> SharedCommand::readListHeaders(ifstream& in) {
+	try {
+        vector<string> binLabels;
+
+        unsigned long long start = in.tellg();
+        string label = "";
+        in >> label;
+
+        if (label == "label") {
+            //gets "numOtus"
+            in >> label; m->gobble(in);
+
+            //eat rest of line
+            label = m->getline(in); m->gobble(in);
+
+            //parse labels to save
+            istringstream iStringStream(label);
+            while(!iStringStream.eof()){
+                if (m->control_pressed) { break; }
+                string temp;
+                iStringStream >> temp;  m->gobble(iStringStream);
+
+                binLabels.push_back(temp);
             }
+        }else {
+            int hold = 0;
+            in >> hold;
+            in.clear(); in.seekg(start);
 
-            //if picked groups must split the shared file by label
-            if (pickedGroups) {
-                string filename = listfile;
-                if (outputDir == "") { outputDir += m->hasPath(filename); }
-
-                map<string, string> variables;
-                variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(filename));
-                variables["[distance]"] = lookup[0]->getLabel();
-                filename = getOutputFileName("shared",variables);
-                outputNames.push_back(filename); outputTypes["shared"].push_back(filename);
-                ofstream out2;
-                m->openOutputFile(filename, out2);
-
-                vector<string> savedLabels = m->currentSharedBinLabels;
-                eliminateZeroOTUS(lookup);
-                lookup[0]->printHeaders(out2);
-                printSharedData(lookup, out2);
-                out2.close();
-                m->currentSharedBinLabels = savedLabels; //restore old labels
-
-            }else {
-                if (!m->printedSharedHeaders) { lookup[0]->printHeaders(out); }
-                printSharedData(lookup, out); //prints info to the .shared file
+            string snumBins = toString(hold);
+            for (int i = 0; i < hold; i++) {
+                string binLabel = "Otu";
+                string sbinNumber = toString(i+1);
+                if (sbinNumber.length() < snumBins.length()) {
+                    int diff = snumBins.length() - sbinNumber.length();
+                    for (int h = 0; h < diff; h++) { binLabel += "0"; }
+                }
+                binLabel += sbinNumber;
+                binLabels.push_back(binLabel);
             }
-            for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
-            delete SharedList;
         }
-        
-        if (!pickedGroups) { out.close(); }
+        m->listBinLabelsInFile = binLabels;
 
-        if (groupMap != NULL) { delete groupMap; } if (countTable != NULL) { delete countTable; }
+        return binLabels;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SharedCommand", "readListHeaders");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//reads the label and number of otus of the next row, saving where the first row with that label starts
+bool SharedCommand::readListLabel(ifstream& in, string& label, int& numBins, map<string, unsigned long long>& labelPositions) {
+	try {
+        m->gobble(in);
+        if (in.eof()) { return false; }
 
-        if (m->control_pressed) {
-            if (!pickedGroups) { m->mothurRemove(filename); }
-            return 0;
+        unsigned long long start = in.tellg();
+        in >> label >> numBins;
+        if (in.fail()) { return false; }
+
+        if (labelPositions.count(label) == 0) { labelPositions[label] = start; }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SharedCommand", "readListLabel");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//reads the otus of a row one at a time, adding the abundance of each name to its groups. found marks the names seen
+//and reports names that are not in the group file or are in the list file twice.
+int SharedCommand::fillListAbundances(ifstream& in, int numBins, NameGroupIndex& seqGroups, vector< vector<int> >& abunds, vector<bool>* found, int& numSeqs) {
+	try {
+        int error = 0;
+        numSeqs = 0;
+
+        abunds.assign(seqGroups.getNumGroups(), vector<int>(numBins, 0));
+
+        string bin = "";
+        for (int i = 0; i < numBins; i++) {
+            if (m->control_pressed) { break; }
+
+            in >> bin;
+            numSeqs += m->getNumNames(bin);
+
+            int start = 0;
+            for (int j = 0; j <= bin.length(); j++) {
+                if ((j != bin.length()) && (bin[j] != ',')) { continue; }
+
+                string name = bin.substr(start, j-start);
+                start = j+1;
+
+                int seqIndex = seqGroups.getIndex(name);
+                if (found != NULL) {
+                    if ((seqIndex == -1) || ((*found)[seqIndex])) {
+                        error = 1;
+                        if (groupfile != "") {
+                            m->mothurOut("[ERROR]: " + name + " is in your listfile and not in your groupfile. Please correct."); m->mothurOutEndLine();	}
+                        else{ m->mothurOut("[ERROR]: " + name + " is in your listfile and not in your count file. Please correct."); m->mothurOutEndLine();	}
+                    }else { (*found)[seqIndex] = true; }
+                }else if (seqIndex == -1) {
+                    m->mothurOut("Error: Sequence '" + name + "' was not found in the group file, please correct."); m->mothurOutEndLine(); m->control_pressed = true; break;
+                }
+
+                if (seqIndex != -1) { seqGroups.addCounts(seqIndex, i, abunds); }
+            }
         }
-        
+        m->gobble(in);
+
+        return error;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SharedCommand", "fillListAbundances");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//prints the rows of a label straight from the abundances of its groups, the way getSharedRAbundVector, eliminateZeroOTUS and printSharedData did
+int SharedCommand::printSharedLabel(string label, int numBins, vector<string>& binLabels, vector<string>& allGroups, vector< vector<int> >& abunds, ofstream& out) {
+	try {
+        if (m->control_pressed) { return 0; }
+
+        m->currentSharedBinLabels.assign(binLabels.begin(), binLabels.begin()+min((int)binLabels.size(), numBins));
+
+        //the groups the user selected
+        SharedUtil util;
+        vector<string> userGroups = m->getGroups();
+        vector<string> holdGroups = allGroups;
+        util.setGroups(userGroups, holdGroups);
+        m->setGroups(userGroups);
+
+        vector<int> selected;
+        for (int i = 0; i < allGroups.size(); i++) {
+            if (m->inUsersGroups(allGroups[i], m->getGroups())) { selected.push_back(i); }
+        }
+
+        m->mothurOut(label); m->mothurOutEndLine();
+
+        //groups are sorted unless the user gave an order
+        vector<int> printed;
+        if (order.size() == 0) { printed = selected; }
+        else {
+            for (int i = 0; i < order.size(); i++) {
+                int groupIndex = -1;
+                for (int j = 0; j < selected.size(); j++) { if (allGroups[selected[j]] == order[i]) { groupIndex = selected[j]; break; } }
+
+                if (groupIndex != -1) { printed.push_back(groupIndex); }
+                else { m->mothurOut("Can't find shared info for " + order[i] + ", skipping."); m->mothurOutEndLine(); }
+            }
+        }
+
+        vector<int> bins;
+        ofstream out2;
+        vector<string> savedLabels;
+
+        //if picked groups must split the shared file by label and remove the otus the groups don't have
+        if (pickedGroups) {
+            string filename = listfile;
+            if (outputDir == "") { outputDir += m->hasPath(filename); }
+
+            map<string, string> variables;
+            variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(filename));
+            variables["[distance]"] = label;
+            filename = getOutputFileName("shared",variables);
+            outputNames.push_back(filename); outputTypes["shared"].push_back(filename);
+            m->openOutputFile(filename, out2);
+
+            savedLabels = m->currentSharedBinLabels;
+            vector<string> newBinLabels;
+            string snumBins = toString(numBins);
+            for (int i = 0; i < numBins; i++) {
+                bool allZero = true;
+                for (int j = 0; j < selected.size(); j++) {
+                    if (abunds[selected[j]][i] != 0) { allZero = false;  break;  }
+                }
+                if (allZero) { continue; }
+
+                bins.push_back(i);
+
+                //if there is a bin label use it otherwise make one
+                string binLabel = "Otu";
+                string sbinNumber = toString(i+1);
+                if (sbinNumber.length() < snumBins.length()) {
+                    int diff = snumBins.length() - sbinNumber.length();
+                    for (int h = 0; h < diff; h++) { binLabel += "0"; }
+                }
+                binLabel += sbinNumber;
+                if (i < m->currentSharedBinLabels.size()) {  binLabel = m->currentSharedBinLabels[i]; }
+
+                newBinLabels.push_back(binLabel);
+            }
+            m->currentSharedBinLabels = newBinLabels;
+
+            SharedRAbundVector headers(bins.size());
+            headers.printHeaders(out2);
+        }else {
+            for (int i = 0; i < numBins; i++) { bins.push_back(i); }
+
+            if (!m->printedSharedHeaders) { SharedRAbundVector headers(numBins); headers.printHeaders(out); }
+        }
+
+        ofstream& output = (pickedGroups ? out2 : out);
+        vector<string> Groups;
+        for (int i = 0; i < printed.size(); i++) {
+            vector<int>& counts = abunds[printed[i]];
+
+            output << label << '\t' << allGroups[printed[i]] << '\t' << bins.size();
+            for (int j = 0; j < bins.size(); j++) { output << '\t' << counts[bins[j]]; }
+            output << endl;
+
+            Groups.push_back(allGroups[printed[i]]);
+        }
+        m->setGroups(Groups);
+
+        if (pickedGroups) {
+            out2.close();
+            m->currentSharedBinLabels = savedLabels; //restore old labels
+        }
+
         return 0;
     }
 	catch(exception& e) {
-		m->errorOut(e, "SharedCommand", "createSharedFromListGroup");
+		m->errorOut(e, "SharedCommand", "printSharedLabel");
 		exit(1);
 	}
 }
@@ -1119,49 +1263,6 @@ void SharedCommand::printSharedData(vector<SharedRAbundVector*> thislookup, ofst
 	}
 }
 //**********************************************************************************************************************
-int SharedCommand::ListGroupSameSeqs(vector<string>& groupMapsSeqs, SharedListVector* SharedList) {
-	try {
-		int error = 0;
-
-		set<string> groupNamesSeqs;
-		for(int i = 0; i < groupMapsSeqs.size(); i++) {
-			groupNamesSeqs.insert(groupMapsSeqs[i]);
-		}
-
-		//go through list and if group returns "not found" output it
-		for (int i = 0; i < SharedList->getNumBins(); i++) {
-			if (m->control_pressed) { return 0; }
-
-			string names = SharedList->get(i);
-
-			vector<string> listNames;
-			m->splitAtComma(names, listNames);
-
-			for (int j = 0; j < listNames.size(); j++) {
-				int num = groupNamesSeqs.count(listNames[j]);
-
-				if (num == 0) {
-                    error = 1;
-                    if (groupfile != "") {
-                        m->mothurOut("[ERROR]: " + listNames[j] + " is in your listfile and not in your groupfile. Please correct."); m->mothurOutEndLine();	}
-                    else{ m->mothurOut("[ERROR]: " + listNames[j] + " is in your listfile and not in your count file. Please correct."); m->mothurOutEndLine();	}
-                }else { groupNamesSeqs.erase(listNames[j]); }
-			}
-		}
-
-		for (set<string>::iterator itGroupSet = groupNamesSeqs.begin(); itGroupSet != groupNamesSeqs.end(); itGroupSet++) {
-			error = 1;
-			m->mothurOut("[ERROR]: " + (*itGroupSet) + " is in your groupfile and not your listfile. Please correct."); m->mothurOutEndLine();
-		}
-
-		return error;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "SharedCommand", "ListGroupSameSeqs");
-		exit(1);
-	}
-}
-//**********************************************************************************************************************
 
 SharedCommand::~SharedCommand(){
 	//delete list;
@@ -12,6 +12,7 @@
 #include "command.hpp"
 #include "sharedlistvector.h"
 #include "inputdata.h"
+#include "namegroupindex.h"
 
 /* The shared() command:
 	The shared command can only be executed after a successful read.shared command.  
@@ -44,8 +45,11 @@ private:
 	int readOrderFile();
 	bool isValidGroup(string, vector<string>);
 	int eliminateZeroOTUS(vector<SharedRAbundVector*>&);
-	int ListGroupSameSeqs(vector<string>&, SharedListVector*);
     int createSharedFromListGroup();
+    vector<string> readListHeaders(ifstream&);
+    bool readListLabel(ifstream&, string&, int&, map<string, unsigned long long>&);
+    int fillListAbundances(ifstream&, int, NameGroupIndex&, vector< vector<int> >&, vector<bool>*, int&);
+    int printSharedLabel(string, int, vector<string>&, vector<string>&, vector< vector<int> >&, ofstream&);
     int createSharedFromBiom();
     string getTag(string&);
     vector<string> readRows(string, int&);
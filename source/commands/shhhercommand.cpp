@@ -740,7 +740,7 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 vector<string> seqNameVector;
                 vector<int> lengths;
                 vector<short> flowDataIntI;
-                vector<double> flowDataPrI;
+                vector<float> flowDataPrI;
                 map<string, int> nameMap;
                 vector<short> uniqueFlowgrams;
                 vector<int> uniqueCount;
@@ -760,24 +760,22 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 if (m->control_pressed) { break; }
                 
                 m->mothurOut("Calculating distances between flowgrams...\n");
-                string distFileName = flowFileName.substr(0,flowFileName.find_last_of('.')) + ".shhh.dist";
                 begTime = time(NULL);
                
-                
-                flowDistParentFork(numFlowCells, distFileName, numUniques, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
+                //distances are kept in memory, only pairs within the cutoff are stored
+                SparseDistanceMatrix* distMatrix = new SparseDistanceMatrix();
+                flowDistParentFork(numFlowCells, distMatrix, numUniques, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
                 
                 m->mothurOutEndLine();
                 m->mothurOut("Total time: " + toString(time(NULL) - begTime) + '\t' + toString((clock() - begClock)/CLOCKS_PER_SEC) + '\n');
                 
+                ListVector* uniqueList = createNamesList(numSeqs, numUniques, seqNameVector, mapSeqToUnique);
                 
-                string namesFileName = flowFileName.substr(0,flowFileName.find_last_of('.')) + ".shhh.names";
-                createNamesFile(numSeqs, numUniques, namesFileName, seqNameVector, mapSeqToUnique, mapUniqueToSeq);
-                
-                if (m->control_pressed) { break; }
+                if (m->control_pressed) { delete distMatrix; delete uniqueList; break; }
                 
                 m->mothurOut("\nClustering flowgrams...\n");
                 string listFileName = flowFileName.substr(0,flowFileName.find_last_of('.')) + ".shhh.list";
-                cluster(listFileName, distFileName, namesFileName);
+                cluster(listFileName, distMatrix, uniqueList);
                 
                 if (m->control_pressed) { break; }
                 
@@ -794,8 +792,6 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 
                 if (m->control_pressed) { break; }
                 
-                m->mothurRemove(distFileName);
-                m->mothurRemove(namesFileName);
                 m->mothurRemove(listFileName);
                 
                 vector<double> dist;		//adDist - distance of sequences to centroids
@@ -1017,42 +1013,59 @@ int ShhherCommand::getFlowData(string filename, vector<string>& thisSeqNameVecto
 }
 /**************************************************************************************************/
 
-int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
+int ShhherCommand::flowDistParentFork(int numFlowCells, SparseDistanceMatrix* distMatrix, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<float>& flowDataPrI, vector<short>& flowDataIntI){
 	try{		
-        
-		ostringstream outStream;
-		outStream.setf(ios::fixed, ios::floatfield);
-		outStream.setf(ios::dec, ios::basefield);
-		outStream.setf(ios::showpoint);
-		outStream.precision(6);
 		
 		int begTime = time(NULL);
 		double begClock = clock();
         
-		for(int i=0;i<stopSeq;i++){
+        distMatrix->resize(stopSeq);
+        
+        //rows are done in blocks so each flowgram in the columns is pulled into the cache once per block instead of once per row
+        vector<float> blockDists;
+        
+		for(int blockStart=0;blockStart<stopSeq;blockStart+=DIST_BLOCK_SIZE){
 			
 			if (m->control_pressed) { break; }
 			
-			for(int j=0;j<i;j++){
-				float flowDistance = calcPairwiseDist(numFlowCells, mapUniqueToSeq[i], mapUniqueToSeq[j], mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
+            int blockEnd = blockStart + DIST_BLOCK_SIZE;
+            if (blockEnd > stopSeq) { blockEnd = stopSeq; }
+            blockDists.assign((blockEnd - blockStart) * blockEnd, 0);
+            
+            for(int j=0;j<blockEnd-1;j++){
                 
-				if(flowDistance < 1e-6){
-					outStream << mapUniqueToSeq[i] << '\t' << mapUniqueToSeq[j] << '\t' << 0.000000 << endl;
-				}
-				else if(flowDistance <= cutoff){
-					outStream << mapUniqueToSeq[i] << '\t' << mapUniqueToSeq[j] << '\t' << flowDistance << endl;
-				}
-			}
-			if(i % 100 == 0){
-				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - begTime));
-				m->mothurOutJustToScreen("\t" + toString((clock()-begClock)/CLOCKS_PER_SEC)+"\n");
-			}
+                if (m->control_pressed) { break; }
+                
+                int firstRow = blockStart;
+                if (firstRow <= j) { firstRow = j + 1; }
+                
+                for(int i=firstRow;i<blockEnd;i++){
+                    blockDists[(i - blockStart) * blockEnd + j] = calcPairwiseDist(numFlowCells, mapUniqueToSeq[i], mapUniqueToSeq[j], mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
+                }
+            }
+            
+            if (m->control_pressed) { break; }
+            
+            //add the cells in the same order and at the same precision the column file used, so the clustering is unchanged
+            for(int i=blockStart;i<blockEnd;i++){
+                int rowOffset = (i - blockStart) * blockEnd;
+                for(int j=0;j<i;j++){
+                    float flowDistance = blockDists[rowOffset + j];
+                    
+                    if(flowDistance < 1e-6)	{	flowDistance = 0.0;	}
+                    else					{	flowDistance = (float)(floor(flowDistance * 1e6 + 0.5) / 1e6);	}
+                    
+                    if(flowDistance < cutoff){
+                        PDistCell value(i, flowDistance);
+                        distMatrix->addCell(j, value);
+                    }
+                }
+            }
+            
+            m->mothurOutJustToScreen(toString(blockStart) + "\t" + toString(time(NULL) - begTime));
+            m->mothurOutJustToScreen("\t" + toString((clock()-begClock)/CLOCKS_PER_SEC)+"\n");
 		}
 		
-		ofstream distFile(distFileName.c_str());
-		distFile << outStream.str();		
-		distFile.close();
-		
 		if (m->control_pressed) {}
 		else {
 			m->mothurOutJustToScreen(toString(stopSeq-1) + "\t" + toString(time(NULL) - begTime));
@@ -1068,26 +1081,25 @@ int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int
 }
 /**************************************************************************************************/
 
-float ShhherCommand::calcPairwiseDist(int numFlowCells, int seqA, int seqB, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
+float ShhherCommand::calcPairwiseDist(int numFlowCells, int seqA, int seqB, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<float>& flowDataPrI, vector<short>& flowDataIntI){
 	try{
 		int minLength = lengths[mapSeqToUnique[seqA]];
 		if(lengths[seqB] < minLength){	minLength = lengths[mapSeqToUnique[seqB]];	}
 		
 		int ANumFlowCells = seqA * numFlowCells;
 		int BNumFlowCells = seqB * numFlowCells;
+        
+        const short* flowAIntI = &flowDataIntI[ANumFlowCells];
+        const short* flowBIntI = &flowDataIntI[BNumFlowCells];
+        const float* flowAPrI = &flowDataPrI[ANumFlowCells];
+        const float* flowBPrI = &flowDataPrI[BNumFlowCells];
+        const double* joint = &jointLookUp[0];
 		
 		float dist = 0;
 		
+        //no control_pressed check in here so the compiler is free to unroll and vectorize, the callers check between pairs
 		for(int i=0;i<minLength;i++){
-			
-			if (m->control_pressed) { break; }
-			
-			int flowAIntI = flowDataIntI[ANumFlowCells + i];
-			float flowAPrI = flowDataPrI[ANumFlowCells + i];
-			
-			int flowBIntI = flowDataIntI[BNumFlowCells + i];
-			float flowBPrI = flowDataPrI[BNumFlowCells + i];
-			dist += jointLookUp[flowAIntI * NUMBINS + flowBIntI] - flowAPrI - flowBPrI;
+			dist += joint[flowAIntI[i] * NUMBINS + flowBIntI[i]] - flowAPrI[i] - flowBPrI[i];
 		}
 		
 		dist /= (float) minLength;
@@ -1100,8 +1112,7 @@ float ShhherCommand::calcPairwiseDist(int numFlowCells, int seqA, int seqB, vect
 }
 
 /**************************************************************************************************/
-
-int ShhherCommand::getUniques(int numSeqs, int numFlowCells, vector<short>& uniqueFlowgrams, vector<int>& uniqueCount, vector<int>& uniqueLengths, vector<int>& mapSeqToUnique, vector<int>& mapUniqueToSeq, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
+int ShhherCommand::getUniques(int numSeqs, int numFlowCells, vector<short>& uniqueFlowgrams, vector<int>& uniqueCount, vector<int>& uniqueLengths, vector<int>& mapSeqToUnique, vector<int>& mapUniqueToSeq, vector<int>& lengths, vector<float>& flowDataPrI, vector<short>& flowDataIntI){
 	try{
 		int numUniques = 0;
 		uniqueFlowgrams.assign(numFlowCells * numSeqs, -1);
@@ -1176,7 +1187,7 @@ int ShhherCommand::getUniques(int numSeqs, int numFlowCells, vector<short>& uniq
 	}
 }
 /**************************************************************************************************/
-int ShhherCommand::createNamesFile(int numSeqs, int numUniques, string filename, vector<string>& seqNameVector, vector<int>& mapSeqToUnique, vector<int>& mapUniqueToSeq){
+ListVector* ShhherCommand::createNamesList(int numSeqs, int numUniques, vector<string>& seqNameVector, vector<int>& mapSeqToUnique){
 	try{
 		
 		vector<string> duplicateNames(numUniques, "");
@@ -1184,43 +1195,28 @@ int ShhherCommand::createNamesFile(int numSeqs, int numUniques, string filename,
 			duplicateNames[mapSeqToUnique[i]] += seqNameVector[i] + ',';
 		}
 		
-		ofstream nameFile;
-		m->openOutputFile(filename, nameFile);
+		//one bin per unique flowgram, in the same order as the rows of the distance matrix
+		ListVector* list = new ListVector();
 		
 		for(int i=0;i<numUniques;i++){
 			
 			if (m->control_pressed) { break; }
 			
-            //			nameFile << seqNameVector[mapUniqueToSeq[i]] << '\t' << duplicateNames[i].substr(0, duplicateNames[i].find_last_of(',')) << endl;
-			nameFile << mapUniqueToSeq[i] << '\t' << duplicateNames[i].substr(0, duplicateNames[i].find_last_of(',')) << endl;
+			list->push_back(duplicateNames[i].substr(0, duplicateNames[i].find_last_of(',')));
 		}
-		
-		nameFile.close();
+		list->setLabel("0");
         
-		return 0;
+		return list;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "ShhherCommand", "createNamesFile");
+		m->errorOut(e, "ShhherCommand", "createNamesList");
 		exit(1);
 	}
 }
 //**********************************************************************************************************************
 
-int ShhherCommand::cluster(string filename, string distFileName, string namesFileName){
+int ShhherCommand::cluster(string filename, SparseDistanceMatrix* matrix, ListVector* list){
 	try {
-		
-		ReadMatrix* read = new ReadColumnMatrix(distFileName); 	
-		read->setCutoff(cutoff);
-		
-		NameAssignment* clusterNameMap = new NameAssignment(namesFileName);
-		clusterNameMap->readMap();
-		read->read(clusterNameMap);
-        
-		ListVector* list = read->getListVector();
-		SparseDistanceMatrix* matrix = read->getDMatrix();
-		
-		delete read; 
-		delete clusterNameMap; 
         
 		RAbundVector* rabund = new RAbundVector(list->getRAbundVector());
 		
@@ -1253,7 +1249,6 @@ int ShhherCommand::cluster(string filename, string distFileName, string namesFil
 	}		
 }
 /**************************************************************************************************/
-
 int ShhherCommand::getOTUData(int numSeqs, string fileName,  vector<int>& otuData,
                                vector<int>& cumNumSeqs,
                                vector<int>& nSeqsPerOTU,
@@ -1455,15 +1450,14 @@ double ShhherCommand::getDistToCentroid(int cent, int flow, int length, vector<s
                                         vector<short>& flowDataIntI, int numFlowCells){
 	try{
 		
-		int flowAValue = cent * numFlowCells;
-		int flowBValue = flow * numFlowCells;
+		const short* flowA = &uniqueFlowgrams[cent * numFlowCells];
+		const short* flowB = &flowDataIntI[flow * numFlowCells];
+		const double* single = &singleLookUp[0];
 		
 		double dist = 0;
         
 		for(int i=0;i<length;i++){
-			dist += singleLookUp[uniqueFlowgrams[flowAValue] * NUMBINS + flowDataIntI[flowBValue]];
-			flowAValue++;
-			flowBValue++;
+			dist += single[flowA[i] * NUMBINS + flowB[i]];
 		}
 		
 		return dist / (double)length;
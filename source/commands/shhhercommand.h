@@ -18,6 +18,7 @@
 #include "sabundvector.hpp"
 #include "listvector.hpp"
 #include "cluster.hpp"
+#include "sparsedistancematrix.h"
 #include <cfloat>
 
 //**********************************************************************************************************************
@@ -28,6 +29,7 @@
 #define MIN_WEIGHT 0.1
 #define MIN_TAU 0.0001
 #define MIN_ITER 10
+#define DIST_BLOCK_SIZE 64
 //**********************************************************************************************************************
 
 class ShhherCommand : public Command {
@@ -66,11 +68,11 @@ private:
     int driver(vector<string>, string, string);
     int createProcesses(vector<string>);
     int getFlowData(string, vector<string>&, vector<int>&, vector<short>&, map<string, int>&, int&);
-    int getUniques(int, int, vector<short>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
-    int flowDistParentFork(int, string, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
-    float calcPairwiseDist(int, int, int, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
-    int createNamesFile(int, int, string, vector<string>&, vector<int>&, vector<int>&);
-    int cluster(string, string, string);
+    int getUniques(int, int, vector<short>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<float>&, vector<short>&);
+    int flowDistParentFork(int, SparseDistanceMatrix*, int, vector<int>&, vector<int>&, vector<int>&, vector<float>&, vector<short>&);
+    float calcPairwiseDist(int, int, int, vector<int>&, vector<int>&, vector<float>&, vector<short>&);
+    ListVector* createNamesList(int, int, vector<string>&, vector<int>&);
+    int cluster(string, SparseDistanceMatrix*, ListVector*);
     int getOTUData(int numSeqs, string,  vector<int>&, vector<int>&, vector<int>&, vector<vector<int> >&, vector<vector<int> >&, vector<int>&, vector<int>&,map<string, int>&);
     int calcCentroidsDriver(int numOTUs, vector<int>&, vector<int>&, vector<int>&, vector<short>&, vector<int>&, vector<double>&, vector<int>&, vector<short>&, vector<short>&, vector<int>&, int, vector<int>&);
     double getDistToCentroid(int, int, int, vector<short>&, vector<short>&, int);
@@ -196,6 +196,7 @@ int SparccCommand::execute(){
         int start = time(NULL);
         
         InputData input(sharedfile, "sharedfile");
+        input.setLabels(labels);
         vector<SharedRAbundVector*> lookup = input.getSharedRAbundVectors();
         string lastLabel = lookup[0]->getLabel();
         
@@ -297,6 +297,7 @@ int SplitAbundCommand::execute(){
 			set<string> userLabels = labels;	
 			
 			InputData input(listfile, "list");
+			input.setLabels(labels);
 			ListVector* list = input.getListVector();
 			string lastLabel = list->getLabel();
 			
@@ -831,6 +831,7 @@ int SubSampleCommand::getSubSampleShared() {
 	try {
 		
 		InputData* input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		vector<SharedRAbundVector*> lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 		
@@ -995,6 +996,7 @@ int SubSampleCommand::getSubSampleList() {
 		if (namefile != "") { m->readNames(namefile, nameMap); }
         
 		InputData* input = new InputData(listfile, "list");
+		input->setLabels(labels);
 		ListVector* list = input->getListVector();
 		string lastLabel = list->getLabel();
 		
@@ -406,6 +406,7 @@ int SummaryCommand::execute(){
             }
 		
 			input = new InputData(inputFileNames[p], format);
+			input->setLabels(labels);
 			sabund = input->getSAbundVector();
 			string lastLabel = sabund->getLabel();
 		
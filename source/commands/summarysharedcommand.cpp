@@ -336,6 +336,7 @@ int SummarySharedCommand::execute(){
 		}
 			
 		input = new InputData(sharedfile, "sharedfile");
+		input->setLabels(labels);
 		lookup = input->getSharedRAbundVectors();
 		string lastLabel = lookup[0]->getLabel();
 	
@@ -990,6 +991,15 @@ int SummarySharedCommand::driver(vector<SharedRAbundVector*> thisLookup, int sta
 		m->openOutputFile(sumFile, outputFileHandle);
 		
 		vector<SharedRAbundVector*> subset;
+        
+        //calculators with pair stats work from the sparse table instead of the dense vectors
+        bool usePairStats = false;
+        for(int i=0;i<sumCalculators.size();i++) { if (sumCalculators[i]->hasPairStats()) { usePairStats = true; } }
+        
+        SharedOTUTable* table = NULL;
+        if (usePairStats) { table = new SharedOTUTable(thisLookup); }
+        SharedPairStats stats;
+        
 		for (int k = start; k < end; k++) { // pass cdd each set of groups to compare
 
 			for (int l = 0; l < k; l++) {
@@ -999,6 +1009,8 @@ int SummarySharedCommand::driver(vector<SharedRAbundVector*> thisLookup, int sta
 				subset.clear(); //clear out old pair of sharedrabunds
 				//add new pair of sharedrabunds
 				subset.push_back(thisLookup[k]); subset.push_back(thisLookup[l]); 
+                
+                if (usePairStats) { stats.fill(*table, k, l); }
 				
 				//sort groups to be alphanumeric
 				if (thisLookup[k]->getGroup() > thisLookup[l]->getGroup()) {
@@ -1017,9 +1029,11 @@ int SummarySharedCommand::driver(vector<SharedRAbundVector*> thisLookup, int sta
 						}
 					}
 					
-					vector<double> tempdata = sumCalculators[i]->getValues(subset); //saves the calculator outputs
+					vector<double> tempdata;
+                    if (sumCalculators[i]->hasPairStats())  {   tempdata = sumCalculators[i]->getPairValues(stats);  }
+                    else                                    {   tempdata = sumCalculators[i]->getValues(subset);     } //saves the calculator outputs
 					
-					if (m->control_pressed) { outputFileHandle.close(); return 1; }
+					if (m->control_pressed) { outputFileHandle.close(); if (table != NULL) { delete table; } return 1; }
 					
 					outputFileHandle << '\t';
 					sumCalculators[i]->print(outputFileHandle);
@@ -1030,6 +1044,8 @@ int SummarySharedCommand::driver(vector<SharedRAbundVector*> thisLookup, int sta
 				outputFileHandle << endl;
 			}
 		}
+        
+        if (table != NULL) { delete table; }
 		
 		outputFileHandle.close();
 		
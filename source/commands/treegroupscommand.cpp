@@ -411,6 +411,7 @@ int TreeGroupCommand::execute(){
 			if (treeCalculators.size() == 0) { m->mothurOut("You have given no valid calculators."); m->mothurOutEndLine(); return 0; }
 			
 			input = new InputData(sharedfile, "sharedfile");
+			input->setLabels(labels);
 			lookup = input->getSharedRAbundVectors();
 			lastLabel = lookup[0]->getLabel();
 			
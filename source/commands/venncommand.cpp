@@ -284,6 +284,7 @@ int VennCommand::execute(){
 		
 		venn = new Venn(outputDir, nseqs, inputfile, fontsize, sharedOtus); 
 		input = new InputData(inputfile, format);
+		input->setLabels(labels);
 		
 		string lastLabel;
 		
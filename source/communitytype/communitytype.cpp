@@ -198,16 +198,88 @@ void CommunityTypeFinder::printRelAbund(string fileName, vector<string> otuNames
 
 /**************************************************************************************************/
 
-vector<vector<double> > CommunityTypeFinder::getHessian(){
+void CommunityTypeFinder::groupCounts(){
     try {
-        vector<double> alpha(numOTUs, 0.0000);
+        countValues.assign(numOTUs, vector<int>());
+        countStarts.assign(numOTUs, vector<int>());
+        countSamples.assign(numOTUs, vector<int>());
+        sampleCounts.assign(numSamples, vector<pair<int, int> >());
+        sampleTotals.assign(numSamples, 0);
+        
+        for(int i=0;i<numSamples;i++){
+            for(int j=0;j<numOTUs;j++){ sampleTotals[i] += countMatrix[i][j]; }
+        }
+        
+        for(int j=0;j<numOTUs;j++){
+            if (m->control_pressed) {  return; }
+            
+            vector<pair<int, int> > nonzero; //count, sample
+            for(int i=0;i<numSamples;i++){
+                if(countMatrix[i][j] != 0){ nonzero.push_back(make_pair(countMatrix[i][j], i)); }
+            }
+            sort(nonzero.begin(), nonzero.end());
+            
+            for(int k=0;k<nonzero.size();k++){
+                if(k == 0 || nonzero[k].first != nonzero[k-1].first){
+                    countValues[j].push_back(nonzero[k].first);
+                    countStarts[j].push_back(k);
+                }
+                countSamples[j].push_back(nonzero[k].second);
+                sampleCounts[nonzero[k].second].push_back(make_pair(j, (int)countValues[j].size()-1));
+            }
+            countStarts[j].push_back((int)nonzero.size());
+        }
+    }
+    catch(exception& e){
+        m->errorOut(e, "CommunityTypeFinder", "groupCounts");
+        exit(1);
+    }
+}
+
+/**************************************************************************************************/
+//sums the posteriors pi of the samples with each count value, and of all the samples with a nonzero count in each OTU
+
+void CommunityTypeFinder::getCountWeights(vector<double>& pi, vector<vector<double> >& valueWeights, vector<double>& otuWeights){
+    try {
+        if(sampleTotals.size() != numSamples){ groupCounts(); }
+        
+        valueWeights.resize(numOTUs);
+        otuWeights.assign(numOTUs, 0.0000);
+        
+        for(int j=0;j<numOTUs;j++){
+            valueWeights[j].assign(countValues[j].size(), 0.0000);
+            
+            for(int k=0;k<countValues[j].size();k++){
+                for(int l=countStarts[j][k];l<countStarts[j][k+1];l++){
+                    valueWeights[j][k] += pi[countSamples[j][l]];
+                }
+                otuWeights[j] += valueWeights[j][k];
+            }
+        }
+    }
+    catch(exception& e){
+        m->errorOut(e, "CommunityTypeFinder", "getCountWeights");
+        exit(1);
+    }
+}
+
+/**************************************************************************************************/
+//the hessian of the current partition is diag(diagonal) off the diagonal plus scale * alpha * alpha'
+
+void CommunityTypeFinder::getHessianTerms(vector<double>& diagonal, vector<double>& alpha, double& scale){
+    try {
+        alpha.assign(numOTUs, 0.0000);
+        diagonal.assign(numOTUs, 0.0000);
         double alphaSum = 0.0000;
         
-        vector<double> pi = zMatrix[currentPartition];
-        vector<double> psi_ajk(numOTUs, 0.0000);
-        vector<double> psi_cjk(numOTUs, 0.0000);
-        vector<double> psi1_ajk(numOTUs, 0.0000);
-        vector<double> psi1_cjk(numOTUs, 0.0000);
+        vector<double>& pi = zMatrix[currentPartition];
+        vector<vector<double> > valueWeights;
+        vector<double> otuWeights;
+        getCountWeights(pi, valueWeights, otuWeights);
+        
+        //psi_cjk - psi_ajk, the samples with a zero count add the same amount to both
+        vector<double> psi_diff(numOTUs, 0.0000);
+        vector<double> psi1_diff(numOTUs, 0.0000);
         
         for(int j=0;j<numOTUs;j++){
             
@@ -216,14 +288,13 @@ vector<vector<double> > CommunityTypeFinder::getHessian(){
             alpha[j] = exp(lambdaMatrix[currentPartition][j]);
             alphaSum += alpha[j];
             
-            for(int i=0;i<numSamples;i++){
-                double X = (double) countMatrix[i][j];
-                
-                psi_ajk[j] += pi[i] * psi(alpha[j]);
-                psi1_ajk[j] += pi[i] * psi1(alpha[j]);
-                
-                psi_cjk[j] += pi[i] * psi(alpha[j] + X);
-                psi1_cjk[j] += pi[i] * psi1(alpha[j] + X);
+            psi_diff[j] = -otuWeights[j] * psi(alpha[j]);
+            psi1_diff[j] = -otuWeights[j] * psi1(alpha[j]);
+            
+            for(int k=0;k<countValues[j].size();k++){
+                double alphaX = alpha[j] + (double) countValues[j][k];
+                psi_diff[j] += valueWeights[j][k] * psi(alphaX);
+                psi1_diff[j] += valueWeights[j][k] * psi1(alphaX);
             }
         }
         
@@ -236,8 +307,7 @@ vector<vector<double> > CommunityTypeFinder::getHessian(){
         for(int i=0;i<numSamples;i++){
             if (m->control_pressed) {  break; }
             weight += pi[i];
-            double sum = 0.0000;
-            for(int j=0;j<numOTUs;j++){     sum += alpha[j] + countMatrix[i][j];    }
+            double sum = alphaSum + sampleTotals[i];
             
             psi_Ck += pi[i] * psi(sum);
             psi1_Ck += pi[i] * psi1(sum);
@@ -246,19 +316,41 @@ vector<vector<double> > CommunityTypeFinder::getHessian(){
         double psi_Ak = weight * psi(alphaSum);
         double psi1_Ak = weight * psi1(alphaSum);
         
+        for(int i=0;i<numOTUs;i++){
+            if (m->control_pressed) {  break; }
+            double term1 = -alpha[i] * (psi_Ak + psi_diff[i] - psi_Ck);
+            double term2 = -alpha[i] * alpha[i] * (psi1_Ak + psi1_diff[i] - psi1_Ck);
+            double term3 = 0.1 * alpha[i];
+            
+            diagonal[i] = term1 + term2 + term3;
+        }
+        
+        scale = -(psi1_Ak - psi1_Ck);
+    }
+    catch(exception& e){
+        m->errorOut(e, "CommunityTypeFinder", "getHessianTerms");
+        exit(1);
+    }
+}
+
+/**************************************************************************************************/
+
+vector<vector<double> > CommunityTypeFinder::getHessian(){
+    try {
+        vector<double> diagonal, alpha;
+        double scale;
+        getHessianTerms(diagonal, alpha, scale);
+        
         vector<vector<double> > hessian(numOTUs);
         for(int i=0;i<numOTUs;i++){ hessian[i].assign(numOTUs, 0.0000); }
         
         for(int i=0;i<numOTUs;i++){
             if (m->control_pressed) {  break; }
-            double term1 = -alpha[i] * (- psi_ajk[i] + psi_Ak + psi_cjk[i] - psi_Ck);
-            double term2 = -alpha[i] * alpha[i] * (-psi1_ajk[i] + psi1_Ak + psi1_cjk[i] - psi1_Ck);
-            double term3 = 0.1 * alpha[i];
             
-            hessian[i][i] = term1 + term2 + term3;
+            hessian[i][i] = diagonal[i];
             
             for(int j=0;j<i;j++){
-                hessian[i][j] = - alpha[i] * alpha[j] * (psi1_Ak - psi1_Ck);
+                hessian[i][j] = scale * alpha[i] * alpha[j];
                 hessian[j][i] = hessian[i][j];
             }
         }
@@ -42,6 +42,9 @@ public:
 protected:
     
     int findkMeans();
+    void groupCounts();
+    void getCountWeights(vector<double>&, vector<vector<double> >&, vector<double>&);
+    void getHessianTerms(vector<double>&, vector<double>&, double&);
     vector<vector<double> > getHessian();
     double psi1(double);
     double psi(double);
@@ -56,6 +59,14 @@ protected:
     vector<vector<double> > error;
     vector<vector<int> > countMatrix;
     vector<double> weights;
+    
+    //the nonzero counts grouped by OTU and count value, so terms that only depend on alpha and the count are
+    //computed once for all the samples sharing the count. samples with a zero count cancel out of the sums.
+    vector<vector<int> > countValues;                   //[numOTUs][distinct nonzero counts]
+    vector<vector<int> > countStarts;                   //[numOTUs][start of each count value in countSamples, then the end]
+    vector<vector<int> > countSamples;                  //[numOTUs][samples with a nonzero count, ordered by count]
+    vector<vector<pair<int, int> > > sampleCounts;      //[numSamples][(otu, index in countValues)]
+    vector<int> sampleTotals;
 
 
 
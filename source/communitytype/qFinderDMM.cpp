@@ -20,6 +20,8 @@ qFinderDMM::qFinderDMM(vector<vector<int> > cm, int p) : CommunityTypeFinder() {
         numSamples = (int)countMatrix.size();
         numOTUs = (int)countMatrix[0].size();
         
+        groupCounts();
+        
        // if (m->debug) { m->mothurOut("before kmeans\n"); }
         findkMeans();
        //if (m->debug) { m->mothurOut("done kMeans\n"); }
@@ -79,13 +81,19 @@ qFinderDMM::qFinderDMM(vector<vector<int> > cm, int p) : CommunityTypeFinder() {
                 logDeterminant += (2.0 * log(numSamples) - log(weights[currentPartition]));
             }
             //if (m->debug) { m->mothurOut("before hession\n"); }
-            vector<vector<double> > hessian = getHessian();
+            vector<double> diagonal, alpha, invDiagonal;
+            double scale;
+            getHessianTerms(diagonal, alpha, scale);
             //if (m->debug) { m->mothurOut("after hession\n"); }
-            vector<vector<double> > invHessian = l.getInverse(hessian);
+            if(!getInverseDiagonal(diagonal, alpha, scale, invDiagonal)){
+                vector<vector<double> > invHessian = l.getInverse(getHessian());
+                invDiagonal.resize(numOTUs);
+                for(int i=0;i<numOTUs;i++){ invDiagonal[i] = invHessian[i][i]; }
+            }
             //if (m->debug) { m->mothurOut("after inverse\n"); }
             for(int i=0;i<numOTUs;i++){
-                logDeterminant += log(abs(hessian[i][i]));
-                error[currentPartition][i] = invHessian[i][i];
+                logDeterminant += log(abs(diagonal[i]));
+                error[currentPartition][i] = invDiagonal[i];
             }
         }
         
@@ -595,44 +603,33 @@ int qFinderDMM::bfgs2_Solver(vector<double>& x){
 
 double qFinderDMM::negativeLogEvidenceLambdaPi(vector<double>& x){
     try{
-        vector<double> sumAlphaX(numSamples, 0.0000);
-        
-        double logEAlpha = 0.0000;
         double sumLambda = 0.0000;
         double sumAlpha = 0.0000;
         double logE = 0.0000;
         double nu = 0.10000;
         double eta = 0.10000;
         
-        double weight = 0.00000;
-        for(int i=0;i<numSamples;i++){
-            weight += zMatrix[currentPartition][i];
-        }
+        double weight = partitionWeight;
         
         for(int i=0;i<numOTUs;i++){
             if (m->control_pressed) {  return 0; }
             double lambda = x[i];
             double alpha = exp(x[i]);
-            logEAlpha += lgamma(alpha);
             sumLambda += lambda;
             sumAlpha += alpha;
             
-            for(int j=0;j<numSamples;j++){
-                double X = countMatrix[j][i];
-                double alphaX = alpha + X;
-                sumAlphaX[j] += alphaX;
-                
-                logE -= zMatrix[currentPartition][j] * lgamma(alphaX);
+            //the lgamma(alpha) and lgamma(alpha + 0) of the samples with a zero count cancel
+            logE += otuWeights[i] * lgamma(alpha);
+            for(int j=0;j<countValues[i].size();j++){
+                logE -= valueWeights[i][j] * lgamma(alpha + countValues[i][j]);
             }
         }
         
-        logEAlpha -= lgamma(sumAlpha);
-
         for(int i=0;i<numSamples;i++){
-            logE += zMatrix[currentPartition][i] * lgamma(sumAlphaX[i]);
+            logE += zMatrix[currentPartition][i] * lgamma(sumAlpha + sampleTotals[i]);
         }
 
-        return logE + weight * logEAlpha + nu * sumAlpha - eta * sumLambda;
+        return logE - weight * lgamma(sumAlpha) + nu * sumAlpha - eta * sumLambda;
     }
     catch(exception& e){
         m->errorOut(e, "qFinderDMM", "negativeLogEvidenceLambdaPi");
@@ -644,9 +641,6 @@ double qFinderDMM::negativeLogEvidenceLambdaPi(vector<double>& x){
 
 void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<double>& df){
     try{
-//        cout << "\tstart negativeLogDerivEvidenceLambdaPi" << endl;
-        
-        vector<double> storeVector(numSamples, 0.0000);
         vector<double> derivative(numOTUs, 0.0000);
         vector<double> alpha(numOTUs, 0.0000);
         
@@ -654,42 +648,25 @@ void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<doub
         double nu = 0.1000;
         double eta = 0.1000;
         
-        double weight = 0.0000;
-        for(int i=0;i<numSamples;i++){
-            weight += zMatrix[currentPartition][i];
-        }
-
+        double weight = partitionWeight;
         
         for(int i=0;i<numOTUs;i++){
             if (m->control_pressed) {  return; }
-//            cout << "start i loop" << endl;
-//            
-//            cout << i << '\t' << alpha[i] << '\t' << x[i] << '\t' << exp(x[i]) << '\t' << store << endl;
             
             alpha[i] = exp(x[i]);
             store += alpha[i];
             
-//            cout << "before derivative" << endl;
+            //the psi(alpha) and psi(alpha + 0) of the samples with a zero count cancel
+            derivative[i] = otuWeights[i] * psi(alpha[i]);
             
-            derivative[i] = weight * psi(alpha[i]);
-
-//            cout << "after derivative" << endl;
-
-//            cout << i << '\t' << alpha[i] << '\t' << psi(alpha[i]) << '\t' << derivative[i] << endl;
-
-            for(int j=0;j<numSamples;j++){
-                double X = countMatrix[j][i];
-                double alphaX = X + alpha[i];
-                
-                derivative[i] -= zMatrix[currentPartition][j] * psi(alphaX);
-                storeVector[j] += alphaX;
+            for(int j=0;j<countValues[i].size();j++){
+                derivative[i] -= valueWeights[i][j] * psi(alpha[i] + countValues[i][j]);
             }
-//            cout << "end i loop" << endl;
         }
 
         double sumStore = 0.0000;
         for(int i=0;i<numSamples;i++){
-            sumStore += zMatrix[currentPartition][i] * psi(storeVector[i]);
+            sumStore += zMatrix[currentPartition][i] * psi(store + sampleTotals[i]);
         }
         
         store = weight * psi(store);
@@ -698,10 +675,7 @@ void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<doub
         
         for(int i=0;i<numOTUs;i++){
             df[i] = alpha[i] * (nu + derivative[i] - store + sumStore) - eta;
-//            cout << i << '\t' << df[i] << endl;
         }
-//        cout << df.size() << endl;
-//        cout << "\tend negativeLogDerivEvidenceLambdaPi" << endl;
     }
     catch(exception& e){
          m->errorOut(e, "qFinderDMM", "negativeLogDerivEvidenceLambdaPi");
@@ -710,34 +684,76 @@ void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<doub
 }
 
 /**************************************************************************************************/
+//negative log evidence of each sample in each partition. the lgamma terms only depend on the partition's alpha and
+//the count, so they are found once for each count value of an OTU rather than for every sample
 
-double qFinderDMM::getNegativeLogEvidence(vector<double>& lambda, int group){
+void qFinderDMM::getNegativeLogEvidence(vector<vector<double> >& negLogEvidence){
     try {
-        double sumAlpha = 0.0000;
-        double sumAlphaX = 0.0000;
-        double sumLnGamAlpha = 0.0000;
-        double logEvidence = 0.0000;
+        negLogEvidence.resize(numPartitions);
         
-        for(int i=0;i<numOTUs;i++){
-            if (m->control_pressed) {  return 0; }
-            double alpha = exp(lambda[i]);
-            double X = countMatrix[group][i];
-            double alphaX = alpha + X;
+        vector<vector<double> > lnGamRatio(numOTUs); //lgamma(alpha + count) - lgamma(alpha)
+        
+        for(int k=0;k<numPartitions;k++){
+            if (m->control_pressed) {  return; }
             
-            sumLnGamAlpha += lgamma(alpha);
-            sumAlpha += alpha;
-            sumAlphaX += alphaX;
+            double sumAlpha = 0.0000;
+            
+            for(int i=0;i<numOTUs;i++){
+                double alpha = exp(lambdaMatrix[k][i]);
+                double lnGamAlpha = lgamma(alpha);
+                sumAlpha += alpha;
+                
+                lnGamRatio[i].resize(countValues[i].size());
+                for(int j=0;j<countValues[i].size();j++){
+                    lnGamRatio[i][j] = lgamma(alpha + countValues[i][j]) - lnGamAlpha;
+                }
+            }
+            
+            double lnGamSumAlpha = lgamma(sumAlpha);
             
-            logEvidence -= lgamma(alphaX);
+            negLogEvidence[k].assign(numSamples, 0.0000);
+            for(int i=0;i<numSamples;i++){
+                double logEvidence = lgamma(sumAlpha + sampleTotals[i]) - lnGamSumAlpha;
+                
+                for(int j=0;j<sampleCounts[i].size();j++){
+                    logEvidence -= lnGamRatio[sampleCounts[i][j].first][sampleCounts[i][j].second];
+                }
+                negLogEvidence[k][i] = logEvidence;
+            }
         }
+    }
+    catch(exception& e){
+        m->errorOut(e, "qFinderDMM", "getNegativeLogEvidence");
+        exit(1);
+    }
+}
+
+/**************************************************************************************************/
+//H = D + scale * alpha * alpha' with D = diagonal - scale * alpha^2. by Sherman-Morrison the diagonal of its inverse
+//is 1/D - scale * (alpha/D)^2 / (1 + scale * sum(alpha^2/D)). returns false if D or the denominator is singular
+
+bool qFinderDMM::getInverseDiagonal(vector<double>& diagonal, vector<double>& alpha, double scale, vector<double>& inverse){
+    try {
+        vector<double> d(numOTUs, 0.0000);
+        double denominator = 1.0000;
         
-        sumLnGamAlpha -= lgamma(sumAlpha);
-        logEvidence += lgamma(sumAlphaX);
+        for(int i=0;i<numOTUs;i++){
+            d[i] = diagonal[i] - scale * alpha[i] * alpha[i];
+            if(d[i] == 0){ return false; }
+            denominator += scale * alpha[i] * alpha[i] / d[i];
+        }
+        if(denominator == 0 || isnan(denominator) || isinf(denominator)){ return false; }
         
-        return logEvidence + sumLnGamAlpha;
+        inverse.assign(numOTUs, 0.0000);
+        for(int i=0;i<numOTUs;i++){
+            double ratio = alpha[i] / d[i];
+            inverse[i] = 1.0000 / d[i] - scale * ratio * ratio / denominator;
+            if(isnan(inverse[i]) || isinf(inverse[i])){ return false; }
+        }
+        return true;
     }
     catch(exception& e){
-        m->errorOut(e, "qFinderDMM", "getNegativeLogEvidence");
+        m->errorOut(e, "qFinderDMM", "getInverseDiagonal");
         exit(1);
     }
 }
@@ -748,6 +764,11 @@ void qFinderDMM::optimizeLambda(){
     try {
         for(currentPartition=0;currentPartition<numPartitions;currentPartition++){
             if (m->control_pressed) {  return; }
+            
+            partitionWeight = 0.0000;
+            for(int i=0;i<numSamples;i++){ partitionWeight += zMatrix[currentPartition][i]; }
+            getCountWeights(zMatrix[currentPartition], valueWeights, otuWeights);
+            
             bfgs2_Solver(lambdaMatrix[currentPartition]);
         }
     }
@@ -760,7 +781,8 @@ void qFinderDMM::optimizeLambda(){
 
 void qFinderDMM::calculatePiK(){
     try {
-        vector<double> store(numPartitions);
+        vector<vector<double> > negLogEvidence;
+        getNegativeLogEvidence(negLogEvidence);
         
         for(int i=0;i<numSamples;i++){
             if (m->control_pressed) {  return; }
@@ -768,17 +790,13 @@ void qFinderDMM::calculatePiK(){
             double minNegLogEvidence =numeric_limits<double>::max();
             
             for(int j=0;j<numPartitions;j++){
-                double negLogEvidenceJ = getNegativeLogEvidence(lambdaMatrix[j], i);
-                
-                if(negLogEvidenceJ < minNegLogEvidence){
-                    minNegLogEvidence = negLogEvidenceJ;
+                if(negLogEvidence[j][i] < minNegLogEvidence){
+                    minNegLogEvidence = negLogEvidence[j][i];
                 }
-                store[j] = negLogEvidenceJ;
             }
             
             for(int j=0;j<numPartitions;j++){
-                if (m->control_pressed) {  return; }
-                zMatrix[j][i] = weights[j] * exp(-(store[j] - minNegLogEvidence));
+                zMatrix[j][i] = weights[j] * exp(-(negLogEvidence[j][i] - minNegLogEvidence));
                 sum += zMatrix[j][i];
             }
             
@@ -803,59 +821,33 @@ double qFinderDMM::getNegativeLogLikelihood(){
         double nu = 0.10000;
         
         vector<double> pi(numPartitions, 0.0000);
-        vector<double> logBAlpha(numPartitions, 0.0000);
+        for(int i=0;i<numPartitions;i++){ pi[i] = weights[i] / (double)numSamples; }
         
-        double doubleSum = 0.0000;
+        //log(B(alpha + X) / B(alpha)) of each sample in each partition
+        vector<vector<double> > negLogEvidence;
+        getNegativeLogEvidence(negLogEvidence);
+        if (m->control_pressed) {  return 0; }
         
-        for(int i=0;i<numPartitions;i++){
-            if (m->control_pressed) {  return 0; }
-            double sumAlphaK = 0.0000;
-            
-            pi[i] = weights[i] / (double)numSamples;
-            
-            for(int j=0;j<numOTUs;j++){
-                double alpha = exp(lambdaMatrix[i][j]);
-                sumAlphaK += alpha;
-                
-                logBAlpha[i] += lgamma(alpha);
-            }
-            logBAlpha[i] -= lgamma(sumAlphaK);
-        }
+        double doubleSum = 0.0000;
         
         for(int i=0;i<numSamples;i++){
             if (m->control_pressed) {  return 0; }
             
             double probability = 0.0000;
             double factor = 0.0000;
-            double sum = 0.0000;
             vector<double> logStore(numPartitions, 0.0000);
             double offset = -numeric_limits<double>::max();
             
-            for(int j=0;j<numOTUs;j++){
-                sum += countMatrix[i][j];
-                factor += lgamma(countMatrix[i][j] + 1.0000);
+            for(int j=0;j<sampleCounts[i].size();j++){
+                factor += lgamma(countValues[sampleCounts[i][j].first][sampleCounts[i][j].second] + 1.0000);
             }
-            factor -= lgamma(sum + 1.0);
+            factor -= lgamma(sampleTotals[i] + 1.0);
             
             for(int k=0;k<numPartitions;k++){
-                
-                double sumAlphaKX = 0.0000;
-                double logBAlphaX = 0.0000;
-                
-                for(int j=0;j<numOTUs;j++){
-                    double alphaX = exp(lambdaMatrix[k][j]) + (double)countMatrix[i][j];
-                    
-                    sumAlphaKX += alphaX;
-                    logBAlphaX += lgamma(alphaX);
-                }
-                
-                logBAlphaX -= lgamma(sumAlphaKX);
-                
-                logStore[k] = logBAlphaX - logBAlpha[k] - factor;
+                logStore[k] = -negLogEvidence[k][i] - factor;
                 if(logStore[k] > offset){
                     offset = logStore[k];
                 }
-                
             }
             
             for(int k=0;k<numPartitions;k++){
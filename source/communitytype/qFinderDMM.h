@@ -27,14 +27,18 @@ private:
 
     double negativeLogEvidenceLambdaPi(vector<double>&);
     void negativeLogDerivEvidenceLambdaPi(vector<double>&, vector<double>&);
-    double getNegativeLogEvidence(vector<double>&, int);
+    void getNegativeLogEvidence(vector<vector<double> >&);
     double getNegativeLogLikelihood();
+    bool getInverseDiagonal(vector<double>&, vector<double>&, double, vector<double>&);
     
     
     int lineMinimizeFletcher(vector<double>&, vector<double>&, double, double, double, double&, double&, vector<double>&, vector<double>&);
     int bfgs2_Solver(vector<double>&);//, double, double);
     
-   
+    //posteriors of the partition being optimized summed over the samples sharing a count, set by optimizeLambda
+    vector<vector<double> > valueWeights;
+    vector<double> otuWeights;
+    double partitionWeight;
 
         
 };
@@ -0,0 +1,56 @@
+//
+//  alignmentcache.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "alignmentcache.h"
+
+/**************************************************************************************************/
+AlignmentCache::AlignmentCache(int size) {
+    m = MothurOut::getInstance();
+    maxSize = size; hits = 0; misses = 0;
+}
+/**************************************************************************************************/
+bool AlignmentCache::get(string unaligned, alignResult& result) {
+    try {
+        if (maxSize < 1) { return false; }
+        
+        map<string, pair<alignResult, list<string>::iterator> >::iterator it = results.find(unaligned);
+        if (it == results.end()) { misses++; return false; }
+        
+        //move to the front of the line
+        order.splice(order.begin(), order, (it->second).second);
+        
+        result = (it->second).first;
+        hits++;
+        
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "AlignmentCache", "get");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void AlignmentCache::add(string unaligned, alignResult result) {
+    try {
+        if (maxSize < 1) { return; }
+        if (results.count(unaligned) != 0) { return; }
+        
+        //remove the sequence used longest ago
+        if (results.size() >= maxSize) {
+            results.erase(order.back());
+            order.pop_back();
+        }
+        
+        order.push_front(unaligned);
+        results[unaligned] = make_pair(result, order.begin());
+    }
+    catch(exception& e) {
+        m->errorOut(e, "AlignmentCache", "add");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
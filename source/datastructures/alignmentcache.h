@@ -0,0 +1,52 @@
+#ifndef Mothur_alignmentcache_h
+#define Mothur_alignmentcache_h
+
+//
+//  alignmentcache.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "packedsequence.h"
+
+/* Keeps the alignments of recently aligned sequences so align.seqs can reuse them when the same unaligned sequence
+ comes up again, skipping the template search and nast. Fasta files that have not been through unique.seqs are
+ mostly repeats. The alignment is stored packed with the report fields and the flip note. When the cache is full the
+ sequence used longest ago is dropped. */
+
+/**************************************************************************************************/
+struct alignResult {
+    PackedSequence aligned;
+    string report;          //report fields after the query name
+    string accnos;          //note after the name in the accnos file
+    bool inAccnos;
+    
+    alignResult() : report(""), accnos(""), inAccnos(false) {}
+    alignResult(PackedSequence a, string r, string ac, bool in) : aligned(a), report(r), accnos(ac), inAccnos(in) {}
+};
+/**************************************************************************************************/
+
+class AlignmentCache {
+    
+public:
+    AlignmentCache(int);            //max number of sequences, 0 turns the cache off
+    ~AlignmentCache() {}
+    
+    bool get(string, alignResult&); //unaligned sequence, false if not in the cache
+    void add(string, alignResult);
+    
+    int getHits()       { return hits;      }
+    int getMisses()     { return misses;    }
+    
+private:
+    MothurOut* m;
+    int maxSize, hits, misses;
+    list<string> order;             //most recently used first
+    map<string, pair<alignResult, list<string>::iterator> > results;
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -37,7 +37,7 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
             if (m->control_pressed) {  templateSequences.clear(); break;  }
             
             if (temp.getName() != "") {
-                templateSequences.push_back(temp);
+                templateSequences.push_back(PackedSequence(temp));
                 
                 //save longest base
                 if (temp.getUnaligned().length() >= longest)  { longest = (temp.getUnaligned().length()+1); }
@@ -97,7 +97,7 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
 			if (needToGenerate) {
 				//add sequences to search 
 				for (int i = 0; i < templateSequences.size(); i++) {
-					search->addSequence(templateSequences[i]);
+					search->addSequence(templateSequences[i].getSequence());
 					
 					if (m->control_pressed) {  templateSequences.clear(); break;  }
 				}
@@ -151,7 +151,7 @@ Sequence AlignmentDB::findClosestSequence(Sequence* seq) {
 	
 		vector<int> spot = search->findClosestSequences(seq, 1);
 	
-		if (spot.size() != 0)	{		return templateSequences[spot[0]];	}
+		if (spot.size() != 0)	{		return templateSequences[spot[0]].getSequence();	}
 		else					{		return emptySequence;				}
 		
 	}
@@ -13,6 +13,10 @@
 #include "mothur.h"
 #include "sequence.hpp"
 #include "database.hpp"
+#include "packedsequence.h"
+
+/* Holds the template sequences and the search database for align.seqs. It is built once before align.seqs forks
+ and the processes search the parent's copy, which is only read while searching. */
 
 /**************************************************************************************************/
 
@@ -33,7 +37,7 @@ private:
 	string method;
 	
 	Database* search;
-	vector<Sequence> templateSequences;
+	vector<PackedSequence> templateSequences;  //packed to save memory with long reference alignments
 	Sequence emptySequence;
 	MothurOut* m;
 };
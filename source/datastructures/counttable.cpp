@@ -16,8 +16,7 @@ int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>&
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearSeqs();
         for (set<string>::iterator it = gs.begin(); it != gs.end(); it++) { groups.push_back(*it);  hasGroups = true; }
         numGroups = groups.size();
         totalGroups.resize(numGroups, 0);
@@ -51,10 +50,9 @@ int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>&
                 m->mothurOut("[ERROR]: Your group file does not contain " + seqName + ". Please correct."); m->mothurOutEndLine();
             }
             
-            map<string, int>::iterator it2 = indexNameMap.find(seqName);
-            if (it2 == indexNameMap.end()) {
-                if (hasGroups) {  counts.push_back(groupCounts);  }
-                indexNameMap[seqName] = uniques;
+            if (findSeq(seqName) == -1) {
+                if (hasGroups) {  counts.push_back(getSparseCounts(groupCounts));  }
+                addSeqName(seqName, totals.size());
                 totals.push_back(1);
                 total++;
                 uniques++;
@@ -151,8 +149,7 @@ int CountTable::createTable(string namefile, string groupfile, bool createGroup)
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearSeqs();
         map<int, string> originalGroupIndexes;
         
         if (groupfile != "") { 
@@ -231,10 +228,9 @@ int CountTable::createTable(string namefile, string groupfile, bool createGroup)
                 totalGroups[i] += thisGroupsCount[i]; 
             }
             
-            map<string, int>::iterator it = indexNameMap.find(firstCol);
-            if (it == indexNameMap.end()) {
-                if (hasGroups) {  counts.push_back(thisGroupsCount);  }
-                indexNameMap[firstCol] = uniques;
+            if (findSeq(firstCol) == -1) {
+                if (hasGroups) {  counts.push_back(getSparseCounts(thisGroupsCount));  }
+                addSeqName(firstCol, totals.size());
                 totals.push_back(thisTotal);
                 total += thisTotal;
                 uniques++;
@@ -266,64 +262,72 @@ int CountTable::createTable(string namefile, string groupfile, bool createGroup)
 int CountTable::readTable(string file, bool readGroups, bool mothurRunning) {
     try {
         filename = file;
-        ifstream in;
-        m->openInputFile(filename, in);
-        
-        string headers = m->getline(in); m->gobble(in);
-        vector<string> columnHeaders = m->splitWhiteSpace(headers);
-        
-        int numGroups = 0;
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
-        map<int, string> originalGroupIndexes;
-        if ((columnHeaders.size() > 2) && readGroups) { hasGroups = true; numGroups = columnHeaders.size() - 2;  }
-        for (int i = 2; i < columnHeaders.size(); i++) {  groups.push_back(columnHeaders[i]);  originalGroupIndexes[i-2] = columnHeaders[i]; totalGroups.push_back(0); }
-        //sort groups to keep consistent with how we store the groups in groupmap
-        sort(groups.begin(), groups.end());
-        for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
-        m->setAllGroups(groups);
-        
-        bool error = false;
-        string name;
-        int thisTotal;
+        clearSeqs();
         uniques = 0;
         total = 0;
-        while (!in.eof()) {
+        
+        bool error = false;
+        if (!readBinary(readGroups, mothurRunning, error)) {
+            ifstream in;
+            m->openInputFile(filename, in);
             
-            if (m->control_pressed) { break; }
+            string headers = m->getline(in); m->gobble(in);
+            vector<string> columnHeaders = m->splitWhiteSpace(headers);
             
-            in >> name; m->gobble(in); in >> thisTotal; m->gobble(in);
-            if (m->debug) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(thisTotal) + "\n"); }
+            int numGroups = 0;
+            map<int, string> originalGroupIndexes;
+            if ((columnHeaders.size() > 2) && readGroups) { hasGroups = true; numGroups = columnHeaders.size() - 2;  }
+            for (int i = 2; i < columnHeaders.size(); i++) {  groups.push_back(columnHeaders[i]);  originalGroupIndexes[i-2] = columnHeaders[i]; totalGroups.push_back(0); }
+            //sort groups to keep consistent with how we store the groups in groupmap
+            sort(groups.begin(), groups.end());
+            for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
+            m->setAllGroups(groups);
             
-            if ((thisTotal == 0) && !mothurRunning) { error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + name + " with a total=0. Please correct."); m->mothurOutEndLine();
-            }
+            //column of the file to group index
+            vector<int> groupIndexes; groupIndexes.resize(numGroups, 0);
+            for (int i = 0; i < numGroups; i++) {  groupIndexes[i] = indexGroupMap[originalGroupIndexes[i]]; }
             
-            //if group info, then read it
+            string name;
+            int thisTotal;
             vector<int> groupCounts; groupCounts.resize(numGroups, 0);
-            if (columnHeaders.size() > 2) { //file contains groups
-                if (readGroups) { //user wants to save them
-                    for (int i = 0; i < numGroups; i++) {  int thisIndex = indexGroupMap[originalGroupIndexes[i]]; in >> groupCounts[thisIndex]; m->gobble(in); totalGroups[thisIndex] += groupCounts[thisIndex];  }
-                }else { //read and discard
-                    m->getline(in); m->gobble(in);
+            while (!in.eof()) {
+                
+                if (m->control_pressed) { break; }
+                
+                in >> name; m->gobble(in); in >> thisTotal; m->gobble(in);
+                if (m->debug) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(thisTotal) + "\n"); }
+                
+                if ((thisTotal == 0) && !mothurRunning) { error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + name + " with a total=0. Please correct."); m->mothurOutEndLine();
+                }
+                
+                //if group info, then read it
+                if (columnHeaders.size() > 2) { //file contains groups
+                    if (readGroups) { //user wants to save them
+                        for (int i = 0; i < numGroups; i++) {  int thisIndex = groupIndexes[i]; in >> groupCounts[thisIndex]; m->gobble(in); totalGroups[thisIndex] += groupCounts[thisIndex];  }
+                    }else { //read and discard
+                        m->getline(in); m->gobble(in);
+                    }
+                }
+                
+                if (findSeq(name) == -1) {
+                    if (hasGroups) {  counts.push_back(getSparseCounts(groupCounts));  }
+                    addSeqName(name, totals.size());
+                    totals.push_back(thisTotal);
+                    total += thisTotal;
+                    uniques++;
+                }else {
+                    error = true;
+                    m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + name + ", sequence names must be unique. Please correct."); m->mothurOutEndLine(); 
                 }
             }
+            in.close();
             
-            map<string, int>::iterator it = indexNameMap.find(name);
-            if (it == indexNameMap.end()) {
-                if (hasGroups) {  counts.push_back(groupCounts);  }
-                indexNameMap[name] = uniques;
-                totals.push_back(thisTotal);
-                total += thisTotal;
-                uniques++;
-            }else {
-                error = true;
-                m->mothurOut("[ERROR]: Your count table contains more than 1 sequence named " + name + ", sequence names must be unique. Please correct."); m->mothurOutEndLine(); 
-            }
+            //tables read without their groups can't be saved
+            if (!error && !m->control_pressed && (hasGroups || (columnHeaders.size() <= 2))) { writeBinary(); }
         }
-        in.close();
         
         if (error) { m->control_pressed = true; }
         else { //check for zero groups
@@ -350,17 +354,13 @@ int CountTable::printTable(string file) {
         for (int i = 0; i < groups.size(); i++) { out << '\t' << groups[i]; }
         out << endl;
         
-        map<int, string> reverse; //use this to preserve order
-        for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-        
         for (int i = 0; i < totals.size(); i++) {
-            map<int, string>::iterator itR = reverse.find(i);
-            
-            if (itR != reverse.end()) { //will equal end if seqs were removed because remove just removes from indexNameMap
-                out << itR->second << '\t' << totals[i];
+            if (seqNames[i] != "") { //will be blank if seqs were removed
+                out << seqNames[i] << '\t' << totals[i];
                 if (hasGroups) {
+                    vector<int> thisCounts = getDenseCounts(i);
                     for (int j = 0; j < groups.size(); j++) {
-                        out << '\t' << counts[i][j];
+                        out << '\t' << thisCounts[j];
                     }
                 }
                 out << endl;
@@ -400,14 +400,15 @@ int CountTable::printHeaders(ofstream& out) {
 /************************************************************/
 int CountTable::printSeq(ofstream& out, string seqName) {
     try {
-		map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+		int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
         }else { 
-            out << it->first << '\t' << totals[it->second];
+            out << seqName << '\t' << totals[seqIndex];
             if (hasGroups) {
+                vector<int> thisCounts = getDenseCounts(seqIndex);
                 for (int i = 0; i < groups.size(); i++) {
-                    out << '\t' << counts[it->second][i];
+                    out << '\t' << thisCounts[i];
                 }
             }
             out << endl;
@@ -425,15 +426,15 @@ vector<int> CountTable::getGroupCounts(string seqName) {
     try {
         vector<int> temp;
         if (hasGroups) {
-            map<string, int>::iterator it = indexNameMap.find(seqName);
-            if (it == indexNameMap.end()) {
+            int seqIndex = findSeq(seqName);
+            if (seqIndex == -1) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (m->inUsersGroups(seqName, groups)) {
                     m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group."); m->mothurOutEndLine();
                 }
                 m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
             }else { 
-                temp = counts[it->second];
+                temp = getDenseCounts(seqIndex);
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n"); m->control_pressed = true; }
         
@@ -473,15 +474,15 @@ int CountTable::getGroupCount(string seqName, string groupName) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: group " + groupName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
             }else { 
-                map<string, int>::iterator it2 = indexNameMap.find(seqName);
-                if (it2 == indexNameMap.end()) {
+                int seqIndex = findSeq(seqName);
+                if (seqIndex == -1) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (m->inUsersGroups(seqName, groups)) {
                         m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group."); m->mothurOutEndLine();
                     }
                     m->mothurOut("[ERROR]: seq " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
                 }else { 
-                    return counts[it2->second][it->second];
+                    return getCount(seqIndex, it->second);
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->control_pressed = true; }
@@ -502,19 +503,19 @@ int CountTable::setAbund(string seqName, string groupName, int num) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + groupName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
             }else { 
-                map<string, int>::iterator it2 = indexNameMap.find(seqName);
-                if (it2 == indexNameMap.end()) {
+                int seqIndex = findSeq(seqName);
+                if (seqIndex == -1) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (m->inUsersGroups(seqName, groups)) {
                         m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group."); m->mothurOutEndLine();
                     }
                     m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
                 }else { 
-                    int oldCount = counts[it2->second][it->second];
-                    counts[it2->second][it->second] = num;
+                    int oldCount = getCount(seqIndex, it->second);
+                    setCount(seqIndex, it->second, num);
                     totalGroups[it->second] += (num - oldCount);
                     total += (num - oldCount);
-                    totals[it2->second] += (num - oldCount);
+                    totals[seqIndex] += (num - oldCount);
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->control_pressed = true; }
@@ -534,9 +535,8 @@ int CountTable::addGroup(string groupName) {
         if (sanity) { m->mothurOut("[ERROR]: " + groupName + " is already in the count table, cannot add again.\n"); m->control_pressed = true;  return 0; }
         
         groups.push_back(groupName);
-        if (!hasGroups) { counts.resize(uniques);  }
+        if (!hasGroups) { counts.resize(totals.size());  }
         
-        for (int i = 0; i < counts.size(); i++) { counts[i].push_back(0); }
         totalGroups.push_back(0);
         indexGroupMap[groupName] = groups.size()-1;
         map<string, int> originalGroupMap = indexGroupMap;
@@ -546,23 +546,21 @@ int CountTable::addGroup(string groupName) {
         
         //fix indexGroupMap && totalGroups
         vector<int> newTotals; newTotals.resize(groups.size(), 0);
+        vector<int> newIndexes; newIndexes.resize(groups.size(), 0);
         for (int i = 0; i < groups.size(); i++) {  
             indexGroupMap[groups[i]] = i;  
             //find original spot of group[i]
             int index = originalGroupMap[groups[i]];
             newTotals[i] = totalGroups[index];
+            newIndexes[index] = i;
         }
         totalGroups = newTotals;
         
-        //fix counts vectors
+        //fix counts vectors, the new group has no seqs so only the group indexes change
         for (int i = 0; i < counts.size(); i++) {
             vector<int> newCounts; newCounts.resize(groups.size(), 0);
-            for (int j = 0; j < groups.size(); j++) {  
-                //find original spot of group[i]
-                int index = originalGroupMap[groups[j]];
-                newCounts[j] = counts[i][index];
-            }
-            counts[i] = newCounts;
+            for (int j = 0; j < counts[i].size(); j+=2) {  newCounts[newIndexes[counts[i][j]]] = counts[i][j+1];  }
+            counts[i] = getSparseCounts(newCounts);
         }
         hasGroups = true;
         m->setAllGroups(groups);
@@ -579,10 +577,6 @@ int CountTable::addGroup(string groupName) {
 int CountTable::removeGroup(string groupName) {
     try {        
         if (hasGroups) {
-            //save for later in case removing a group means we need to remove a seq.
-            map<int, string> reverse;
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
             map<string, int>::iterator it = indexGroupMap.find(groupName);
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + groupName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
@@ -600,23 +594,28 @@ int CountTable::removeGroup(string groupName) {
                 groups = newGroups;
                 totalGroups.erase(totalGroups.begin()+indexOfGroupToRemove);
                 
-                int thisIndex = 0;
-                map<string, int> newIndexNameMap;
+                //seqs left are moved down to fill the spots of the seqs removed
+                vector<string> oldNames = seqNames;
+                seqNames.clear();
+                int numKept = 0;
                 for (int i = 0; i < counts.size(); i++) {
-                    int num = counts[i][indexOfGroupToRemove];
-                    counts[i].erase(counts[i].begin()+indexOfGroupToRemove);
+                    int num = getCount(i, indexOfGroupToRemove);
+                    setCount(i, indexOfGroupToRemove, 0);
+                    for (int j = 0; j < counts[i].size(); j+=2) { if (counts[i][j] > indexOfGroupToRemove) { counts[i][j]--; } }
                     totals[i] -= num;
                     total -= num;
                     if (totals[i] == 0) { //your sequences are only from the group we want to remove, then remove you.
-                        counts.erase(counts.begin()+i);
-                        totals.erase(totals.begin()+i);
-                        uniques--;
-                        i--;
+                        if (oldNames[i] != "") { uniques--; }
+                    }else {
+                        counts[numKept].swap(counts[i]);
+                        totals[numKept] = totals[i];
+                        seqNames.push_back(oldNames[i]);
+                        numKept++;
                     }
-                    newIndexNameMap[reverse[thisIndex]] = i;
-                    thisIndex++;
                 }
-                indexNameMap = newIndexNameMap;
+                counts.resize(numKept);
+                totals.resize(numKept);
+                nameHash.rebuild(seqNames, numKept);
                 
                 if (groups.size() == 0) { hasGroups = false; }
             }
@@ -653,8 +652,8 @@ vector<string> CountTable::getGroups(string seqName) {
 int CountTable::renameSeq(string oldSeqName, string newSeqName) {
     try {
         
-        map<string, int>::iterator it = indexNameMap.find(oldSeqName);
-        if (it == indexNameMap.end()) {
+        int seqIndex = findSeq(oldSeqName);
+        if (seqIndex == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (m->inUsersGroups(oldSeqName, groups)) {
@@ -663,9 +662,11 @@ int CountTable::renameSeq(string oldSeqName, string newSeqName) {
             }
             m->mothurOut("[ERROR]: " + oldSeqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
         }else {  
-            int index = it->second;
-            indexNameMap.erase(it);
-            indexNameMap[newSeqName] = index;
+            //like a map, a seq already named newSeqName is replaced
+            int oldIndex = findSeq(newSeqName);
+            if (oldIndex != -1) { removeSeqName(oldIndex); }
+            removeSeqName(seqIndex);
+            addSeqName(newSeqName, seqIndex);
         }
         
         return 0;
@@ -681,8 +682,8 @@ int CountTable::renameSeq(string oldSeqName, string newSeqName) {
 int CountTable::getNumSeqs(string seqName) {
     try {
                 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (m->inUsersGroups(seqName, groups)) {
@@ -691,7 +692,7 @@ int CountTable::getNumSeqs(string seqName) {
             }
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
         }else { 
-            return totals[it->second];
+            return totals[seqIndex];
         }
 
         return 0;
@@ -706,12 +707,12 @@ int CountTable::getNumSeqs(string seqName) {
 int CountTable::setNumSeqs(string seqName, int abund) {
     try {
         
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true; return -1;
         }else {
-            int diff = totals[it->second] - abund;
-            totals[it->second] = abund;
+            int diff = totals[seqIndex] - abund;
+            totals[seqIndex] = abund;
             total-=diff;
         }
         
@@ -728,8 +729,8 @@ int CountTable::setNumSeqs(string seqName, int abund) {
 int CountTable::get(string seqName) {
     try {
         
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (m->inUsersGroups(seqName, groups)) {
@@ -737,7 +738,7 @@ int CountTable::get(string seqName) {
                 }
             }
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->control_pressed = true;
-        }else { return it->second; }
+        }else { return seqIndex; }
         
         return -1;
     }
@@ -750,10 +751,10 @@ int CountTable::get(string seqName) {
 //add seqeunce without group info
 int CountTable::push_back(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
-            if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + "."); m->mothurOutEndLine(); m->control_pressed = true;  }
-            indexNameMap[seqName] = uniques;
+        int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
+            if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + "."); m->mothurOutEndLine(); m->control_pressed = true; counts.push_back(vector<int>()); }
+            addSeqName(seqName, totals.size());
             totals.push_back(1);
             total++;
             uniques++;
@@ -772,15 +773,16 @@ int CountTable::push_back(string seqName) {
 //remove sequence
 int CountTable::remove(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it != indexNameMap.end()) {
+        int seqIndex = findSeq(seqName);
+        if (seqIndex != -1) {
             uniques--;
             if (hasGroups){ //remove this sequences counts from group totals
-                for (int i = 0; i < totalGroups.size(); i++) {  totalGroups[i] -= counts[it->second][i];  counts[it->second][i] = 0; }
+                for (int j = 0; j < counts[seqIndex].size(); j+=2) {  totalGroups[counts[seqIndex][j]] -= counts[seqIndex][j+1];  }
+                counts[seqIndex].clear();
             }
-            int thisTotal = totals[it->second]; totals[it->second] = 0;
+            int thisTotal = totals[seqIndex]; totals[seqIndex] = 0;
             total -= thisTotal;
-            indexNameMap.erase(it);
+            removeSeqName(seqIndex);
         }else {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
@@ -802,10 +804,10 @@ int CountTable::remove(string seqName) {
 //add seqeunce without group info
 int CountTable::push_back(string seqName, int thisTotal) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
-            if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + "."); m->mothurOutEndLine(); m->control_pressed = true;  }
-            indexNameMap[seqName] = uniques;
+        int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
+            if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + "."); m->mothurOutEndLine(); m->control_pressed = true; counts.push_back(vector<int>()); }
+            addSeqName(seqName, totals.size());
             totals.push_back(thisTotal);
             total+=thisTotal;
             uniques++;
@@ -825,13 +827,13 @@ int CountTable::push_back(string seqName, int thisTotal) {
 int CountTable::push_back(string seqName, vector<int> groupCounts) {
     try {
         int thisTotal = 0;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int seqIndex = findSeq(seqName);
+        if (seqIndex == -1) {
             if ((hasGroups) && (groupCounts.size() != getNumGroups())) {  m->mothurOut("[ERROR]: Your count table has a " + toString(getNumGroups()) + " groups and " + seqName + " has " + toString(groupCounts.size()) + ", please correct."); m->mothurOutEndLine(); m->control_pressed = true;  }
             
             for (int i = 0; i < getNumGroups(); i++) {   totalGroups[i] += groupCounts[i];  thisTotal += groupCounts[i]; }
-            if (hasGroups) {  counts.push_back(groupCounts);  }
-            indexNameMap[seqName] = uniques;
+            if (hasGroups) {  counts.push_back(getSparseCounts(groupCounts));  }
+            addSeqName(seqName, totals.size());
             totals.push_back(thisTotal);
             total+= thisTotal;
             uniques++;
@@ -851,10 +853,10 @@ int CountTable::push_back(string seqName, vector<int> groupCounts) {
 //create ListVector from uniques
 ListVector CountTable::getListVector() {
     try {
-        ListVector list(indexNameMap.size());
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) { 
+        ListVector list(nameHash.getNumNames());
+        for (int i = 0; i < seqNames.size(); i++) { 
             if (m->control_pressed) { break; }
-            list.set(it->second, it->first); 
+            if (seqNames[i] != "") { list.set(i, seqNames[i]); }
         }
         return list;
     }
@@ -868,10 +870,12 @@ ListVector CountTable::getListVector() {
 //returns the names of all unique sequences in file
 vector<string> CountTable::getNamesOfSeqs() {
     try {
-        vector<string> names;
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
-            names.push_back(it->first);
+        vector<string> names; names.reserve(nameHash.getNumNames());
+        for (int i = 0; i < seqNames.size(); i++) {
+            if (seqNames[i] != "") { names.push_back(seqNames[i]); }
         }
+        //sorted like the map of names we used to keep
+        sort(names.begin(), names.end());
                 
         return names;
     }
@@ -885,8 +889,9 @@ vector<string> CountTable::getNamesOfSeqs() {
 map<string, int> CountTable::getNameMap() {
     try {
         map<string, int> names;
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
-            names[it->first] = totals[it->second];
+        vector<string> sortedNames = getNamesOfSeqs();
+        for (int i = 0; i < sortedNames.size(); i++) {
+            names.insert(names.end(), make_pair(sortedNames[i], totals[findSeq(sortedNames[i])]));
         }
         
         return names;
@@ -906,8 +911,9 @@ vector<string> CountTable::getNamesOfSeqs(string group) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + group + " is not in your count table. Please correct.\n"); m->control_pressed = true;
             }else { 
-                for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 != indexNameMap.end(); it2++) {
-                    if (counts[it2->second][it->second] != 0) {  names.push_back(it2->first); }
+                vector<string> sortedNames = getNamesOfSeqs();
+                for (int i = 0; i < sortedNames.size(); i++) {
+                    if (getCount(findSeq(sortedNames[i]), it->second) != 0) {  names.push_back(sortedNames[i]); }
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->control_pressed = true; }
@@ -923,8 +929,8 @@ vector<string> CountTable::getNamesOfSeqs(string group) {
 //merges counts of seq1 and seq2, saving in seq1
 int CountTable::mergeCounts(string seq1, string seq2) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seq1);
-        if (it == indexNameMap.end()) {
+        int seqIndex = findSeq(seq1);
+        if (seqIndex == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (m->inUsersGroups(seq1, groups)) {
@@ -933,8 +939,8 @@ int CountTable::mergeCounts(string seq1, string seq2) {
             }
             m->mothurOut("[ERROR]: " + seq1 + " is not in your count table. Please correct.\n"); m->control_pressed = true;
         }else { 
-            map<string, int>::iterator it2 = indexNameMap.find(seq2);
-            if (it2 == indexNameMap.end()) {
+            int seqIndex2 = findSeq(seq2);
+            if (seqIndex2 == -1) {
                 if (hasGroupInfo()) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (m->inUsersGroups(seq2, groups)) {
@@ -944,10 +950,16 @@ int CountTable::mergeCounts(string seq1, string seq2) {
                 m->mothurOut("[ERROR]: " + seq2 + " is not in your count table. Please correct.\n"); m->control_pressed = true;
             }else { 
                 //merge data
-                for (int i = 0; i < groups.size(); i++) { counts[it->second][i] += counts[it2->second][i]; }
-                totals[it->second] += totals[it2->second];
+                if (hasGroups) {
+                    vector<int> thisCounts = getDenseCounts(seqIndex);
+                    for (int j = 0; j < counts[seqIndex2].size(); j+=2) { thisCounts[counts[seqIndex2][j]] += counts[seqIndex2][j+1]; }
+                    counts[seqIndex] = getSparseCounts(thisCounts);
+                    counts[seqIndex2].clear();
+                }
+                totals[seqIndex] += totals[seqIndex2];
+                totals[seqIndex2] = 0;
                 uniques--;
-                indexNameMap.erase(it2); 
+                removeSeqName(seqIndex2); 
             }
         }
         return 0;
@@ -978,5 +990,312 @@ int CountTable::copy(CountTable* ct) {
 }
 
 /************************************************************/
-
-
+/************************************************************/
+//binary copies of count files smaller than this aren't saved, they are read quickly enough
+static const unsigned long long countBinaryMinSize = 10000000;
+static const string countBinaryMagic = "mothurcount";
+static const int countBinaryVersion = 1;
+/************************************************************/
+int CountTable::findSeq(string seqName) {
+    try {
+        return nameHash.find(seqName, seqNames);
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "findSeq");
+		exit(1);
+	}
+}
+/************************************************************/
+void CountTable::addSeqName(string seqName, int seqIndex) {
+    try {
+        if (seqIndex >= seqNames.size()) { seqNames.resize(seqIndex+1, ""); }
+        seqNames[seqIndex] = seqName;
+        nameHash.add(seqIndex, seqNames);
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "addSeqName");
+		exit(1);
+	}
+}
+/************************************************************/
+void CountTable::removeSeqName(int seqIndex) {
+    try {
+        nameHash.remove(seqIndex, seqNames);
+        seqNames[seqIndex] = "";
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "removeSeqName");
+		exit(1);
+	}
+}
+/************************************************************/
+void CountTable::clearSeqs() {
+    seqNames.clear();
+    nameHash.clear();
+    counts.clear();
+    totals.clear();
+}
+/************************************************************/
+int CountTable::getCount(int seqIndex, int groupIndex) {
+    try {
+        vector<int>& row = counts[seqIndex];
+        
+        int low = 0; int high = row.size() / 2;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (row[2*mid] < groupIndex) { low = mid + 1; }
+            else { high = mid; }
+        }
+        
+        if ((2*low < row.size()) && (row[2*low] == groupIndex)) { return row[2*low+1]; }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "getCount");
+		exit(1);
+	}
+}
+/************************************************************/
+void CountTable::setCount(int seqIndex, int groupIndex, int num) {
+    try {
+        vector<int>& row = counts[seqIndex];
+        
+        int low = 0; int high = row.size() / 2;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (row[2*mid] < groupIndex) { low = mid + 1; }
+            else { high = mid; }
+        }
+        
+        if ((2*low < row.size()) && (row[2*low] == groupIndex)) {
+            if (num == 0) { row.erase(row.begin()+2*low, row.begin()+2*low+2); }
+            else { row[2*low+1] = num; }
+        }else if (num != 0) {
+            int pair[2] = { groupIndex, num };
+            row.insert(row.begin()+2*low, pair, pair+2);
+        }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "setCount");
+		exit(1);
+	}
+}
+/************************************************************/
+//counts of the seq for every group
+vector<int> CountTable::getDenseCounts(int seqIndex) {
+    try {
+        vector<int> thisCounts; thisCounts.resize(groups.size(), 0);
+        for (int i = 0; i < counts[seqIndex].size(); i+=2) { thisCounts[counts[seqIndex][i]] = counts[seqIndex][i+1]; }
+        return thisCounts;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "getDenseCounts");
+		exit(1);
+	}
+}
+/************************************************************/
+//group index, count pairs of the groups with counts
+vector<int> CountTable::getSparseCounts(vector<int>& thisCounts) {
+    try {
+        int numFound = 0;
+        for (int i = 0; i < thisCounts.size(); i++) { if (thisCounts[i] != 0) { numFound++; } }
+        
+        vector<int> row; row.reserve(numFound*2);
+        for (int i = 0; i < thisCounts.size(); i++) {
+            if (thisCounts[i] != 0) { row.push_back(i); row.push_back(thisCounts[i]); }
+        }
+        return row;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "getSparseCounts");
+		exit(1);
+	}
+}
+/************************************************************/
+//the binary copy holds the size of the count file, the sorted groups and for each seq its name, total and group counts
+bool CountTable::readBinary(bool readGroups, bool mothurRunning, bool& error) {
+    try {
+        string binaryName = filename + ".binary";
+        ifstream in(binaryName.c_str(), ios::binary);
+        if (!in) { return false; }
+        
+        //made before the count file changed
+        if (m->getTimeStamp(binaryName) < m->getTimeStamp(filename)) { in.close(); return false; }
+        
+        char magic[16];
+        in.read(magic, countBinaryMagic.length());
+        if (!in || (string(magic, countBinaryMagic.length()) != countBinaryMagic)) { in.close(); return false; }
+        
+        int version = readNumber(in);
+        unsigned long long textSize = readNumber(in);
+        if ((version != countBinaryVersion) || (textSize != getFileSize(filename))) { in.close(); return false; }
+        
+        int numGroups = readNumber(in);
+        for (int i = 0; i < numGroups; i++) {  groups.push_back(readString(in)); totalGroups.push_back(0); indexGroupMap[groups[i]] = i; }
+        if ((numGroups != 0) && readGroups) { hasGroups = true; }
+        m->setAllGroups(groups);
+        
+        int numSeqs = readNumber(in);
+        if (!in) { in.close(); groups.clear(); totalGroups.clear(); indexGroupMap.clear(); hasGroups = false; return false; }
+        totals.reserve(numSeqs);
+        seqNames.reserve(numSeqs);
+        if (hasGroups) { counts.reserve(numSeqs); }
+        nameHash.rebuild(seqNames, numSeqs);
+        
+        vector<string> zeroTotals; //reported once we know the copy isn't damaged
+        for (int i = 0; i < numSeqs; i++) {
+            
+            if (m->control_pressed || !in) { break; }
+            
+            string name = readString(in);
+            int thisTotal = (int)readNumber(in);
+            if (thisTotal == 0) { zeroTotals.push_back(name); }
+            
+            int numFound = readNumber(in);
+            vector<int> row; row.resize(numFound*2, 0);
+            int groupIndex = 0;
+            for (int j = 0; j < numFound; j++) {
+                groupIndex += readNumber(in);
+                if (groupIndex >= numGroups) { in.setstate(ios::failbit); break; }
+                row[2*j] = groupIndex;
+                row[2*j+1] = (int)readNumber(in);
+                totalGroups[groupIndex] += row[2*j+1];
+            }
+            if (hasGroups) {  counts.push_back(row);  }
+            
+            addSeqName(name, totals.size());
+            totals.push_back(thisTotal);
+            total += thisTotal;
+            uniques++;
+        }
+        
+        if (!in) { //damaged, read the count file instead
+            in.close();
+            groups.clear(); totalGroups.clear(); indexGroupMap.clear(); clearSeqs();
+            hasGroups = false; uniques = 0; total = 0;
+            return false;
+        }
+        in.close();
+        
+        if (!mothurRunning) {
+            for (int i = 0; i < zeroTotals.size(); i++) { error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + zeroTotals[i] + " with a total=0. Please correct."); m->mothurOutEndLine(); }
+        }
+        
+        if (!readGroups) { totalGroups.assign(numGroups, 0); }
+        
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "readBinary");
+		exit(1);
+	}
+}
+/************************************************************/
+int CountTable::writeBinary() {
+    try {
+        //only saved when the user asks for it with set.dir(countbinary=t)
+        if (!m->saveCountBinary) { return 0; }
+        if (getFileSize(filename) < countBinaryMinSize) { return 0; }
+        
+        //written under a temporary name so a command reading the file at the same time won't see a partial copy
+        string binaryName = filename + ".binary";
+        string tempName = binaryName + "." + m->mothurGetpid(0) + ".temp";
+        ofstream out(tempName.c_str(), ios::binary | ios::trunc);
+        if (!out) { return 0; } //can't write next to the count file
+        
+        out.write(countBinaryMagic.c_str(), countBinaryMagic.length());
+        writeNumber(out, countBinaryVersion);
+        writeNumber(out, getFileSize(filename));
+        
+        writeNumber(out, groups.size());
+        for (int i = 0; i < groups.size(); i++) { writeString(out, groups[i]); }
+        
+        writeNumber(out, totals.size());
+        for (int i = 0; i < totals.size(); i++) {
+            writeString(out, seqNames[i]);
+            writeNumber(out, (unsigned int)totals[i]);
+            
+            if (hasGroups) {
+                writeNumber(out, counts[i].size()/2);
+                int lastGroup = 0;
+                for (int j = 0; j < counts[i].size(); j+=2) {
+                    writeNumber(out, counts[i][j] - lastGroup);
+                    writeNumber(out, (unsigned int)counts[i][j+1]);
+                    lastGroup = counts[i][j];
+                }
+            }else { writeNumber(out, 0); }
+        }
+        out.close();
+        
+        if (!out || m->control_pressed) { m->mothurRemove(tempName); return 0; }
+        
+        if (rename(tempName.c_str(), binaryName.c_str()) != 0) { m->mothurRemove(tempName); }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "writeBinary");
+		exit(1);
+	}
+}
+/************************************************************/
+void CountTable::writeNumber(ostream& out, unsigned long long num) {
+	while (num >= 0x80) {
+		out.put((char)((num & 0x7F) | 0x80));
+		num >>= 7;
+	}
+	out.put((char)num);
+}
+/************************************************************/
+unsigned long long CountTable::readNumber(istream& input) {
+	unsigned long long num = 0;
+	int shift = 0;
+	while (input) {
+		int byte = input.get();
+		if (byte == EOF) { break; }
+        
+		num |= ((unsigned long long)(byte & 0x7F)) << shift;
+		if ((byte & 0x80) == 0) { break; }
+		shift += 7;
+	}
+	return num;
+}
+/************************************************************/
+void CountTable::writeString(ostream& out, string s) {
+	writeNumber(out, s.length());
+	out.write(s.c_str(), s.length());
+}
+/************************************************************/
+string CountTable::readString(istream& input) {
+	unsigned long long length = readNumber(input);
+    
+	string s = "";
+	char buffer[4096];
+	while ((length > 0) && input) {
+		int size = 4096;
+		if (length < size) { size = length; }
+		input.read(buffer, size);
+		s.append(buffer, input.gcount());
+		length -= size;
+	}
+	return s;
+}
+/************************************************************/
+unsigned long long CountTable::getFileSize(string name) {
+    try {
+        ifstream sizeIn(name.c_str(), ios::binary);
+        if (!sizeIn) { return 0; }
+        
+        sizeIn.seekg(0, ios::end);
+        unsigned long long size = sizeIn.tellg();
+        sizeIn.close();
+        
+        return size;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "getFileSize");
+		exit(1);
+	}
+}
+/************************************************************/
@@ -35,10 +35,16 @@
  
  */
 
+/* Names are found through a hash of the sequence names, and each sequence only keeps the groups it is found in,
+ so large tables with many groups and few sequences per group take little memory. When set.dir(countbinary=t) is
+ given, reading a large count file saves a binary copy of it as yourFile.count_table.binary, and later reads load the
+ copy until the count file changes. */
+
 
 #include "mothurout.h"
 #include "listvector.hpp"
 #include "groupmap.h"
+#include "namehash.h"
 
 class CountTable {
     
@@ -73,7 +79,7 @@ class CountTable {
         int push_back(string, vector<int>); //add a sequence with group info
         int remove(string); //remove seq
         int get(string); //returns unique sequence index for reading distance matrices like NameAssignment
-        int size() { return indexNameMap.size(); }
+        int size() { return nameHash.getNumNames(); }
     
         vector<string> getGroups(string); //returns vector of groups represented by this sequences
         vector<int> getGroupCounts(string);  //returns group counts for a seq passed in, if no group info is in file vector is blank. Order is the same as the groups returned by getGroups function.
@@ -97,12 +103,29 @@ class CountTable {
         bool hasGroups;
         int total, uniques;
         vector<string> groups;
-        vector< vector<int> > counts;
+        vector< vector<int> > counts;   //for each seq, the groups it is in and their counts as group index, count pairs sorted by group
         vector<int> totals;
         vector<int> totalGroups;
-        map<string, int> indexNameMap;
+        vector<string> seqNames;        //name of each seq index, blank once the seq is removed
+        NameHash nameHash;              //finds the seq index of a name in seqNames
         map<string, int> indexGroupMap;
     
+        int findSeq(string);            //seq index, -1 if not found
+        void addSeqName(string, int);   //name, seq index
+        void removeSeqName(int);
+        void clearSeqs();
+        int getCount(int, int);         //seq index, group index
+        void setCount(int, int, int);   //seq index, group index, count
+        vector<int> getDenseCounts(int);
+        vector<int> getSparseCounts(vector<int>&);
+    
+        bool readBinary(bool, bool, bool&);     //readGroups, mothurRunning, error. false if there is no current binary copy of the file
+        int writeBinary();
+        void writeNumber(ostream&, unsigned long long);
+        unsigned long long readNumber(istream&);
+        void writeString(ostream&, string);
+        string readString(istream&);
+        unsigned long long getFileSize(string);
 };
 
 #endif
@@ -11,15 +11,61 @@
 #include "database.hpp"
 #include "sequence.hpp"
 #include "distancedb.hpp"
-#include "eachgapignore.h"
 
 
+/**************************************************************************************************/
+//words of a packed sequence, outside the stored words there are no bases
+inline unsigned int getBaseWord(packedAlignment& seq, int w) {
+	w -= seq.firstWord;
+	if ((w < 0) || (w >= seq.bases.size())) { return 0; }
+	return seq.bases[w];
+}
+inline unsigned int getOtherWord(packedAlignment& seq, int w) {
+	w -= seq.firstWord;
+	if ((w < 0) || (w >= seq.others.size())) { return 0; }
+	return seq.others[w];
+}
+inline unsigned long long getCodeWord(packedAlignment& seq, int w) {
+	w -= seq.firstWord;
+	if ((w < 0) || (w >= seq.codes.size())) { return 0; }
+	return seq.codes[w];
+}
+/**************************************************************************************************/
+//bits of word w that are columns first to last
+inline unsigned int getRangeMask(int w, int first, int last) {
+	int low = first - (w * 32); if (low < 0) { low = 0; }
+	int high = last - (w * 32); if (high > 31) { high = 31; }
+	return ((0xFFFFFFFFu >> (31 - high)) & (0xFFFFFFFFu << low));
+}
+/**************************************************************************************************/
+//one bit per column for the 2 bit codes that are not 0
+inline unsigned int getNonZeroCodes(unsigned long long x) {
+	x = (x | (x >> 1)) & 0x5555555555555555ULL;
+	x = (x | (x >> 1)) & 0x3333333333333333ULL;
+	x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+	x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+	x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+	x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+	return (unsigned int)x;
+}
+/**************************************************************************************************/
+//first '.' at or after column, or the end of the alignment
+inline int getFirstDot(packedAlignment& seq, int column, int alignLength) {
+	for (int i = 0; i < seq.dots.size(); i++) {
+		if (seq.dots[i].second >= column) { return max(seq.dots[i].first, column); }
+	}
+	return alignLength;
+}
+/**************************************************************************************************/
+inline char getBase(packedAlignment& seq, int column) {
+	if ((getOtherWord(seq, column / 32) >> (column % 32)) & 1) { return seq.raw[column]; }
+	return "ACGT"[(getCodeWord(seq, column / 32) >> (2 * (column % 32))) & 3];
+}
 /**************************************************************************************************/
 DistanceDB::DistanceDB() : Database() { 
 	try {
 		templateAligned = true;  
 		templateSeqsLength = 0; 
-		distCalculator = new eachGapIgnoreTermGapDist();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "DistanceDB", "DistanceDB");
@@ -38,7 +84,8 @@ void DistanceDB::addSequence(Sequence seq) {
 		
 		if (templateSeqsLength == 0) { templateSeqsLength = seq.getAligned().length(); }
 				
-		data.push_back(seq);
+		names.push_back(seq.getName());
+		data.push_back(pack(seq.getAligned()));
 	}
 	catch(exception& e) {
 		m->errorOut(e, "DistanceDB", "addSequence");
@@ -52,7 +99,7 @@ vector<int> DistanceDB::findClosestSequences(Sequence* query, int numWanted){
 		vector<int> topMatches;
 		Scores.clear();
 		bool templateSameLength = true;
-		string sequence = query->getAligned();
+		const string& sequence = query->getAligned();
 		vector<seqDist> dists; 
 		
 		searchScore = -1.0;
@@ -66,14 +113,18 @@ vector<int> DistanceDB::findClosestSequences(Sequence* query, int numWanted){
 		if (sequence.length() != templateSeqsLength) { templateSameLength = false; }
 		
 		if (templateSameLength && templateAligned) {
+			packedAlignment packedQuery = pack(sequence);
+			int diff, length;
+			
 			if (numWanted != 1) {
 				
 				dists.resize(data.size());
 				
 				//calc distance from this sequence to every sequence in the template
 				for (int i = 0; i < data.size(); i++) {
-					distCalculator->calcDist(*query, data[i]);
-					float dist = distCalculator->getDist();
+					calcDist(packedQuery, data[i], diff, length, 0, 0);
+					float dist = 1.0;
+					if (length != 0) { dist = ((double)diff / (double)length); }
 					
 					//save distance to each template sequence
 					dists[i].seq1 = -1;
@@ -94,14 +145,20 @@ vector<int> DistanceDB::findClosestSequences(Sequence* query, int numWanted){
 			}else {
 				int bestIndex = 0;
 				float smallDist = 100000;
+				int bestDiff = 0; int bestLength = 0;
 				for (int i = 0; i < data.size(); i++) {
-					distCalculator->calcDist(*query, data[i]);
-					float dist = distCalculator->getDist();
+					//a template whose distance can't be smaller than the best is dropped before the end
+					if (!calcDist(packedQuery, data[i], diff, length, bestDiff, bestLength)) { continue; }
+					
+					float dist = 1.0;
+					if (length != 0) { dist = ((double)diff / (double)length); }
+					else { diff = 1; length = 1; }
 					
 					//are you smaller?
 					if (dist < smallDist) {
 						bestIndex = i;
 						smallDist = dist;
+						bestDiff = diff; bestLength = length;
 					}
 				}
 				searchScore = smallDist;
@@ -123,6 +180,128 @@ vector<int> DistanceDB::findClosestSequences(Sequence* query, int numWanted){
 	}	
 }
 /**************************************************************************************************/
+packedAlignment DistanceDB::pack(const string& aligned) {
+	try {
+		packedAlignment seq;
+		seq.firstBase = -1; seq.lastBase = -1; seq.firstWord = 0;
+		
+		int alignLength = aligned.length();
+		for (int i = 0; i < alignLength; i++) {
+			if (aligned[i] == '.') {
+				if ((seq.dots.size() != 0) && (seq.dots.back().second == (i-1))) { seq.dots.back().second = i; }
+				else { seq.dots.push_back(pair<int, int>(i, i)); }
+			}else if (aligned[i] != '-') {
+				if (seq.firstBase == -1) { seq.firstBase = i; }
+				seq.lastBase = i;
+			}
+		}
+		
+		if (seq.firstBase == -1) { return seq; }
+		
+		seq.firstWord = seq.firstBase / 32;
+		int numWords = (seq.lastBase / 32) - seq.firstWord + 1;
+		seq.codes.assign(numWords, 0);
+		seq.bases.assign(numWords, 0);
+		seq.others.assign(numWords, 0);
+		
+		bool hasOthers = false;
+		for (int i = seq.firstBase; i <= seq.lastBase; i++) {
+			char base = aligned[i];
+			if ((base == '.') || (base == '-')) { continue; }
+			
+			int w = (i / 32) - seq.firstWord;
+			int bit = i % 32;
+			seq.bases[w] |= (1u << bit);
+			
+			unsigned long long code = 0;
+			if (base == 'A')		{ code = 0; }
+			else if (base == 'C')	{ code = 1; }
+			else if (base == 'G')	{ code = 2; }
+			else if (base == 'T')	{ code = 3; }
+			else { seq.others[w] |= (1u << bit); hasOthers = true; }
+			
+			seq.codes[w] |= (code << (2 * bit));
+		}
+		
+		if (hasOthers) { seq.raw = aligned; }
+		
+		return seq;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceDB", "pack");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the eachGapIgnoreTermGapDist distance: from the first to the last column where both sequences have a base, stopping at
+//a '.', columns where either has a base count towards the length and columns where they differ are diffs
+bool DistanceDB::calcDist(packedAlignment& query, packedAlignment& temp, int& diff, int& length, int bestDiff, int bestLength) {
+	try {
+		diff = 0; length = 0;
+		
+		if ((query.firstBase == -1) || (temp.firstBase == -1)) { return true; }
+		
+		int low = max(query.firstBase, temp.firstBase);
+		int high = min(query.lastBase, temp.lastBase);
+		if (low > high) { return true; }
+		
+		//first and last column both sequences have a base in
+		int start = -1;
+		for (int w = low / 32; w <= high / 32; w++) {
+			unsigned int both = getBaseWord(query, w) & getBaseWord(temp, w) & getRangeMask(w, low, high);
+			if (both != 0) { start = (w * 32) + __builtin_ctz(both); break; }
+		}
+		
+		//non-overlapping sequences
+		if (start == -1) { return true; }
+		
+		int end = start;
+		for (int w = high / 32; w >= start / 32; w--) {
+			unsigned int both = getBaseWord(query, w) & getBaseWord(temp, w) & getRangeMask(w, start, high);
+			if (both != 0) { end = (w * 32) + 31 - __builtin_clz(both); break; }
+		}
+		
+		int dot = min(getFirstDot(query, start, templateSeqsLength), getFirstDot(temp, start, templateSeqsLength));
+		int last = min(end, dot - 1);
+		
+		for (int w = start / 32; w <= last / 32; w++) {
+			unsigned int range = getRangeMask(w, start, last);
+			unsigned int queryBases = getBaseWord(query, w) & range;
+			unsigned int tempBases = getBaseWord(temp, w) & range;
+			
+			//a base across from a gap is a diff
+			length += __builtin_popcount(queryBases | tempBases);
+			diff += __builtin_popcount(queryBases ^ tempBases);
+			
+			unsigned int both = queryBases & tempBases;
+			if (both != 0) {
+				unsigned int others = (getOtherWord(query, w) | getOtherWord(temp, w)) & both;
+				unsigned int mismatches = getNonZeroCodes(getCodeWord(query, w) ^ getCodeWord(temp, w)) & both & ~others;
+				diff += __builtin_popcount(mismatches);
+				
+				while (others != 0) {
+					int column = (w * 32) + __builtin_ctz(others);
+					if (getBase(query, column) != getBase(temp, column)) { diff++; }
+					others &= (others - 1);
+				}
+			}
+			
+			//even if every column left matched the distance would not be smaller than the best
+			if (bestLength != 0) {
+				long long remaining = last - ((w * 32) + 31);
+				if (remaining < 0) { remaining = 0; }
+				if (((long long)diff * bestLength) >= ((long long)bestDiff * (length + remaining))) { return false; }
+			}
+		}
+		
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceDB", "calcDist");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 bool DistanceDB::isAligned(string seq){
 	try {
 		bool aligned;
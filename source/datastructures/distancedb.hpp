@@ -12,28 +12,47 @@
 
 
 #include "mothur.h"
-#include "dist.h"
+
+/* The templates are kept packed for the search: two bits per column for A, C, G and T, one bit per column marking
+ the columns with a base and the columns with any other base character, and the runs of '.'. Only the words between
+ the first and last base of a template are stored. The distance is the eachGapIgnoreTermGapDist distance, computed 32
+ columns at a time, and when only the closest template is wanted a template is dropped as soon as its mismatches
+ can't give a smaller distance than the best one so far. */
+
+/**************************************************************************************************/
+
+struct packedAlignment {
+	vector<unsigned long long> codes;		//2 bits per column, 32 columns per word
+	vector<unsigned int> bases, others;		//1 bit per column, bases and bases other than A, C, G or T
+	vector< pair<int, int> > dots;			//first and last column of each run of '.'
+	string raw;								//the aligned sequence, only kept when it has other bases
+	int firstBase, lastBase, firstWord;		//words are stored from firstWord, firstBase is -1 if there are no bases
+};
+
+/**************************************************************************************************/
 
 class DistanceDB : public Database {
 	
 public:
 	
 	DistanceDB();
-	~DistanceDB() { delete distCalculator; }
+	~DistanceDB() {}
 	
 	void generateDB() {} //doesn't generate a search db 
 	void addSequence(Sequence); 
-	string getName(int i) { return data[i].getName(); } 
+	string getName(int i) { return names[i]; } 
 	vector<int> findClosestSequences(Sequence*, int);  // returns indexes of n closest sequences to query
 	
 private:
-	vector<Sequence> data;
-	Dist* distCalculator;
+	vector<string> names;
+	vector<packedAlignment> data;
 	
 	int templateSeqsLength;
 	bool templateAligned;
 	
 	bool isAligned(string);
+	packedAlignment pack(const string&);
+	bool calcDist(packedAlignment&, packedAlignment&, int&, int&, int, int);	//query, template, diffs, length, best diffs, best length (0 for no best). false if dropped
 	
 };
 
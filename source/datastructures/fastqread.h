@@ -49,7 +49,7 @@ public:
     void setName(string n) { name = n; }
     string getSeq() { return sequence; }
     void setSeq(string s) { sequence = s; }
-    vector<int> getScores() { return scores; }
+    const vector<int>& getScores() { return scores; }
     void setScores(vector<int> s) { scores = s;  }
     void printFastq(ostream&);
     
@@ -65,15 +65,15 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num){
 		Scores.clear();
 		
 		vector<int> matches(numSeqs, 0);						//	a record of the sequences with shared kmers
-		vector<int> timesKmerFound(kmerLocations.size()+1, 0);	//	a record of the kmers that we have already found
+		vector<int> timesKmerFound(kmerStarts.size(), 0);	//	a record of the kmers that we have already found
 		
 		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;	
 	
 		for(int i=0;i<numKmers;i++){
 			int kmerNumber = kmer.getKmerNumber(candidateSeq->getUnaligned(), i);		//	go through the query sequence and get a kmer number
 			if(timesKmerFound[kmerNumber] == 0){				//	if we haven't seen it before...
-				for(int j=0;j<kmerLocations[kmerNumber].size();j++){//increase the count for each sequence that also has
-					matches[kmerLocations[kmerNumber][j]]++;	//	that kmer
+				for(int j=kmerStarts[kmerNumber];j<kmerStarts[kmerNumber+1];j++){//increase the count for each sequence that also has
+					matches[kmerSeqs[j]]++;	//	that kmer
 				}
 			}
 			timesKmerFound[kmerNumber] = 1;						//	ok, we've seen the kmer now
@@ -142,6 +142,7 @@ void KmerDB::generateDB(){
 		}
 		kmerFile.close();
 		
+		pack();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "generateDB");
@@ -154,6 +155,13 @@ void KmerDB::addSequence(Sequence seq) {
 	try {
 		Kmer kmer(kmerSize);
 		
+		//adding to a packed database, unpack it
+		if (kmerLocations.size() == 0) {
+			kmerLocations.resize(maxKmer+1);
+			for(int i=0;(i+1)<kmerStarts.size();i++){ kmerLocations[i].assign(kmerSeqs.begin()+kmerStarts[i], kmerSeqs.begin()+kmerStarts[i+1]); }
+			kmerStarts.clear(); kmerSeqs.clear();
+		}
+		
 		string unaligned = seq.getUnaligned();	//	...take the unaligned sequence...
 		int numKmers = unaligned.length() - kmerSize + 1;
 			
@@ -183,18 +191,34 @@ void KmerDB::readKmerDB(ifstream& kmerDBFile){
 		//read version
 		string line = m->getline(kmerDBFile); m->gobble(kmerDBFile);
 		
-		string seqName;
-		int seqNumber;
-
+		//read straight into the packed table
+		kmerLocations.clear();
+		kmerStarts.assign(maxKmer+2, 0);
+		kmerSeqs.clear();
+		
 		for(int i=0;i<maxKmer;i++){
-			int numValues = 0;	
-			kmerDBFile >> seqName >> numValues;
+			if (m->control_pressed) { break; }
+			
+			kmerStarts[i] = kmerSeqs.size();
+			
+			line = m->getline(kmerDBFile); m->gobble(kmerDBFile);
+			const char* pos = line.c_str();
+			char* next;
+			
+			strtol(pos, &next, 10); pos = next;					//	kmer number
+			int numValues = strtol(pos, &next, 10); pos = next;	//	1. number of sequences with the kmer number
 			
 			for(int j=0;j<numValues;j++){						//	for each kmer number get the...
-				kmerDBFile >> seqNumber;						//		1. number of sequences with the kmer number
-				kmerLocations[i].push_back(seqNumber);			//		2. sequence indices
+				kmerSeqs.push_back(strtol(pos, &next, 10));		//		2. sequence indices
+				pos = next;
 			}
 		}
+		kmerStarts[maxKmer] = kmerSeqs.size();
+		kmerStarts[maxKmer+1] = kmerSeqs.size();
+		
+		//don't keep the spare capacity
+		vector<int>(kmerSeqs).swap(kmerSeqs);
+		
 		kmerDBFile.close();
 		
 	}
@@ -203,13 +227,52 @@ void KmerDB::readKmerDB(ifstream& kmerDBFile){
 		exit(1);
 	}	
 }
+/**************************************************************************************************/
+void KmerDB::setNumSeqs(int i) {
+	try {
+		numSeqs = i;
+		
+		//done adding sequences
+		pack();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "setNumSeqs");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//moves the sequences added to kmerLocations into the packed table
+void KmerDB::pack() {
+	try {
+		if (kmerLocations.size() == 0) { return; }
+		
+		kmerStarts.assign(kmerLocations.size()+1, 0);
+		
+		unsigned long long total = 0;
+		for(int i=0;i<kmerLocations.size();i++){ total += kmerLocations[i].size(); }
+		
+		kmerSeqs.clear(); kmerSeqs.reserve(total);
+		for(int i=0;i<kmerLocations.size();i++){
+			kmerStarts[i] = kmerSeqs.size();
+			kmerSeqs.insert(kmerSeqs.end(), kmerLocations[i].begin(), kmerLocations[i].end());
+			vector<int>().swap(kmerLocations[i]);
+		}
+		kmerStarts[kmerLocations.size()] = kmerSeqs.size();
+		
+		vector<vector<int> >().swap(kmerLocations);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "pack");
+		exit(1);
+	}	
+}
 
 /**************************************************************************************************/
 int KmerDB::getCount(int kmer) {
 	try {
 		if (kmer < 0) { return 0; }  //if user gives negative number
 		else if (kmer > maxKmer) {	return 0;	}  //or a kmer that is bigger than maxkmer
-		else {	return kmerLocations[kmer].size();	}  // kmer is in vector range
+		else {	return kmerStarts[kmer+1] - kmerStarts[kmer];	}  // kmer is in vector range
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "getCount");
@@ -238,7 +301,7 @@ vector<int> KmerDB::getSequencesWithKmer(int kmer) {
 	
 		if (kmer < 0) { }  //if user gives negative number
 		else if (kmer > maxKmer) {	}  //or a kmer that is bigger than maxkmer
-		else {	seqs = kmerLocations[kmer];	}
+		else {	seqs.assign(kmerSeqs.begin()+kmerStarts[kmer], kmerSeqs.begin()+kmerStarts[kmer+1]);	}
 		
 		return seqs;
 	}
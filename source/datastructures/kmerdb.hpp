@@ -11,7 +11,9 @@
  *	This class is a child class of the Database class, which stores the template sequences as a kmer table and provides
  *	a method of searching the kmer table for the sequence with the most kmers in common with a query sequence.
  *	kmerLocations is the primary storage variable that is a two-dimensional vector where each row represents the
- *	different number of kmers and each column contains the index to sequences that use that kmer.
+ *	different number of kmers and each column contains the index to sequences that use that kmer.  Once the database
+ *	is built it is packed into kmerStarts and kmerSeqs, one block of memory that is only read while searching, so the
+ *	processes commands fork share it with their parent instead of copying it.
  *
  *	Construction of an object of this type will first look for an appropriately named database file and if it is found
  *	then will read in the database file (readKmerDB), otherwise it will generate one and store the data in memory
@@ -33,6 +35,7 @@ public:
 	void addSequence(Sequence);
 	vector<int> findClosestSequences(Sequence*, int);
 	void readKmerDB(ifstream&);
+	void setNumSeqs(int);
 	int getCount(int);  //returns number of sequences with that kmer number
 	vector<int> getSequencesWithKmer(int);  //returns vector of sequences that contain kmer passed in
 	int getReversed(int);  //returns reverse compliment kmerNumber 
@@ -43,7 +46,11 @@ private:
 	int kmerSize;
 	int maxKmer, count;
 	string kmerDBName;
-	vector<vector<int> > kmerLocations;
+	vector<vector<int> > kmerLocations;    //filled by addSequence
+	vector<int> kmerStarts;                 //the sequences with kmer i are kmerSeqs[kmerStarts[i]] to kmerSeqs[kmerStarts[i+1]-1]
+	vector<int> kmerSeqs;
+	
+	void pack();
 };
 
 #endif
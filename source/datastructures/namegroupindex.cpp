@@ -0,0 +1,183 @@
+//
+//  namegroupindex.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "namegroupindex.h"
+#include "counttable.h"
+
+/***********************************************************************/
+//reads the way GroupMap::readMap does
+int NameGroupIndex::readGroupFile(string filename) {
+	try {
+		ifstream in;
+		m->openInputFile(filename, in);
+
+		map<string, int> groupIds;
+		string seqName, seqGroup;
+		int error = 0;
+		string rest = "";
+		char buffer[4096];
+		bool columnOne = true;
+
+		while (!in.eof()) {
+			if (m->control_pressed) { in.close(); return 1; }
+
+			in.read(buffer, 4096);
+			vector<string> pieces = m->splitWhiteSpace(rest, buffer, in.gcount());
+
+			for (int i = 0; i < pieces.size(); i++) {
+				if (columnOne) { seqName = pieces[i]; columnOne = false; }
+				else { seqGroup = pieces[i]; columnOne = true; addPair(seqName, seqGroup, groupIds, error); }
+			}
+		}
+		in.close();
+
+		if (rest != "") {
+			vector<string> pieces = m->splitWhiteSpace(rest);
+
+			for (int i = 0; i < pieces.size(); i++) {
+				if (columnOne) { seqName = pieces[i]; columnOne = false; }
+				else { seqGroup = pieces[i]; columnOne = true; addPair(seqName, seqGroup, groupIds, error); }
+			}
+		}
+		starts.push_back(entryGroups.size());
+
+		//sort the groups and renumber the pairs
+		sort(groups.begin(), groups.end());
+		vector<int> newIds(groups.size(), 0);
+		for (int i = 0; i < groups.size(); i++) { newIds[groupIds[groups[i]]] = i; }
+		for (int i = 0; i < entryGroups.size(); i++) { entryGroups[i] = newIds[entryGroups[i]]; }
+
+		return error;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "readGroupFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int NameGroupIndex::addPair(string& seqName, string& seqGroup, map<string, int>& groupIds, int& error) {
+	try {
+		m->checkGroupName(seqGroup);
+
+		map<string, int>::iterator it = groupIds.find(seqGroup);
+		int groupId = 0;
+		if (it == groupIds.end()) { groupId = groups.size(); groupIds[seqGroup] = groupId; groups.push_back(seqGroup); }
+		else { groupId = it->second; }
+
+		if (m->debug) { m->mothurOut("[DEBUG]: name = '" + seqName + "', group = '" + seqGroup + "'\n"); }
+		m->checkName(seqName);
+
+		if (!addSeqName(seqName)) { error = 1; m->mothurOut("Your groupfile contains more than 1 sequence named " + seqName + ", sequence names must be unique. Please correct."); m->mothurOutEndLine(); }
+		else {
+			starts.push_back(entryGroups.size());
+			entryGroups.push_back(groupId);
+			entryCounts.push_back(1);
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "addPair");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int NameGroupIndex::readCountTable(string filename) {
+	try {
+		CountTable ct;
+		ct.readTable(filename, true, false);
+
+		groups = ct.getNamesOfGroups();
+		vector<string> names = ct.getNamesOfSeqs();
+
+		for (int i = 0; i < names.size(); i++) {
+			if (m->control_pressed) { break; }
+
+			addSeqName(names[i]);
+			starts.push_back(entryGroups.size());
+
+			vector<int> counts = ct.getGroupCounts(names[i]);
+			for (int j = 0; j < counts.size(); j++) {
+				if (counts[j] != 0) { entryGroups.push_back(j); entryCounts.push_back(counts[j]); }
+			}
+		}
+		starts.push_back(entryGroups.size());
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "readCountTable");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string NameGroupIndex::getGroup(int seqIndex) {
+	try {
+		if (starts[seqIndex] == starts[seqIndex+1]) { return "not found"; }
+		return groups[entryGroups[starts[seqIndex]]];
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "getGroup");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void NameGroupIndex::addCounts(int seqIndex, int bin, vector< vector<int> >& abunds) {
+	try {
+		for (int i = starts[seqIndex]; i < starts[seqIndex+1]; i++) { abunds[entryGroups[i]][bin] += entryCounts[i]; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "addCounts");
+		exit(1);
+	}
+}
+/***********************************************************************/
+struct compareSeqNames {
+	vector<string>* names;
+	compareSeqNames(vector<string>* n) : names(n) {}
+	bool operator()(int left, int right) const { return ((*names)[left] < (*names)[right]); }
+};
+/***********************************************************************/
+vector<int> NameGroupIndex::getSeqsSortedByName() {
+	try {
+		vector<int> sorted(seqNames.size(), 0);
+		for (int i = 0; i < sorted.size(); i++) { sorted[i] = i; }
+		sort(sorted.begin(), sorted.end(), compareSeqNames(&seqNames));
+
+		return sorted;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "getSeqsSortedByName");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int NameGroupIndex::getIndex(string& seqName) {
+	try {
+		return nameHash.find(seqName, seqNames);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "getIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool NameGroupIndex::addSeqName(string& seqName) {
+	try {
+		if (getIndex(seqName) != -1) { return false; }
+
+		seqNames.push_back(seqName);
+		nameHash.add(seqNames.size()-1, seqNames);
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameGroupIndex", "addSeqName");
+		exit(1);
+	}
+}
+/***********************************************************************/
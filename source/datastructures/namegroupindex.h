@@ -0,0 +1,55 @@
+#ifndef Mothur_namegroupindex_h
+#define Mothur_namegroupindex_h
+
+//
+//  namegroupindex.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "namehash.h"
+
+/* Maps the sequence names of a group file or count table to the groups they belong to, for commands that read a
+ list file one label at a time. Each name is stored once and found through a hash, and each group name is stored
+ once, so a sequence only costs its name and the group index, count pairs it is found in. Group names are sorted the
+ way GroupMap and CountTable return them. */
+
+/***********************************************************************/
+
+class NameGroupIndex {
+
+public:
+	NameGroupIndex() { m = MothurOut::getInstance(); }
+	~NameGroupIndex() {}
+
+	int readGroupFile(string);              //returns 1 if a name is repeated, like GroupMap::readMap
+	int readCountTable(string);
+
+	vector<string> getNamesOfGroups()   { return groups;            }
+	int getNumGroups()                  { return groups.size();     }
+	int getNumSeqs()                    { return seqNames.size();   }   //unique names
+
+	int getIndex(string&);                  //index of a sequence, -1 if not found
+	string getName(int i)               { return seqNames[i];       }
+	string getGroup(int);                   //group of a sequence from a group file
+	void addCounts(int, int, vector< vector<int> >&);   //seq index, bin, abundances[group][bin]
+	vector<int> getSeqsSortedByName();
+
+private:
+	MothurOut* m;
+	vector<string> groups;
+	vector<string> seqNames;
+	vector<int> starts;                     //seqs group, count pairs are entries starts[i] to starts[i+1]-1
+	vector<int> entryGroups, entryCounts;
+	NameHash nameHash;                      //finds the index of a name in seqNames
+
+	bool addSeqName(string&);               //false if the name is already there
+	int addPair(string&, string&, map<string, int>&, int&);
+};
+
+/***********************************************************************/
+
+#endif
@@ -0,0 +1,104 @@
+//
+//  namehash.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "namehash.h"
+
+/***********************************************************************/
+//64 bit FNV-1a
+unsigned long long NameHash::hash(const string& s) {
+	return hash(14695981039346656037ULL, s.data(), s.length());
+}
+/***********************************************************************/
+unsigned long long NameHash::hash(unsigned long long h, const char* bytes, int length) {
+	for (int i = 0; i < length; i++) { h ^= (unsigned char)bytes[i]; h *= 1099511628211ULL; }
+	return h;
+}
+/***********************************************************************/
+int NameHash::find(const string& name, vector<string>& names) {
+	try {
+		if (slots.size() == 0) { return -1; }
+
+		unsigned long long mask = slots.size() - 1;
+		unsigned long long slot = hash(name) & mask;
+		while (slots[slot] != 0) {
+			if ((slots[slot] > 0) && (names[slots[slot]-1] == name)) { return (slots[slot]-1); }
+			slot = (slot + 1) & mask;
+		}
+
+		return -1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameHash", "find");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void NameHash::add(int index, vector<string>& names) {
+	try {
+		//keep at least half the slots empty so searches stay short
+		if (((usedSlots + 1) * 2) > slots.size()) { rebuild(names, numNames+1); return; }
+
+		unsigned long long mask = slots.size() - 1;
+		unsigned long long slot = hash(names[index]) & mask;
+		while (slots[slot] > 0) { slot = (slot + 1) & mask; }
+
+		if (slots[slot] == 0) { usedSlots++; }
+		slots[slot] = index + 1;
+		numNames++;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameHash", "add");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void NameHash::remove(int index, vector<string>& names) {
+	try {
+		if (slots.size() == 0) { return; }
+
+		unsigned long long mask = slots.size() - 1;
+		unsigned long long slot = hash(names[index]) & mask;
+		while (slots[slot] != 0) {
+			if (slots[slot] == (index + 1)) { slots[slot] = -1; numNames--; break; }
+			slot = (slot + 1) & mask;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameHash", "remove");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void NameHash::rebuild(vector<string>& names, int num) {
+	try {
+		int numSlots = 16;
+		while (numSlots < (num * 2)) { numSlots *= 2; }
+
+		slots.assign(numSlots, 0);
+		usedSlots = 0; numNames = 0;
+
+		unsigned long long mask = numSlots - 1;
+		for (int i = 0; i < names.size(); i++) {
+			if (names[i] == "") { continue; }
+
+			unsigned long long slot = hash(names[i]) & mask;
+			while (slots[slot] != 0) { slot = (slot + 1) & mask; }
+			slots[slot] = i + 1;
+			usedSlots++; numNames++;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NameHash", "rebuild");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void NameHash::clear() {
+	slots.clear();
+	usedSlots = 0; numNames = 0;
+}
+/***********************************************************************/
@@ -0,0 +1,46 @@
+#ifndef Mothur_namehash_h
+#define Mothur_namehash_h
+
+//
+//  namehash.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/* Finds names in a vector<string> through an open addressing hash of them, so CountTable and NameGroupIndex don't
+ need a map<string, int> copy of every sequence name. The names stay in the owner's vector and the hash only stores
+ their indexes, so the owner passes its vector in to each call. The hash function is 64 bit FNV-1a, which CommandCache
+ also uses for its keys and input files. */
+
+/***********************************************************************/
+
+class NameHash {
+
+public:
+	NameHash() { m = MothurOut::getInstance(); usedSlots = 0; numNames = 0; }
+	~NameHash() {}
+
+	static unsigned long long hash(const string&);
+	static unsigned long long hash(unsigned long long, const char*, int);  //hash so far, bytes, number of bytes. start from hash("")
+
+	int find(const string&, vector<string>&);   //name, names. index of the name, -1 if not found
+	void add(int, vector<string>&);             //index of a name already in names
+	void remove(int, vector<string>&);          //index of a name still in names
+	void rebuild(vector<string>&, int);         //names, room for this many names. blank names are skipped
+	void clear();
+	int getNumNames()   { return numNames; }
+
+private:
+	MothurOut* m;
+	vector<int> slots;                      //0 for an empty slot, -1 for a removed name, otherwise index + 1
+	int usedSlots, numNames;
+
+};
+
+/***********************************************************************/
+
+#endif
@@ -0,0 +1,398 @@
+//
+//  otuindex.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "otuindex.h"
+
+//file layout:
+//  "mothurotuindex", version, format, size of the text file
+//  one block per label
+//      list: numBins, for each bin the number of names and the index of each name
+//      shared: numOtus, numGroups, for each group the group index, the number of non zero otus and then (otu - previous otu, abundance) for each of them
+//  names, bin labels of the file, for each label the label, block position and text position
+//  8 byte position of the names
+//all numbers except the last are variable length integers, 7 bits per byte with the high bit set if more bytes follow
+
+static const string otuIndexMagic = "mothurotuindex";
+static const int otuIndexVersion = 1;
+
+/***********************************************************************/
+OTUIndex::OTUIndex() {
+	m = MothurOut::getInstance();
+	format = "";
+}
+/***********************************************************************/
+int OTUIndex::createIndex(string textFile, string f, string indexFile) {
+	try {
+		format = f;
+		names.clear(); binLabelsInFile.clear(); labels.clear(); labelIndex.clear(); blockStart.clear(); textEnd.clear();
+		map<string, int> nameIndex;
+
+		ifstream textIn;
+		m->openInputFile(textFile, textIn);
+
+		string completeName = m->getFullPathName(indexFile);
+		ofstream out(completeName.c_str(), ios::binary | ios::trunc);
+		if (!out) { m->mothurOut("[ERROR]: Could not open " + completeName + "\n"); textIn.close(); return 1; }
+
+		unsigned long long textSize = getFileSize(textFile);
+		out.write(otuIndexMagic.c_str(), otuIndexMagic.length());
+		writeNumber(out, otuIndexVersion);
+		writeString(out, format);
+		writeNumber(out, textSize);
+
+		string saveNextLabel = m->saveNextLabel;
+		m->saveNextLabel = "";
+
+		while (!textIn.eof()) {
+			if (m->control_pressed) { break; }
+
+			string thisLabel = "";
+			unsigned long long thisStart = out.tellp();
+
+			if (format == "list") {
+				ListVector* list = new ListVector(textIn); m->gobble(textIn);
+				if (labels.size() == 0) { binLabelsInFile = m->listBinLabelsInFile; }
+				thisLabel = list->getLabel();
+				writeListBlock(out, list, nameIndex);
+				delete list;
+			}else {
+				SharedOTUTable* table = new SharedOTUTable(textIn); m->gobble(textIn);
+				if (labels.size() == 0) { binLabelsInFile = m->sharedBinLabelsInFile; }
+				thisLabel = table->getLabel();
+				writeSharedBlock(out, table, nameIndex);
+				delete table;
+			}
+
+			labelIndex[thisLabel] = labels.size();
+			labels.push_back(thisLabel);
+			blockStart.push_back(thisStart);
+			if (textIn.eof()) { textEnd.push_back(textSize); }
+			else { textEnd.push_back(textIn.tellg()); }
+
+			m->mothurOut(thisLabel + "\n");
+		}
+		textIn.close();
+		m->saveNextLabel = saveNextLabel;
+
+		//names are written after the blocks because we don't know them until the whole file is read
+		unsigned long long namesStart = out.tellp();
+		writeNumber(out, names.size());
+		for (int i = 0; i < names.size(); i++) { writeString(out, names[i]); }
+		writeNumber(out, binLabelsInFile.size());
+		for (int i = 0; i < binLabelsInFile.size(); i++) { writeString(out, binLabelsInFile[i]); }
+		writeNumber(out, labels.size());
+		for (int i = 0; i < labels.size(); i++) {
+			writeString(out, labels[i]);
+			writeNumber(out, blockStart[i]);
+			writeNumber(out, textEnd[i]);
+		}
+
+		char fixed[8];
+		for (int i = 0; i < 8; i++) { fixed[i] = (char)((namesStart >> (8*i)) & 0xFF); }
+		out.write(fixed, 8);
+		out.close();
+
+		if (m->control_pressed) { m->mothurRemove(completeName); }
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "createIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int OTUIndex::writeListBlock(ostream& out, ListVector* list, map<string, int>& nameIndex) {
+	try {
+		writeNumber(out, list->size());
+
+		for (int i = 0; i < list->size(); i++) {
+			vector<string> binNames;
+			string bin = list->get(i);
+			if (bin != "") { m->splitAtComma(bin, binNames); }
+
+			writeNumber(out, binNames.size());
+			for (int j = 0; j < binNames.size(); j++) {
+				map<string, int>::iterator it = nameIndex.find(binNames[j]);
+				if (it == nameIndex.end()) {
+					nameIndex[binNames[j]] = names.size();
+					writeNumber(out, names.size());
+					names.push_back(binNames[j]);
+				}else { writeNumber(out, it->second); }
+			}
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "writeListBlock");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int OTUIndex::writeSharedBlock(ostream& out, SharedOTUTable* table, map<string, int>& nameIndex) {
+	try {
+		writeNumber(out, table->getNumBins());
+		writeNumber(out, table->getNumGroups());
+
+		for (int g = 0; g < table->getNumGroups(); g++) {
+			string group = table->getGroup(g);
+			map<string, int>::iterator it = nameIndex.find(group);
+			if (it == nameIndex.end()) {
+				nameIndex[group] = names.size();
+				writeNumber(out, names.size());
+				names.push_back(group);
+			}else { writeNumber(out, it->second); }
+
+			writeNumber(out, table->getRowEnd(g) - table->getRowStart(g));
+
+			//the otus of a group are sorted, so the gaps are small
+			int lastOTU = 0;
+			for (unsigned long long j = table->getRowStart(g); j < table->getRowEnd(g); j++) {
+				writeNumber(out, table->getOTU(j) - lastOTU);
+				writeNumber(out, table->getCellAbundance(j));
+				lastOTU = table->getOTU(j);
+			}
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "writeSharedBlock");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool OTUIndex::open(string textFile, string f) {
+	try {
+		string completeName = m->getFullPathName(textFile + ".otuindex");
+		in.open(completeName.c_str(), ios::binary);
+		if (!in) { in.clear(); return false; }
+
+		char magic[14];
+		in.read(magic, otuIndexMagic.length());
+		if (!in || (string(magic, otuIndexMagic.length()) != otuIndexMagic)) { in.close(); return false; }
+
+		int version = readNumber(in);
+		format = readString(in);
+		unsigned long long textSize = readNumber(in);
+
+		if ((version != otuIndexVersion) || (format != f)) { in.close(); return false; }
+		if ((textSize != getFileSize(textFile)) || (m->getTimeStamp(completeName) < m->getTimeStamp(textFile))) {
+			m->mothurOut("[WARNING]: " + completeName + " does not match " + textFile + ", ignoring it. You can run make.otuindex to update it.\n");
+			in.close(); return false;
+		}
+
+		in.seekg(-8, ios::end);
+		char fixed[8];
+		in.read(fixed, 8);
+		unsigned long long namesStart = 0;
+		for (int i = 0; i < 8; i++) { namesStart |= ((unsigned long long)(unsigned char)fixed[i]) << (8*i); }
+
+		in.seekg(namesStart);
+		int numNames = readNumber(in);
+		names.resize(numNames);
+		for (int i = 0; i < numNames; i++) { names[i] = readString(in); }
+
+		int numBinLabels = readNumber(in);
+		binLabelsInFile.resize(numBinLabels);
+		for (int i = 0; i < numBinLabels; i++) { binLabelsInFile[i] = readString(in); }
+
+		int numLabels = readNumber(in);
+		for (int i = 0; i < numLabels; i++) {
+			string thisLabel = readString(in);
+			labelIndex[thisLabel] = labels.size();
+			labels.push_back(thisLabel);
+			blockStart.push_back(readNumber(in));
+			textEnd.push_back(readNumber(in));
+		}
+
+		if (!in) { m->mothurOut("[WARNING]: " + completeName + " is damaged, ignoring it.\n"); in.close(); return false; }
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "open");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int OTUIndex::findLabel(string label) {
+	map<string, int>::iterator it = labelIndex.find(label);
+	if (it == labelIndex.end()) { return -1; }
+	return it->second;
+}
+/***********************************************************************/
+bool OTUIndex::hasLabel(string label) {
+	return (findLabel(label) != -1);
+}
+/***********************************************************************/
+unsigned long long OTUIndex::getTextEnd(string label) {
+	int index = findLabel(label);
+	if (index == -1) { return 0; }
+	return textEnd[index];
+}
+/***********************************************************************/
+int OTUIndex::getLabelEndingAt(unsigned long long pos) {
+	vector<unsigned long long>::iterator it = lower_bound(textEnd.begin(), textEnd.end(), pos);
+	if ((it == textEnd.end()) || (*it != pos)) { return -1; }
+	return (it - textEnd.begin());
+}
+/***********************************************************************/
+ListVector* OTUIndex::getListVector(string label) {
+	try {
+		int index = findLabel(label);
+		if (index == -1) { return NULL; }
+
+		in.clear();
+		in.seekg(blockStart[index]);
+
+		int numBins = readNumber(in);
+		ListVector* list = new ListVector(numBins);
+		list->setLabel(label);
+
+		for (int i = 0; i < numBins; i++) {
+			if (m->control_pressed) { break; }
+
+			int numNames = readNumber(in);
+			string bin = "";
+			for (int j = 0; j < numNames; j++) {
+				if (j != 0) { bin += ","; }
+				bin += names[readNumber(in)];
+			}
+			list->set(i, bin);
+		}
+
+		m->listBinLabelsInFile = binLabelsInFile;
+		vector<string> binLabels = binLabelsInFile;
+		if (binLabels.size() > numBins) { binLabels.resize(numBins); }
+		list->setLabels(binLabels);
+
+		//the list reader leaves the label it read, or "" at the end of the file
+		if (index == (labels.size()-1)) { m->saveNextLabel = ""; }
+		else { m->saveNextLabel = label; }
+
+		return list;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "getListVector");
+		exit(1);
+	}
+}
+/***********************************************************************/
+SharedOTUTable* OTUIndex::getSharedOTUTable(string label) {
+	try {
+		int index = findLabel(label);
+		if (index == -1) { return NULL; }
+
+		in.clear();
+		in.seekg(blockStart[index]);
+
+		int num = readNumber(in);
+		int numGroups = readNumber(in);
+
+		m->clearAllGroups();
+		m->sharedBinLabelsInFile = binLabelsInFile;
+		m->currentSharedBinLabels = binLabelsInFile;
+
+		SharedOTUTable* table = new SharedOTUTable();
+		table->setLabel(label);
+		table->setOTULabels(binLabelsInFile, num);
+
+		vector<string> allGroups;
+		for (int g = 0; g < numGroups; g++) {
+			if (m->control_pressed) { break; }
+
+			string group = names[readNumber(in)];
+			int numNonZero = readNumber(in);
+
+			vector<int> otus(numNonZero, 0); vector<int> abunds(numNonZero, 0);
+			int lastOTU = 0;
+			for (int j = 0; j < numNonZero; j++) {
+				otus[j] = lastOTU + readNumber(in);
+				abunds[j] = readNumber(in);
+				lastOTU = otus[j];
+			}
+
+			table->push_back(group, otus, abunds);
+			allGroups.push_back(group);
+		}
+
+		m->setAllGroups(allGroups);
+
+		//the shared reader leaves the label after the one it read, or "" at the end of the file
+		if (index == (labels.size()-1)) { m->saveNextLabel = ""; }
+		else { m->saveNextLabel = labels[index+1]; }
+
+		return table;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "getSharedOTUTable");
+		exit(1);
+	}
+}
+/***********************************************************************/
+unsigned long long OTUIndex::getFileSize(string filename) {
+	try {
+		string completeName = m->getFullPathName(filename);
+		ifstream sizeIn(completeName.c_str(), ios::binary);
+		if (!sizeIn) { return 0; }
+
+		sizeIn.seekg(0, ios::end);
+		unsigned long long size = sizeIn.tellg();
+		sizeIn.close();
+
+		return size;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OTUIndex", "getFileSize");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void OTUIndex::writeNumber(ostream& out, unsigned long long num) {
+	while (num >= 0x80) {
+		out.put((char)((num & 0x7F) | 0x80));
+		num >>= 7;
+	}
+	out.put((char)num);
+}
+/***********************************************************************/
+unsigned long long OTUIndex::readNumber(istream& input) {
+	unsigned long long num = 0;
+	int shift = 0;
+	while (input) {
+		int byte = input.get();
+		if (byte == EOF) { break; }
+
+		num |= ((unsigned long long)(byte & 0x7F)) << shift;
+		if ((byte & 0x80) == 0) { break; }
+		shift += 7;
+	}
+	return num;
+}
+/***********************************************************************/
+void OTUIndex::writeString(ostream& out, string s) {
+	writeNumber(out, s.length());
+	out.write(s.c_str(), s.length());
+}
+/***********************************************************************/
+string OTUIndex::readString(istream& input) {
+	unsigned long long length = readNumber(input);
+
+	string s = "";
+	char buffer[4096];
+	while ((length > 0) && input) {
+		int size = 4096;
+		if (length < size) { size = length; }
+		input.read(buffer, size);
+		s.append(buffer, input.gcount());
+		length -= size;
+	}
+	return s;
+}
+/***********************************************************************/
@@ -0,0 +1,66 @@
+#ifndef Mothur_otuindex_h
+#define Mothur_otuindex_h
+
+//
+//  otuindex.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "listvector.hpp"
+#include "sharedotutable.h"
+
+/* Binary companion of a list or shared file, written by make.otuindex as yourFile.otuindex.
+ The sequence names of a list file or the groups of a shared file are stored once, and each label is stored as
+ variable length integers pointing into them. A directory of the labels at the end of the file gives the position of
+ each label, so InputData can read the label it wants without parsing the labels before it.
+ The size of the text file is saved in the index, and an index whose text file has a different size or is newer than
+ the index is not used. */
+
+/***********************************************************************/
+
+class OTUIndex {
+
+public:
+	OTUIndex();
+	~OTUIndex() { in.close(); }
+
+	int createIndex(string, string, string);    //text file, format ("list" or "sharedfile"), index file
+	bool open(string, string);                  //text file, format. opens textfile.otuindex, returns false if there isn't a current one
+
+	vector<string> getLabels()          { return labels;    }
+	bool hasLabel(string);
+	unsigned long long getTextEnd(string);      //position in the text file after this label
+	unsigned long long getTextEnd(int i)    { return textEnd[i];    }
+	int getLabelEndingAt(unsigned long long);   //index of the label that ends at this position in the text file, -1 if none
+
+	//set m->saveNextLabel and the bin labels the same way the text readers do
+	ListVector* getListVector(string);          //returns NULL if the label is not in the file
+	SharedOTUTable* getSharedOTUTable(string);  //returns NULL if the label is not in the file
+
+private:
+	MothurOut* m;
+	ifstream in;
+	string format;
+	vector<string> names;               //sequence names of a list file, groups of a shared file
+	vector<string> binLabelsInFile;
+	vector<string> labels;
+	map<string, int> labelIndex;
+	vector<unsigned long long> blockStart, textEnd;
+
+	int findLabel(string);
+	unsigned long long getFileSize(string);
+	void writeNumber(ostream&, unsigned long long);
+	unsigned long long readNumber(istream&);
+	void writeString(ostream&, string);
+	string readString(istream&);
+	int writeListBlock(ostream&, ListVector*, map<string, int>&);
+	int writeSharedBlock(ostream&, SharedOTUTable*, map<string, int>&);
+};
+
+/***********************************************************************/
+
+#endif
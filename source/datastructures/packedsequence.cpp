@@ -0,0 +1,125 @@
+//
+//  packedsequence.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "packedsequence.h"
+
+//the 16 IUPAC codes, the index into this string is the 4 bit code
+static const char iupacCodes[] = "ACGTURYSWKMBDHVN";
+
+/**************************************************************************************************/
+PackedSequence::PackedSequence() {
+    m = MothurOut::getInstance();
+    alignmentLength = 0; numBases = 0; packed = false;
+}
+/**************************************************************************************************/
+PackedSequence::PackedSequence(Sequence& seq) {
+    try {
+        m = MothurOut::getInstance();
+        
+        name = seq.getName();
+        comment = seq.getComment();
+        
+        const string& aligned = seq.getAligned();
+        alignmentLength = aligned.length();
+        numBases = seq.getNumBases();
+        
+        packed = pack(aligned);
+        if (!packed) { raw = aligned; }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSequence", "PackedSequence");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int PackedSequence::getCode(char base) {
+    for (int i = 0; i < 16; i++) { if (iupacCodes[i] == base) { return i; } }
+    return -1;
+}
+/**************************************************************************************************/
+bool PackedSequence::pack(const string& aligned) {
+    try {
+        bases.clear(); gaps.clear();
+        
+        int baseCount = 0;
+        for (int i = 0; i < aligned.length(); i++) {
+            char c = aligned[i];
+            
+            if ((c == '-') || (c == '.')) {
+                //extend the current run or start a new one
+                if ((gaps.size() != 0) && (gaps.back().symbol == c) && ((gaps.back().start + gaps.back().length) == i)) { gaps.back().length++; }
+                else { gaps.push_back(gapRun(i, 1, c)); }
+            }else {
+                int code = getCode(c);
+                if (code == -1) { bases.clear(); gaps.clear(); return false; }
+                
+                if ((baseCount % 2) == 0)   { bases.push_back((unsigned char)code);               }
+                else                        { bases.back() |= (unsigned char)(code << 4);       }
+                baseCount++;
+            }
+        }
+        
+        //don't keep the spare capacity for sets with thousands of templates
+        vector<unsigned char>(bases).swap(bases);
+        vector<gapRun>(gaps).swap(gaps);
+        
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSequence", "pack");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+string PackedSequence::unpack() {
+    try {
+        if (!packed) { return raw; }
+        
+        string aligned(alignmentLength, '-');
+        
+        int baseCount = 0;
+        int pos = 0;
+        for (int i = 0; i <= gaps.size(); i++) {
+            //fill the bases before this run, or before the end of the alignment
+            int end = alignmentLength;
+            if (i < gaps.size()) { end = gaps[i].start; }
+            
+            for (; pos < end; pos++) {
+                unsigned char basePair = bases[baseCount / 2];
+                if ((baseCount % 2) == 0)   { aligned[pos] = iupacCodes[basePair & 0x0F];        }
+                else                        { aligned[pos] = iupacCodes[(basePair >> 4) & 0x0F]; }
+                baseCount++;
+            }
+            
+            if (i < gaps.size()) {
+                for (int j = 0; j < gaps[i].length; j++) { aligned[pos] = gaps[i].symbol; pos++; }
+            }
+        }
+        
+        return aligned;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSequence", "unpack");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+Sequence PackedSequence::getSequence() {
+    try {
+        Sequence seq;
+        seq.setName(name);
+        seq.setComment(comment);
+        seq.setAligned(unpack());
+        
+        return seq;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedSequence", "getSequence");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,57 @@
+#ifndef Mothur_packedsequence_h
+#define Mothur_packedsequence_h
+
+//
+//  packedsequence.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "sequence.hpp"
+
+/* Compact storage for aligned reference sequences.  Reference alignments like silva are mostly gap characters,
+ so the gaps are stored as runs and the bases are stored 4 bits each using the IUPAC codes.  Sequences that contain 
+ characters the packing can't represent (lowercase bases, etc.) are stored as is. getSequence() rebuilds the 
+ original Sequence. */
+
+/**************************************************************************************************/
+struct gapRun {
+    int start;
+    int length;
+    char symbol;
+    
+    gapRun() : start(0), length(0), symbol('-') {}
+    gapRun(int s, int l, char c) : start(s), length(l), symbol(c) {}
+};
+/**************************************************************************************************/
+
+class PackedSequence {
+    
+public:
+    PackedSequence();
+    PackedSequence(Sequence&);
+    ~PackedSequence() {}
+    
+    Sequence getSequence();
+    string getName()            { return name;              }
+    int getAlignLength()        { return alignmentLength;   }
+    int getNumBases()           { return numBases;          }
+    
+private:
+    MothurOut* m;
+    string name, comment, raw;
+    vector<unsigned char> bases;  //two bases per byte
+    vector<gapRun> gaps;
+    int alignmentLength, numBases;
+    bool packed;
+    
+    bool pack(const string&);
+    string unpack();
+    static int getCode(char);
+};
+
+/**************************************************************************************************/
+
+#endif
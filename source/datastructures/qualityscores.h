@@ -31,7 +31,7 @@ public:
     int read(ifstream&);
 	string getName();
 	int getLength(){    return (int)qScores.size();  }
-	vector<int> getQualityScores() { return qScores; }
+	const vector<int>& getQualityScores() { return qScores; }
 	void printQScores(ofstream&);
     void printQScores(ostream&);
 	void trimQScores(int, int);
@@ -45,7 +45,7 @@ public:
 	void updateReverseMap(vector<vector<int> >&, int, int, int);
     void setName(string n); 
     void setScores(vector<int> qs) { qScores = qs; seqLength = qScores.size(); }
-    vector<int> getScores() { return qScores; }
+    const vector<int>& getScores() { return qScores; }
 	
 private:
 	
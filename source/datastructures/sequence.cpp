@@ -672,13 +672,13 @@ string Sequence::convert2ints() {
 
 //********************************************************************************************************************
 
-string Sequence::getName(){
+const string& Sequence::getName() const {
 	return name;
 }
 
 //********************************************************************************************************************
 
-string Sequence::getAligned(){
+const string& Sequence::getAligned() const {
 	if(isAligned == 0)	{ return unaligned; }
 	else				{  return aligned;  }
 }
@@ -692,23 +692,23 @@ string Sequence::getInlineSeq(){
 
 //********************************************************************************************************************
 
-string Sequence::getPairwise(){
+const string& Sequence::getPairwise() const {
 	return pairwise;
 }
 
 //********************************************************************************************************************
 
-string Sequence::getUnaligned(){
+const string& Sequence::getUnaligned() const {
 	return unaligned;
 }
 //********************************************************************************************************************
 
-string Sequence::getComment(){
+const string& Sequence::getComment() const {
     return comment;
 }
 //********************************************************************************************************************
 
-int Sequence::getNumBases(){
+int Sequence::getNumBases() const {
 	return numBases;
 }
 //********************************************************************************************************************
@@ -742,7 +742,7 @@ void Sequence::printUnAlignedSequence(ostream& out){
 }
 //********************************************************************************************************************
 
-int Sequence::getAlignLength(){
+int Sequence::getAlignLength() const {
 	return alignmentLength;
 }
 
@@ -887,7 +887,7 @@ void Sequence::padFromPos(int end){
 
 //********************************************************************************************************************
 
-bool Sequence::getIsAligned(){
+bool Sequence::getIsAligned() const {
 	return isAligned;
 }
 //********************************************************************************************************************
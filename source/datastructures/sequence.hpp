@@ -54,25 +54,26 @@ public:
 	void trim(int);
 	
 	string convert2ints();
-	string getName();
-	string getAligned();
-	string getPairwise();
-	string getUnaligned();
+    //these return references to avoid copying long sequences, copy them if you need the value after the sequence changes
+	const string& getName() const;
+	const string& getAligned() const;
+	const string& getPairwise() const;
+	const string& getUnaligned() const;
 	string getInlineSeq();
-    string getComment();
+    const string& getComment() const;
     int getNumNs();
-	int getNumBases();
+	int getNumBases() const;
 	int getStartPos();
 	int getEndPos();
 	void padToPos(int);
 	void padFromPos(int);
     int filterToPos(int); //any character before the pos is changed to . and aligned and unaligned strings changed
     int filterFromPos(int); //any character after the pos is changed to . and aligned and unaligned strings changed
-	int getAlignLength();
+	int getAlignLength() const;
 	int getAmbigBases();
 	void removeAmbigBases();
 	int getLongHomoPolymer();
-	bool getIsAligned();
+	bool getIsAligned() const;
 	void printSequence(ostream&);
     void printUnAlignedSequence(ostream&);
 	
@@ -148,7 +148,7 @@ void SequenceDB::set(int index, Sequence newSeq) {
 
 /***********************************************************************/
 
-Sequence SequenceDB::get(int index) {
+const Sequence& SequenceDB::get(int index) {
 	return data[index];
 }
 
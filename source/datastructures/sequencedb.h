@@ -31,7 +31,7 @@ public:
 	
 	void set(int, string);     //unaligned - should also set length
 	void set(int, Sequence);   //unaligned - should also set length
-	Sequence get(int);         //returns sequence name at that location
+	const Sequence& get(int);  //returns sequence at that location
 	void push_back(Sequence);        //adds unaligned sequence
 	void resize(int);      //resizes data
 	void clear();              //clears data - remeber to loop through and delete the sequences inside or you will have a memory leak
@@ -0,0 +1,264 @@
+//
+//  sequenceindex.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "sequenceindex.h"
+#include "sequence.hpp"
+#include "fastqread.h"
+
+//file layout:
+//  #version
+//  type, size of the sequence file, fastq format
+//  one line per record: name, start, length, 1 if the record is already written the way mothur prints it
+
+/***********************************************************************/
+SequenceIndex::SequenceIndex(string f, string t, string q, bool save) {
+	try {
+		m = MothurOut::getInstance();
+		filename = m->getFullPathName(f);
+		type = t;
+		fastqFormat = q;
+		if (type != "fastq") { fastqFormat = "none"; }
+		indexFileName = filename + ".seqindex";
+		tempFileName = "";
+		start = 0; length = 0; verbatim = false;
+		streaming = false; current = "";
+
+		m->openInputFileBinary(filename, in);
+
+		//a new index is only made when the command is asked to save it, otherwise the file is read once from the top
+		if (!open()) {
+			if (save) { createIndex(); }
+			else { streaming = true; }
+		}
+
+		if (streaming) { in.close(); m->openInputFile(filename, in); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "SequenceIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+SequenceIndex::~SequenceIndex() {
+	in.close();
+	indexIn.close();
+	if (tempFileName != "") { m->mothurRemove(tempFileName); }
+}
+/***********************************************************************/
+bool SequenceIndex::open() {
+	try {
+		indexIn.open(indexFileName.c_str());
+		if (!indexIn) { indexIn.clear(); return false; }
+
+		//made by an older version of mothur or before the file changed
+		bool good = m->checkReleaseVersion(indexIn, m->getVersion());
+		if (good) { if (m->getTimeStamp(indexFileName) < m->getTimeStamp(filename)) { good = false; } }
+
+		if (good) {
+			string version = m->getline(indexIn); m->gobble(indexIn);
+
+			string thisType, thisFormat;
+			unsigned long long thisSize = 0;
+			indexIn >> thisType >> thisSize >> thisFormat; m->gobble(indexIn);
+
+			if ((thisType != type) || (thisSize != getFileSize(filename)) || (thisFormat != fastqFormat)) { good = false; }
+		}
+
+		if (!good) { indexIn.close(); indexIn.clear(); }
+
+		return good;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "open");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SequenceIndex::createIndex() {
+	try {
+		//written under a temporary name so a command reading the file at the same time won't see a partial index
+		tempFileName = indexFileName + "." + m->mothurGetpid(0) + ".temp";
+		ofstream out(tempFileName.c_str(), ios::trunc);
+		if (!out) { tempFileName = ""; streaming = true; return 0; } //can't write next to the file
+
+		m->mothurOut("Indexing " + filename + ", the index will be reused the next time you use this file.\n");
+		out << "#" << m->getVersion() << endl << type << '\t' << getFileSize(filename) << '\t' << fastqFormat << endl;
+
+		ifstream dataIn;
+		m->openInputFile(filename, dataIn);
+
+		ifstream raw;
+		m->openInputFileBinary(filename, raw);
+
+		vector<char> buffer;
+		while (!dataIn.eof()) {
+			if (m->control_pressed) { break; }
+
+			unsigned long long thisStart = dataIn.tellg();
+
+			string name = ""; bool keep = true;
+			string printed = readRecord(dataIn, name, keep);
+			m->gobble(dataIn);
+
+			if (!keep) { continue; }
+
+			//is the record already written the way we print it
+			bool same = false;
+			if (printed.length() != 0) {
+				buffer.resize(printed.length());
+				raw.clear(); raw.seekg(thisStart);
+				raw.read(&buffer[0], printed.length());
+				if (raw.gcount() == printed.length()) { same = (memcmp(&buffer[0], printed.c_str(), printed.length()) == 0); }
+			}
+
+			out << name << '\t' << thisStart << '\t' << printed.length() << '\t' << same << '\n';
+		}
+		dataIn.close();
+		raw.close();
+		out.close();
+
+		if (m->control_pressed) { m->mothurRemove(tempFileName); tempFileName = ""; return 0; }
+
+		//if another command saved the index first we use ours
+		if (rename(tempFileName.c_str(), indexFileName.c_str()) == 0) { tempFileName = ""; indexIn.open(indexFileName.c_str()); }
+		else { indexIn.open(tempFileName.c_str()); }
+
+		string version = m->getline(indexIn); m->gobble(indexIn);
+		string header = m->getline(indexIn); m->gobble(indexIn);
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "createIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+bool SequenceIndex::getNext(string& name) {
+	try {
+		if (streaming) {
+			while (!in.eof()) {
+				if (m->control_pressed) { return false; }
+
+				bool keep = true;
+				current = readRecord(in, name, keep);
+				m->gobble(in);
+
+				if (keep) { return true; }
+			}
+			return false;
+		}
+
+		if (!indexIn || indexIn.eof()) { return false; }
+
+		std::getline(indexIn, name, '\t');
+		int same = 0;
+		indexIn >> start >> length >> same;
+		if (indexIn.fail()) { return false; }
+		indexIn.get(); //newline
+
+		verbatim = (same == 1);
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "getNext");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SequenceIndex::print(ostream& out) {
+	try {
+		if (streaming) { out << current; return 0; }
+
+		in.clear();
+		in.seekg(start);
+
+		if (verbatim) {
+			vector<char> buffer(length);
+			if (length != 0) { in.read(&buffer[0], length); out.write(&buffer[0], in.gcount()); }
+		}else {
+			string name = ""; bool keep = true;
+			out << readRecord(in, name, keep);
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "print");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//reads the way get.seqs and remove.seqs do
+string SequenceIndex::readRecord(ifstream& dataIn, string& name, bool& keep) {
+	try {
+		ostringstream printed;
+		keep = true;
+
+		if (type == "fasta") {
+			Sequence seq(dataIn);
+			name = seq.getName();
+			if (name == "") { keep = false; }
+			seq.printSequence(printed);
+		}else if (type == "fastq") {
+			bool ignore;
+			FastqRead fread(dataIn, ignore, fastqFormat); m->gobble(dataIn);
+			name = fread.getName();
+			if (ignore) { keep = false; }
+			fread.printFastq(printed);
+		}else {
+			string header = "";
+			string scores = "";
+
+			dataIn >> header;
+
+			name = "";
+			if (header.length() != 0) {
+				name = header.substr(1);
+				while (!dataIn.eof())	{
+					char c = dataIn.get();
+					if (c == 10 || c == 13 || c == -1){	break;	}
+					else { header += c; }
+				}
+				m->gobble(dataIn);
+			}
+
+			while(dataIn){
+				char letter= dataIn.get();
+				if(letter == '>'){	dataIn.putback(letter);	break;	}
+				else{ scores += letter; }
+			}
+
+			printed << header << endl << scores;
+		}
+
+		return printed.str();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "readRecord");
+		exit(1);
+	}
+}
+/***********************************************************************/
+unsigned long long SequenceIndex::getFileSize(string name) {
+	try {
+		ifstream sizeIn(name.c_str(), ios::binary);
+		if (!sizeIn) { return 0; }
+
+		sizeIn.seekg(0, ios::end);
+		unsigned long long size = sizeIn.tellg();
+		sizeIn.close();
+
+		return size;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceIndex", "getFileSize");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,50 @@
+#ifndef Mothur_sequenceindex_h
+#define Mothur_sequenceindex_h
+
+//
+//  sequenceindex.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/* Offset index of a fasta, quality or fastq file.
+ The index is made by reading the file the same way the commands do. Each entry holds the name of a record, where it
+ starts and whether the record is already written the way mothur prints it. Those records are copied byte for byte, the
+ others are read again from where they start.
+ An index is only made when the command is asked to save it, with index=T, next to the file as yourFile.seqindex.
+ A saved index is reused until the file changes or mothur is updated, so a command writing a few records of a large file
+ only reads those records. Without a current index, or if it can't be saved next to the file, the records are read
+ once from the top of the file the way the commands always have. */
+
+/***********************************************************************/
+
+class SequenceIndex {
+
+public:
+	SequenceIndex(string, string, string, bool);    //sequence file, type ("fasta", "qfile" or "fastq"), fastq format, save a new index next to the file
+	~SequenceIndex();
+
+	bool getNext(string&);                      //moves to the next record and gives its name, false after the last record
+	int print(ostream&);                        //writes the current record the way the commands print it
+
+private:
+	MothurOut* m;
+	string filename, type, fastqFormat, indexFileName, tempFileName;
+	ifstream in, indexIn;
+	unsigned long long start, length;
+	bool verbatim, streaming;
+	string current;                             //the current record as printed, when there is no index
+
+	bool open();                                //opens a current index, false if there isn't one
+	int createIndex();
+	string readRecord(ifstream&, string&, bool&);   //reads a record, gives its name and whether the commands use it, returns it as printed
+	unsigned long long getFileSize(string);
+};
+
+/***********************************************************************/
+
+#endif
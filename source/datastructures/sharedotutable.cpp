@@ -0,0 +1,358 @@
+//
+//  sharedotutable.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "sharedotutable.h"
+#include "sharedutilities.h"
+
+/***********************************************************************/
+SharedOTUTable::SharedOTUTable() {
+	m = MothurOut::getInstance();
+	label = "";
+	rowStart.push_back(0);
+}
+/***********************************************************************/
+//reads one label of a shared file, uses the same saveNextLabel handshake as the SharedRAbundVector reader
+SharedOTUTable::SharedOTUTable(ifstream& f) {
+	try {
+		m = MothurOut::getInstance();
+		rowStart.push_back(0);
+		m->clearAllGroups();
+		vector<string> allGroups;
+
+		int num, inputData;
+		string holdLabel, nextLabel, groupN;
+
+		//are we at the beginning of the file??
+		if (m->saveNextLabel == "") {
+			f >> label;
+
+			//is this a shared file that has headers
+			if (label == "label") {
+				//gets "group"
+				f >> label; m->gobble(f);
+
+				//gets "numOtus"
+				f >> label; m->gobble(f);
+
+				//eat rest of line
+				label = m->getline(f); m->gobble(f);
+
+				//parse labels to save
+				istringstream iStringStream(label);
+				m->sharedBinLabelsInFile.clear();
+				while(!iStringStream.eof()){
+					if (m->control_pressed) { break; }
+					string temp;
+					iStringStream >> temp;  m->gobble(iStringStream);
+
+					m->sharedBinLabelsInFile.push_back(temp);
+				}
+
+				f >> label >> groupN >> num;
+			}else {
+				//read in first row since you know there is at least 1 group.
+				f >> groupN >> num;
+
+				//make binlabels because we don't have any
+				m->sharedBinLabelsInFile.clear();
+				for (int i = 0; i < num; i++) {  m->sharedBinLabelsInFile.push_back(makeBinLabel(i, num));  }
+			}
+		}else {
+			label = m->saveNextLabel;
+
+			//read in first row since you know there is at least 1 group.
+			f >> groupN >> num;
+		}
+
+		//reset labels, currentLabels may have gotten changed as otus were eliminated because of group choices or sampling
+		m->currentSharedBinLabels = m->sharedBinLabelsInFile;
+		setOTULabels(m->sharedBinLabelsInFile, num);
+
+		holdLabel = label;
+		nextLabel = label;
+
+		//read the groups of this label, only keeping the non zero cells
+		while ((nextLabel == holdLabel) && (!f.eof())) {
+			if (m->control_pressed) { break; }
+
+			if (m->debug) { m->mothurOut("[DEBUG]: "+ groupN + '\t' + toString(num) + "\n"); }
+
+			allGroups.push_back(groupN);
+			groupIndex[groupN] = groups.size();
+			groups.push_back(groupN);
+
+			int total = 0;
+			for(int i=0;i<num;i++){
+				f >> inputData;
+				if (inputData != 0) { otuIndexes.push_back(i); abundances.push_back(inputData); total += inputData; }
+			}
+			rowStart.push_back(abundances.size());
+			groupTotals.push_back(total);
+
+			m->gobble(f);
+
+			nextLabel = "";
+			if (!f.eof()) { f >> nextLabel; }
+			if ((nextLabel == holdLabel) && (!f.eof())) { f >> groupN >> num; }
+		}
+
+		m->saveNextLabel = nextLabel;
+		m->setAllGroups(allGroups);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "SharedOTUTable");
+		exit(1);
+	}
+}
+/***********************************************************************/
+SharedOTUTable::SharedOTUTable(vector<SharedRAbundVector*>& lookup) {
+	try {
+		m = MothurOut::getInstance();
+		label = "";
+		rowStart.push_back(0);
+
+		if (lookup.size() == 0) { return; }
+
+		label = lookup[0]->getLabel();
+		int numBins = lookup[0]->getNumBins();
+		for (int i = 0; i < numBins; i++) {
+			if (i < m->currentSharedBinLabels.size()) { otuLabels.push_back(m->currentSharedBinLabels[i]); }
+			else { otuLabels.push_back(makeBinLabel(i, numBins)); }
+		}
+
+		for (int i = 0; i < lookup.size(); i++) {
+			vector<int> abunds = lookup[i]->getAbundances();
+			push_back(lookup[i]->getGroup(), abunds);
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "SharedOTUTable");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SharedOTUTable::push_back(string groupName, vector<int>& abunds) {
+	try {
+		groupIndex[groupName] = groups.size();
+		groups.push_back(groupName);
+
+		int total = 0;
+		for (int i = 0; i < abunds.size(); i++) {
+			if (abunds[i] != 0) { otuIndexes.push_back(i); abundances.push_back(abunds[i]); total += abunds[i]; }
+		}
+		rowStart.push_back(abundances.size());
+		groupTotals.push_back(total);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "push_back");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SharedOTUTable::push_back(string groupName, vector<int>& otus, vector<int>& abunds) {
+	try {
+		groupIndex[groupName] = groups.size();
+		groups.push_back(groupName);
+
+		int total = 0;
+		for (int i = 0; i < otus.size(); i++) {
+			if (abunds[i] != 0) { otuIndexes.push_back(otus[i]); abundances.push_back(abunds[i]); total += abunds[i]; }
+		}
+		rowStart.push_back(abundances.size());
+		groupTotals.push_back(total);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "push_back");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SharedOTUTable::setOTULabels(vector<string> l, int num) {
+	try {
+		otuLabels = l;
+		if (otuLabels.size() > num) { otuLabels.resize(num); }
+		for (int i = otuLabels.size(); i < num; i++) { otuLabels.push_back(makeBinLabel(i, num)); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "setOTULabels");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SharedOTUTable::getGroupIndex(string groupName) {
+	try {
+		map<string, int>::iterator it = groupIndex.find(groupName);
+		if (it == groupIndex.end()) { return -1; }
+		return it->second;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "getGroupIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SharedOTUTable::getAbundance(int g, int otu) {
+	try {
+		vector<int>::iterator start = otuIndexes.begin() + rowStart[g];
+		vector<int>::iterator end = otuIndexes.begin() + rowStart[g+1];
+		vector<int>::iterator it = lower_bound(start, end, otu);
+
+		if ((it != end) && (*it == otu)) { return abundances[it - otuIndexes.begin()]; }
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "getAbundance");
+		exit(1);
+	}
+}
+/***********************************************************************/
+vector<int> SharedOTUTable::getAbundances(int g) {
+	try {
+		vector<int> abunds(otuLabels.size(), 0);
+		for (unsigned long long j = rowStart[g]; j < rowStart[g+1]; j++) { abunds[otuIndexes[j]] = abundances[j]; }
+		return abunds;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "getAbundances");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//same group selection as SharedRAbundVector::getSharedRAbundVectors
+int SharedOTUTable::selectGroups() {
+	try {
+		SharedUtil util;
+
+		vector<string> Groups = m->getGroups();
+		vector<string> allGroups = m->getAllGroups();
+		util.setGroups(Groups, allGroups);
+		m->setGroups(Groups);
+
+		vector<string> newGroups;
+		vector<unsigned long long> newRowStart;
+		vector<int> newOTUIndexes, newAbundances, newTotals;
+		newRowStart.push_back(0);
+
+		for (int i = 0; i < groups.size(); i++) {
+			//if this group is not one the user wants then skip it
+			if (!util.isValidGroup(groups[i], m->getGroups())) { continue; }
+
+			newGroups.push_back(groups[i]);
+			for (unsigned long long j = rowStart[i]; j < rowStart[i+1]; j++) { newOTUIndexes.push_back(otuIndexes[j]); newAbundances.push_back(abundances[j]); }
+			newRowStart.push_back(newAbundances.size());
+			newTotals.push_back(groupTotals[i]);
+		}
+
+		if (newGroups.size() == groups.size()) { return 0; }
+
+		groups = newGroups; rowStart = newRowStart; otuIndexes = newOTUIndexes; abundances = newAbundances; groupTotals = newTotals;
+		groupIndex.clear();
+		for (int i = 0; i < groups.size(); i++) { groupIndex[groups[i]] = i; }
+
+		eliminateZeroOTUs();
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "selectGroups");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SharedOTUTable::eliminateZeroOTUs() {
+	try {
+		vector<int> newIndex(otuLabels.size(), -1);
+		for (unsigned long long j = 0; j < otuIndexes.size(); j++) { newIndex[otuIndexes[j]] = 0; }
+
+		//renumber the otus that still have sequences
+		vector<string> newLabels;
+		for (int i = 0; i < otuLabels.size(); i++) {
+			if (newIndex[i] != -1) { newIndex[i] = newLabels.size(); newLabels.push_back(otuLabels[i]); }
+		}
+
+		for (unsigned long long j = 0; j < otuIndexes.size(); j++) { otuIndexes[j] = newIndex[otuIndexes[j]]; }
+
+		otuLabels = newLabels;
+		m->currentSharedBinLabels = otuLabels;
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "eliminateZeroOTUs");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SharedOTUTable::getOTUMajor(vector<unsigned long long>& otuStart, vector<int>& cellGroups, vector<int>& cellAbunds) {
+	try {
+		otuStart.assign(otuLabels.size()+1, 0);
+		cellGroups.resize(abundances.size());
+		cellAbunds.resize(abundances.size());
+
+		//count the cells of each otu, then turn the counts into starting positions
+		for (unsigned long long j = 0; j < otuIndexes.size(); j++) { otuStart[otuIndexes[j]+1]++; }
+		for (int i = 0; i < otuLabels.size(); i++) { otuStart[i+1] += otuStart[i]; }
+
+		//walking the groups in order keeps the cells of each otu sorted by group
+		vector<unsigned long long> next(otuStart.begin(), otuStart.end()-1);
+		for (int g = 0; g < groups.size(); g++) {
+			for (unsigned long long j = rowStart[g]; j < rowStart[g+1]; j++) {
+				unsigned long long spot = next[otuIndexes[j]]++;
+				cellGroups[spot] = g;
+				cellAbunds[spot] = abundances[j];
+			}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "getOTUMajor");
+		exit(1);
+	}
+}
+/***********************************************************************/
+vector<SharedRAbundVector*> SharedOTUTable::getSharedRAbundVectors() {
+	try {
+		vector<SharedRAbundVector*> lookup;
+
+		for (int g = 0; g < groups.size(); g++) {
+			SharedRAbundVector* temp = new SharedRAbundVector();
+			temp->setLabel(label);
+			temp->setGroup(groups[g]);
+
+			vector<int> abunds = getAbundances(g);
+			for (int i = 0; i < abunds.size(); i++) { temp->push_back(abunds[i], groups[g]); }
+
+			lookup.push_back(temp);
+		}
+
+		m->currentSharedBinLabels = otuLabels;
+
+		return lookup;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "getSharedRAbundVectors");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string SharedOTUTable::makeBinLabel(int bin, int numBins) {
+	try {
+		string snumBins = toString(numBins);
+		string binLabel = "Otu";
+		string sbinNumber = toString(bin+1);
+		if (sbinNumber.length() < snumBins.length()) {
+			int diff = snumBins.length() - sbinNumber.length();
+			for (int h = 0; h < diff; h++) { binLabel += "0"; }
+		}
+		binLabel += sbinNumber;
+		return binLabel;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedOTUTable", "makeBinLabel");
+		exit(1);
+	}
+}
+/***********************************************************************/
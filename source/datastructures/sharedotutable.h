@@ -0,0 +1,79 @@
+#ifndef Mothur_sharedotutable_h
+#define Mothur_sharedotutable_h
+
+//
+//  sharedotutable.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "sharedrabundvector.h"
+
+/* DataStructure for one label of a shared file.
+ The abundances are stored by group in compressed sparse row form, so only the non zero cells are kept.
+ The cells of group g are [getRowStart(g), getRowEnd(g)) and are sorted by otu.
+ Group names and otu labels are stored once in the table instead of in every cell.
+ getSharedRAbundVectors() builds the dense vectors for the calculators that still need them. */
+
+/***********************************************************************/
+
+class SharedOTUTable {
+
+public:
+	SharedOTUTable();
+	SharedOTUTable(ifstream&);                      //reads the next label of a shared file
+	SharedOTUTable(vector<SharedRAbundVector*>&);
+	~SharedOTUTable() {}
+
+	string getLabel()                   { return label;                 }
+	void setLabel(string l)             { label = l;                    }
+	int getNumGroups()                  { return groups.size();         }
+	int getNumBins()                    { return otuLabels.size();      }
+	unsigned long long getNumNonZero()  { return abundances.size();     }
+	vector<string> getGroups()          { return groups;                }
+	string getGroup(int g)              { return groups[g];             }
+	vector<string> getOTULabels()       { return otuLabels;             }
+	string getOTULabel(int otu)         { return otuLabels[otu];        }
+	int getNumSeqs(int g)               { return groupTotals[g];        }
+
+	unsigned long long getRowStart(int g)   { return rowStart[g];       }
+	unsigned long long getRowEnd(int g)     { return rowStart[g+1];     }
+	int getOTU(unsigned long long cell)             { return otuIndexes[cell];  }
+	int getCellAbundance(unsigned long long cell)   { return abundances[cell];  }
+
+	int getGroupIndex(string);          //returns -1 if the group is not in the table
+	int getAbundance(int, int);         //group, otu
+	vector<int> getAbundances(int);     //dense abundances of a group
+
+	void setOTULabels(vector<string> l) { otuLabels = l;                }
+	void setOTULabels(vector<string>, int); //labels, numBins. keeps the first numBins labels, making any that are missing
+	void push_back(string, vector<int>&);   //group, dense abundances
+	void push_back(string, vector<int>&, vector<int>&);     //group, sorted otus and abundances of the non zero cells
+	int selectGroups();                 //removes the groups not in m->getGroups()
+	int eliminateZeroOTUs();
+
+	//cells ordered by otu, the cells of otu i are [otuStart[i], otuStart[i+1])
+	void getOTUMajor(vector<unsigned long long>& otuStart, vector<int>& cellGroups, vector<int>& cellAbunds);
+
+	vector<SharedRAbundVector*> getSharedRAbundVectors();
+
+private:
+	MothurOut* m;
+	string label;
+	vector<string> groups;
+	map<string, int> groupIndex;
+	vector<string> otuLabels;
+	vector<unsigned long long> rowStart;    //size = groups.size()+1, a table can have more than 2^31 non zero cells
+	vector<int> otuIndexes;     //otu of each non zero cell
+	vector<int> abundances;     //abundance of each non zero cell
+	vector<int> groupTotals;
+
+	string makeBinLabel(int, int);
+};
+
+/***********************************************************************/
+
+#endif
@@ -96,9 +96,11 @@ bool InteractEngine::getInput(){
                     mout->printedListHeaders = false;
                     mout->listBinLabelsInFile.clear();
 							
+					PerformanceTrace::getInstance()->startCommand(commandName);
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
 					else { quitCommandCalled = command->execute(); }
+					PerformanceTrace::getInstance()->endCommand(quitCommandCalled, command->getOutputFiles());
 							
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -168,6 +170,7 @@ BatchEngine::BatchEngine(string path, string batchFileName){
 	try {
 	
 		openedBatch = mout->openInputFile(batchFileName, inputBatchFile);
+		scheduleProcessors = 0;
 		
 		string temppath = path.substr(0, (path.find_last_of("othur")-5));
 	
@@ -205,6 +208,8 @@ bool BatchEngine::getInput(){
 			mout->mothurOut("unable to open batchfile\n");
 			return 1; 
 		}
+		
+		if (scheduleProcessors > 0) { return runScheduled(); }
 	
 		string input = "";
 		string commandName = "";
@@ -251,9 +256,11 @@ bool BatchEngine::getInput(){
                     mout->listBinLabelsInFile.clear();
 
 							
+					PerformanceTrace::getInstance()->startCommand(commandName);
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
 					else { quitCommandCalled = command->execute(); }
+					PerformanceTrace::getInstance()->endCommand(quitCommandCalled, command->getOutputFiles());
 							
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -278,6 +285,35 @@ bool BatchEngine::getInput(){
 	}
 }
 /***********************************************************************/
+//reads the whole batchfile and lets the scheduler run the commands that don't depend on each other at the same time
+bool BatchEngine::runScheduled(){
+	try {
+		mout->mothurOut("\nScheduling the batch commands using " + toString(scheduleProcessors) + " processors.\n");
+		
+		BatchScheduler scheduler(scheduleProcessors);
+		
+		//like running one at a time, a batchfile without quit ends with it
+		string input = "";
+		while((input != "quit") && (input != "quit()")){
+			input = getNextCommand(inputBatchFile);
+			mout->gobble(inputBatchFile);
+			
+			if ((input == "") || (input[0] == '#')) { continue; }
+			
+			scheduler.addCommand(input);
+		}
+		inputBatchFile.close();
+		
+		scheduler.run();
+		
+		return 1;
+	}
+	catch(exception& e) {
+		mout->errorOut(e, "BatchEngine", "runScheduled");
+		exit(1);
+	}
+}
+/***********************************************************************/
 string BatchEngine::getNextCommand(ifstream& inputBatchFile) {
 	try {
 			
@@ -385,9 +421,11 @@ bool ScriptEngine::getInput(){
                     mout->printedListHeaders = false;
                     mout->listBinLabelsInFile.clear();
 
+					PerformanceTrace::getInstance()->startCommand(commandName);
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
 					else { quitCommandCalled = command->execute(); }
+					PerformanceTrace::getInstance()->endCommand(quitCommandCalled, command->getOutputFiles());
 					
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -17,6 +17,8 @@
 #include "command.hpp"
 #include "commandfactory.hpp"
 #include "mothurout.h"
+#include "batchscheduler.h"
+#include "performancetrace.h"
 
 class Engine {
 public:
@@ -43,9 +45,12 @@ public:
 	~BatchEngine();
 	virtual bool getInput();
 	int openedBatch;
+	void setScheduleProcessors(int p)	{	scheduleProcessors = p;		}
 private:
 	ifstream inputBatchFile;
+	int scheduleProcessors;     //0 runs the commands one at a time
 	string getNextCommand(ifstream&);
+	bool runScheduled();
 
 };
 
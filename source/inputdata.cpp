@@ -19,12 +19,14 @@ InputData::InputData(string fName, string f) : format(f){
 	m->openInputFile(fName, fileHandle);
 	filename = fName;
 	m->saveNextLabel = "";
+	otuIndex = NULL; checkedIndex = false;
 }
 /***********************************************************************/
 
 InputData::~InputData(){
 	fileHandle.close();
 	m->saveNextLabel = "";
+	if (otuIndex != NULL) { delete otuIndex; }
 }
 
 /***********************************************************************/
@@ -47,7 +49,9 @@ InputData::InputData(string fName, string orderFileName, string f) : format(f){
 		ofHandle.close();
 	
 		m->openInputFile(fName, fileHandle);
+		filename = fName;
 		m->saveNextLabel = "";
+		otuIndex = NULL; checkedIndex = false;
 		
 	}
 	catch(exception& e) {
@@ -56,9 +60,97 @@ InputData::InputData(string fName, string orderFileName, string f) : format(f){
 	}
 }
 /***********************************************************************/
+//looks for the yourFile.otuindex written by make.otuindex, so the label functions can go straight to the label
+bool InputData::openOTUIndex(){
+	try {
+		if (!checkedIndex) {
+			checkedIndex = true;
+			
+			if ((format == "list") || (format == "sharedfile")) {
+				otuIndex = new OTUIndex();
+				if (!otuIndex->open(filename, format)) { delete otuIndex; otuIndex = NULL; }
+			}
+		}
+		
+		return (otuIndex != NULL);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "InputData", "openOTUIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//works out which labels the usual label loop will look at: the labels asked for, the label that shows a missing label
+//is not in the file, the label before it that will be used instead and the one after it, and the last label if some are still missing
+void InputData::setLabels(set<string> userLabels){
+	try {
+		neededLabels.clear();
+		if (userLabels.size() == 0) { return; }
+		if (!openOTUIndex()) { return; }
+		
+		vector<string> fileLabels = otuIndex->getLabels();
+		if (fileLabels.size() == 0) { return; }
+		
+		neededLabels.resize(fileLabels.size(), false);
+		neededLabels[0] = true; //the first label is always read, it has the headers
+		
+		set<string> remaining = userLabels;
+		for (int i = 0; i < fileLabels.size(); i++) {
+			if (remaining.size() == 0) { break; }
+			
+			int numRemaining = remaining.size();
+			if (userLabels.count(fileLabels[i]) == 1) { neededLabels[i] = true; remaining.erase(fileLabels[i]); }
+			
+			if (m->anyLabelsToProcess(fileLabels[i], remaining, "quiet")) {
+				neededLabels[i] = true;
+				if (i != 0) { neededLabels[i-1] = true; remaining.erase(fileLabels[i-1]); }
+				//reading the label before resets saveNextLabel, so the shared reader names the next block after this one
+				if (i != (fileLabels.size()-1)) { neededLabels[i+1] = true; }
+			}
+			if (remaining.size() != numRemaining) { neededLabels[i] = true; }
+		}
+		if (remaining.size() != 0) { neededLabels[fileLabels.size()-1] = true; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "InputData", "setLabels");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//moves the file pointer past the labels the command won't look at, to the end of the file if there are no more it wants
+void InputData::skipUnusedLabels(){
+	try {
+		if (neededLabels.size() == 0) { return; }
+		if (m->saveNextLabel == "") { return; } //beginning of the file or already at the end
+		
+		m->gobble(fileHandle);
+		if (!fileHandle) { return; }
+		
+		int lastRead = otuIndex->getLabelEndingAt(fileHandle.tellg());
+		if (lastRead == -1) { return; }
+		
+		int next = lastRead + 1;
+		while ((next < neededLabels.size()) && (!neededLabels[next])) { next++; }
+		
+		if (next == neededLabels.size()) { fileHandle.seekg(0, ios::end); fileHandle.get(); }
+		else if (next != (lastRead + 1)) {
+			if (m->debug) { m->mothurOut("[DEBUG]: skipping to " + otuIndex->getLabels()[next] + " with the otuindex\n"); }
+			fileHandle.seekg(otuIndex->getTextEnd(next-1));
+			//the shared reader has already read the label of the next block
+			if (format == "sharedfile") { m->saveNextLabel = otuIndex->getLabels()[next]; }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "InputData", "skipUnusedLabels");
+		exit(1);
+	}
+}
+/***********************************************************************/
 
 ListVector* InputData::getListVector(){
 	try {
+		skipUnusedLabels();
+		
 		if(!fileHandle.eof()){
 			if(format == "list") {
 				list = new ListVector(fileHandle);
@@ -80,6 +172,8 @@ ListVector* InputData::getListVector(){
 /***********************************************************************/
 ListVector* InputData::getListVector(string label){
 	try {
+		if (openOTUIndex()) { return otuIndex->getListVector(label); }
+		
 		ifstream in;
 		string  thisLabel;
 		m->openInputFile(filename, in);
@@ -117,6 +211,18 @@ ListVector* InputData::getListVector(string label){
 /***********************************************************************/
 ListVector* InputData::getListVector(string label, bool resetFP){
 	try {
+		if (openOTUIndex()) {
+			list = otuIndex->getListVector(label);
+			
+			//leave the file pointer after this label, like reading up to it would
+			if (list != NULL) {
+				fileHandle.clear();
+				fileHandle.seekg(otuIndex->getTextEnd(label));
+				m->gobble(fileHandle);
+			}
+			return list;
+		}
+		
 		string  thisLabel;
 		fileHandle.clear();
 		fileHandle.seekg(0);
@@ -216,6 +322,8 @@ SharedListVector* InputData::getSharedListVector(string label){
 
 SharedOrderVector* InputData::getSharedOrderVector(){
 	try {
+		skipUnusedLabels();
+		
 		if(fileHandle){
 			if (format == "sharedfile")  {
 				SharedOrder = new SharedOrderVector(fileHandle);
@@ -280,6 +388,8 @@ SharedOrderVector* InputData::getSharedOrderVector(string label){
 
 OrderVector* InputData::getOrderVector(){
 	try {
+		skipUnusedLabels();
+		
 		if(fileHandle){
 			if((format == "list") || (format == "listorder")) {
 				input = new ListVector(fileHandle);
@@ -421,6 +531,8 @@ OrderVector* InputData::getOrderVector(string label){
 //this is used when you don't need the order vector
 vector<SharedRAbundVector*> InputData::getSharedRAbundVectors(){
 	try {
+		skipUnusedLabels();
+		
 		if(fileHandle){
 			if (format == "sharedfile")  {
 				SharedRAbundVector* SharedRAbund = new SharedRAbundVector(fileHandle);
@@ -450,6 +562,19 @@ vector<SharedRAbundVector*> InputData::getSharedRAbundVectors(){
 /***********************************************************************/
 vector<SharedRAbundVector*> InputData::getSharedRAbundVectors(string label){
 	try {
+		if (openOTUIndex()) {
+			SharedOTUTable* table = otuIndex->getSharedOTUTable(label);
+			
+			//this is created to signal to calling function that the label is not in the file
+			vector<SharedRAbundVector*> lookup;
+			if (table == NULL) { lookup.push_back(NULL); return lookup; }
+			
+			table->selectGroups();
+			lookup = table->getSharedRAbundVectors();
+			delete table;
+			return lookup;
+		}
+		
 		ifstream in;
 		string  thisLabel;
 		
@@ -513,6 +638,8 @@ vector<SharedRAbundVector*> InputData::getSharedRAbundVectors(string label){
 //this is used when you don't need the order vector
 vector<SharedRAbundFloatVector*> InputData::getSharedRAbundFloatVectors(){
 	try {
+		skipUnusedLabels();
+		
 		if(fileHandle){
 			if (format == "relabund")  {
 				SharedRAbundFloatVector* SharedRelAbund = new SharedRAbundFloatVector(fileHandle);
@@ -608,9 +735,98 @@ vector<SharedRAbundFloatVector*> InputData::getSharedRAbundFloatVectors(string l
 	}
 }
 /***********************************************************************/
+//returns NULL at eof
+SharedOTUTable* InputData::getSharedOTUTable(){
+	try {
+		skipUnusedLabels();
+		
+		if(fileHandle){
+			if (format == "sharedfile")  {
+				SharedOTUTable* table = new SharedOTUTable(fileHandle);
+				table->selectGroups();
+				return table;
+			}else if (format == "shared") {
+				SharedList = new SharedListVector(fileHandle);
+				
+				vector<SharedRAbundVector*> lookup = SharedList->getSharedRAbundVector();
+				SharedOTUTable* table = new SharedOTUTable(lookup);
+				for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
+				delete SharedList;
+				return table;
+			}
+			m->gobble(fileHandle);
+		}
+		
+		return NULL;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "InputData", "getSharedOTUTable");
+		exit(1);
+	}
+}
+/***********************************************************************/
+SharedOTUTable* InputData::getSharedOTUTable(string label){
+	try {
+		if (openOTUIndex()) {
+			SharedOTUTable* table = otuIndex->getSharedOTUTable(label);
+			if (table != NULL) { table->selectGroups(); }
+			return table;
+		}
+		
+		ifstream in;
+		string  thisLabel;
+		
+		m->openInputFile(filename, in);
+		m->saveNextLabel = "";
+		
+		if(in){
+			if (format == "sharedfile")  {
+				while (in.eof() != true) {
+					
+					SharedOTUTable* table = new SharedOTUTable(in);
+					thisLabel = table->getLabel();
+					
+					//if you are at the last label
+					if (thisLabel == label) {  in.close(); table->selectGroups(); return table;  }
+					else {  delete table;  }
+					m->gobble(in);
+				}
+			}else if (format == "shared") {
+				while (in.eof() != true) {
+					
+					SharedList = new SharedListVector(in);
+					thisLabel = SharedList->getLabel();
+					
+					//if you are at the last label
+					if (thisLabel == label) {  
+						in.close(); 
+						vector<SharedRAbundVector*> lookup = SharedList->getSharedRAbundVector();
+						SharedOTUTable* table = new SharedOTUTable(lookup);
+						for (int i = 0; i < lookup.size(); i++) {  delete lookup[i];  }
+						delete SharedList;
+						return table;  
+					}
+					else {  delete SharedList;  }
+					m->gobble(in);
+				}
+			}
+		}
+		
+		//this signals to calling function that the input file is at eof
+		in.close();
+		return NULL;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "InputData", "getSharedOTUTable");
+		exit(1);
+	}
+}
+/***********************************************************************/
 
 SAbundVector* InputData::getSAbundVector(){
 	try {
+		skipUnusedLabels();
+		
 		if(fileHandle){
 			if (format == "list") {
 				input = new ListVector(fileHandle);
@@ -749,6 +965,8 @@ SAbundVector* InputData::getSAbundVector(string label){
 /***********************************************************************/
 RAbundVector* InputData::getRAbundVector(){
 	try {
+		skipUnusedLabels();
+		
 		if(fileHandle){
 			if (format == "list") {
 				input = new ListVector(fileHandle);
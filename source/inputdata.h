@@ -7,6 +7,8 @@
 #include "sharedordervector.h"
 #include "listvector.hpp"
 #include "sharedrabundfloatvector.h"
+#include "sharedotutable.h"
+#include "otuindex.h"
 
 
 class InputData {
@@ -32,6 +34,9 @@ public:
 	vector<SharedRAbundVector*> getSharedRAbundVectors(string);  //pass the label you want
 	vector<SharedRAbundFloatVector*> getSharedRAbundFloatVectors();
 	vector<SharedRAbundFloatVector*> getSharedRAbundFloatVectors(string);  //pass the label you want
+	SharedOTUTable* getSharedOTUTable();
+	SharedOTUTable* getSharedOTUTable(string);  //pass the label you want
+	void setLabels(set<string>);	//labels the command will process, empty for all. lets the readers above skip the others when there is an otuindex
 	
 private:
 	string format;
@@ -46,6 +51,12 @@ private:
 	map<string,int> orderMap;
 	string filename;
 	MothurOut* m;
+	OTUIndex* otuIndex;
+	bool checkedIndex;
+	vector<bool> neededLabels;	//labels of the file the command's label loop will look at
+	
+	bool openOTUIndex();
+	void skipUnusedLabels();
 };
 
 
@@ -11,11 +11,12 @@
 #include "mothurfisher.h"
 
 /***********************************************************/
-MothurMetastats::MothurMetastats(double t, int n) {
+MothurMetastats::MothurMetastats(double t, int n, int p) {
 	try {
 		m = MothurOut::getInstance(); 
 		threshold = t;
 		numPermutations = n;
+		processors = p;
 		
 	}catch(exception& e) {
 		m->errorOut(e, "MothurMetastats", "MothurMetastats");
@@ -245,41 +246,122 @@ int MothurMetastats::runMetastats(string outputFileName, vector< vector<double>
 /***********************************************************/
 vector<double> MothurMetastats::permuted_pvalues(vector< vector<double> >& Imatrix, vector<double>& tstats, vector< vector<double> >& Fmatrix) {
 	try {
-        //# matrix stores tstats for each taxa(row) for each permuted trial(column)
         vector<double> ps;  ps.resize(row, 0.0); //# to store the pvalues
-        vector< vector<double> > permuted_ttests; permuted_ttests.resize(numPermutations);            
-        for (int i = 0; i < numPermutations; i++) { permuted_ttests[i].resize(row, 0.0);  } 
- 
-        //# calculate null version of tstats using B permutations.
-        for (int i = 0; i < numPermutations; i++) {   
-            permuted_ttests[i] = permute_and_calc_ts(Imatrix);
-        }
         
-        //# calculate each pvalue using the null ts
-        if ((secondGroupingStart) < 8 || (column-secondGroupingStart) < 8){
-            vector< vector<double> > cleanedpermuted_ttests; cleanedpermuted_ttests.resize(numPermutations);  //# the array pooling just the frequently observed ts
-            //# then pool the t's together!
+        //rows laid out one after another so a permutation only shuffles the column order
+        vector<double> proportions(row * column, 0.0);
+        for (int i = 0; i < row; i++) { for (int j = 0; j < column; j++) { proportions[i * column + j] = Imatrix[i][j]; } }
+        
+        vector<double> absTstats(row, 0.0);
+        for (int i = 0; i < row; i++) { absTstats[i] = abs(tstats[i]); }
+        
+        //# with small groups the t's of the frequently observed taxa are pooled
+        bool pool = ((secondGroupingStart) < 8 || (column-secondGroupingStart) < 8);
+        vector<bool> useRow(row, true);
+        vector<double> sortedTstats;
+        int hfc = 1;
+        if (pool) {
             //# count how many high freq taxa there are
-            int hfc = 1;
             for (int i = 0; i < row; i++) {                 // # for each taxa
                 double group1Total = 0.0; double group2Total = 0.0;
                 for(int j = 0; j < secondGroupingStart; j++)		{ group1Total += Fmatrix[i][j];	}
 				for(int j = secondGroupingStart; j < column; j++)	{ group2Total += Fmatrix[i][j];	}
                 
-                if (group1Total >= secondGroupingStart || group2Total >= (column-secondGroupingStart)){ 
-                    hfc++;
-                    for (int j = 0; j < numPermutations; j++) {   cleanedpermuted_ttests[j].push_back(permuted_ttests[j][i]); }
-                }
+                if (group1Total >= secondGroupingStart || group2Total >= (column-secondGroupingStart)){ hfc++; }
+                else { useRow[i] = false; }
             }
             
+            for (int i = 0; i < row; i++) { if (!isnan(absTstats[i])) { sortedTstats.push_back(absTstats[i]); } }
+            sort(sortedTstats.begin(), sortedTstats.end());
+        }
+        
+        //pooled: counts[k] is the number of null t's greater than exactly k of the sortedTstats
+        //not pooled: counts[i] is the number of null t's of taxa i greater than its t
+        vector<long long> counts;
+        if (pool) { counts.resize(sortedTstats.size()+1, 0); }
+        else { counts.resize(row, 0); }
+        
+        //each permutation gets its own seed so the pvalues don't depend on the number of processors
+        vector<unsigned int> seeds(numPermutations, 0);
+        for (int i = 0; i < numPermutations; i++) { seeds[i] = rand(); }
+        
+        int numProcessors = processors;
+        if (numProcessors > numPermutations) { numProcessors = numPermutations; }
+        if (numProcessors < 1) { numProcessors = 1; }
+        
+        vector<int> startPermutation, endPermutation;
+        int numPerProcessor = numPermutations / numProcessors;
+        for (int i = 0; i < numProcessors; i++) {
+            startPermutation.push_back(i * numPerProcessor);
+            if (i == (numProcessors - 1)) { endPermutation.push_back(numPermutations); }
+            else { endPermutation.push_back((i+1) * numPerProcessor); }
+        }
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        int process = 1;
+        vector<int> processIDS;
+        
+        //loop through and create all the processes you want
+        while (process != numProcessors) {
+            pid_t pid = fork();
+            
+            if (pid > 0) {
+                processIDS.push_back(pid);
+                process++;
+            }else if (pid == 0){
+                vector<long long> processCounts(counts.size(), 0);
+                driver(proportions, seeds, startPermutation[process], endPermutation[process], pool, useRow, absTstats, sortedTstats, processCounts);
+                
+                //pass counts to parent
+                ofstream out;
+                string tempFile = m->getOutputDir() + m->mothurGetpid(process) + ".metastats.temp";
+                m->openOutputFile(tempFile, out);
+                for (int i = 0; i < processCounts.size(); i++) { out << processCounts[i] << endl; }
+                out.close();
+                
+                exit(0);
+            }else {
+                m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+                exit(0);
+            }
+        }
+        
+        //do my part
+        driver(proportions, seeds, startPermutation[0], endPermutation[0], pool, useRow, absTstats, sortedTstats, counts);
+        
+        //force parent to wait until all the processes are done
+        for (int i=0;i<processIDS.size();i++) {
+            int temp = processIDS[i];
+            wait(&temp);
+        }
+        
+        for (int i = 0; i < processIDS.size(); i++) {
+            ifstream in;
+            string tempFile = m->getOutputDir() + toString(processIDS[i]) + ".metastats.temp";
+            m->openInputFile(tempFile, in);
+            for (int j = 0; j < counts.size(); j++) { long long count = 0; in >> count; m->gobble(in); counts[j] += count; }
+            in.close(); m->mothurRemove(tempFile);
+        }
+#else
+        driver(proportions, seeds, 0, numPermutations, pool, useRow, absTstats, sortedTstats, counts);
+#endif
+        if (m->control_pressed) { return ps; }
+        
+        //# calculate each pvalue using the null ts
+        if (pool){
+            //number of null t's greater than each of the sortedTstats
+            vector<long long> numGreaterThanSorted(counts.size(), 0);
+            long long total = 0;
+            for (int k = (int)counts.size()-1; k >= 0; k--) { total += counts[k]; numGreaterThanSorted[k] = total; }
+            
             //#now for each taxa
             for (int i = 0; i < row; i++) { 
-                //number of cleanedpermuted_ttests greater than tstat[i]
-                int numGreater = 0;
-                for (int j = 0; j < numPermutations; j++) {
-                    for (int k = 0; k < hfc; k++) {
-                        if (cleanedpermuted_ttests[j][k] > abs(tstats[i])) { numGreater++; }
-                    }
+                //number of pooled null t's greater than tstat[i]
+                long long numGreater = 0;
+                if (!isnan(absTstats[i])) {
+                    int k = (int)(upper_bound(sortedTstats.begin(), sortedTstats.end(), absTstats[i]) - sortedTstats.begin());
+                    numGreater = numGreaterThanSorted[k];
                 }
                 
                 ps[i] = (1/(double)(numPermutations*hfc))*numGreater;
@@ -287,8 +369,7 @@ vector<double> MothurMetastats::permuted_pvalues(vector< vector<double> >& Imatr
         }else{
             for (int i = 0; i < row; i++) { 
                 //number of permuted_ttests[i] greater than tstat[i] //(sum(permuted_ttests[i,] > abs(tstats[i]))+1)
-                int numGreater = 1;
-                for (int j = 0; j < numPermutations; j++) { if (permuted_ttests[j][i] > abs(tstats[i])) { numGreater++; }   }
+                long long numGreater = 1 + counts[i];
                 ps[i] = (1/(double)(numPermutations+1))*numGreater;
             }
         }
@@ -301,63 +382,67 @@ vector<double> MothurMetastats::permuted_pvalues(vector< vector<double> >& Imatr
     }	
 }
 /***********************************************************/
-vector<double> MothurMetastats::permute_and_calc_ts(vector< vector<double> >& Imatrix) {
+//runs permutations start to end, counting the null t's instead of storing them
+int MothurMetastats::driver(vector<double>& proportions, vector<unsigned int>& seeds, int start, int end, bool pool, vector<bool>& useRow, vector<double>& absTstats, vector<double>& sortedTstats, vector<long long>& counts) {
 	try {
-        vector< vector<double> > permutedMatrix = Imatrix;
+        vector<int> columns(column, 0);
         
-        //randomize columns, ie group abundances.
-        map<int, int> randomMap;
-        vector<int> randoms;
-        for (int i = 0; i < column; i++) { randoms.push_back(i); }
-        random_shuffle(randoms.begin(), randoms.end());
-        for (int i = 0; i < randoms.size(); i++) {   randomMap[i] = randoms[i];   }
-        
-        //calc ts
-        vector< vector<double> > C1; C1.resize(row);
-        for (int i = 0; i < row; i++) { C1[i].resize(3, 0.0);  } // statistic profiles for class1 and class 2
-        vector< vector<double> > C2; C2.resize(row);            // mean[1], variance[2], standard error[3] 
-        for (int i = 0; i < row; i++) { C2[i].resize(3, 0.0);  } 
-        vector<double> Ts; Ts.resize(row, 0.0); // a place to store the true t-statistics 
-
-        //#*************************************
-        //#  generate statistics mean, var, stderr    
-        //#*************************************
-        for(int i = 0; i < row; i++){ // for each taxa
-            //# find the mean of each group
-            double g1Total = 0.0; double g2Total = 0.0;
-            for (int j = 0; j < secondGroupingStart; j++)       {     g1Total += permutedMatrix[i][randomMap[j]]; }
-            C1[i][0] = g1Total/(double)(secondGroupingStart);
-            for (int j = secondGroupingStart; j < column; j++)  {     g2Total += permutedMatrix[i][randomMap[j]]; }
-            C2[i][0] = g2Total/(double)(column-secondGroupingStart);
+        for (int p = start; p < end; p++) {
+            if (m->control_pressed) { return 0; }
             
-            //# find the variance of each group
-            double g1Var = 0.0; double g2Var = 0.0;
-            for (int j = 0; j < secondGroupingStart; j++)       {     g1Var += pow((permutedMatrix[i][randomMap[j]]-C1[i][0]), 2);  }
-            C1[i][1] = g1Var/(double)(secondGroupingStart-1);
-            for (int j = secondGroupingStart; j < column; j++)  {     g2Var += pow((permutedMatrix[i][randomMap[j]]-C2[i][0]), 2);  }
-            C2[i][1] = g2Var/(double)(column-secondGroupingStart-1);
+            //randomize columns, ie group abundances.
+            for (int i = 0; i < column; i++) { columns[i] = i; }
+            srand(seeds[p]);
+            random_shuffle(columns.begin(), columns.end());
             
-            //# find the std error of each group -std err^2 (will change to std err at end)
-            C1[i][2] = C1[i][1]/(double)(secondGroupingStart);    
-            C2[i][2] = C2[i][1]/(double)(column-secondGroupingStart);
+            for (int i = 0; i < row; i++) {
+                if (!useRow[i]) { continue; }
+                
+                double ts = calc_permuted_ts(&proportions[i * column], columns);
+                
+                if (pool) {
+                    if (isnan(ts)) { continue; } //never greater than a t
+                    int k = (int)(lower_bound(sortedTstats.begin(), sortedTstats.end(), ts) - sortedTstats.begin());
+                    counts[k]++;
+                }else if (ts > absTstats[i]) { counts[i]++; }
+            }
         }
         
+        return 0;
         
-
-        //#*************************************
-        //#  two sample t-statistics
-        //#*************************************
-        for(int i = 0; i < row; i++){                  // # for each taxa
-            double xbar_diff = C1[i][0] - C2[i][0]; 
-            double denom = sqrt(C1[i][2] + C2[i][2]);
-            Ts[i] = abs(xbar_diff/denom);  // calculate two sample t-statistic
-        }
-
-        return Ts;
-
+    }catch(exception& e) {
+        m->errorOut(e, "MothurMetastats", "driver");
+        exit(1);
+    }	
+}
+/***********************************************************/
+//two sample t-statistic of one taxa with its columns in the permuted order
+double MothurMetastats::calc_permuted_ts(double* proportions, vector<int>& columns) {
+	try {
+        //# find the mean of each group
+        double g1Total = 0.0; double g2Total = 0.0;
+        for (int j = 0; j < secondGroupingStart; j++)       {     g1Total += proportions[columns[j]]; }
+        double mean1 = g1Total/(double)(secondGroupingStart);
+        for (int j = secondGroupingStart; j < column; j++)  {     g2Total += proportions[columns[j]]; }
+        double mean2 = g2Total/(double)(column-secondGroupingStart);
+        
+        //# find the variance of each group
+        double g1Var = 0.0; double g2Var = 0.0;
+        for (int j = 0; j < secondGroupingStart; j++)       {     double diff = proportions[columns[j]]-mean1; g1Var += diff*diff;  }
+        double var1 = g1Var/(double)(secondGroupingStart-1);
+        for (int j = secondGroupingStart; j < column; j++)  {     double diff = proportions[columns[j]]-mean2; g2Var += diff*diff;  }
+        double var2 = g2Var/(double)(column-secondGroupingStart-1);
+        
+        //# find the std error of each group -std err^2
+        double stderr1 = var1/(double)(secondGroupingStart);    
+        double stderr2 = var2/(double)(column-secondGroupingStart);
+        
+        double xbar_diff = mean1 - mean2; 
+        double denom = sqrt(stderr1 + stderr2);
+        return abs(xbar_diff/denom);
         
     }catch(exception& e) {
-        m->errorOut(e, "MothurMetastats", "permuted_ttests");
+        m->errorOut(e, "MothurMetastats", "calc_permuted_ts");
         exit(1);
     }	
 }
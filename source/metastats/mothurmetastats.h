@@ -16,18 +16,19 @@
 class MothurMetastats {
 	
 	public:
-		MothurMetastats(double, int); //threshold, numPermutations
+		MothurMetastats(double, int, int processors = 1); //threshold, numPermutations, processors
 		~MothurMetastats();
 	
 		int runMetastats(string, vector< vector<double> >&, int); //outputFileName, data, secondGroupingStart
 	
 	private:
 		MothurOut* m;
-		int row, column, numPermutations, secondGroupingStart;
+		int row, column, numPermutations, secondGroupingStart, processors;
 		double threshold;
         
         vector<double> permuted_pvalues(vector< vector<double> >&, vector<double>&, vector< vector<double> >&);
-        vector<double> permute_and_calc_ts(vector< vector<double> >&);
+        int driver(vector<double>&, vector<unsigned int>&, int, int, bool, vector<bool>&, vector<double>&, vector<double>&, vector<long long>&); //proportions, seeds, start, end, pool, rows used, abs tstats, sorted tstats, counts
+        double calc_permuted_ts(double*, vector<int>&);
     
 		int start(vector<double>&, int, vector<double>&, vector< vector<double> >&); //Find the initial values for the matrix
 		int meanvar(vector<double>&, int, vector<double>&);
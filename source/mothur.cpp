@@ -15,6 +15,7 @@
 
 CommandFactory* CommandFactory::_uniqueInstance = 0;
 MothurOut* MothurOut::_uniqueInstance = 0;
+PerformanceTrace* PerformanceTrace::_uniqueInstance = 0;
 /***********************************************************************/
 volatile int ctrlc_pressed = 0;
 void ctrlc_handler ( int sig ) {
@@ -71,27 +72,42 @@ int main(int argc, char *argv[]){
 		
 		//will make the gui output "pretty"
 		bool outputHeader = true;
+        int scheduleProcessors = 0;
 		if (argc>1) {
 			string guiInput = argv[1];
 			if (guiInput[0] == '+') { outputHeader = false; }
 			if (guiInput[0] == '-') { outputHeader = false; }
             
-            if (argc > 2) { //is one of these -q for quiet mode?
-                if (argc > 3) { m->mothurOut("[ERROR]: mothur only allows command inputs and the -q command line options.\n  i.e. ./mothur \"#summary.seqs(fasta=final.fasta);\" -q\n or ./mothur -q \"#summary.seqs(fasta=final.fasta);\"\n"); return 0; }
+            if (argc > 2) { //is one of these -q for quiet mode or --schedule=processors for running batch commands at the same time?
+                if (argc > 4) { m->mothurOut("[ERROR]: mothur only allows command inputs and the -q and --schedule command line options.\n  i.e. ./mothur \"#summary.seqs(fasta=final.fasta);\" -q\n or ./mothur -q \"#summary.seqs(fasta=final.fasta);\"\n or ./mothur --schedule=8 yourBatchFile\n"); return 0; }
                 else {
-                    string argv1 = argv[1];
-                    string argv2 = argv[2];
-                    if ((argv1 == "--quiet") || (argv1 == "-q")) {
-                        m->quietMode = true;
-                        argv[1] = argv[2];
-                    }else if ((argv2 == "--quiet") || (argv2 == "-q")) {
-                         m->quietMode = true;
-                    }else {
-                        m->mothurOut("[ERROR]: mothur only allows command inputs and the -q command line options.\n");
-                        m->mothurOut("[ERROR]: Unrecognized options: " + argv1 + " " + argv2 + "\n");
+                    int inputIndex = 0;
+                    string unrecognized = "";
+                    for (int i = 1; i < argc; i++) {
+                        string arg = argv[i];
+                        if ((arg == "--quiet") || (arg == "-q")) {
+                            m->quietMode = true;
+                        }else if (arg.substr(0, 11) == "--schedule=") {
+                            string processors = arg.substr(11);
+                            if (m->isInteger(processors)) { m->mothurConvert(processors, scheduleProcessors); }
+                            else { unrecognized += arg + " "; }
+                        }else if (inputIndex == 0) {
+                            inputIndex = i;
+                        }else { unrecognized += arg + " "; }
+                    }
+                    
+                    if ((inputIndex == 0) || (unrecognized != "")) {
+                        m->mothurOut("[ERROR]: mothur only allows command inputs and the -q and --schedule command line options.\n");
+                        if (unrecognized != "") { m->mothurOut("[ERROR]: Unrecognized options: " + unrecognized + "\n"); }
                         return 0;
                     }
-                   
+                    //--schedule isn't a gui input, so the header depends on the input after it
+                    string firstArg = argv[1];
+                    if (firstArg.substr(0, 11) == "--schedule=") {
+                        string guiInput = argv[inputIndex];
+                        outputHeader = ((guiInput[0] != '+') && (guiInput[0] != '-'));
+                    }
+                    argv[1] = argv[inputIndex];
                 }
             }
 		}
@@ -167,7 +183,7 @@ int main(int argc, char *argv[]){
 		}
 		
 		//srand(54321);
-		srand( (unsigned)time( NULL ) );
+		m->setRandomSeed((unsigned)time( NULL ));
 		
 		Engine* mothur = NULL;
 		bool bail = 0;
@@ -224,7 +240,9 @@ int main(int argc, char *argv[]){
 				m->mothurOutJustToLog("Batch Mode");
 				m->mothurOutEndLine(); m->mothurOutEndLine();
 				
-				mothur = new BatchEngine(argv[0], argv[1]);
+				BatchEngine* batch = new BatchEngine(argv[0], argv[1]);
+				batch->setScheduleProcessors(scheduleProcessors);
+				mothur = batch;
 			}
 		}else{
 			m->mothurOutJustToLog("Interactive Mode");
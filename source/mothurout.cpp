@@ -8,6 +8,7 @@
  */
 
 #include "mothurout.h"
+#include "performancetrace.h"
 
 //needed for testing project
 //MothurOut* MothurOut::_uniqueInstance;
@@ -167,6 +168,83 @@ bool MothurOut::hasCurrentFiles()  {
 	}
 }
 
+/*********************************************************************************************/
+//type -> filename for the current files that are set, same tags as printCurrentFiles
+map<string, string> MothurOut::getCurrentFiles()  {
+	try {
+		map<string, string> files;
+		
+		if (accnosfile != "")		{  files["accnos"] = accnosfile;			}
+		if (columnfile != "")		{  files["column"] = columnfile;			}
+		if (designfile != "")		{  files["design"] = designfile;			}
+		if (fastafile != "")		{  files["fasta"] = fastafile;				}
+		if (groupfile != "")		{  files["group"] = groupfile;				}
+		if (listfile != "")			{  files["list"] = listfile;				}
+		if (namefile != "")			{  files["name"] = namefile;				}
+		if (oligosfile != "")		{  files["oligos"] = oligosfile;			}
+		if (orderfile != "")		{  files["order"] = orderfile;				}
+		if (ordergroupfile != "")	{  files["ordergroup"] = ordergroupfile;	}
+		if (phylipfile != "")		{  files["phylip"] = phylipfile;			}
+		if (qualfile != "")			{  files["qfile"] = qualfile;				}
+		if (rabundfile != "")		{  files["rabund"] = rabundfile;			}
+		if (relabundfile != "")		{  files["relabund"] = relabundfile;		}
+		if (sabundfile != "")		{  files["sabund"] = sabundfile;			}
+		if (sfffile != "")			{  files["sff"] = sfffile;					}
+		if (sharedfile != "")		{  files["shared"] = sharedfile;			}
+		if (taxonomyfile != "")		{  files["taxonomy"] = taxonomyfile;		}
+		if (treefile != "")			{  files["tree"] = treefile;				}
+		if (flowfile != "")			{  files["flow"] = flowfile;				}
+		if (biomfile != "")			{  files["biom"] = biomfile;				}
+		if (counttablefile != "")	{  files["count"] = counttablefile;			}
+		if (summaryfile != "")		{  files["summary"] = summaryfile;			}
+		if (filefile != "")			{  files["file"] = filefile;				}
+		if (processors != "1")		{  files["processors"] = processors;		}
+		
+		return files;
+	}
+	catch(exception& e) {
+		errorOut(e, "MothurOut", "getCurrentFiles");
+		exit(1);
+	}
+}
+/*********************************************************************************************/
+//returns false if mothur does not save a current file of this type
+bool MothurOut::setCurrentFile(string type, string filename)  {
+	try {
+		if (type == "fasta")				{	setFastaFile(getFullPathName(filename));		}
+		else if (type == "qfile")			{	setQualFile(getFullPathName(filename));			}
+		else if (type == "phylip")			{	setPhylipFile(getFullPathName(filename));		}
+		else if (type == "column")			{	setColumnFile(getFullPathName(filename));		}
+		else if (type == "list")			{	setListFile(getFullPathName(filename));			}
+		else if (type == "rabund")			{	setRabundFile(getFullPathName(filename));		}
+		else if (type == "sabund")			{	setSabundFile(getFullPathName(filename));		}
+		else if (type == "name")			{	setNameFile(getFullPathName(filename));			}
+		else if (type == "group")			{	setGroupFile(getFullPathName(filename));		}
+		else if (type == "order")			{	setOrderFile(getFullPathName(filename));		}
+		else if (type == "ordergroup")		{	setOrderGroupFile(getFullPathName(filename));	}
+		else if (type == "tree")			{	setTreeFile(getFullPathName(filename));			}
+		else if (type == "shared")			{	setSharedFile(getFullPathName(filename));		}
+		else if (type == "relabund")		{	setRelAbundFile(getFullPathName(filename));		}
+		else if (type == "design")			{	setDesignFile(getFullPathName(filename));		}
+		else if (type == "sff")				{	setSFFFile(getFullPathName(filename));			}
+		else if (type == "oligos")			{	setOligosFile(getFullPathName(filename));		}
+		else if (type == "accnos")			{	setAccnosFile(getFullPathName(filename));		}
+		else if (type == "taxonomy")		{	setTaxonomyFile(getFullPathName(filename));		}
+		else if (type == "flow")			{	setFlowFile(getFullPathName(filename));			}
+		else if (type == "biom")			{	setBiomFile(getFullPathName(filename));			}
+		else if (type == "count")			{	setCountTableFile(getFullPathName(filename));	}
+		else if (type == "summary")			{	setSummaryFile(getFullPathName(filename));		}
+		else if (type == "file")			{	setFileFile(getFullPathName(filename));			}
+		else if (type == "processors")		{	setProcessors(filename);						}
+		else { return false; }
+		
+		return true;
+	}
+	catch(exception& e) {
+		errorOut(e, "MothurOut", "setCurrentFile");
+		exit(1);
+	}
+}
 /*********************************************************************************************/
 void MothurOut::clearCurrentFiles()  {
 	try {
@@ -302,6 +380,21 @@ void MothurOut::setFileName(string filename)  {
 	}
 }
 /*********************************************************************************************/
+//for a forked process whose output mothur adds to the logfile when it is done, so processes running at the same time don't mix their output
+void MothurOut::redirectOutput(string filename)  {
+	try {
+		out.close(); out.clear();
+		if (filename != "") {
+			openOutputFile(filename, out);
+			cout.setstate(ios::badbit); //mothur prints it to the screen when it adds it to the logfile
+		}
+	}
+	catch(exception& e) {
+		errorOut(e, "MothurOut", "redirectOutput");
+		exit(1);
+	}
+}
+/*********************************************************************************************/
 void MothurOut::setDefaultPath(string pathname)  {
 	try {
 	
@@ -1466,6 +1559,7 @@ int MothurOut::appendFiles(string temp, string filename) {
 	try{
 		ofstream output;
 		ifstream input;
+		PerformanceTrace::getInstance()->startPhase("merge");
 	
 		//open output file in append mode
 		openOutputFileBinaryAppend(filename, output);
@@ -1486,6 +1580,7 @@ int MothurOut::appendFiles(string temp, string filename) {
 		}
 		
 		output.close();
+		PerformanceTrace::getInstance()->endPhase("merge");
 		
 		return numLines;
 	}
@@ -1499,6 +1594,7 @@ int MothurOut::appendBinaryFiles(string temp, string filename) {
 	try{
 		ofstream output;
 		ifstream input;
+		PerformanceTrace::getInstance()->startPhase("merge");
         
 		//open output file in append mode
 		openOutputFileBinaryAppend(filename, output);
@@ -1515,6 +1611,7 @@ int MothurOut::appendBinaryFiles(string temp, string filename) {
 		}
 		
 		output.close();
+		PerformanceTrace::getInstance()->endPhase("merge");
 		
 		return ableToOpen;
 	}
@@ -1568,6 +1665,7 @@ int MothurOut::appendFilesWithoutHeaders(string temp, string filename) {
 	try{
 		ofstream output;
 		ifstream input;
+		PerformanceTrace::getInstance()->startPhase("merge");
         
 		//open output file in append mode
 		openOutputFileAppend(filename, output);
@@ -1591,6 +1689,7 @@ int MothurOut::appendFilesWithoutHeaders(string temp, string filename) {
 		}
 		
 		output.close();
+		PerformanceTrace::getInstance()->endPhase("merge");
 		
 		return numLines;
 	}
@@ -35,6 +35,7 @@ class MothurOut {
 	public:
 		static MothurOut* getInstance();
 		void setFileName(string);
+		string getFileName() { return logFileName; }
 		
 		void mothurOut(string); //writes to cout and the logfile
 		void mothurOutEndLine(); //writes to cout and the logfile
@@ -44,6 +45,8 @@ class MothurOut {
 		void mothurOutJustToLog(string);
 		void errorOut(exception&, string, string);
 		void closeLog();
+		void flushLog() { out.flush(); cout.flush(); } //so a forked process doesn't write the parent's output again
+		void redirectOutput(string); //sends the logfile output to the file and none to the screen, "" closes the file
 		string getDefaultPath() { return defaultPath; }
 		void setDefaultPath(string);
 		string getOutputDir() { return outputDir; }
@@ -53,6 +56,8 @@ class MothurOut {
 		void setReleaseDate(string r) { releaseDate = r; }
 		string getVersion() { return version; }
 		void setVersion(string r) { version = r; }
+		int getRandomSeed() { return randomSeed; }
+		void setRandomSeed(int r) { randomSeed = r; srand(r); }
 	
 		void addGroup(string g) { Groups.push_back(g); }
 		void setGroups(vector<string>& g) { sort(g.begin(), g.end()); Groups = g; }
@@ -70,7 +75,7 @@ class MothurOut {
 		vector<string> currentSharedBinLabels;
         vector<string> listBinLabelsInFile;
 		string saveNextLabel, argv, sharedHeaderMode, groupMode, testDirectory;
-		bool printedSharedHeaders, printedListHeaders, commandInputsConvertError, changedSeqNames, modifyNames;
+		bool printedSharedHeaders, printedListHeaders, commandInputsConvertError, changedSeqNames, modifyNames, saveCountBinary;
 		
 		//functions from mothur.h
 		//file operations
@@ -226,7 +231,7 @@ class MothurOut {
 		int control_pressed;
 		bool executing, runParse, jumble, gui, mothurCalling, debug, quietMode;
 		
-		//current files - if you add a new type you must edit optionParser->getParameters, get.current and set.current commands and mothurOut->printCurrentFiles/clearCurrentFiles/getCurrentTypes. add a get and set function.
+		//current files - if you add a new type you must edit optionParser->getParameters, get.current and set.current commands and mothurOut->printCurrentFiles/clearCurrentFiles/getCurrentTypes/getCurrentFiles/setCurrentFile. add a get and set function.
 		string getPhylipFile()		{ return phylipfile;		}
 		string getColumnFile()		{ return columnfile;		}
 		string getListFile()		{ return listfile;			}
@@ -284,6 +289,8 @@ class MothurOut {
 		bool hasCurrentFiles();
 		void clearCurrentFiles();
         set<string> getCurrentTypes(); 
+        map<string, string> getCurrentFiles();      //type -> filename
+        bool setCurrentFile(string, string);        //type, filename
 		
 	private:
 		static MothurOut* _uniqueInstance;
@@ -327,14 +334,17 @@ class MothurOut {
             groupMode = "group";
             changedSeqNames = false;
             modifyNames = true;
+            saveCountBinary = false;
             numErrors = 0;
             numWarnings = 0;
+            randomSeed = 0;
 		}
 		~MothurOut();
 
 		string logFileName;
 		string defaultPath, outputDir;
 		string releaseDate, version;
+		int randomSeed;
 	
 		string accnosfile, phylipfile, columnfile, listfile, rabundfile, sabundfile, namefile, groupfile, designfile, taxonomyfile, biomfile, filefile;
 		string orderfile, treefile, sharedfile, ordergroupfile, relabundfile, fastafile, qualfile, sfffile, oligosfile, processors, flowfile, counttablefile, summaryfile;
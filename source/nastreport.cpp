@@ -80,16 +80,19 @@ NastReport::~NastReport() {
 
 void NastReport::print(){
 	try {
-		candidateReportFile << queryName << '\t' << queryLength << '\t' << templateName << '\t' << templateLength << '\t';
-		candidateReportFile << searchMethod << '\t' << setprecision(2) << fixed << searchScore << '\t';
-
-		candidateReportFile << alignmentMethod << '\t' << candidateStartPosition << "\t" << candidateEndPosition << '\t';
-		candidateReportFile << templateStartPosition << "\t" << templateEndPosition << '\t';
-		candidateReportFile << pairwiseAlignmentLength << '\t' << totalGapsInQuery << '\t' << totalGapsInTemplate << '\t';
-		candidateReportFile << longestInsert << '\t';
-		candidateReportFile << setprecision(2) << similarityToTemplate;
-		
-		candidateReportFile << endl;
+		candidateReportFile << queryName << '\t' << getResults() << endl;
+		candidateReportFile.flush();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NastReport", "print");
+		exit(1);
+	}
+}
+/******************************************************************************************************************/
+//prints results saved with getResults for a query with the same sequence
+void NastReport::print(string name, string results){
+	try {
+		candidateReportFile << name << '\t' << results << endl;
 		candidateReportFile.flush();
 	}
 	catch(exception& e) {
@@ -98,6 +101,28 @@ void NastReport::print(){
 	}
 }
 /******************************************************************************************************************/
+//the report line after the query name
+string NastReport::getResults(){
+	try {
+		ostringstream out;
+		
+		out << queryLength << '\t' << templateName << '\t' << templateLength << '\t';
+		out << searchMethod << '\t' << setprecision(2) << fixed << searchScore << '\t';
+
+		out << alignmentMethod << '\t' << candidateStartPosition << "\t" << candidateEndPosition << '\t';
+		out << templateStartPosition << "\t" << templateEndPosition << '\t';
+		out << pairwiseAlignmentLength << '\t' << totalGapsInQuery << '\t' << totalGapsInTemplate << '\t';
+		out << longestInsert << '\t';
+		out << setprecision(2) << similarityToTemplate;
+		
+		return out.str();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NastReport", "getResults");
+		exit(1);
+	}
+}
+/******************************************************************************************************************/
 
 string NastReport::getReport(){
 	try {
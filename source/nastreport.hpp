@@ -27,6 +27,8 @@ public:
 	void setAlignmentParameters(string, Alignment*);
 	void setNastParameters(Nast);
 	void print();
+	void print(string, string);     //query name, results
+	string getResults();
 	string getReport();
 	string getHeaders();
 	
@@ -0,0 +1,304 @@
+/*
+ *  performancetrace.cpp
+ *  Mothur
+ *
+ *  Copyright 2016 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "performancetrace.h"
+#include "mothurout.h"
+
+/***********************************************************************/
+//PerformanceTrace* PerformanceTrace::_uniqueInstance;
+/***********************************************************************/
+PerformanceTrace* PerformanceTrace::getInstance() {
+	if( _uniqueInstance == 0) {
+		_uniqueInstance = new PerformanceTrace();
+	}
+	return _uniqueInstance;
+}
+/***********************************************************************/
+PerformanceTrace::PerformanceTrace() {
+	traceFile = "";
+	commandName = "";
+	inCommand = false;
+	commandPid = 0;
+	commandStart = 0;
+	userStart = 0; systemStart = 0; childUserStart = 0; childSystemStart = 0;
+	bytesReadStart = 0; bytesWrittenStart = 0;
+}
+/***********************************************************************/
+void PerformanceTrace::setTraceFile(string filename) {
+	MothurOut* m = MothurOut::getInstance();
+	try {
+		static bool registered = false;
+		if (!registered && (filename != "")) { atexit(PerformanceTrace::writeWorker); registered = true; }
+
+		traceFile = filename;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PerformanceTrace", "setTraceFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+double PerformanceTrace::getTime() {
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	return now.tv_sec + (now.tv_usec / 1000000.0);
+#else
+	return time(NULL);
+#endif
+}
+/***********************************************************************/
+void PerformanceTrace::getCPUTime(double& user, double& system, double& childUser, double& childSystem) {
+	user = 0; system = 0; childUser = 0; childSystem = 0;
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	struct rusage self, children;
+	getrusage(RUSAGE_SELF, &self);
+	getrusage(RUSAGE_CHILDREN, &children);
+
+	user = self.ru_utime.tv_sec + (self.ru_utime.tv_usec / 1000000.0);
+	system = self.ru_stime.tv_sec + (self.ru_stime.tv_usec / 1000000.0);
+	childUser = children.ru_utime.tv_sec + (children.ru_utime.tv_usec / 1000000.0);
+	childSystem = children.ru_stime.tv_sec + (children.ru_stime.tv_usec / 1000000.0);
+#endif
+}
+/***********************************************************************/
+//bytes this process has read and written, linux only
+void PerformanceTrace::getIOBytes(unsigned long long& bytesRead, unsigned long long& bytesWritten) {
+	bytesRead = 0; bytesWritten = 0;
+
+	ifstream in("/proc/self/io");
+	if (!in) { return; }
+
+	string name; unsigned long long value;
+	while (in >> name >> value) {
+		if (name == "rchar:")		{ bytesRead = value;	}
+		else if (name == "wchar:")	{ bytesWritten = value; }
+	}
+	in.close();
+}
+/***********************************************************************/
+//kilobytes
+unsigned long long PerformanceTrace::getPeakRSS() {
+	//linux keeps a peak we can reset for each command
+	ifstream in("/proc/self/status");
+	if (in) {
+		string line;
+		while (getline(in, line)) {
+			if (line.substr(0, 6) == "VmHWM:") {
+				istringstream value(line.substr(6));
+				unsigned long long peak = 0;
+				value >> peak;
+				in.close();
+				return peak;
+			}
+		}
+		in.close();
+	}
+
+#if defined (__APPLE__) || (__MACH__)
+	struct rusage r_usage;
+	getrusage(RUSAGE_SELF, &r_usage);
+	return r_usage.ru_maxrss / 1024;
+#elif (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	struct rusage r_usage;
+	getrusage(RUSAGE_SELF, &r_usage);
+	return r_usage.ru_maxrss;
+#else
+	return 0;
+#endif
+}
+/***********************************************************************/
+void PerformanceTrace::resetPeakRSS() {
+	ofstream out("/proc/self/clear_refs");
+	if (out) { out << "5"; out.close(); }
+}
+/***********************************************************************/
+string PerformanceTrace::getWorkerFile(int pid) {
+	ostringstream name;
+	name << traceFile << "." << pid << ".workers.temp";
+	return name.str();
+}
+/***********************************************************************/
+//runs when a process exits, only the processes forked by the running command write a line
+void PerformanceTrace::writeWorker() {
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	PerformanceTrace* trace = _uniqueInstance;
+	if (trace == 0) { return; }
+	if (!trace->isOn() || !trace->inCommand || (getpid() == trace->commandPid)) { return; }
+
+	double user, system, childUser, childSystem;
+	trace->getCPUTime(user, system, childUser, childSystem);
+	unsigned long long bytesRead, bytesWritten;
+	trace->getIOBytes(bytesRead, bytesWritten);
+
+	ofstream out(trace->getWorkerFile(trace->commandPid).c_str(), ios::app);
+	if (!out) { return; }
+	out << getpid() << '\t' << (user + system + childUser + childSystem) << '\t' << trace->getPeakRSS() << '\t' << bytesRead << '\t' << bytesWritten << endl;
+	out.close();
+#endif
+}
+/***********************************************************************/
+vector<TraceWorker> PerformanceTrace::readWorkers() {
+	vector<TraceWorker> workers;
+
+	string filename = getWorkerFile(commandPid);
+	ifstream in(filename.c_str());
+	if (!in) { return workers; }
+
+	TraceWorker worker;
+	while (in >> worker.pid >> worker.busy >> worker.peakRSS >> worker.bytesRead >> worker.bytesWritten) { workers.push_back(worker); }
+	in.close();
+	remove(filename.c_str());
+
+	return workers;
+}
+/***********************************************************************/
+string PerformanceTrace::formatNumber(double value) {
+	ostringstream out;
+	out << fixed << setprecision(3) << value;
+	return out.str();
+}
+/***********************************************************************/
+string PerformanceTrace::escape(string value) {
+	string escaped = "";
+	for (int i = 0; i < value.length(); i++) {
+		if ((value[i] == '"') || (value[i] == '\\')) { escaped += '\\'; }
+		escaped += value[i];
+	}
+	return escaped;
+}
+/***********************************************************************/
+void PerformanceTrace::startCommand(string name) {
+	MothurOut* m = MothurOut::getInstance();
+	try {
+		if (!isOn()) { return; }
+
+		commandName = name;
+		inCommand = true;
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		commandPid = getpid();
+#endif
+		phaseTimes.clear(); phaseStarts.clear(); phaseDepth.clear(); phaseOrder.clear();
+		remove(getWorkerFile(commandPid).c_str());
+
+		resetPeakRSS();
+		getCPUTime(userStart, systemStart, childUserStart, childSystemStart);
+		getIOBytes(bytesReadStart, bytesWrittenStart);
+		commandStart = getTime();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PerformanceTrace", "startCommand");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//phases of the same name can nest, the outer one is timed
+void PerformanceTrace::startPhase(string name) {
+	if (!inCommand) { return; }
+
+	if (phaseDepth[name] == 0) {
+		phaseStarts[name] = getTime();
+		if (phaseTimes.count(name) == 0) { phaseTimes[name] = 0; phaseOrder.push_back(name); }
+	}
+	phaseDepth[name]++;
+}
+/***********************************************************************/
+void PerformanceTrace::endPhase(string name) {
+	if (!inCommand) { return; }
+	if (phaseDepth[name] == 0) { return; }
+
+	phaseDepth[name]--;
+	if (phaseDepth[name] == 0) { phaseTimes[name] += getTime() - phaseStarts[name]; }
+}
+/***********************************************************************/
+void PerformanceTrace::endCommand(int result, map<string, vector<string> > outputs) {
+	MothurOut* m = MothurOut::getInstance();
+	try {
+		if (!isOn() || !inCommand) { return; }
+
+		double wall = getTime() - commandStart;
+		double user, system, childUser, childSystem;
+		getCPUTime(user, system, childUser, childSystem);
+		user -= userStart; system -= systemStart; childUser -= childUserStart; childSystem -= childSystemStart;
+		unsigned long long bytesRead, bytesWritten;
+		getIOBytes(bytesRead, bytesWritten);
+		bytesRead -= bytesReadStart; bytesWritten -= bytesWrittenStart;
+		unsigned long long peakRSS = getPeakRSS();
+		inCommand = false;
+
+		vector<TraceWorker> workers = readWorkers();
+		double workerBusy = 0; double workerBusyMax = 0;
+		unsigned long long workerPeakRSS = 0, workerBytesRead = 0, workerBytesWritten = 0;
+		for (int i = 0; i < workers.size(); i++) {
+			workerBusy += workers[i].busy;
+			if (workers[i].busy > workerBusyMax)	{ workerBusyMax = workers[i].busy;		}
+			if (workers[i].peakRSS > workerPeakRSS) { workerPeakRSS = workers[i].peakRSS;	}
+			workerBytesRead += workers[i].bytesRead;
+			workerBytesWritten += workers[i].bytesWritten;
+		}
+
+		unsigned long long outputBytes = 0;
+		int numOutputs = 0;
+		for (map<string, vector<string> >::iterator it = outputs.begin(); it != outputs.end(); it++) {
+			for (int i = 0; i < it->second.size(); i++) {
+				ifstream in(it->second[i].c_str(), ios::binary);
+				if (!in) { continue; }
+				in.seekg(0, ios::end);
+				outputBytes += (unsigned long long)in.tellg();
+				in.close();
+				numOutputs++;
+			}
+		}
+
+		time_t now = time(NULL);
+		string date = ctime(&now); date = date.substr(0, date.length()-1);
+
+		//csv, one row per command
+		string csvFile = traceFile + ".trace.csv";
+		bool newFile = true;
+		ifstream inCSV(csvFile.c_str());
+		if (inCSV) { newFile = (inCSV.peek() == EOF); inCSV.close(); }
+
+		ofstream csv(csvFile.c_str(), ios::app);
+		if (newFile) {
+			csv << "version,command,date,result,wall_s,user_s,system_s,children_user_s,children_system_s,peak_rss_kb,bytes_read,bytes_written,";
+			csv << "read_s,compute_s,merge_s,num_workers,worker_busy_s,worker_busy_max_s,worker_peak_rss_kb,worker_bytes_read,worker_bytes_written,num_outputs,output_bytes" << endl;
+		}
+		csv << m->getVersion() << ',' << commandName << ',' << date << ',' << result << ',' << formatNumber(wall) << ',' << formatNumber(user) << ',' << formatNumber(system) << ',';
+		csv << formatNumber(childUser) << ',' << formatNumber(childSystem) << ',' << peakRSS << ',' << bytesRead << ',' << bytesWritten << ',';
+		csv << formatNumber(phaseTimes["read"]) << ',' << formatNumber(phaseTimes["compute"]) << ',' << formatNumber(phaseTimes["merge"]) << ',';
+		csv << workers.size() << ',' << formatNumber(workerBusy) << ',' << formatNumber(workerBusyMax) << ',' << workerPeakRSS << ',' << workerBytesRead << ',' << workerBytesWritten << ',';
+		csv << numOutputs << ',' << outputBytes << endl;
+		csv.close();
+
+		//json, one object per line
+		ofstream json((traceFile + ".trace.json").c_str(), ios::app);
+		json << "{\"version\":\"" << escape(m->getVersion()) << "\",\"command\":\"" << escape(commandName) << "\",\"date\":\"" << date << "\",\"result\":" << result;
+		json << ",\"wall_s\":" << formatNumber(wall) << ",\"user_s\":" << formatNumber(user) << ",\"system_s\":" << formatNumber(system);
+		json << ",\"children_user_s\":" << formatNumber(childUser) << ",\"children_system_s\":" << formatNumber(childSystem);
+		json << ",\"peak_rss_kb\":" << peakRSS << ",\"bytes_read\":" << bytesRead << ",\"bytes_written\":" << bytesWritten;
+		json << ",\"phases\":{";
+		for (int i = 0; i < phaseOrder.size(); i++) {
+			if (i != 0) { json << ","; }
+			json << "\"" << escape(phaseOrder[i]) << "\":" << formatNumber(phaseTimes[phaseOrder[i]]);
+		}
+		json << "},\"workers\":[";
+		for (int i = 0; i < workers.size(); i++) {
+			if (i != 0) { json << ","; }
+			json << "{\"pid\":" << workers[i].pid << ",\"busy_s\":" << formatNumber(workers[i].busy) << ",\"peak_rss_kb\":" << workers[i].peakRSS;
+			json << ",\"bytes_read\":" << workers[i].bytesRead << ",\"bytes_written\":" << workers[i].bytesWritten << "}";
+		}
+		json << "],\"num_outputs\":" << numOutputs << ",\"output_bytes\":" << outputBytes << "}" << endl;
+		json.close();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PerformanceTrace", "endCommand");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,78 @@
+#ifndef PERFORMANCETRACE_H
+#define PERFORMANCETRACE_H
+
+/*
+ *  performancetrace.h
+ *  Mothur
+ *
+ *  Copyright 2016 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+
+/* Records where each command spends its time and memory. Turned on with set.dir(trace=t).
+ For every command a row is added to yourLogfile.trace.csv and a line of JSON to yourLogfile.trace.json with the wall
+ and cpu time, peak memory, bytes read and written, the time spent in each phase and the busy time of each process the
+ command forked. Commands mark their phases with startPhase and endPhase, appendFiles is timed as the merge phase.
+ The processes a command forks add themselves to the trace when they exit. */
+
+/***********************************************************************/
+
+struct TraceWorker {
+	int pid;
+	double busy;                    //user and system seconds
+	unsigned long long peakRSS;     //kilobytes
+	unsigned long long bytesRead, bytesWritten;
+};
+
+/***********************************************************************/
+
+class PerformanceTrace {
+
+public:
+	static PerformanceTrace* getInstance();
+
+	void setTraceFile(string);          //yourLogfile, "" turns the trace off
+	bool isOn()                 { return (traceFile != ""); }
+
+	void startCommand(string);
+	void endCommand(int, map<string, vector<string> >);    //result of execute, output files
+	void startPhase(string);
+	void endPhase(string);
+
+private:
+	string traceFile;
+	string commandName;
+	bool inCommand;
+	int commandPid;
+	double commandStart;
+	double userStart, systemStart, childUserStart, childSystemStart;
+	unsigned long long bytesReadStart, bytesWrittenStart;
+	map<string, double> phaseTimes;
+	map<string, double> phaseStarts;
+	map<string, int> phaseDepth;
+	vector<string> phaseOrder;
+
+	double getTime();
+	void getCPUTime(double&, double&, double&, double&);
+	void getIOBytes(unsigned long long&, unsigned long long&);
+	unsigned long long getPeakRSS();
+	void resetPeakRSS();
+	string getWorkerFile(int);
+	vector<TraceWorker> readWorkers();
+	string formatNumber(double);
+	string escape(string);
+
+	static void writeWorker();          //registered with atexit, runs in the processes commands fork
+
+	static PerformanceTrace* _uniqueInstance;
+	PerformanceTrace( const PerformanceTrace& ); // Disable copy constructor
+	void operator=( const PerformanceTrace& ); // Disable assignment operator
+	PerformanceTrace();
+	~PerformanceTrace() { _uniqueInstance = 0; }
+};
+
+/***********************************************************************/
+
+#endif
@@ -13,7 +13,8 @@
 AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                                          vector<int> globalDiscardedFeatureIndices,
                                          OptimumFeatureSubsetSelector optimumFeatureSubsetSelector, 
-                                         string treeSplitCriterion)
+                                         string treeSplitCriterion,
+                                         const vector< vector<int> >* presortedRows)
 
                     : baseDataSet(baseDataSet),
                     numSamples((int)baseDataSet.size()),
@@ -23,7 +24,8 @@ AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                     nodeIdCount(0),
                     globalDiscardedFeatureIndices(globalDiscardedFeatureIndices),
                     optimumFeatureSubsetSize(optimumFeatureSubsetSelector.getOptimumFeatureSubsetSize(numFeatures)),
-                    treeSplitCriterion(treeSplitCriterion) {
+                    treeSplitCriterion(treeSplitCriterion),
+                    presortedRows(presortedRows) {
 
     try {
         // TODO: istead of calculating this for every DecisionTree
@@ -39,6 +41,10 @@ AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
             }
         }
         
+        isGlobalDiscarded.resize(numFeatures, false);
+        for (int i = 0; i < globalDiscardedFeatureIndices.size(); i++) { isGlobalDiscarded[globalDiscardedFeatureIndices[i]] = true; }
+        if (presortedRows != NULL) { nodeRowCounts.resize(numSamples, 0); }
+        
         if (m->debug) {
             //m->mothurOut("outputClasses = " + toStringVectorInt(outputClasses));
             m->mothurOut("numOutputClasses = " + toString(numOutputClasses) + '\n');
@@ -59,30 +65,14 @@ int AbstractDecisionTree::createBootStrappedSamples(){
             if (m->control_pressed) { return 0; }
             // TODO: optimize the rand() function call + double check if it's working properly
             int randomIndex = rand() % numSamples;
-            bootstrappedTrainingSamples.push_back(baseDataSet[randomIndex]);
+            bootstrappedTrainingSampleRows.push_back(randomIndex);
             isInTrainingSamples[randomIndex] = true;
         }
         
         for (int i = 0; i < numSamples; i++) {
             if (m->control_pressed) { return 0; }
             if (isInTrainingSamples[i]){ bootstrappedTrainingSampleIndices.push_back(i); }
-            else{
-                bootstrappedTestSamples.push_back(baseDataSet[i]);
-                bootstrappedTestSampleIndices.push_back(i);
-            }
-        }
-        
-            // do the transpose of Test Samples
-        for (int i = 0; i < bootstrappedTestSamples[0].size(); i++) {
-            if (m->control_pressed) { return 0; }
-            
-            vector<int> tmpFeatureVector(bootstrappedTestSamples.size(), 0);
-            for (int j = 0; j < bootstrappedTestSamples.size(); j++) {
-                if (m->control_pressed) { return 0; }
-                
-                tmpFeatureVector[j] = bootstrappedTestSamples[j][i];
-            }
-            testSampleFeatureVectors.push_back(tmpFeatureVector);
+            else{ bootstrappedTestSampleIndices.push_back(i); }
         }
         
         return 0;
@@ -93,45 +83,54 @@ int AbstractDecisionTree::createBootStrappedSamples(){
 	} 
 }
 /**************************************************************************************************/
-int AbstractDecisionTree::getMinEntropyOfFeature(vector<int> featureVector,
-                                                 vector<int> outputVector,
+//adds increment to the count of each row in the node, getMinEntropyOfFeature uses the counts to walk presortedRows
+void AbstractDecisionTree::countNodeRows(RFTreeNode* node, int increment){
+    try {
+        if (presortedRows == NULL) { return; }
+        int end = node->getSampleStart() + node->getNumSamples();
+        for (int i = node->getSampleStart(); i < end; i++) { nodeRowCounts[bootstrappedTrainingSampleRows[i]] += increment; }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "AbstractDecisionTree", "countNodeRows");
+		exit(1);
+	} 
+}
+/**************************************************************************************************/
+int AbstractDecisionTree::getMinEntropyOfFeature(RFTreeNode* node,
+                                                 int featureIndex,
                                                  double& minEntropy,
                                                  int& featureSplitValue,
                                                  double& intrinsicValue){
     try {
-
-        vector< pair<int, int> > featureOutputPair(featureVector.size(), pair<int, int>(0, 0));
+        int start = node->getSampleStart();
+        int nodeSize = node->getNumSamples();
+        featureOutputPairs.clear();
         
-        for (int i = 0; i < featureVector.size(); i++) { 
-            if (m->control_pressed) { return 0; }
-            
-            featureOutputPair[i].first = featureVector[i];
-            featureOutputPair[i].second = outputVector[i];
+        //walking the rows presorted by this feature costs numSamples, sorting the node's rows costs nodeSize*log(nodeSize)
+        bool usePresorted = false;
+        if (presortedRows != NULL) {
+            if ((*presortedRows)[featureIndex].size() != 0) { usePresorted = ((nodeSize * log2((double)nodeSize)) > numSamples); }
         }
-        // TODO: using default behavior to sort(), need to specify the comparator for added safety and compiler portability,
         
-        IntPairVectorSorter intPairVectorSorter;
-        sort(featureOutputPair.begin(), featureOutputPair.end(), intPairVectorSorter);
-        
-        vector<int> splitPoints;
-        vector<int> uniqueFeatureValues(1, featureOutputPair[0].first);
-        
-        for (int i = 0; i < featureOutputPair.size(); i++) {
-
-            if (m->control_pressed) { return 0; }
-            int featureValue = featureOutputPair[i].first;
-
-            vector<int>::iterator it = find(uniqueFeatureValues.begin(), uniqueFeatureValues.end(), featureValue);
-            if (it == uniqueFeatureValues.end()){                 // NOT FOUND
-                uniqueFeatureValues.push_back(featureValue);
-                splitPoints.push_back(i);
+        if (usePresorted) {
+            const vector<int>& sortedRows = (*presortedRows)[featureIndex];
+            for (int i = 0; i < sortedRows.size(); i++) {
+                int row = sortedRows[i];
+                for (int j = 0; j < nodeRowCounts[row]; j++) {
+                    featureOutputPairs.push_back(pair<int, int>(baseDataSet[row][featureIndex], baseDataSet[row][numFeatures]));
+                }
+            }
+        }else {
+            for (int i = start; i < start + nodeSize; i++) {
+                int row = bootstrappedTrainingSampleRows[i];
+                featureOutputPairs.push_back(pair<int, int>(baseDataSet[row][featureIndex], baseDataSet[row][numFeatures]));
             }
+            IntPairVectorSorter intPairVectorSorter;
+            sort(featureOutputPairs.begin(), featureOutputPairs.end(), intPairVectorSorter);
         }
+        if (m->control_pressed) { return 0; }
         
-
-        
-        int bestSplitIndex = -1;
-        if (splitPoints.size() == 0){
+        if (featureOutputPairs.front().first == featureOutputPairs.back().first){
             // TODO: trying out C++'s infitinity, don't know if this will work properly
             // TODO: check the caller function of this function, there check the value if minEntropy and comapre to inf
             // so that no wrong calculation is done
@@ -139,8 +138,7 @@ int AbstractDecisionTree::getMinEntropyOfFeature(vector<int> featureVector,
             intrinsicValue = numeric_limits<double>::infinity();                      // OUTPUT
             featureSplitValue = -1;                                                   // OUTPUT
         }else{
-            getBestSplitAndMinEntropy(featureOutputPair, splitPoints, minEntropy, bestSplitIndex, intrinsicValue);  // OUTPUT
-            featureSplitValue = featureOutputPair[splitPoints[bestSplitIndex]].first;    // OUTPUT
+            getBestSplitAndMinEntropy(featureOutputPairs, minEntropy, featureSplitValue, intrinsicValue);  // OUTPUT
         }
         
         return 0;
@@ -171,45 +169,45 @@ double AbstractDecisionTree::calcIntrinsicValue(int numLessThanValueAtSplitPoint
 	} 
 }
 /**************************************************************************************************/
-
-int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > featureOutputPairs, vector<int> splitPoints,
-                                                    double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue){
+//featureOutputPairs are sorted by feature value. splits at every change in value, sweeping once and moving each sample
+//from the right side's class counts to the left's as it passes. the first split with the lowest entropy wins
+int AbstractDecisionTree::getBestSplitAndMinEntropy(const vector< pair<int, int> >& featureOutputPairs,
+                                                    double& minEntropy, int& featureSplitValue, double& relatedIntrinsicValue){
     try {
         
         int numSamples = (int)featureOutputPairs.size();
-        vector<double> entropies;
-        vector<double> intrinsicValues;
+        vector<int> lessThanClassCounts(numOutputClasses, 0);
+        vector<int> greaterThanClassCounts(numOutputClasses, 0);
+        for (int i = 0; i < numSamples; i++) { greaterThanClassCounts[featureOutputPairs[i].second]++; }
         
-        for (int i = 0; i < splitPoints.size(); i++) {
+        bool found = false;
+        minEntropy = numeric_limits<double>::infinity();
+        featureSplitValue = -1;
+        relatedIntrinsicValue = numeric_limits<double>::infinity();
+        
+        for (int i = 1; i < numSamples; i++) {
             if (m->control_pressed) { return 0; }
-            int index = splitPoints[i];
-            int valueAtSplitPoint = featureOutputPairs[index].first;
-
-            int numLessThanValueAtSplitPoint = 0;
-            int numGreaterThanValueAtSplitPoint = 0;
             
-            for (int j = 0; j < featureOutputPairs.size(); j++) {
-                if (m->control_pressed) { return 0; }
-                pair<int, int> record = featureOutputPairs[j];
-                if (record.first < valueAtSplitPoint){ numLessThanValueAtSplitPoint++; }
-                else{ numGreaterThanValueAtSplitPoint++; }
-            }
+            lessThanClassCounts[featureOutputPairs[i-1].second]++;
+            greaterThanClassCounts[featureOutputPairs[i-1].second]--;
+            
+            if (featureOutputPairs[i].first == featureOutputPairs[i-1].first) { continue; }
             
-            double upperEntropyOfSplit = calcSplitEntropy(featureOutputPairs, index, numOutputClasses, true);
-            double lowerEntropyOfSplit = calcSplitEntropy(featureOutputPairs, index, numOutputClasses, false);
+            int numLessThanValueAtSplitPoint = i;
+            int numGreaterThanValueAtSplitPoint = numSamples - i;
+            
+            double upperEntropyOfSplit = calcSplitEntropy(lessThanClassCounts, numLessThanValueAtSplitPoint);
+            double lowerEntropyOfSplit = calcSplitEntropy(greaterThanClassCounts, numGreaterThanValueAtSplitPoint);
             
             double totalEntropy = (numLessThanValueAtSplitPoint * upperEntropyOfSplit + numGreaterThanValueAtSplitPoint * lowerEntropyOfSplit) / (double)numSamples;
-            double intrinsicValue = calcIntrinsicValue(numLessThanValueAtSplitPoint, numGreaterThanValueAtSplitPoint, numSamples);
-            entropies.push_back(totalEntropy);
-            intrinsicValues.push_back(intrinsicValue);
             
+            if (!found || (totalEntropy < minEntropy)) {
+                found = true;
+                minEntropy = totalEntropy;                                                                  // OUTPUT
+                featureSplitValue = featureOutputPairs[i].first;                                            // OUTPUT
+                relatedIntrinsicValue = calcIntrinsicValue(numLessThanValueAtSplitPoint, numGreaterThanValueAtSplitPoint, numSamples);  // OUTPUT
+            }
         }
-                
-        // set output values
-        vector<double>::iterator it = min_element(entropies.begin(), entropies.end());
-        minEntropy = *it;                                                         // OUTPUT
-        minEntropyIndex = (int)(it - entropies.begin());                          // OUTPUT
-        relatedIntrinsicValue = intrinsicValues[minEntropyIndex];                 // OUTPUT
         
         return 0;
     }
@@ -220,28 +218,11 @@ int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > fea
 }
 /**************************************************************************************************/
 
-double AbstractDecisionTree::calcSplitEntropy(vector< pair<int, int> > featureOutputPairs, int splitIndex, int numOutputClasses, bool isUpperSplit = true) {
+double AbstractDecisionTree::calcSplitEntropy(const vector<int>& classCounts, int totalClassCounts) {
     try {
-        vector<int> classCounts(numOutputClasses, 0);
-        
-        if (isUpperSplit) { 
-            for (int i = 0; i < splitIndex; i++) {
-                if (m->control_pressed) { return 0; }
-                classCounts[featureOutputPairs[i].second]++;
-            }
-        } else {
-            for (int i = splitIndex; i < featureOutputPairs.size(); i++) { 
-                if (m->control_pressed) { return 0; }
-                classCounts[featureOutputPairs[i].second]++;
-            }
-        }
-        
-        int totalClassCounts = accumulate(classCounts.begin(), classCounts.end(), 0);
-        
         double splitEntropy = 0.0;
         
         for (int i = 0; i < classCounts.size(); i++) {
-            if (m->control_pressed) { return 0; }
             if (classCounts[i] == 0) { continue; }
             double probability = (double) classCounts[i] / (double) totalClassCounts;
             splitEntropy += -(probability * log2(probability));
@@ -256,28 +237,30 @@ double AbstractDecisionTree::calcSplitEntropy(vector< pair<int, int> > featureOu
 }
 
 /**************************************************************************************************/
-
-int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples){    
+//partitions the node's rows in place, the rows going left first. returns the number of rows going left
+int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector<int>& leftChildClassCounts, vector<int>& rightChildClassCounts){    
     try {
-        // TODO: there is a possibility of optimization if we can recycle the samples in each nodes
-        // we just need to pointers to the samples i.e. vector<int> and use it everywhere and not create the sample 
-        // sample over and over again
-        // we need to make this const so that it is not modified by all the function calling
-        // currently purgeTreeNodesDataRecursively() is used for the same purpose, but this can be avoided altogher
-        // if re-using the same data over the classes
-        
         int splitFeatureGlobalIndex = node->getSplitFeatureIndex();
+        int splitFeatureValue = node->getSplitFeatureValue();
         
-        for (int i = 0; i < node->getBootstrappedTrainingSamples().size(); i++) {
-            if (m->control_pressed) { return 0; }
-            vector<int> sample =  node->getBootstrappedTrainingSamples()[i];
+        leftChildClassCounts.assign(numOutputClasses, 0);
+        rightChildClassCounts.assign(numOutputClasses, 0);
+        
+        int numLeft = 0;
+        int start = node->getSampleStart();
+        for (int i = start; i < start + node->getNumSamples(); i++) {
             if (m->control_pressed) { return 0; }
+            int row = bootstrappedTrainingSampleRows[i];
             
-            if (sample[splitFeatureGlobalIndex] < node->getSplitFeatureValue()) { leftChildSamples.push_back(sample); }
-            else { rightChildSamples.push_back(sample); }
+            if (baseDataSet[row][splitFeatureGlobalIndex] < splitFeatureValue) {
+                leftChildClassCounts[baseDataSet[row][numFeatures]]++;
+                swap(bootstrappedTrainingSampleRows[i], bootstrappedTrainingSampleRows[start + numLeft]);
+                numLeft++;
+            }
+            else { rightChildClassCounts[baseDataSet[row][numFeatures]]++; }
         }
         
-        return 0;
+        return numLeft;
     }
 	catch(exception& e) {
 		m->errorOut(e, "AbstractDecisionTree", "getSplitPopulation");
@@ -285,22 +268,17 @@ int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<in
 	} 
 }
 /**************************************************************************************************/
-// TODO: checkIfAlreadyClassified() verify code
-// TODO: use bootstrappedOutputVector for easier calculation instead of using getBootstrappedTrainingSamples()
 bool AbstractDecisionTree::checkIfAlreadyClassified(RFTreeNode* treeNode, int& outputClass) {
     try {
-
-        vector<int> tempOutputClasses;
-        for (int i = 0; i < treeNode->getBootstrappedTrainingSamples().size(); i++) {
-            if (m->control_pressed) { return 0; }
-            int sampleOutputClass = treeNode->getBootstrappedTrainingSamples()[i][numFeatures];
-            vector<int>::iterator it = find(tempOutputClasses.begin(), tempOutputClasses.end(), sampleOutputClass);
-            if (it == tempOutputClasses.end()) {               // NOT FOUND
-                tempOutputClasses.push_back(sampleOutputClass);
-            }
+        const vector<int>& classCounts = treeNode->getClassCounts();
+        
+        int numClassesPresent = 0;
+        outputClass = -1;
+        for (int i = 0; i < classCounts.size(); i++) {
+            if (classCounts[i] > 0) { numClassesPresent++; outputClass = i; }
         }
         
-        if (tempOutputClasses.size() < 2) { outputClass = tempOutputClasses[0]; return true; }
+        if (numClassesPresent < 2) { return true; }
         else { outputClass = -1; return false; }
         
     }
@@ -311,4 +289,3 @@ bool AbstractDecisionTree::checkIfAlreadyClassified(RFTreeNode* treeNode, int& o
 }
 
 /**************************************************************************************************/
-
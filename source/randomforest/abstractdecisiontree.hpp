@@ -32,20 +32,22 @@ public:
     AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                            vector<int> globalDiscardedFeatureIndices, 
                            OptimumFeatureSubsetSelector optimumFeatureSubsetSelector, 
-                           string treeSplitCriterion);    
+                           string treeSplitCriterion,
+                           const vector< vector<int> >* presortedRows = NULL);
     virtual ~AbstractDecisionTree(){}
     
   
 protected:
   
     virtual int createBootStrappedSamples();
-    virtual int getMinEntropyOfFeature(vector<int> featureVector, vector<int> outputVector, double& minEntropy, int& featureSplitValue, double& intrinsicValue);
-        virtual int getBestSplitAndMinEntropy(vector< pair<int, int> > featureOutputPairs, vector<int> splitPoints, double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue);
+    virtual int getMinEntropyOfFeature(RFTreeNode* node, int featureIndex, double& minEntropy, int& featureSplitValue, double& intrinsicValue);
+    virtual int getBestSplitAndMinEntropy(const vector< pair<int, int> >& featureOutputPairs, double& minEntropy, int& featureSplitValue, double& relatedIntrinsicValue);
     virtual double calcIntrinsicValue(int numLessThanValueAtSplitPoint, int numGreaterThanValueAtSplitPoint, int numSamples);
-    virtual double calcSplitEntropy(vector< pair<int, int> > featureOutputPairs, int splitIndex, int numOutputClasses, bool);
+    virtual double calcSplitEntropy(const vector<int>& classCounts, int totalClassCounts);
 
-    virtual int getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples);
+    virtual int getSplitPopulation(RFTreeNode* node, vector<int>& leftChildClassCounts, vector<int>& rightChildClassCounts);
     virtual bool checkIfAlreadyClassified(RFTreeNode* treeNode, int& outputClass);
+    void countNodeRows(RFTreeNode* node, int increment);
 
     vector< vector<int> >& baseDataSet;
     int numSamples;
@@ -53,12 +55,14 @@ protected:
     int numOutputClasses;
     vector<int> outputClasses;
     
-    vector< vector<int> > bootstrappedTrainingSamples;
-    vector<int> bootstrappedTrainingSampleIndices;
-    vector< vector<int> > bootstrappedTestSamples;
-    vector<int> bootstrappedTestSampleIndices;
+    vector<int> bootstrappedTrainingSampleRows;     //rows of baseDataSet drawn for training, with repeats. each node owns a range of it
+    vector<int> bootstrappedTrainingSampleIndices;  //rows drawn at least once
+    vector<int> bootstrappedTestSampleIndices;      //out of bag rows
     
-    vector<vector<int> > testSampleFeatureVectors;
+    const vector< vector<int> >* presortedRows;     //rows of baseDataSet sorted by each feature, NULL to sort at every node
+    vector<int> nodeRowCounts;                      //times each row is in the node being split, used with presortedRows
+    vector< pair<int, int> > featureOutputPairs;
+    vector<bool> isGlobalDiscarded;
     
     RFTreeNode* rootNode;
     int nodeIdCount;
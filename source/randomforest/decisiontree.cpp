@@ -12,12 +12,15 @@ DecisionTree::DecisionTree(vector< vector<int> >& baseDataSet,
                            vector<int> globalDiscardedFeatureIndices,
                            OptimumFeatureSubsetSelector optimumFeatureSubsetSelector,
                            string treeSplitCriterion,
-                           float featureStandardDeviationThreshold)
+                           float featureStandardDeviationThreshold,
+                           const vector< vector<int> >* presortedRows)
             : AbstractDecisionTree(baseDataSet,
                                    globalDiscardedFeatureIndices,
                                    optimumFeatureSubsetSelector,
-                                   treeSplitCriterion),
+                                   treeSplitCriterion,
+                                   presortedRows),
             variableImportanceList(numFeatures, 0),
+            featureCheckedAtNode(numFeatures, -1),
             featureStandardDeviationThreshold(featureStandardDeviationThreshold) {
                 
     try {
@@ -35,38 +38,35 @@ DecisionTree::DecisionTree(vector< vector<int> >& baseDataSet,
 
 int DecisionTree::calcTreeVariableImportanceAndError(int& numCorrect, double& treeErrorRate) {
     try {
-        vector< vector<int> > randomlySampledTestData(bootstrappedTestSamples.size(), vector<int>(bootstrappedTestSamples[0].size(), 0));
+        if (bootstrappedTestSampleIndices.size() == 0) { return 0; }
         
-            // TODO: is is possible to further speed up the following O(N^2) by using std::copy?
-        for (int i = 0; i < bootstrappedTestSamples.size(); i++) {
-            for (int j = 0; j < bootstrappedTestSamples[i].size(); j++) {
-                randomlySampledTestData[i][j] = bootstrappedTestSamples[i][j];
-            }
-        }
+        // shuffling a feature the tree never splits on can't change a prediction, so only the split features are tried
+        set<int> splitFeatures;
+        getSplitFeatures(rootNode, splitFeatures);
         
-        for (int i = 0; i < numFeatures; i++) {
+        for (set<int>::iterator itFeature = splitFeatures.begin(); itFeature != splitFeatures.end(); itFeature++) {
             if (m->control_pressed) { return 0; }
+            int i = *itFeature;
             
                 // if the index is in globalDiscardedFeatureIndices (i.e, null feature) we don't want to shuffle them
-            vector<int>::iterator it = find(globalDiscardedFeatureIndices.begin(), globalDiscardedFeatureIndices.end(), i);
-            if (it == globalDiscardedFeatureIndices.end()) {        // NOT FOUND
+            if (!isGlobalDiscarded[i]) {
                 // if the standard deviation is very low, we know it's not a good feature at all
                 // we can save some time here by discarding that feature
                 
-                vector<int> featureVector = testSampleFeatureVectors[i];
+                vector<int> featureVector(bootstrappedTestSampleIndices.size(), 0);
+                for (int j = 0; j < bootstrappedTestSampleIndices.size(); j++) { featureVector[j] = baseDataSet[bootstrappedTestSampleIndices[j]][i]; }
+                
                 if (m->getStandardDeviation(featureVector) > featureStandardDeviationThreshold) {
                     // NOTE: only shuffle the features, never shuffle the output vector
-                    // so i = 0 and i will be alwaays <= (numFeatures - 1) as the index at numFeatures will denote
-                    // the feature vector
-                    randomlyShuffleAttribute(bootstrappedTestSamples, i, i - 1, randomlySampledTestData);
+                    random_shuffle(featureVector.begin(), featureVector.end());
 
                     int numCorrectAfterShuffle = 0;
-                    for (int j = 0; j < randomlySampledTestData.size(); j++) {
+                    for (int j = 0; j < bootstrappedTestSampleIndices.size(); j++) {
                         if (m->control_pressed) {return 0; }
                         
-                        vector<int> shuffledSample = randomlySampledTestData[j];
-                        int actualSampleOutputClass = shuffledSample[numFeatures];
-                        int predictedSampleOutputClass = evaluateSample(shuffledSample);
+                        const vector<int>& testSample = baseDataSet[bootstrappedTestSampleIndices[j]];
+                        int actualSampleOutputClass = testSample[numFeatures];
+                        int predictedSampleOutputClass = evaluateSample(testSample, i, featureVector[j]);
                         if (actualSampleOutputClass == predictedSampleOutputClass) { numCorrectAfterShuffle++; }
                     }
                     variableImportanceList[i] += (numCorrect - numCorrectAfterShuffle);
@@ -100,20 +100,23 @@ int DecisionTree::calcTreeVariableImportanceAndError(int& numCorrect, double& tr
 }
 /***********************************************************************/
 
-// TODO: there must be a way to optimize this function
-int DecisionTree::evaluateSample(vector<int> testSample) {
+int DecisionTree::evaluateSample(const vector<int>& testSample) {
+    return evaluateSample(testSample, -1, 0);
+}
+/***********************************************************************/
+//evaluates testSample as if its value for shuffledFeatureIndex were shuffledFeatureValue
+int DecisionTree::evaluateSample(const vector<int>& testSample, int shuffledFeatureIndex, int shuffledFeatureValue) {
     try {
         RFTreeNode *node = rootNode;
-        while (true) {
-            if (m->control_pressed) { return 0; }
+        while (!node->checkIsLeaf()) {
+            int splitFeatureIndex = node->getSplitFeatureIndex();
+            int sampleSplitFeatureValue = testSample[splitFeatureIndex];
+            if (splitFeatureIndex == shuffledFeatureIndex) { sampleSplitFeatureValue = shuffledFeatureValue; }
             
-            if (node->checkIsLeaf()) { return node->getOutputClass(); }
-            
-            int sampleSplitFeatureValue = testSample[node->getSplitFeatureIndex()];
             if (sampleSplitFeatureValue < node->getSplitFeatureValue()) { node = node->getLeftChildNode(); }
             else { node = node->getRightChildNode(); } 
         }
-        return 0;
+        return node->getOutputClass();
     }
 	catch(exception& e) {
 		m->errorOut(e, "DecisionTree", "evaluateSample");
@@ -126,11 +129,14 @@ int DecisionTree::evaluateSample(vector<int> testSample) {
 int DecisionTree::calcTreeErrorRate(int& numCorrect, double& treeErrorRate){
     numCorrect = 0;
     try {
-        for (int i = 0; i < bootstrappedTestSamples.size(); i++) {
+        treeErrorRate = 0.0;
+        if (bootstrappedTestSampleIndices.size() == 0) { return 0; } //every sample was drawn for training
+        
+        for (int i = 0; i < bootstrappedTestSampleIndices.size(); i++) {
              if (m->control_pressed) {return 0; }
             
-            vector<int> testSample = bootstrappedTestSamples[i];
             int testSampleIndex = bootstrappedTestSampleIndices[i];
+            const vector<int>& testSample = baseDataSet[testSampleIndex];
             
             int actualSampleOutputClass = testSample[numFeatures];
             int predictedSampleOutputClass = evaluateSample(testSample);
@@ -140,7 +146,7 @@ int DecisionTree::calcTreeErrorRate(int& numCorrect, double& treeErrorRate){
             outOfBagEstimates[testSampleIndex] = predictedSampleOutputClass;
         }
         
-        treeErrorRate = 1 - ((double)numCorrect / (double)bootstrappedTestSamples.size());   
+        treeErrorRate = 1 - ((double)numCorrect / (double)bootstrappedTestSampleIndices.size());   
         
         return 0;
     }
@@ -151,60 +157,30 @@ int DecisionTree::calcTreeErrorRate(int& numCorrect, double& treeErrorRate){
 }
 
 /***********************************************************************/
-// TODO: optimize the algo, instead of transposing two time, we can extarct the feature,
-// shuffle it and then re-insert in the original place, thus iproving runnting time
-//This function randomize abundances for a given OTU/feature.
 
-void DecisionTree::randomlyShuffleAttribute(const vector< vector<int> >& samples,
-                               const int featureIndex,
-                               const int prevFeatureIndex,
-                               vector< vector<int> >& shuffledSample) {
+void DecisionTree::getSplitFeatures(RFTreeNode* treeNode, set<int>& splitFeatures) {
     try {
-        // NOTE: we need (numFeatures + 1) featureVecotors, the last extra vector is actually outputVector
-        
-        // restore previously shuffled feature
-        if (prevFeatureIndex > -1) {
-            for (int j = 0; j < samples.size(); j++) {
-                if (m->control_pressed) { return; }
-                shuffledSample[j][prevFeatureIndex] = samples[j][prevFeatureIndex];
-            }
-        }
-        
-        // now do the shuffling
-        vector<int> featureVectors(samples.size(), 0);
-        for (int j = 0; j < samples.size(); j++) {
-            if (m->control_pressed) { return; }
-            featureVectors[j] = samples[j][featureIndex];
-        }
-        random_shuffle(featureVectors.begin(), featureVectors.end());
-        for (int j = 0; j < samples.size(); j++) {
-            if (m->control_pressed) { return; }
-            shuffledSample[j][featureIndex] = featureVectors[j];
-        }
+        if (treeNode == NULL || treeNode->checkIsLeaf()) { return; }
+        splitFeatures.insert(treeNode->getSplitFeatureIndex());
+        getSplitFeatures(treeNode->getLeftChildNode(), splitFeatures);
+        getSplitFeatures(treeNode->getRightChildNode(), splitFeatures);
     }
 	catch(exception& e) {
-        m->errorOut(e, "DecisionTree", "randomlyShuffleAttribute");
+		m->errorOut(e, "DecisionTree", "getSplitFeatures");
 		exit(1);
-	}
-    
+	} 
 }
-
 /***********************************************************************/
 
-int DecisionTree::purgeTreeNodesDataRecursively(RFTreeNode* treeNode) {
+void DecisionTree::purgeDataSetsFromTree() {
     try {
-        treeNode->bootstrappedTrainingSamples.clear();
-        treeNode->bootstrappedFeatureVectors.clear();
-        treeNode->bootstrappedOutputVector.clear();
-        treeNode->localDiscardedFeatureIndices.clear();
-        treeNode->globalDiscardedFeatureIndices.clear();
-        
-        if (treeNode->leftChildNode != NULL) { purgeTreeNodesDataRecursively(treeNode->leftChildNode); }
-        if (treeNode->rightChildNode != NULL) { purgeTreeNodesDataRecursively(treeNode->rightChildNode); }
-        return 0;
+        bootstrappedTrainingSampleRows.clear();
+        featureOutputPairs.clear();
+        nodeRowCounts.clear();
+        featureCheckedAtNode.clear();
     }
 	catch(exception& e) {
-		m->errorOut(e, "DecisionTree", "purgeTreeNodesDataRecursively");
+		m->errorOut(e, "DecisionTree", "purgeDataSetsFromTree");
 		exit(1);
 	} 
 }
@@ -214,7 +190,10 @@ void DecisionTree::buildDecisionTree(){
     try {
     
         int generation = 0;
-        rootNode = new RFTreeNode(bootstrappedTrainingSamples, globalDiscardedFeatureIndices, numFeatures, numSamples, numOutputClasses, generation, nodeIdCount, featureStandardDeviationThreshold);
+        vector<int> classCounts(numOutputClasses, 0);
+        for (int i = 0; i < bootstrappedTrainingSampleRows.size(); i++) { classCounts[baseDataSet[bootstrappedTrainingSampleRows[i]][numFeatures]]++; }
+        
+        rootNode = new RFTreeNode(0, (int)bootstrappedTrainingSampleRows.size(), classCounts, numFeatures, numOutputClasses, generation, nodeIdCount, featureStandardDeviationThreshold);
         nodeIdCount++;
         
         splitRecursively(rootNode);
@@ -233,7 +212,7 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
        
         if (rootNode->getNumSamples() < 2){
             rootNode->setIsLeaf(true);
-            rootNode->setOutputClass(rootNode->getBootstrappedTrainingSamples()[0][rootNode->getNumFeatures()]);
+            rootNode->setOutputClass(baseDataSet[bootstrappedTrainingSampleRows[rootNode->getSampleStart()]][numFeatures]);
             return 0;
         }
         
@@ -245,11 +224,17 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
             return 0;
         }
         if (m->control_pressed) { return 0; }
-        vector<int> featureSubsetIndices = selectFeatureSubsetRandomly(globalDiscardedFeatureIndices, rootNode->getLocalDiscardedFeatureIndices());
+        vector<int> featureSubsetIndices = selectFeatureSubsetRandomly(rootNode);
+        if (m->control_pressed) { return 0; }
+        
+        // every feature is constant in this node so it can't be split
+        if (featureSubsetIndices.size() == 0) {
+            rootNode->setIsLeaf(true);
+            updateOutputClassOfNode(rootNode);
+            return 0;
+        }
         
-            // TODO: need to check if the value is actually copied correctly
         rootNode->setFeatureSubsetIndices(featureSubsetIndices);
-        if (m->control_pressed) { return 0; }
       
         findAndUpdateBestFeatureToSplitOn(rootNode);
         
@@ -259,16 +244,16 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
         
         if (m->control_pressed) { return 0; }
         
-        vector< vector<int> > leftChildSamples;
-        vector< vector<int> > rightChildSamples;
-        getSplitPopulation(rootNode, leftChildSamples, rightChildSamples);
+        vector<int> leftChildClassCounts;
+        vector<int> rightChildClassCounts;
+        int numLeftChildSamples = getSplitPopulation(rootNode, leftChildClassCounts, rightChildClassCounts);
+        int numRightChildSamples = rootNode->getNumSamples() - numLeftChildSamples;
         
         if (m->control_pressed) { return 0; }
         
-        // TODO: need to write code to clear this memory
-        RFTreeNode* leftChildNode = new RFTreeNode(leftChildSamples, globalDiscardedFeatureIndices, numFeatures, (int)leftChildSamples.size(), numOutputClasses, rootNode->getGeneration() + 1, nodeIdCount, featureStandardDeviationThreshold);
+        RFTreeNode* leftChildNode = new RFTreeNode(rootNode->getSampleStart(), numLeftChildSamples, leftChildClassCounts, numFeatures, numOutputClasses, rootNode->getGeneration() + 1, nodeIdCount, featureStandardDeviationThreshold);
         nodeIdCount++;
-        RFTreeNode* rightChildNode = new RFTreeNode(rightChildSamples, globalDiscardedFeatureIndices, numFeatures, (int)rightChildSamples.size(), numOutputClasses, rootNode->getGeneration() + 1, nodeIdCount, featureStandardDeviationThreshold);
+        RFTreeNode* rightChildNode = new RFTreeNode(rootNode->getSampleStart() + numLeftChildSamples, numRightChildSamples, rightChildClassCounts, numFeatures, numOutputClasses, rootNode->getGeneration() + 1, nodeIdCount, featureStandardDeviationThreshold);
         nodeIdCount++;
         
         rootNode->setLeftChildNode(leftChildNode);
@@ -295,10 +280,6 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
 int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
     try {
 
-        vector< vector<int> > bootstrappedFeatureVectors = node->getBootstrappedFeatureVectors();
-        if (m->control_pressed) { return 0; }
-        vector<int> bootstrappedOutputVector = node->getBootstrappedOutputVector();
-        if (m->control_pressed) { return 0; }
         vector<int> featureSubsetIndices = node->getFeatureSubsetIndices();
         if (m->control_pressed) { return 0; }
         
@@ -307,6 +288,7 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
         vector<double> featureSubsetIntrinsicValues;
         vector<double> featureSubsetGainRatios;
         
+        countNodeRows(node, 1);
         for (int i = 0; i < featureSubsetIndices.size(); i++) {
             if (m->control_pressed) { return 0; }
             
@@ -316,8 +298,8 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
             int featureSplitValue;
             double featureIntrinsicValue;
             
-            getMinEntropyOfFeature(bootstrappedFeatureVectors[tryIndex], bootstrappedOutputVector, featureMinEntropy, featureSplitValue, featureIntrinsicValue);
-            if (m->control_pressed) { return 0; }
+            getMinEntropyOfFeature(node, tryIndex, featureMinEntropy, featureSplitValue, featureIntrinsicValue);
+            if (m->control_pressed) { countNodeRows(node, -1); return 0; }
             
             featureSubsetEntropies.push_back(featureMinEntropy);
             featureSubsetSplitValues.push_back(featureSplitValue);
@@ -329,6 +311,8 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
             
         }
         
+        countNodeRows(node, -1);
+        
         vector<double>::iterator minEntropyIterator = min_element(featureSubsetEntropies.begin(), featureSubsetEntropies.end());
         vector<double>::iterator maxGainRatioIterator = max_element(featureSubsetGainRatios.begin(), featureSubsetGainRatios.end());
         double featureMinEntropy = *minEntropyIterator;
@@ -368,40 +352,32 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
 	} 
 }
 /***********************************************************************/
-vector<int> DecisionTree::selectFeatureSubsetRandomly(vector<int> globalDiscardedFeatureIndices, vector<int> localDiscardedFeatureIndices){
+//draws features until it has optimumFeatureSubsetSize of them or has looked at every feature. a feature is checked for
+//being constant in the node only when it is drawn, instead of checking every feature at every node
+vector<int> DecisionTree::selectFeatureSubsetRandomly(RFTreeNode* node){
     try {
 
         vector<int> featureSubsetIndices;
         
-        vector<int> combinedDiscardedFeatureIndices;
-        combinedDiscardedFeatureIndices.insert(combinedDiscardedFeatureIndices.end(), globalDiscardedFeatureIndices.begin(), globalDiscardedFeatureIndices.end());
-        combinedDiscardedFeatureIndices.insert(combinedDiscardedFeatureIndices.end(), localDiscardedFeatureIndices.begin(), localDiscardedFeatureIndices.end());
-        
-        sort(combinedDiscardedFeatureIndices.begin(), combinedDiscardedFeatureIndices.end());
-        
-        int numberOfRemainingSuitableFeatures = (int)(numFeatures - combinedDiscardedFeatureIndices.size());
-        int currentFeatureSubsetSize = numberOfRemainingSuitableFeatures < optimumFeatureSubsetSize ? numberOfRemainingSuitableFeatures : optimumFeatureSubsetSize;
+        int numberOfRemainingFeatures = numFeatures - (int)globalDiscardedFeatureIndices.size();
+        int numChecked = 0;
         
-        while (featureSubsetIndices.size() < currentFeatureSubsetSize) {
+        while ((featureSubsetIndices.size() < optimumFeatureSubsetSize) && (numChecked < numberOfRemainingFeatures)) {
             
             if (m->control_pressed) { return featureSubsetIndices; }
             
             // TODO: optimize rand() call here
             int randomIndex = rand() % numFeatures;
-            vector<int>::iterator it = find(featureSubsetIndices.begin(), featureSubsetIndices.end(), randomIndex);
-            if (it == featureSubsetIndices.end()){    // NOT FOUND
-                vector<int>::iterator it2 = find(combinedDiscardedFeatureIndices.begin(), combinedDiscardedFeatureIndices.end(), randomIndex);
-                if (it2 == combinedDiscardedFeatureIndices.end()){  // NOT FOUND AGAIN
-                    featureSubsetIndices.push_back(randomIndex);
-                }
-            }
+            if (isGlobalDiscarded[randomIndex]) { continue; }
+            if (featureCheckedAtNode[randomIndex] == node->nodeId) { continue; } //already picked or discarded for this node
+            
+            featureCheckedAtNode[randomIndex] = node->nodeId;
+            numChecked++;
+            
+            if (!isLocallyDiscarded(node, randomIndex)) { featureSubsetIndices.push_back(randomIndex); }
         }
         sort(featureSubsetIndices.begin(), featureSubsetIndices.end());
         
-        //#ifdef DEBUG_LEVEL_3
-        //    PRINT_VAR(featureSubsetIndices);
-        //#endif
-        
         return featureSubsetIndices;
     }
 	catch(exception& e) {
@@ -410,6 +386,23 @@ vector<int> DecisionTree::selectFeatureSubsetRandomly(vector<int> globalDiscarde
 	} 
 }
 /***********************************************************************/
+//a feature whose standard deviation in the node is at or below the threshold can't split the node usefully
+bool DecisionTree::isLocallyDiscarded(RFTreeNode* node, int featureIndex){
+    try {
+        int start = node->getSampleStart();
+        vector<int> featureVector(node->getNumSamples(), 0);
+        for (int i = 0; i < featureVector.size(); i++) { featureVector[i] = baseDataSet[bootstrappedTrainingSampleRows[start + i]][featureIndex]; }
+        
+        double standardDeviation = m->getStandardDeviation(featureVector);
+        if (standardDeviation <= featureStandardDeviationThreshold) { return true; }
+        return false;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DecisionTree", "isLocallyDiscarded");
+		exit(1);
+	} 
+}
+/***********************************************************************/
 
 // TODO: printTree() needs a check if correct
 int DecisionTree::printTree(RFTreeNode* treeNode, string caption){
@@ -452,11 +445,10 @@ void DecisionTree::deleteTreeNodesRecursively(RFTreeNode* treeNode) {
 void DecisionTree::pruneTree(double pruneAggressiveness = 0.9) {
     
     // find out the number of misclassification by each of the nodes
-    for (int i = 0; i < bootstrappedTestSamples.size(); i++) {
+    for (int i = 0; i < bootstrappedTestSampleIndices.size(); i++) {
         if (m->control_pressed) { return; }
         
-        vector<int> testSample = bootstrappedTestSamples[i];
-        updateMisclassificationCountRecursively(rootNode, testSample);
+        updateMisclassificationCountRecursively(rootNode, baseDataSet[bootstrappedTestSampleIndices[i]]);
     }
     
     // do the actual pruning
@@ -490,7 +482,7 @@ void DecisionTree::pruneRecursively(RFTreeNode* treeNode, double pruneAggressive
 }
 /***********************************************************************/
 
-void DecisionTree::updateMisclassificationCountRecursively(RFTreeNode* treeNode, vector<int> testSample) {
+void DecisionTree::updateMisclassificationCountRecursively(RFTreeNode* treeNode, const vector<int>& testSample) {
     
     int actualSampleOutputClass = testSample[numFeatures];
     int nodePredictedOutputClass = treeNode->outputClass;
@@ -517,15 +509,11 @@ void DecisionTree::updateMisclassificationCountRecursively(RFTreeNode* treeNode,
 /***********************************************************************/
 
 void DecisionTree::updateOutputClassOfNode(RFTreeNode* treeNode) {
-    vector<int> counts(numOutputClasses, 0);
-    for (int i = 0; i < treeNode->bootstrappedOutputVector.size(); i++) {
-        int bootstrappedOutput = treeNode->bootstrappedOutputVector[i];
-        counts[bootstrappedOutput]++;
-    }
+    const vector<int>& counts = treeNode->getClassCounts();
 
-    vector<int>::iterator majorityVotedOutputClassCountIterator = max_element(counts.begin(), counts.end());
+    vector<int>::const_iterator majorityVotedOutputClassCountIterator = max_element(counts.begin(), counts.end());
     int majorityVotedOutputClassCount = *majorityVotedOutputClassCountIterator;
-    vector<int>::iterator it = find(counts.begin(), counts.end(), majorityVotedOutputClassCount);
+    vector<int>::const_iterator it = find(counts.begin(), counts.end(), majorityVotedOutputClassCount);
     int majorityVotedOutputClass = (int)(it - counts.begin());
     treeNode->setOutputClass(majorityVotedOutputClass);
 
@@ -37,25 +37,21 @@ public:
                  vector<int> globalDiscardedFeatureIndices,
                  OptimumFeatureSubsetSelector optimumFeatureSubsetSelector,
                  string treeSplitCriterion,
-                 float featureStandardDeviationThreshold);
+                 float featureStandardDeviationThreshold,
+                 const vector< vector<int> >* presortedRows = NULL);
     
     virtual ~DecisionTree(){ deleteTreeNodesRecursively(rootNode); }
     
     int calcTreeVariableImportanceAndError(int& numCorrect, double& treeErrorRate);
-    int evaluateSample(vector<int> testSample);
+    int evaluateSample(const vector<int>& testSample);
+    int evaluateSample(const vector<int>& testSample, int shuffledFeatureIndex, int shuffledFeatureValue);
     int calcTreeErrorRate(int& numCorrect, double& treeErrorRate);
     
-    void randomlyShuffleAttribute(const vector< vector<int> >& samples,
-                                  const int featureIndex,
-                                  const int prevFeatureIndex,
-                                  vector< vector<int> >& shuffledSample);
-    
-    void purgeDataSetsFromTree() { purgeTreeNodesDataRecursively(rootNode); }
-    int purgeTreeNodesDataRecursively(RFTreeNode* treeNode);
+    void purgeDataSetsFromTree();
     
     void pruneTree(double pruneAggressiveness);
     void pruneRecursively(RFTreeNode* treeNode, double pruneAggressiveness);
-    void updateMisclassificationCountRecursively(RFTreeNode* treeNode, vector<int> testSample);
+    void updateMisclassificationCountRecursively(RFTreeNode* treeNode, const vector<int>& testSample);
     void updateOutputClassOfNode(RFTreeNode* treeNode);
     
     
@@ -64,12 +60,15 @@ private:
     void buildDecisionTree();
     int splitRecursively(RFTreeNode* rootNode);
     int findAndUpdateBestFeatureToSplitOn(RFTreeNode* node);
-    vector<int> selectFeatureSubsetRandomly(vector<int> globalDiscardedFeatureIndices, vector<int> localDiscardedFeatureIndices);
+    vector<int> selectFeatureSubsetRandomly(RFTreeNode* node);
+    bool isLocallyDiscarded(RFTreeNode* node, int featureIndex);
+    void getSplitFeatures(RFTreeNode* treeNode, set<int>& splitFeatures);
     int printTree(RFTreeNode* treeNode, string caption);
     void deleteTreeNodesRecursively(RFTreeNode* treeNode);
     
     vector<int> variableImportanceList;
     map<int, int> outOfBagEstimates;
+    vector<int> featureCheckedAtNode;      //id of the last node selectFeatureSubsetRandomly looked at each feature for
   
     float featureStandardDeviationThreshold;
 };
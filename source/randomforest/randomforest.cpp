@@ -18,8 +18,10 @@ RandomForest::RandomForest(const vector <vector<int> > dataSet,
                            const bool discardHighErrorTrees = true,
                            const float highErrorTreeDiscardThreshold = 0.4,
                            const string optimumFeatureSubsetSelectionCriteria = "log2",
-                           const float featureStandardDeviationThreshold = 0.0)
-            : Forest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold) {
+                           const float featureStandardDeviationThreshold = 0.0,
+                           const int processors)
+            : Forest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold),
+            processors(processors) {
     m = MothurOut::getInstance();
 }
 
@@ -140,19 +142,7 @@ int RandomForest::getMissclassifications(string filename, map<int, string> intTo
 int RandomForest::calcForrestVariableImportance(string filename) {
     try {
     
-        // follow the link: http://en.wikipedia.org/wiki/Dynamic_cast
-        //if you are going to dynamically cast, aren't you undoing the advantage of abstraction. Why abstract at all?
-        //could cause maintenance issues later if other types of Abstract decison trees are created that cannot be cast as a decision tree.
-        for (int i = 0; i < decisionTrees.size(); i++) {
-            if (m->control_pressed) { return 0; }
-            
-            DecisionTree* decisionTree = dynamic_cast<DecisionTree*>(decisionTrees[i]);
-            
-            for (int j = 0; j < numFeatures; j++) {
-                globalVariableImportanceList[j] += (double)decisionTree->variableImportanceList[j];
-            }
-        }
-        
+        //populateDecisionTrees added up the importance of the trees it kept
         for (int i = 0;  i < numFeatures; i++) {
             globalVariableImportanceList[i] /= (double)numDecisionTrees;
         }
@@ -196,13 +186,131 @@ int RandomForest::populateDecisionTrees() {
         
         vector<double> errorRateImprovements;
         
-        for (int i = 0; i < numDecisionTrees; i++) {
+        presortFeatures();
+        if (m->control_pressed) { return 0; }
+        
+        //each tree gets its own seed so the forest is the same no matter how many processors build it
+        vector<unsigned int> seeds(numDecisionTrees, 0);
+        for (int i = 0; i < numDecisionTrees; i++) { seeds[i] = rand(); }
+        
+        if (processors > numDecisionTrees) { processors = numDecisionTrees; }
+        if (processors < 1) { processors = 1; }
+        
+        //divide the trees between the processors
+        vector<int> startTree, endTree;
+        int numTreesPerProcessor = numDecisionTrees / processors;
+        for (int i = 0; i < processors; i++) {
+            startTree.push_back(i * numTreesPerProcessor);
+            if (i == (processors - 1)) { endTree.push_back(numDecisionTrees); }
+            else { endTree.push_back((i+1) * numTreesPerProcessor); }
+        }
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        int process = 1;
+        vector<int> processIDS;
+        
+        //loop through and create all the processes you want
+        while (process != processors) {
+            pid_t pid = fork();
+            
+            if (pid > 0) {
+                processIDS.push_back(pid);
+                process++;
+            }else if (pid == 0){
+                //build this process's trees from a clean forest and pass the estimates to the parent
+                globalOutOfBagEstimates.clear();
+                globalVariableImportanceList.assign(numFeatures, 0.0);
+                vector<double> childErrorRateImprovements;
+                
+                driver(startTree[process], endTree[process], seeds, childErrorRateImprovements);
+                
+                writeEstimates(m->getOutputDir() + m->mothurGetpid(process) + ".randomforest.temp", childErrorRateImprovements);
+                exit(0);
+            }else {
+                m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+                exit(0);
+            }
+        }
+        
+        //do my part
+        driver(startTree[0], endTree[0], seeds, errorRateImprovements);
+        
+        //force parent to wait until all the processes are done
+        for (int i=0;i<processIDS.size();i++) {
+            int temp = processIDS[i];
+            wait(&temp);
+        }
+        
+        for (int i = 0; i < processIDS.size(); i++) {
+            string tempFile = m->getOutputDir() + toString(processIDS[i]) + ".randomforest.temp";
+            readEstimates(tempFile, errorRateImprovements);
+            m->mothurRemove(tempFile);
+        }
+#else
+        driver(0, numDecisionTrees, seeds, errorRateImprovements);
+#endif
+        
+        double avgErrorRateImprovement = -1.0;
+        if (errorRateImprovements.size() > 0) {
+            avgErrorRateImprovement = accumulate(errorRateImprovements.begin(), errorRateImprovements.end(), 0.0);
+//            cout << "Total " << avgErrorRateImprovement << " size " << errorRateImprovements.size() << endl;
+            avgErrorRateImprovement /= errorRateImprovements.size();
+        }
+        
+        if (m->debug && doPruning) {
+            m->mothurOut("avgErrorRateImprovement:" + toString(avgErrorRateImprovement) + "\n");
+        }
+        // m->mothurOut("globalOutOfBagEstimates = " + toStringVectorMap(globalOutOfBagEstimates)+ "\n");
+
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "RandomForest", "populateDecisionTrees");
+        exit(1);
+    }  
+}
+/***********************************************************************/
+//sorts the rows by each feature once, so the trees don't sort the samples again at every node
+int RandomForest::presortFeatures() {
+    try {
+        presortedRows.clear();
+        presortedRows.resize(numFeatures);
+        
+        vector<bool> isGlobalDiscarded(numFeatures, false);
+        for (int i = 0; i < globalDiscardedFeatureIndices.size(); i++) { isGlobalDiscarded[globalDiscardedFeatureIndices[i]] = true; }
+        
+        for (int i = 0; i < numFeatures; i++) {
+            if (m->control_pressed) { return 0; }
+            if (isGlobalDiscarded[i]) { continue; } //never split on, left empty
+            
+            presortedRows[i].resize(numSamples, 0);
+            for (int j = 0; j < numSamples; j++) { presortedRows[i][j] = j; }
+            
+            FeatureValueSorter featureValueSorter(dataSet, i);
+            sort(presortedRows[i].begin(), presortedRows[i].end(), featureValueSorter);
+        }
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "RandomForest", "presortFeatures");
+        exit(1);
+    }
+}
+/***********************************************************************/
+int RandomForest::driver(int start, int end, vector<unsigned int>& seeds, vector<double>& errorRateImprovements) {
+    try {
+        
+        for (int i = start; i < end; i++) {
           
             if (m->control_pressed) { return 0; }
             if (((i+1) % 100) == 0) {  m->mothurOut("Creating " + toString(i+1) + " (th) Decision tree\n");  }
+            
+            srand(seeds[i]);
           
-            // TODO: need to first fix if we are going to use pointer based system or anything else
-            DecisionTree* decisionTree = new DecisionTree(dataSet, globalDiscardedFeatureIndices, OptimumFeatureSubsetSelector(optimumFeatureSubsetSelectionCriteria), treeSplitCriterion, featureStandardDeviationThreshold);
+            DecisionTree* decisionTree = new DecisionTree(dataSet, globalDiscardedFeatureIndices, OptimumFeatureSubsetSelector(optimumFeatureSubsetSelectionCriteria), treeSplitCriterion, featureStandardDeviationThreshold, &presortedRows);
           
             if (m->debug && doPruning) {
                 m->mothurOut("Before pruning\n");
@@ -240,47 +348,105 @@ int RandomForest::populateDecisionTrees() {
                 }
             }
             
-            
-            if (discardHighErrorTrees) {
-                if (treeErrorRate < highErrorTreeDiscardThreshold) {
-                    updateGlobalOutOfBagEstimates(decisionTree);
-                    decisionTree->purgeDataSetsFromTree();
-                    decisionTrees.push_back(decisionTree);
-                    if (doPruning) {
-                        errorRateImprovements.push_back(errorRateImprovement);
-                    }
-                } else {
-                    delete decisionTree;
-                }
-            } else {
+            //the forest only needs the estimates and importance of the trees it keeps, so the tree itself is not saved
+            if (!discardHighErrorTrees || (treeErrorRate < highErrorTreeDiscardThreshold)) {
                 updateGlobalOutOfBagEstimates(decisionTree);
-                decisionTree->purgeDataSetsFromTree();
-                decisionTrees.push_back(decisionTree);
+                for (int j = 0; j < numFeatures; j++) {
+                    globalVariableImportanceList[j] += (double)decisionTree->variableImportanceList[j];
+                }
                 if (doPruning) {
                     errorRateImprovements.push_back(errorRateImprovement);
                 }
-            }          
+            }
+            delete decisionTree;
         }
         
-        double avgErrorRateImprovement = -1.0;
-        if (errorRateImprovements.size() > 0) {
-            avgErrorRateImprovement = accumulate(errorRateImprovements.begin(), errorRateImprovements.end(), 0.0);
-//            cout << "Total " << avgErrorRateImprovement << " size " << errorRateImprovements.size() << endl;
-            avgErrorRateImprovement /= errorRateImprovements.size();
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "RandomForest", "driver");
+        exit(1);
+    }  
+}
+/***********************************************************************/
+//used by the child processes to pass their trees' estimates to the parent
+int RandomForest::writeEstimates(string filename, vector<double>& errorRateImprovements) {
+    try {
+        ofstream out;
+        m->openOutputFile(filename, out);
+        out << setprecision(20);
+        
+        out << globalOutOfBagEstimates.size() << endl;
+        for (map<int, vector<int> >::iterator it = globalOutOfBagEstimates.begin(); it != globalOutOfBagEstimates.end(); it++) {
+            out << it->first << '\t' << it->second.size();
+            for (int i = 0; i < it->second.size(); i++) { out << '\t' << it->second[i]; }
+            out << endl;
         }
         
-        if (m->debug && doPruning) {
-            m->mothurOut("avgErrorRateImprovement:" + toString(avgErrorRateImprovement) + "\n");
+        int numImportant = 0;
+        for (int i = 0; i < globalVariableImportanceList.size(); i++) { if (globalVariableImportanceList[i] != 0) { numImportant++; } }
+        out << numImportant << endl;
+        for (int i = 0; i < globalVariableImportanceList.size(); i++) {
+            if (globalVariableImportanceList[i] != 0) { out << i << '\t' << globalVariableImportanceList[i] << endl; }
         }
-        // m->mothurOut("globalOutOfBagEstimates = " + toStringVectorMap(globalOutOfBagEstimates)+ "\n");
-
+        
+        out << errorRateImprovements.size() << endl;
+        for (int i = 0; i < errorRateImprovements.size(); i++) { out << errorRateImprovements[i] << endl; }
+        out.close();
         
         return 0;
     }
     catch(exception& e) {
-        m->errorOut(e, "RandomForest", "populateDecisionTrees");
+        m->errorOut(e, "RandomForest", "writeEstimates");
         exit(1);
-    }  
+    }
+}
+/***********************************************************************/
+//adds a child process's estimates to the forest's
+int RandomForest::readEstimates(string filename, vector<double>& errorRateImprovements) {
+    try {
+        ifstream in;
+        m->openInputFile(filename, in);
+        
+        int numEstimates = 0;
+        in >> numEstimates; m->gobble(in);
+        for (int i = 0; i < numEstimates; i++) {
+            if (m->control_pressed) { break; }
+            int indexOfSample, numClasses;
+            in >> indexOfSample >> numClasses;
+            
+            if (globalOutOfBagEstimates.count(indexOfSample) == 0) {
+                globalOutOfBagEstimates[indexOfSample] = vector<int>(numClasses, 0);
+            }
+            for (int j = 0; j < numClasses; j++) {
+                int count; in >> count;
+                globalOutOfBagEstimates[indexOfSample][j] += count;
+            }
+            m->gobble(in);
+        }
+        
+        int numImportant = 0;
+        in >> numImportant; m->gobble(in);
+        for (int i = 0; i < numImportant; i++) {
+            int featureIndex; double importance;
+            in >> featureIndex >> importance; m->gobble(in);
+            globalVariableImportanceList[featureIndex] += importance;
+        }
+        
+        int numImprovements = 0;
+        in >> numImprovements; m->gobble(in);
+        for (int i = 0; i < numImprovements; i++) {
+            double improvement; in >> improvement; m->gobble(in);
+            errorRateImprovements.push_back(improvement);
+        }
+        in.close();
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "RandomForest", "readEstimates");
+        exit(1);
+    }
 }
 /***********************************************************************/
 // TODO: need to finalize bettween reference and pointer for DecisionTree [partially solved]
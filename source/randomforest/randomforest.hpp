@@ -13,6 +13,20 @@
 #include "forest.h"
 #include "decisiontree.hpp"
 
+/***********************************************************************/
+
+struct FeatureValueSorter {
+    const vector< vector<int> >& dataSet;
+    int featureIndex;
+    
+    FeatureValueSorter(const vector< vector<int> >& d, int f) : dataSet(d), featureIndex(f) {}
+    bool operator() (const int firstRow, const int secondRow) const {
+        return dataSet[firstRow][featureIndex] < dataSet[secondRow][featureIndex];
+    }
+};
+
+/***********************************************************************/
+
 class RandomForest: public Forest {
     
 public:
@@ -25,7 +39,8 @@ public:
                  const bool discardHighErrorTrees,
                  const float highErrorTreeDiscardThreshold,
                  const string optimumFeatureSubsetSelectionCriteria,
-                 const float featureStandardDeviationThreshold);
+                 const float featureStandardDeviationThreshold,
+                 const int processors = 1);
     
     
     //NOTE:: if you are going to dynamically cast, aren't you undoing the advantage of abstraction. Why abstract at all?
@@ -48,6 +63,13 @@ public:
     
 private:
     MothurOut* m;
+    int processors;
+    vector< vector<int> > presortedRows;    //rows of the dataSet sorted by each feature, shared by the trees
+    
+    int presortFeatures();
+    int driver(int, int, vector<unsigned int>&, vector<double>&);   //first tree, last tree, seed of each tree, errorRateImprovements
+    int writeEstimates(string, vector<double>&);
+    int readEstimates(string, vector<double>&);
     
 };
 
@@ -16,10 +16,12 @@ class RFTreeNode{
     
 public:
     
-    RFTreeNode(vector< vector<int> > bootstrappedTrainingSamples,
-               vector<int> globalDiscardedFeatureIndices,
-               int numFeatures,
+    // a node is the range [sampleStart, sampleStart + numSamples) of the tree's bootstrapped sample rows,
+    // the tree partitions the rows in place when it splits a node so the samples are never copied
+    RFTreeNode(int sampleStart,
                int numSamples,
+               vector<int> classCounts,
+               int numFeatures,
                int numOutputClasses,
                int generation,
                int nodeId,
@@ -28,11 +30,7 @@ public:
     virtual ~RFTreeNode(){}
     
     // getters
-    // we need to return const reference so that we have the actual value and not a copy, 
-    // plus we do not modify the value as well
     const int getSplitFeatureIndex() { return splitFeatureIndex; }
-    // TODO: check if this works properly or returs a shallow copy of the data
-    const vector< vector<int> >& getBootstrappedTrainingSamples() { return bootstrappedTrainingSamples; }
     const int getSplitFeatureValue() { return splitFeatureValue; }
     const int getGeneration() { return generation; }
     const bool checkIsLeaf() { return isLeaf; }
@@ -41,11 +39,10 @@ public:
     RFTreeNode* getLeftChildNode() { return leftChildNode; }
     RFTreeNode* getRightChildNode() { return rightChildNode; }
     const int getOutputClass() { return outputClass; }
+    const int getSampleStart() { return sampleStart; }
     const int getNumSamples() { return numSamples; }
     const int getNumFeatures() { return numFeatures; }
-    const vector<int>& getLocalDiscardedFeatureIndices() { return localDiscardedFeatureIndices; }
-    const vector< vector<int> >& getBootstrappedFeatureVectors() { return bootstrappedFeatureVectors; }
-    const vector<int>& getBootstrappedOutputVector() { return bootstrappedOutputVector; }
+    const vector<int>& getClassCounts() { return classCounts; }
     const vector<int>& getFeatureSubsetIndices() { return featureSubsetIndices; }
     const double getOwnEntropy() { return ownEntropy; }
     const int getTestSampleMisclassificationCount() { return testSampleMisclassificationCount; }
@@ -67,15 +64,12 @@ public:
     friend class AbstractDecisionTree;
     
 private:
-    vector<vector<int> > bootstrappedTrainingSamples;
-    vector<int> globalDiscardedFeatureIndices;
-    vector<int> localDiscardedFeatureIndices;
-    vector<vector<int> > bootstrappedFeatureVectors;
-    vector<int> bootstrappedOutputVector;
+    vector<int> classCounts;
     vector<int> featureSubsetIndices;
 
-    int numFeatures;
+    int sampleStart;
     int numSamples;
+    int numFeatures;
     int numOutputClasses;
     int generation;
     bool isLeaf;
@@ -95,7 +89,6 @@ private:
     
     MothurOut* m;
     
-    int createLocalDiscardedFeatureList();
     int updateNodeEntropy();
     
 };
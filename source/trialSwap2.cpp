@@ -4,43 +4,35 @@
 //The sum_of_squares, havel_hakimi and calc_c_score algorithms have been adapted from I. Miklos and J. Podani. 2004. Randomization of presence-absence matrices: comments and new algorithms. Ecology 85:86-92.
 
 
-double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, vector<int> rowtotal, int ncols, int nrows)
+double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, const vector<int>& rowtotal, int ncols, int nrows)
 {
     try {
-        double cscore = 0.0;
+        PackedMatrix packed(co_matrix, ncols, nrows);
+        return calc_c_score(packed, rowtotal);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "calc_c_score");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+double TrialSwap2::calc_c_score (PackedMatrix& co_matrix, const vector<int>& rowtotal)
+{
+    try {
+        double normcscore = 0.0;
         double maxD;
         double D;
-        double normcscore = 0.0;
         int nonzeros = 0;
-        //int ncols = co_matrix[0].size(); int nrows = rowtotal.size();
-        vector<vector<double> > s; s.resize(nrows);
-        for (int i = 0; i < nrows; i++) { s[i].resize(nrows,0.0); }//only fill half the matrix
-        
+        int nrows = co_matrix.nrows;
         
         for(int i=0;i<nrows-1;i++)
         {
-            
+            if (m->control_pressed) { return 0; }
             for(int j=i+1;j<nrows;j++)
             {
-                if (m->control_pressed) { return 0; }
-                for(int k=0;k<ncols;k++)
-                {
-                    if((co_matrix[i][k]==1)&&(co_matrix[j][k]==1)) //if both are 1s ie co-occurrence
-                        s[i][j]++; //s counts co-occurrences
-                }
-                
-                //rowtotal[i] = A, rowtotal[j] = B, ncols = P, s[i][j] = J
-                cscore += (rowtotal[i]-s[i][j])*(rowtotal[j]-s[i][j]);///(nrows*(nrows-1)/2);
-                D = (rowtotal[i]-s[i][j])*(rowtotal[j]-s[i][j]);
-                
-                if(ncols < (rowtotal[i] + rowtotal[j]))
-                {
-                    maxD = (ncols-rowtotal[i])*(ncols-rowtotal[j]);
-                }
-                else
-                {
-                    maxD = rowtotal[i] * rowtotal[j];
-                }
+                //rowtotal[i] = A, rowtotal[j] = B, ncols = P, s = J
+                int s = co_matrix.countCooccurrences(i, j); //s counts co-occurrences
+                D = calc_pair_c_score(rowtotal[i], rowtotal[j], s, co_matrix.ncols, maxD);
                 
                 if(maxD != 0)
                 {
@@ -50,11 +42,8 @@ double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, vector<int> ro
             }
         }
         
-        //cscore = cscore/(double)(nrows*(nrows-1)/2);  //not normalized
         //cout << "normalized c score: " << normcscore/nonzeros << endl;
-        cscore = normcscore/(double)nonzeros;
-
-        return cscore;
+        return normcscore/(double)nonzeros;
     }
     catch(exception& e) {
         m->errorOut(e, "TrialSwap2", "calc_c_score");
@@ -62,37 +51,53 @@ double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, vector<int> ro
     }
 }
 /**************************************************************************************************/
-int TrialSwap2::calc_checker (vector<vector<int> > &co_matrix, vector<int> rowtotal, int ncols, int nrows)
+double TrialSwap2::calc_pair_c_score (int rowtotalI, int rowtotalJ, int s, int ncols, double& maxD)
+{
+    try {
+        double D = (rowtotalI-s)*(rowtotalJ-s);
+        
+        if(ncols < (rowtotalI + rowtotalJ))
+        {
+            maxD = (ncols-rowtotalI)*(ncols-rowtotalJ);
+        }
+        else
+        {
+            maxD = rowtotalI * rowtotalJ;
+        }
+        
+        return D;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "calc_pair_c_score");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int TrialSwap2::calc_checker (vector<vector<int> > &co_matrix, const vector<int>& rowtotal, int ncols, int nrows)
+{
+    try {
+        PackedMatrix packed(co_matrix, ncols, nrows);
+        return calc_checker(packed);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "calc_checker");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int TrialSwap2::calc_checker (PackedMatrix& co_matrix)
 {
     try {
         int cunits=0;
-        //int s[nrows][ncols];
-        //int ncols = co_matrix[0].size(); int nrows = rowtotal.size();
-        vector<vector<int> > s; s.resize(nrows);
-        for (int i = 0; i < nrows; i++) { s[i].resize(nrows,0); }//only fill half the matrix
+        int nrows = co_matrix.nrows;
         
         for(int i=0;i<nrows-1;i++)
         {
+            if (m->control_pressed) { return 0; }
             for(int j=i+1;j<nrows;j++)
             {
-                if (m->control_pressed) { return 0; }
-                //s[i][j]=0;
-                for(int k=0;k<ncols;k++)
-                {
-                    //cout << s[i][j] << endl;
-                    //iterates through the row and counts co-occurrences. The total number of co-occurrences for each row pair is kept in matrix s at location s[i][j].
-                    if((co_matrix[i][k]==1)&&(co_matrix[j][k]==1)) //if both are 1s ie co-occurrence
-                        s[i][j]++; //s counts co-occurrences
-                    
-                }
-                //cout << "rowtotal: " << rowtotal[i] << endl;
-                //cout << "co-occurrences: " << s[i][j] << endl;
-                //cunits+=(rowtotal[i]-s[i][j])*(rowtotal[j]-s[i][j]);
-                if (s[i][j] == 0)
-                {
-                    cunits+=1;
-                }
-                //cunits+=s[i][j];
+                //counts the pairs of rows that never co-occur
+                if (co_matrix.countCooccurrences(i, j) == 0) { cunits+=1; }
             }
         }
         
@@ -104,7 +109,7 @@ int TrialSwap2::calc_checker (vector<vector<int> > &co_matrix, vector<int> rowto
     }
 }
 /**************************************************************************************************/
-double TrialSwap2::calc_vratio (int nrows, int ncols, vector<int> rowtotal, vector<int> columntotal)
+double TrialSwap2::calc_vratio (int nrows, int ncols, const vector<int>& rowtotal, const vector<int>& columntotal)
 {
     try {
         //int nrows = rowtotal.size();
@@ -222,6 +227,167 @@ int TrialSwap2::swap_checkerboards (vector<vector<int> > &co_matrix, int ncols,
     }
 }
 /**************************************************************************************************/
+int TrialSwap2::start_chain (SwapChain& chain, vector<vector<int> > &co_matrix, const vector<int>& rowtotal, int ncols, int nrows)
+{
+    try {
+        chain.matrix = PackedMatrix(co_matrix, ncols, nrows);
+        chain.rowtotal = rowtotal;
+        chain.normCScore = 0.0; chain.nonzeros = 0; chain.checkerUnits = 0;
+        chain.numSwaps = 0; chain.numCalls = 0;
+        chain.pairCooccurrences.clear();
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "start_chain");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//a swap updates 2 * nrows pairs, rescoring counts every pair. uses the swaps per call so far (the burn-in) to pick the faster one
+int TrialSwap2::track_pairs (SwapChain& chain)
+{
+    try {
+        PackedMatrix& co_matrix = chain.matrix;
+        int nrows = co_matrix.nrows;
+        
+        double numPairs = ((double)nrows * (double)(nrows-1)) / 2.0;
+        double swapsPerCall = 1000.0;
+        if (chain.numCalls != 0) { swapsPerCall = chain.numSwaps / (double) chain.numCalls; }
+        
+        double updateCost = swapsPerCall * 2.0 * nrows;
+        double rescoreCost = numPairs * co_matrix.numWords;
+        if (updateCost >= rescoreCost) { return 0; }
+        
+        //past 50 million pairs the counts take too much memory, so the chain rescores the packed matrix instead
+        if (numPairs > 50000000) { return 0; }
+        
+        chain.normCScore = 0.0; chain.nonzeros = 0; chain.checkerUnits = 0;
+        chain.pairCooccurrences.assign((long long)numPairs, 0);
+        for(int i=0;i<nrows-1;i++)
+        {
+            if (m->control_pressed) { return 0; }
+            for(int j=i+1;j<nrows;j++)
+            {
+                int s = co_matrix.countCooccurrences(i, j);
+                chain.pairCooccurrences[chain.pairIndex(i, j)] = s;
+                
+                double maxD;
+                double D = calc_pair_c_score(chain.rowtotal[i], chain.rowtotal[j], s, co_matrix.ncols, maxD);
+                if (maxD != 0) { chain.normCScore += D/maxD; chain.nonzeros++; }
+                if (s == 0) { chain.checkerUnits++; }
+            }
+        }
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "track_pairs");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//same swaps as swap_checkerboards above, the pair counts and scores of the two swapped rows are updated as they happen
+int TrialSwap2::swap_checkerboards (SwapChain& chain)
+{
+    try {
+        PackedMatrix& co_matrix = chain.matrix;
+        int nrows = co_matrix.nrows; int ncols = co_matrix.ncols;
+        bool updatePairs = (chain.pairCooccurrences.size() != 0);
+        
+        for(int a=0;a<1000;a++){
+            int i, j, k, l;
+            i = m->getRandomIndex(nrows-1);
+            while((j = m->getRandomIndex(nrows-1) ) == i ) {;if (m->control_pressed) { return 0; }}
+            k = m->getRandomIndex(ncols-1);
+            while((l = m->getRandomIndex(ncols-1)) == k ) {;if (m->control_pressed) { return 0; }}
+            
+            int ik = co_matrix.get(i, k); int il = co_matrix.get(i, l);
+            int jk = co_matrix.get(j, k); int jl = co_matrix.get(j, l);
+            
+            if((ik*jl==1 && il+jk==0)||(ik+jl==0 && il*jk==1)) //checking for checkerboard value and swap
+            {
+                co_matrix.set(i, k, 1-ik);
+                co_matrix.set(i, l, 1-il);
+                co_matrix.set(j, k, 1-jk);
+                co_matrix.set(j, l, 1-jl);
+                chain.numSwaps++;
+                
+                if (updatePairs) {
+                    if (ik == 1) { update_pairs(chain, i, j, k, l); update_pairs(chain, j, i, l, k); }
+                    else { update_pairs(chain, i, j, l, k); update_pairs(chain, j, i, k, l); }
+                }
+            }
+        }
+        chain.numCalls++;
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "swap_checkerboards");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//row moved from column lost to column gained. its co-occurrences with every row other than the one it swapped with change
+//by that row's difference between the two columns
+int TrialSwap2::update_pairs (SwapChain& chain, int row, int otherRow, int lost, int gained)
+{
+    try {
+        PackedMatrix& co_matrix = chain.matrix;
+        
+        for (int x = 0; x < co_matrix.nrows; x++) {
+            if ((x == row) || (x == otherRow)) { continue; }
+            
+            int change = co_matrix.get(x, gained) - co_matrix.get(x, lost);
+            if (change == 0) { continue; }
+            
+            long long index = (x < row) ? chain.pairIndex(x, row) : chain.pairIndex(row, x);
+            int oldS = chain.pairCooccurrences[index];
+            int newS = oldS + change;
+            chain.pairCooccurrences[index] = newS;
+            
+            double maxD;
+            double oldD = calc_pair_c_score(chain.rowtotal[row], chain.rowtotal[x], oldS, co_matrix.ncols, maxD);
+            double newD = calc_pair_c_score(chain.rowtotal[row], chain.rowtotal[x], newS, co_matrix.ncols, maxD);
+            if (maxD != 0) { chain.normCScore += (newD - oldD)/maxD; }
+            
+            if (oldS == 0) { chain.checkerUnits--; }
+            if (newS == 0) { chain.checkerUnits++; }
+        }
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "update_pairs");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+double TrialSwap2::calc_c_score (SwapChain& chain)
+{
+    try {
+        if (chain.pairCooccurrences.size() == 0) { return calc_c_score(chain.matrix, chain.rowtotal); }
+        return chain.normCScore/(double)chain.nonzeros;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "calc_c_score");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int TrialSwap2::calc_checker (SwapChain& chain)
+{
+    try {
+        if (chain.pairCooccurrences.size() == 0) { return calc_checker(chain.matrix); }
+        return chain.checkerUnits;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "calc_checker");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
 double TrialSwap2::calc_pvalue_greaterthan (vector<double> scorevec, double initialscore)
 {
     try {
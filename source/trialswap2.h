@@ -12,6 +12,54 @@
 
 #include "mothurout.h"
 
+/**************************************************************************************************/
+//presence / absence matrix with each row packed 64 columns to a word, so the co-occurrences of two rows are counted a word at a time
+
+struct PackedMatrix {
+    int nrows, ncols, numWords;
+    vector<unsigned long long> bits;
+    
+    PackedMatrix() : nrows(0), ncols(0), numWords(0) {}
+    PackedMatrix(vector<vector<int> >& matrix, int c, int r) : nrows(r), ncols(c) {
+        numWords = (ncols + 63) / 64;
+        bits.assign(nrows * numWords, 0);
+        for (int i = 0; i < nrows; i++) {
+            for (int k = 0; k < ncols; k++) { if (matrix[i][k] == 1) { set(i, k, 1); } }
+        }
+    }
+    
+    int get(int i, int k) { return (int)((bits[i * numWords + (k >> 6)] >> (k & 63)) & 1ULL); }
+    void set(int i, int k, int value) {
+        if (value == 1) { bits[i * numWords + (k >> 6)] |= (1ULL << (k & 63)); }
+        else { bits[i * numWords + (k >> 6)] &= ~(1ULL << (k & 63)); }
+    }
+    int countCooccurrences(int i, int j) {
+        int count = 0;
+        unsigned long long* rowI = &bits[i * numWords]; unsigned long long* rowJ = &bits[j * numWords];
+        for (int w = 0; w < numWords; w++) { count += __builtin_popcountll(rowI[w] & rowJ[w]); }
+        return count;
+    }
+};
+
+/**************************************************************************************************/
+//a chain of checkerboard swaps. keeps the co-occurrences of every pair of rows and the c score and checker sums,
+//so a swap only updates the pairs involving the two swapped rows instead of rescoring the whole matrix
+
+struct SwapChain {
+    PackedMatrix matrix;
+    vector<int> rowtotal;
+    vector<int> pairCooccurrences;  //upper triangle of the row pairs, empty if there are too many pairs to keep
+    double normCScore;              //sum of D/maxD over the pairs
+    int nonzeros;                   //pairs with maxD != 0
+    int checkerUnits;               //pairs that never co-occur
+    long long numSwaps, numCalls;   //checkerboards swapped and calls to swap_checkerboards
+    
+    SwapChain() : normCScore(0.0), nonzeros(0), checkerUnits(0), numSwaps(0), numCalls(0) {}
+    long long pairIndex(int i, int j) { //i < j
+        return ((long long)i * (long long)matrix.nrows) - (((long long)i * (long long)(i + 1)) / 2) + (long long)(j - i - 1);
+    }
+};
+
 
 class TrialSwap2 {
     
@@ -23,9 +71,17 @@ public:
     double calc_pvalue_greaterthan (vector<double>, double);
     int swap_checkerboards (vector<vector<int> > &, int, int);
     int calc_combo (int, int, vector<vector<int> > &);
-    double calc_vratio (int, int, vector<int>, vector<int>);
-    int calc_checker (vector<vector<int> > &, vector<int>, int, int);
-    double calc_c_score (vector<vector<int> > &, vector<int>, int, int);
+    double calc_vratio (int, int, const vector<int>&, const vector<int>&);
+    int calc_checker (vector<vector<int> > &, const vector<int>&, int, int);
+    double calc_c_score (vector<vector<int> > &, const vector<int>&, int, int);
+    int calc_checker (PackedMatrix&);
+    double calc_c_score (PackedMatrix&, const vector<int>&);
+    
+    int start_chain (SwapChain&, vector<vector<int> > &, const vector<int>&, int, int);   //chain, matrix, rowtotal, ncols, nrows
+    int track_pairs (SwapChain&);   //start updating the scores with each swap, if that is faster than rescoring
+    int swap_checkerboards (SwapChain&);
+    double calc_c_score (SwapChain&);
+    int calc_checker (SwapChain&);
     double get_zscore (double, double, double);
     double getSD (int, vector<double>, double);
     
@@ -34,6 +90,8 @@ private:
     MothurOut* m;
     
     double t_test (double, int, double, vector<double>);
+    double calc_pair_c_score (int, int, int, int, double&);    //rowtotal i, rowtotal j, co-occurrences, ncols. sets maxD
+    int update_pairs (SwapChain&, int, int, int, int);      //chain, row, row it swapped with, column it lost, column it gained
     int print_matrix(vector<vector<int> > &, int, int);
     
     
@@ -562,7 +562,11 @@ void Die(const char *Format, ...)
 	{
 	static bool InDie = false;
 	if (InDie)
+#ifdef UCHIME_LIBRARY
+		throw UchimeFatalError(Format);
+#else
 		exit(1);
+#endif
 	InDie = true;
 	string Msg;
 
@@ -594,6 +598,11 @@ void Die(const char *Format, ...)
 	fprintf(stderr, "\n---Fatal error---\n%s\n", szStr);
 	Log("\n---Fatal error---\n%s\n", szStr);
 
+#ifdef UCHIME_LIBRARY
+	InDie = false;
+	throw UchimeFatalError(Msg);
+#endif
+
 #ifdef _MSC_VER
 	if (IsDebuggerPresent())
  		__debugbreak();
@@ -1172,7 +1181,11 @@ void CmdLineErr(const char *Format, ...)
 	fprintf(stderr, "%s\n", Str.c_str());
 	fprintf(stderr, "For list of command-line options use --help.\n");
 	fprintf(stderr, "\n");
+#ifdef UCHIME_LIBRARY
+	throw UchimeFatalError("Invalid command line: " + Str);
+#else
 	exit(1);
+#endif
 	}
 
 static set<OptInfo>::iterator GetOptInfo(const string &LongName,
@@ -1207,6 +1220,7 @@ static void DefineFlagOpt(const string &LongName, const string &Help,
   void *Value, bool *OptSet)
 	{
 	*(bool *) Value = false;
+	*OptSet = false;
 
 	OptInfo Opt;
 	Opt.Value = Value;
@@ -1222,6 +1236,7 @@ static void DefineTogOpt(const string &LongName, bool Default, const string &Hel
   void *Value, bool *OptSet)
 	{
 	*(bool *) Value = Default;
+	*OptSet = false;
 
 	OptInfo Opt;
 	Opt.Value = Value;
@@ -1237,6 +1252,7 @@ static void DefineIntOpt(const string &LongName, int Default, int Min, int Max,
   const string &Help, void *Value, bool *OptSet)
 	{
 	*(int *) Value = Default;
+	*OptSet = false;
 
 	OptInfo Opt;
 	Opt.Value = Value;
@@ -1254,6 +1270,7 @@ static void DefineUnsOpt(const string &LongName, unsigned Default, unsigned Min,
   unsigned Max, const string &Help, void *Value, bool *OptSet)
 	{
 	*(unsigned *) Value = Default;
+	*OptSet = false;
 
 	OptInfo Opt;
 	Opt.Value = Value;
@@ -1271,6 +1288,7 @@ static void DefineFloatOpt(const string &LongName, double Default, double Min,
   double Max, const string &Help, void *Value, bool *OptSet)
 	{
 	*(double *) Value = Default;
+	*OptSet = false;
 
 	OptInfo Opt;
 	Opt.Value = Value;
@@ -1288,6 +1306,7 @@ static void DefineStrOpt(const string &LongName, const char *Default,
   const string &Help, void *Value, bool *OptSet)
 	{
 	*(string *) Value = (Default == 0 ? "" : string(Default));
+	*OptSet = false;
 
 	OptInfo Opt;
 	Opt.Value = Value;
@@ -1521,11 +1540,27 @@ static void GetArgsFromFile(const string &FileName, vector<string> &Args)
 	CloseStdioFile(f);
 	}
 
+static unsigned RecurseDepth = 0;
+
+#ifdef UCHIME_LIBRARY
+void ResetCmdLine()
+	{
+	RecurseDepth = 0;
+	}
+#endif
+
 void MyCmdLine(int argc, char **argv)
 	{
-	static unsigned RecurseDepth = 0;
 	++RecurseDepth;
 
+	// Options are re-defined on every top-level call so uchime_main can be run
+	// more than once in the same process.
+	if (RecurseDepth == 1)
+		{
+		g_Opts.clear();
+		g_Argv.clear();
+		}
+
 	DefineFlagOpt("compilerinfo", "Write info about compiler types and #defines to stdout.",
 	  (void *) &opt_compilerinfo, &optset_compilerinfo);
 	DefineFlagOpt("quiet", "Turn off progress messages.", (void *) &opt_quiet, &optset_quiet);
@@ -1550,9 +1585,6 @@ void MyCmdLine(int argc, char **argv)
 #define ENUM_OPT(LongName, Values, Default)		DefineEnumOpt(#LongName, Values, Default, "help", (void *) &opt_##LongName, &optset_##LongName);
 #include "myopts.h"
 
-	if (RecurseDepth == 0)
-		g_Argv.clear();
-
 	for (int i = 0; i < argc; ++i) {
 		g_Argv.push_back(string(argv[i]));
 	}
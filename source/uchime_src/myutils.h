@@ -191,6 +191,19 @@ void SetLogFileName(const string &FileName);
 void Log(const char *szFormat, ...);
 
 void Die(const char *szFormat, ...);
+
+#ifdef UCHIME_LIBRARY
+// When uchime is built into another program, Die and CmdLineErr throw this
+// instead of calling exit(), so only the current uchime_main call fails.
+struct UchimeFatalError
+	{
+	string Msg;
+	UchimeFatalError(const string &s) : Msg(s) {}
+	};
+
+void ResetCmdLine();
+#endif
+
 void Warning(const char *szFormat, ...);
 
 void ProgressStep(unsigned i, unsigned N, const char *Format, ...);
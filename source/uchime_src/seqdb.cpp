@@ -196,12 +196,16 @@ void SeqDB::GetSeqData(unsigned Id, SeqData &Buffer) const
 void SeqDB::SetIsNucleo()
 	{
 	const unsigned SeqCount = GetSeqCount();
+	if (SeqCount == 0)
+		Die("No sequences in %s", m_FileName.c_str());
 	unsigned N = 0;
 	for (unsigned i = 0; i < 100; ++i)
 		{
 		unsigned SeqIndex = unsigned(rand()%SeqCount);
 		const byte *Seq = GetSeq(SeqIndex);
 		unsigned L = GetSeqLength(SeqIndex);
+		if (L == 0)
+			continue;
 		const unsigned Pos = unsigned(rand()%L);
 		byte c = Seq[Pos];
 
@@ -87,7 +87,27 @@ float GetAbFromLabel(const string &Label)
 	return 0.0;
 	}
 
-int main(int argc, char *argv[])
+// The reference database is kept between calls so that mothur can run
+// uchime in-process on several groups without re-reading the --db file.
+static SeqDB *g_RefDB = 0;
+static string g_RefDBFileName;
+
+SeqDB &GetRefDB(const string &FileName)
+	{
+	if (g_RefDB != 0 && g_RefDBFileName == FileName)
+		return *g_RefDB;
+
+	delete g_RefDB;
+	g_RefDB = new SeqDB;
+	g_RefDBFileName = "";
+	g_RefDB->FromFasta(FileName);
+	if (!g_RefDB->IsNucleo())
+		Die("Database contains amino acid sequences");
+	g_RefDBFileName = FileName;
+	return *g_RefDB;
+	}
+
+static int UchimeMain(int argc, char *argv[])
 	{
 		
 	MyCmdLine(argc, argv);
@@ -130,6 +150,8 @@ int main(int argc, char *argv[])
 		Die("Missing --input");
 
 	g_UchimeDeNovo = (opt_db == "");
+	g_fUChime = 0;
+	g_fUChimeAlns = 0;
 
 	if (opt_uchimeout != "")
 		g_fUChime = CreateStdioFile(opt_uchimeout);
@@ -138,7 +160,8 @@ int main(int argc, char *argv[])
 		g_fUChimeAlns = CreateStdioFile(opt_uchimealns);
 
 	SeqDB Input;
-	SeqDB DB;
+	SeqDB DeNovoDB;
+	SeqDB &DB = (g_UchimeDeNovo ? DeNovoDB : GetRefDB(opt_db));
 
 	Input.FromFasta(opt_input);
 	if (!Input.IsNucleo())
@@ -162,12 +185,6 @@ int main(int argc, char *argv[])
 		DB.m_IsNucleoSet = true;
 		DB.m_IsNucleo = true;
 		}
-	else
-		{
-		DB.FromFasta(opt_db);
-		if (!DB.IsNucleo())
-			Die("Database contains amino acid sequences");
-		}
 
 	vector<ChimeHit2> Hits;
 	unsigned HitCount = 0;
@@ -206,7 +223,50 @@ int main(int argc, char *argv[])
 
 	CloseStdioFile(g_fUChime);
 	CloseStdioFile(g_fUChimeAlns);
+	g_fUChime = 0;
+	g_fUChimeAlns = 0;
 
 	ProgressExit();
 	return 0;
 	}
+
+#ifdef UCHIME_LIBRARY
+// Entry points for mothur. A fatal error closes the output files and returns 1
+// with the message in ErrorMsg, instead of ending the process.
+int uchime_preloaddb(const string &FileName, string &ErrorMsg)
+	{
+	try
+		{
+		GetRefDB(FileName);
+		}
+	catch (UchimeFatalError &e)
+		{
+		ErrorMsg = e.Msg;
+		return 1;
+		}
+	return 0;
+	}
+
+int uchime_main(int argc, char *argv[], string &ErrorMsg)
+	{
+	try
+		{
+		return UchimeMain(argc, argv);
+		}
+	catch (UchimeFatalError &e)
+		{
+		ErrorMsg = e.Msg;
+		ResetCmdLine();
+		CloseStdioFile(g_fUChime);
+		CloseStdioFile(g_fUChimeAlns);
+		g_fUChime = 0;
+		g_fUChimeAlns = 0;
+		return 1;
+		}
+	}
+#else
+int main(int argc, char *argv[])
+	{
+	return UchimeMain(argc, argv);
+	}
+#endif